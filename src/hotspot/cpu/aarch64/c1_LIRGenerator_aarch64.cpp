@@ -1380,8 +1380,9 @@ void LIRGenerator::do_If(If* x) {
   }
 
   __ cmp(lir_cond(cond), left, right);
-  // Generate branch profiling. Profiling code doesn't kill flags.
-  profile_branch(x, cond);
+  // Generate branch profiling. Sampled profiling kills the flags, so it
+  // redoes the compare on left and right.
+  profile_branch(x, cond, left, right);
   move_to_phi(x->state());
   if (x->x()->type()->is_float_kind()) {
     __ branch(lir_cond(cond), right->type(), x->tsux(), x->usux());
@@ -3627,6 +3627,92 @@ class StubGenerator: public StubCodeGenerator {
     __ eor(result, __ T16B, lo, t0);
   }
 
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - obja     address
+   *    c_rarg1   - objb     address
+   *    c_rarg2   - length   length
+   *    c_rarg3   - scale    log2_array_indxscale
+   *
+   *  Output:
+   *    r0        - int >= mismatched index, < 0 bitwise complement of tail
+   *
+   *  Compares 16 bytes per iteration with paired 64-bit loads, then one
+   *  more 8-byte word. Fewer than 8 remaining bytes are left to the caller
+   *  and reported as the tail.
+   */
+  address generate_vectorizedMismatch() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedMismatch");
+    address start = __ pc();
+
+    const Register obja = c_rarg0, objb = c_rarg1, length = c_rarg2, scale = c_rarg3;
+    const Register result = r0;
+    const Register cnt = r4, base = r5;
+    const Register tmp1 = r10, tmp2 = r11, tmp3 = r12, tmp4 = r13;
+
+    Label LOOP, TAIL, SHORT_TAIL, DONE, DIFF_FIRST, DIFF_SECOND, DIFF_LAST, DIFF;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+
+    __ mov(base, obja);
+    __ movw(cnt, length);           // zero-extend element count
+    __ lslv(cnt, cnt, scale);       // length in bytes
+    __ subs(cnt, cnt, 16);
+    __ br(Assembler::LT, TAIL);
+
+    __ bind(LOOP);
+    __ ldp(tmp1, tmp2, Address(__ post(obja, 16)));
+    __ ldp(tmp3, tmp4, Address(__ post(objb, 16)));
+    __ eor(tmp1, tmp1, tmp3);
+    __ eor(tmp2, tmp2, tmp4);
+    __ cbnz(tmp1, DIFF_FIRST);
+    __ cbnz(tmp2, DIFF_SECOND);
+    __ subs(cnt, cnt, 16);
+    __ br(Assembler::GE, LOOP);
+
+    __ bind(TAIL);
+    __ adds(cnt, cnt, 16 - 8);      // bytes left after one more word
+    __ br(Assembler::LT, SHORT_TAIL);
+    __ ldr(tmp1, Address(__ post(obja, 8)));
+    __ ldr(tmp3, Address(__ post(objb, 8)));
+    __ eor(tmp1, tmp1, tmp3);
+    __ cbnz(tmp1, DIFF_LAST);
+    __ b(DONE);
+
+    __ bind(SHORT_TAIL);
+    __ add(cnt, cnt, 8);
+
+    __ bind(DONE);
+    __ lsrv(cnt, cnt, scale);       // tail in elements
+    __ mvnw(result, cnt);
+    __ leave();
+    __ ret(lr);
+
+    // obja points past the word pair (or word) holding the difference
+    __ bind(DIFF_SECOND);
+    __ mov(tmp1, tmp2);
+    __ bind(DIFF_LAST);
+    __ sub(obja, obja, 8);
+    __ b(DIFF);
+    __ bind(DIFF_FIRST);
+    __ sub(obja, obja, 16);
+
+    __ bind(DIFF);
+    __ rbit(tmp1, tmp1);            // little-endian: lowest set bit is the first byte
+    __ clz(tmp1, tmp1);
+    __ sub(obja, obja, base);
+    __ add(obja, obja, tmp1, Assembler::LSR, 3);
+    __ lsrv(result, obja, scale);
+    __ leave();
+    __ ret(lr);
+
+    return start;
+  }
+
   address generate_has_negatives(address &has_negatives_long) {
     const u1 large_loop_size = 64;
     const uint64_t UPPER_BIT_MASK=0x8080808080808080;
@@ -5802,6 +5888,10 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
     }
 
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
+
     // Safefetch stubs.
     generate_safefetch("SafeFetch32", sizeof(int),     &StubRoutines::_safefetch32_entry,
                                                        &StubRoutines::_safefetch32_fault_pc,
@@ -1281,7 +1281,7 @@ void LIRGenerator::do_If(If* x) {
   }
 
   __ cmp(lir_cond(cond), left, right);
-  profile_branch(x, cond);
+  profile_branch(x, cond, left, right);
   move_to_phi(x->state());
   if (x->x()->type()->is_float_kind()) {
     __ branch(lir_cond(cond), right->type(), x->tsux(), x->usux());
@@ -761,7 +761,9 @@ class StubGenerator: public StubCodeGenerator {
       // Falling out the bottom means we found a hit; we ARE a subtype
 
       // Success.  Cache the super we found and proceed in triumph.
-      __ str(super_klass, Address(sub_klass, sc_offset));
+      if (UseSecondarySupersCache) {
+        __ str(super_klass, Address(sub_klass, sc_offset));
+      }
 
       // Return success
       // R0 is already 0 and flags are already set to eq
@@ -2423,7 +2425,9 @@ class StubGenerator: public StubCodeGenerator {
     // Falling out the bottom means we found a hit; we ARE a subtype
 
     // Success.  Cache the super we found and proceed in triumph.
-    __ str(super_klass, Address(sub_klass, sc_offset));
+    if (UseSecondarySupersCache) {
+      __ str(super_klass, Address(sub_klass, sc_offset));
+    }
 
     // Jump to success
     __ b(L_success);
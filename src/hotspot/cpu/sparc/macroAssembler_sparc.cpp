@@ -2396,7 +2396,9 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   delayed()->deccc(count_temp); // decrement trip counter in delay slot
 
   // Success.  Cache the super we found and proceed in triumph.
-  st_ptr(super_klass, sub_klass, sc_offset);
+  if (UseSecondarySupersCache) {
+    st_ptr(super_klass, sub_klass, sc_offset);
+  }
 
   if (L_success != &L_fallthrough) {
     ba(*L_success);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef CPU_X86_CONTINUATION_X86_INLINE_HPP
+#define CPU_X86_CONTINUATION_X86_INLINE_HPP
+
+#include "code/codeBlob.hpp"
+#include "code/compiledMethod.hpp"
+#include "runtime/frame.inline.hpp"
+#include "runtime/registerMap.hpp"
+#include "utilities/growableArray.hpp"
+
+// Frame layout knowledge used by Continuation::freeze/thaw.
+//
+// Every Java frame on x86 saves the caller's rbp just below its return
+// address. Interpreted frames use rbp as a frame pointer; compiled frames
+// only do so with PreserveFramePointer, and around method handle calls where
+// rbp holds the caller's sp.
+
+class ContinuationHelper : AllStatic {
+ public:
+  // The stub saved the top frame's rbp at fp_addr.
+  static void set_saved_fp_location(RegisterMap* map, intptr_t** fp_addr) {
+    frame::update_map_with_saved_link(map, fp_addr);
+  }
+
+  // The slot in f holding the rbp of f's caller.
+  static intptr_t** link_address(const frame& f) {
+    if (f.is_interpreted_frame()) {
+      return (intptr_t**)f.addr_at(frame::link_offset);
+    }
+    return (intptr_t**)(sender_sp(f) - frame::sender_sp_offset);
+  }
+
+  // The slot in f holding its return pc.
+  static address* return_pc_address(const frame& f) {
+    return (address*)((intptr_t*)link_address(f) + (frame::return_addr_offset - frame::link_offset));
+  }
+
+  // True if rbp holds a stack address while f executes.
+  static bool fp_is_stack_address(const frame& f) {
+    if (f.is_interpreted_frame() || PreserveFramePointer) {
+      return true;
+    }
+    return f.cb()->as_compiled_method()->is_method_handle_return(f.pc());
+  }
+
+  // The exclusive upper bound of the stack words owned by f, including the
+  // incoming arguments interpreted frames keep in their caller's frame.
+  static intptr_t* frame_end(const frame& f) {
+    if (f.is_interpreted_frame()) {
+      intptr_t* end = f.addr_at(frame::sender_sp_offset);
+      intptr_t* locals_end = *f.interpreter_frame_locals_addr() + 1;
+      return MAX2(end, locals_end);
+    }
+    return sender_sp(f);
+  }
+
+  // The sp f's caller continues with when f returns.
+  static intptr_t* sender_unextended_sp(const frame& f) {
+    if (f.is_interpreted_frame()) {
+      return f.interpreter_frame_sender_sp();
+    }
+    return sender_sp(f);
+  }
+
+  static intptr_t** interpreted_sender_sp_address(const frame& f) {
+    assert(f.is_interpreted_frame(), "must be");
+    return (intptr_t**)f.addr_at(frame::interpreter_frame_sender_sp_offset);
+  }
+
+  // Slots of the interpreted frame f, other than its link and saved sender
+  // sp, that may hold addresses into the stack.
+  static void collect_interpreted_stack_slots(const frame& f, GrowableArray<intptr_t**>* slots) {
+    assert(f.is_interpreted_frame(), "must be");
+    intptr_t** last_sp = (intptr_t**)f.addr_at(frame::interpreter_frame_last_sp_offset);
+    if (*last_sp != NULL) {
+      slots->append(last_sp);
+    }
+    slots->append((intptr_t**)f.addr_at(frame::interpreter_frame_locals_offset));
+    slots->append((intptr_t**)f.addr_at(frame::interpreter_frame_initial_sp_offset));
+  }
+
+ private:
+  static intptr_t* sender_sp(const frame& f) {
+    assert(f.is_compiled_frame() && f.cb()->frame_size() > 0, "must be");
+    return f.unextended_sp() + f.cb()->frame_size();
+  }
+};
+
+#endif // CPU_X86_CONTINUATION_X86_INLINE_HPP
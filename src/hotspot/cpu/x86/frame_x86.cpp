@@ -437,6 +437,10 @@ frame frame::sender_for_interpreter_frame(RegisterMap* map) const {
   // This is the sp before any possible extension (adapter/locals).
   intptr_t* unextended_sp = interpreter_frame_sender_sp();
 
+  if (StubRoutines::is_cont_returnBarrier(sender_pc())) {
+    return sender_for_return_barrier(map);
+  }
+
 #if COMPILER2_OR_JVMCI
   if (map->update_map()) {
     update_map_with_saved_link(map, (intptr_t**) addr_at(link_offset));
@@ -446,6 +450,19 @@ frame frame::sender_for_interpreter_frame(RegisterMap* map) const {
   return frame(sender_sp, unextended_sp, link(), sender_pc());
 }
 
+//------------------------------------------------------------------------------
+// frame::sender_for_return_barrier
+frame frame::sender_for_return_barrier(RegisterMap* map) const {
+  // The frames below the barrier are still frozen in the continuation; the
+  // walk continues with the caller of Continuation.doContinue(), whose rbp
+  // is kept in the thread.
+  JavaThread* thread = map->thread();
+  assert(thread->cont_lazy() != NULL, "no continuation is being thawed");
+  if (map->update_map()) {
+    update_map_with_saved_link(map, thread->cont_entry_fp_addr());
+  }
+  return frame(thread->cont_entry_sp(), thread->cont_entry_sp(), thread->cont_entry_fp(), thread->cont_entry_pc());
+}
 
 //------------------------------------------------------------------------------
 // frame::sender_for_compiled_frame
@@ -459,6 +476,9 @@ frame frame::sender_for_compiled_frame(RegisterMap* map) const {
 
   // On Intel the return_address is always the word on the stack
   address sender_pc = (address) *(sender_sp-1);
+  if (StubRoutines::is_cont_returnBarrier(sender_pc)) {
+    return sender_for_return_barrier(map);
+  }
 
   // This is the saved value of EBP which may or may not really be an FP.
   // It is only an FP if the sender is an interpreter frame (or C1?).
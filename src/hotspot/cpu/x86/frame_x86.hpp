@@ -128,6 +128,10 @@
   static void verify_deopt_original_pc(CompiledMethod* nm, intptr_t* unextended_sp);
 #endif
 
+  // Used in frame::sender_for_{interpreter,compiled}_frame when the sender
+  // pc is the continuation return barrier
+  frame sender_for_return_barrier(RegisterMap* map) const;
+
  public:
   // Constructors
 
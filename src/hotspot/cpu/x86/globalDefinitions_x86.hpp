@@ -67,4 +67,9 @@ const bool CCallingConventionRequiresIntsAsLongs = false;
 
 #define THREAD_LOCAL_POLL
 
+#ifdef _LP64
+// Continuation.doYield() and doContinue() stubs are generated
+#define SUPPORT_CONTINUATIONS
+#endif
+
 #endif // CPU_X86_GLOBALDEFINITIONS_X86_HPP
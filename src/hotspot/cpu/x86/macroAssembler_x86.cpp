@@ -4591,7 +4591,11 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   else  jcc(Assembler::notEqual, *L_failure);
 
   // Success.  Cache the super we found and proceed in triumph.
-  movptr(super_cache_addr, super_klass);
+  // Without the cache the scan is repeated on every check, but the
+  // cache line of sub_klass is not written from every core that hits.
+  if (UseSecondarySupersCache) {
+    movptr(super_cache_addr, super_klass);
+  }
 
   if (L_success != &L_fallthrough) {
     jmp(*L_success);
@@ -36,7 +36,9 @@
 #include "oops/method.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
 #include "prims/methodHandles.hpp"
+#include "runtime/continuation.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
@@ -5763,6 +5765,182 @@ address generate_avx_ghash_processBlocks() {
 
   }
 
+  // Continuation.doYield(Continuation cont)
+  //
+  // Entered as the interpreter entry of doYield, from interpreted code or
+  // through the c2i adapter.
+  //
+  // Inputs:
+  //   rsp[0] - return pc into the yielding frame
+  //   rsp[1] - cont
+  //   r13    - sender sp, the sp of the yielding frame
+  //
+  // On success returns to the caller of Continuation.enter() as if enter()
+  // had returned. Otherwise returns the reason to the yielding frame in rax.
+  address generate_cont_doYield() {
+    StubCodeMark mark(this, "StubRoutines", "cont_doYield");
+    address start = __ pc();
+
+    Label L_no_exception, L_frozen;
+
+    __ movptr(c_rarg1, Address(rsp, wordSize));
+    __ movptr(rax, Address(rsp, 0));
+    __ push(rbp);
+    __ movptr(c_rarg2, rsp);   // the lowest word to freeze
+
+    // The yielding frame is the last Java frame.
+    __ movptr(Address(r15_thread, JavaThread::last_Java_pc_offset()), rax);
+    __ set_last_Java_frame(r13, rbp, NULL);
+    __ call_VM_leaf(CAST_FROM_FN_PTR(address, Continuation::freeze), r15_thread, c_rarg1, c_rarg2);
+    __ reset_last_Java_frame(true);
+
+    __ cmpptr(Address(r15_thread, Thread::pending_exception_offset()), (int32_t)NULL_WORD);
+    __ jcc(Assembler::equal, L_no_exception);
+    __ pop(rbp);
+    __ pop(rscratch1);
+    __ mov(rsp, r13);
+    __ push(rscratch1);
+    __ jump(RuntimeAddress(StubRoutines::forward_exception_entry()));
+
+    // Pinned: return the reason to the yielding frame.
+    __ bind(L_no_exception);
+    __ testl(rax, rax);
+    __ jcc(Assembler::zero, L_frozen);
+    __ pop(rbp);
+    __ pop(rscratch1);
+    __ mov(rsp, r13);
+    __ jmp(rscratch1);
+
+    // Return to the caller of enter(), with the frozen frames gone.
+    __ bind(L_frozen);
+    __ movptr(rbp, Address(r15_thread, JavaThread::cont_fp_offset()));
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::cont_pc_offset()));
+    __ movptr(rsp, Address(r15_thread, JavaThread::cont_sp_offset()));
+    __ jmp(rscratch1);
+
+    return start;
+  }
+
+  // Continuation.doContinue()
+  //
+  // Entered as the interpreter entry of doContinue, from interpreted code or
+  // through the c2i adapter.
+  //
+  // Inputs:
+  //   rsp[0] - return pc into the caller
+  //   rsp[1] - the receiver
+  //   r13    - sender sp
+  //
+  // Thaws the frames frozen by doYield below the caller and returns to the
+  // yielding frame with rax = 0. When the frozen frames return from enter()
+  // they return to the caller of doContinue(); frames not thawed yet are
+  // thawed by the return barrier. JVMTI is told first if it asks to be.
+  address generate_cont_doContinue() {
+    StubCodeMark mark(this, "StubRoutines", "cont_doContinue");
+    address start = __ pc();
+
+    Label L_thaw;
+
+    __ movptr(rbx, Address(rsp, wordSize));   // callee saved
+    __ movptr(r14, Address(rsp, 0));
+
+#if INCLUDE_JVMTI
+    Label L_notified;
+    __ cmp8(ExternalAddress(JvmtiExport::get_should_notify_continuations_addr()), 0);
+    __ jcc(Assembler::equal, L_notified);
+    // notify_mount() may safepoint, with the caller as the last Java frame.
+    // This stub has no frame or oop map, so notify_mount() hands the
+    // receiver back in vm_result, which is a root.
+    __ movptr(Address(r15_thread, JavaThread::last_Java_pc_offset()), r14);
+    __ set_last_Java_frame(r13, rbp, NULL);
+    __ call_VM_leaf(CAST_FROM_FN_PTR(address, Continuation::notify_mount), r15_thread, rbx);
+    __ reset_last_Java_frame(true);
+    __ get_vm_result(rbx, r15_thread);
+
+    __ cmpptr(Address(r15_thread, Thread::pending_exception_offset()), (int32_t)NULL_WORD);
+    __ jcc(Assembler::equal, L_notified);
+    __ pop(rscratch1);
+    __ mov(rsp, r13);
+    __ push(rscratch1);
+    __ jump(RuntimeAddress(StubRoutines::forward_exception_entry()));
+    __ bind(L_notified);
+#endif
+    __ movptr(Address(r15_thread, JavaThread::cont_sp_offset()), r13);
+    __ movptr(Address(r15_thread, JavaThread::cont_fp_offset()), rbp);
+    __ movptr(Address(r15_thread, JavaThread::cont_pc_offset()), r14);
+
+    __ call_VM_leaf(CAST_FROM_FN_PTR(address, Continuation::prepare_thaw), r15_thread, rbx);
+    __ testptr(rax, rax);
+    __ jcc(Assembler::notZero, L_thaw);
+    __ pop(rscratch1);
+    __ mov(rsp, r13);
+    __ push(rscratch1);
+    __ jump(RuntimeAddress(StubRoutines::throw_StackOverflowError_entry()));
+
+    __ bind(L_thaw);
+    __ mov(rsp, r13);
+    __ subptr(rsp, rax);
+    __ andptr(rsp, -StackAlignmentInBytes);
+    __ call_VM_leaf(CAST_FROM_FN_PTR(address, Continuation::thaw), r15_thread, rbx);
+
+    __ movptr(rbp, Address(r15_thread, JavaThread::cont_fp_offset()));
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::cont_pc_offset()));
+    __ movptr(rsp, Address(r15_thread, JavaThread::cont_sp_offset()));
+    __ xorl(rax, rax);
+    __ jmp(rscratch1);
+
+    return start;
+  }
+
+  // Continuation return barrier
+  //
+  // Returned to by the lowest thawed frame of a continuation that still has
+  // frozen frames. Thaws the next frames below the caller of doContinue()
+  // and returns to the topmost of them.
+  //
+  // Inputs:
+  //   rax, xmm0 - the result of the returning frame, preserved
+  //
+  // With exception == true this is the exception handler for the barrier:
+  //   rax       - the exception oop, rethrown in the thawed frame
+  address generate_cont_returnBarrier(bool exception) {
+    StubCodeMark mark(this, "StubRoutines", exception ? "cont_returnBarrierExc" : "cont_returnBarrier");
+    address start = __ pc();
+
+    if (exception) {
+      __ movptr(Address(r15_thread, Thread::pending_exception_offset()), rax);
+    }
+
+    // The stack below the caller of doContinue() is unused.
+    __ movptr(rsp, Address(r15_thread, JavaThread::cont_entry_sp_offset()));
+    __ subptr(rsp, Address(r15_thread, JavaThread::cont_entry_size_offset()));
+    __ andptr(rsp, -StackAlignmentInBytes);
+    if (!exception) {
+      __ push(rax);
+      __ subptr(rsp, wordSize);
+      __ movdbl(Address(rsp, 0), xmm0);
+    }
+
+    __ call_VM_leaf(CAST_FROM_FN_PTR(address, Continuation::thaw_return_barrier), r15_thread);
+
+    if (!exception) {
+      __ movdbl(xmm0, Address(rsp, 0));
+      __ addptr(rsp, wordSize);
+      __ pop(rax);
+    }
+    __ movptr(rbp, Address(r15_thread, JavaThread::cont_fp_offset()));
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::cont_pc_offset()));
+    __ movptr(rsp, Address(r15_thread, JavaThread::cont_sp_offset()));
+    if (exception) {
+      __ push(rscratch1);
+      __ jump(RuntimeAddress(StubRoutines::forward_exception_entry()));
+    } else {
+      __ jmp(rscratch1);
+    }
+
+    return start;
+  }
+
 #undef __
 #define __ masm->
 
@@ -5937,6 +6115,13 @@ address generate_avx_ghash_processBlocks() {
                                CAST_FROM_FN_PTR(address,
                                                 SharedRuntime::
                                                 throw_delayed_StackOverflowError));
+
+    // Continuation support, used by the interpreter entries
+    StubRoutines::_cont_doYield = generate_cont_doYield();
+    StubRoutines::_cont_doContinue = generate_cont_doContinue();
+    StubRoutines::_cont_returnBarrier = generate_cont_returnBarrier(false);
+    StubRoutines::_cont_returnBarrierExc = generate_cont_returnBarrier(true);
+
     if (UseCRC32Intrinsics) {
       // set table address before stub generation which use it
       StubRoutines::_crc_table_adr = (address)StubRoutines::x86::_crc_table;
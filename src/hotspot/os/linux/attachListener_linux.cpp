@@ -29,9 +29,12 @@
 #include "runtime/os.inline.hpp"
 #include "services/attachListener.hpp"
 #include "services/dtraceAttacher.hpp"
+#include "utilities/bytes.hpp"
 
 #include <unistd.h>
+#include <poll.h>
 #include <signal.h>
+#include <sys/time.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -56,6 +59,15 @@
 // 2. When a client connect, the SO_PEERCRED socket option is used to
 //    obtain the credentials of client. We check that the effective uid
 //    of the client matches this process.
+//
+// A client that sends protocol version 2 instead of 1 gets a persistent
+// connection: each reply is framed as <result:u4><length:u4><data> in
+// network byte order and the connection stays open for further requests,
+// which the client may pipeline. Only one persistent connection is kept
+// at a time; further version 2 clients get a single framed reply and are
+// then disconnected. The persistent connection has a receive timeout, so a
+// client that stops in the middle of a request loses its connection instead
+// of blocking the listener.
 
 // forward reference
 class LinuxAttachOperation;
@@ -71,12 +83,31 @@ class LinuxAttachListener: AllStatic {
 
   static bool _atexit_registered;
 
+  // the connection of the persistent (version 2) client, or -1
+  static int _persistent_socket;
+
+  // bytes a pipelining client sent beyond the request read last
+  static char _pending[];
+  static int _pending_len;
+
   // reads a request from the given connected socket
   static LinuxAttachOperation* read_request(int s);
 
+  // reads the next request from the persistent connection, if any
+  static LinuxAttachOperation* read_persistent_request();
+
  public:
   enum {
-    ATTACH_PROTOCOL_VER = 1                     // protocol version
+    ATTACH_PROTOCOL_VER = 1,                    // protocol version
+    ATTACH_PROTOCOL_VER_PERSISTENT = 2          // persistent, framed replies
+  };
+  enum {
+    ATTACH_PERSISTENT_READ_TIMEOUT = 5          // seconds
+  };
+  enum {
+    // <ver>0<cmd>0<arg>0<arg>0<arg>0
+    MAX_REQUEST_LEN = (8 + 1) + (AttachOperation::name_length_max + 1) +
+      AttachOperation::arg_count_max * (AttachOperation::arg_length_max + 1)
   };
   enum {
     ATTACH_ERROR_BADVERSION     = 101           // error codes
@@ -102,6 +133,22 @@ class LinuxAttachListener: AllStatic {
   static bool has_path()                { return _has_path; }
   static int listener()                 { return _listener; }
 
+  static int persistent_socket()        { return _persistent_socket; }
+  static void set_persistent_socket(int s) {
+    _persistent_socket = s;
+    _pending_len = 0;
+    if (s != -1) {
+      // The connection is only read after poll() reports data, but a
+      // client that then sends just part of a request must not hold the
+      // listener thread: reads give up after a while and the connection
+      // is dropped.
+      struct timeval tv;
+      tv.tv_sec = ATTACH_PERSISTENT_READ_TIMEOUT;
+      tv.tv_usec = 0;
+      ::setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (void*)&tv, sizeof(tv));
+    }
+  }
+
   // write the given buffer to a socket
   static int write_fully(int s, char* buf, int len);
 
@@ -113,14 +160,23 @@ class LinuxAttachOperation: public AttachOperation {
   // the connection to the client
   int _socket;
 
+  // true if the client asked for a persistent connection
+  bool _persistent;
+
+  int write_framed_reply(jint res, bufferedStream* st);
+
  public:
   void complete(jint res, bufferedStream* st);
 
   void set_socket(int s)                                { _socket = s; }
   int socket() const                                    { return _socket; }
 
+  void set_persistent(bool persistent)                  { _persistent = persistent; }
+  bool is_persistent() const                            { return _persistent; }
+
   LinuxAttachOperation(char* name) : AttachOperation(name) {
     set_socket(-1);
+    set_persistent(false);
   }
 };
 
@@ -128,6 +184,9 @@ class LinuxAttachOperation: public AttachOperation {
 char LinuxAttachListener::_path[UNIX_PATH_MAX];
 bool LinuxAttachListener::_has_path;
 int LinuxAttachListener::_listener = -1;
+int LinuxAttachListener::_persistent_socket = -1;
+char LinuxAttachListener::_pending[LinuxAttachListener::MAX_REQUEST_LEN];
+int LinuxAttachListener::_pending_len = 0;
 bool LinuxAttachListener::_atexit_registered = false;
 
 // Supporting class to help split a buffer into individual components
@@ -254,61 +313,78 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
   // expected count and the maximum possible length of the request.
   // The request is:
   //   <ver>0<cmd>0<arg>0<arg>0<arg>0
-  // where <ver> is the protocol version (1), <cmd> is the command
+  // where <ver> is the protocol version (1 or 2), <cmd> is the command
   // name ("load", "datadump", ...), and <arg> is an argument
   int expected_str_count = 2 + AttachOperation::arg_count_max;
-  const int max_len = (sizeof(ver_str) + 1) + (AttachOperation::name_length_max + 1) +
-    AttachOperation::arg_count_max*(AttachOperation::arg_length_max + 1);
+  const int max_len = MAX_REQUEST_LEN;
 
   char buf[max_len];
   int str_count = 0;
+  int version = 0;
 
-  // Read until all (expected) strings have been read, the buffer is
-  // full, or EOF.
-
+  // Bytes of buf filled so far, and bytes already searched for the end of
+  // a string. On the persistent connection we start with what the client
+  // pipelined after the previous request.
   int off = 0;
-  int left = max_len;
+  int scanned = 0;
+  if (s == _persistent_socket && _pending_len > 0) {
+    memcpy(buf, _pending, _pending_len);
+    off = _pending_len;
+    _pending_len = 0;
+  }
 
-  do {
-    int n;
-    RESTARTABLE(read(s, buf+off, left), n);
-    assert(n <= left, "buffer was too small, impossible!");
-    buf[max_len - 1] = '\0';
-    if (n == -1) {
-      return NULL;      // reset by peer or other error
-    }
-    if (n == 0) {
-      break;
+  // Read until all (expected) strings have been read, the buffer is
+  // full, or EOF. Reads may return more than one request when the client
+  // pipelines, so strings are counted byte by byte.
+
+  while (str_count < expected_str_count) {
+    if (scanned == off) {
+      if (off == max_len) {
+        break;
+      }
+      int n;
+      RESTARTABLE(read(s, buf+off, max_len-off), n);
+      assert(n <= max_len-off, "buffer was too small, impossible!");
+      if (n == -1) {
+        return NULL;      // reset by peer or other error
+      }
+      if (n == 0) {
+        break;
+      }
+      off += n;
     }
-    for (int i=0; i<n; i++) {
-      if (buf[off+i] == 0) {
-        // EOS found
-        str_count++;
-
-        // The first string is <ver> so check it now to
-        // check for protocol mis-match
-        if (str_count == 1) {
-          if ((strlen(buf) != strlen(ver_str)) ||
-              (atoi(buf) != ATTACH_PROTOCOL_VER)) {
-            char msg[32];
-            sprintf(msg, "%d\n", ATTACH_ERROR_BADVERSION);
-            write_fully(s, msg, strlen(msg));
-            return NULL;
-          }
+    if (buf[scanned++] == 0) {
+      // EOS found
+      str_count++;
+
+      // The first string is <ver> so check it now to
+      // check for protocol mis-match
+      if (str_count == 1) {
+        version = atoi(buf);
+        if ((strlen(buf) != strlen(ver_str)) ||
+            (version != ATTACH_PROTOCOL_VER && version != ATTACH_PROTOCOL_VER_PERSISTENT)) {
+          char msg[32];
+          sprintf(msg, "%d\n", ATTACH_ERROR_BADVERSION);
+          write_fully(s, msg, strlen(msg));
+          return NULL;
         }
       }
     }
-    off += n;
-    left -= n;
-  } while (left > 0 && str_count < expected_str_count);
+  }
 
   if (str_count != expected_str_count) {
     return NULL;        // incomplete request
   }
 
+  // keep whatever follows the request for the next read on this connection
+  if (s == _persistent_socket) {
+    _pending_len = off - scanned;
+    memcpy(_pending, buf + scanned, _pending_len);
+  }
+
   // parse request
 
-  ArgumentIterator args(buf, (max_len)-left);
+  ArgumentIterator args(buf, scanned);
 
   // version already checked
   char* v = args.next();
@@ -334,6 +410,19 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
   }
 
   op->set_socket(s);
+  op->set_persistent(version == ATTACH_PROTOCOL_VER_PERSISTENT);
+  return op;
+}
+
+LinuxAttachOperation* LinuxAttachListener::read_persistent_request() {
+  int s = persistent_socket();
+  LinuxAttachOperation* op = read_request(s);
+  if (op == NULL) {
+    // client went away, sent a bad request or timed out in the middle of one
+    log_debug(attach)("Closing persistent attach connection");
+    set_persistent_socket(-1);
+    ::close(s);
+  }
   return op;
 }
 
@@ -341,12 +430,43 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
 // Dequeue an operation
 //
 // In the Linux implementation there is only a single operation and clients
-// cannot queue commands (except at the socket level).
+// cannot queue commands (except at the socket level, or by pipelining on
+// the persistent connection).
 //
 LinuxAttachOperation* LinuxAttachListener::dequeue() {
   for (;;) {
     int s;
 
+    // serve the persistent client, unless a new client is waiting too
+    if (persistent_socket() != -1) {
+      if (_pending_len > 0) {
+        LinuxAttachOperation* op = read_persistent_request();
+        if (op != NULL) {
+          return op;
+        }
+        continue;
+      }
+      struct pollfd fds[2];
+      fds[0].fd = listener();
+      fds[0].events = POLLIN;
+      fds[0].revents = 0;
+      fds[1].fd = persistent_socket();
+      fds[1].events = POLLIN;
+      fds[1].revents = 0;
+      int n;
+      RESTARTABLE(::poll(fds, 2, -1), n);
+      if (n == -1) {
+        return NULL;
+      }
+      if (fds[1].revents != 0) {
+        LinuxAttachOperation* op = read_persistent_request();
+        if (op != NULL) {
+          return op;
+        }
+        continue;
+      }
+    }
+
     // wait for client to connect
     struct sockaddr addr;
     socklen_t len = sizeof(addr);
@@ -413,26 +533,54 @@ void LinuxAttachOperation::complete(jint result, bufferedStream* st) {
   // cleared by handle_special_suspend_equivalent_condition() or
   // java_suspend_self() via check_and_wait_while_suspended()
 
-  // write operation result
-  char msg[32];
-  sprintf(msg, "%d\n", result);
-  int rc = LinuxAttachListener::write_fully(this->socket(), msg, strlen(msg));
+  if (is_persistent()) {
+    int rc = write_framed_reply(result, st);
+    if (rc == 0 && (LinuxAttachListener::persistent_socket() == -1 ||
+                    LinuxAttachListener::persistent_socket() == this->socket())) {
+      // keep the connection for the next request
+      if (LinuxAttachListener::persistent_socket() == -1) {
+        LinuxAttachListener::set_persistent_socket(this->socket());
+      }
+    } else {
+      if (LinuxAttachListener::persistent_socket() == this->socket()) {
+        LinuxAttachListener::set_persistent_socket(-1);
+      }
+      ::shutdown(this->socket(), 2);
+      ::close(this->socket());
+    }
+  } else {
+    // write operation result
+    char msg[32];
+    sprintf(msg, "%d\n", result);
+    int rc = LinuxAttachListener::write_fully(this->socket(), msg, strlen(msg));
+
+    // write any result data
+    if (rc == 0) {
+      LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
+      ::shutdown(this->socket(), 2);
+    }
 
-  // write any result data
-  if (rc == 0) {
-    LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
-    ::shutdown(this->socket(), 2);
+    // done
+    ::close(this->socket());
   }
 
-  // done
-  ::close(this->socket());
-
   // were we externally suspended while we were waiting?
   thread->check_and_wait_while_suspended();
 
   delete this;
 }
 
+// Writes <result:u4><length:u4><data> in network byte order
+int LinuxAttachOperation::write_framed_reply(jint result, bufferedStream* st) {
+  char header[2 * sizeof(u4)];
+  Bytes::put_Java_u4((address)header, (u4)result);
+  Bytes::put_Java_u4((address)(header + sizeof(u4)), (u4)st->size());
+  int rc = LinuxAttachListener::write_fully(this->socket(), header, sizeof(header));
+  if (rc == 0 && st->size() > 0) {
+    rc = LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
+  }
+  return rc;
+}
 
 // AttachListener functions
 
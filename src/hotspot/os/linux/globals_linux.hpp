@@ -53,6 +53,10 @@
   product(bool, UseTransparentHugePages, false,                         \
           "Use MADV_HUGEPAGE for large pages")                          \
                                                                         \
+  product(bool, UseTransparentHugePagesIfAvailable, false,              \
+          "Use MADV_HUGEPAGE for large pages if the kernel transparent "\
+          "huge page mode is madvise or always")                        \
+                                                                        \
   product(bool, LoadExecStackDllInVMThread, true,                       \
           "Load DLLs with executable-stack attribute in the VM Thread") \
                                                                         \
@@ -2138,6 +2138,8 @@ void os::print_os_info(outputStream* st) {
 
   os::Linux::print_full_memory_info(st);
 
+  os::Linux::print_transparent_huge_pages_info(st);
+
   os::Linux::print_proc_sys_info(st);
 
   os::Linux::print_ld_preload_file(st);
@@ -2304,6 +2306,14 @@ void os::Linux::print_full_memory_info(outputStream* st) {
   st->cr();
 }
 
+void os::Linux::print_transparent_huge_pages_info(outputStream* st) {
+  st->print("\nTransparent huge pages: mode %s",
+            transparent_huge_pages_mode_name(transparent_huge_pages_mode()));
+  st->print(", in use %s", UseTransparentHugePages ? "yes" : "no");
+  julong anon_huge = anon_huge_pages_size();
+  st->print_cr(", AnonHugePages " JULONG_FORMAT "k", anon_huge >> 10);
+}
+
 void os::Linux::print_ld_preload_file(outputStream* st) {
   _print_ascii_file("/etc/ld.so.preload", st, "\n/etc/ld.so.preload:");
   st->cr();
@@ -3609,6 +3619,54 @@ bool os::Linux::transparent_huge_pages_sanity_check(bool warn,
   return result;
 }
 
+os::Linux::THPMode os::Linux::transparent_huge_pages_mode() {
+  // The file lists all modes with the selected one in brackets,
+  // e.g. "always [madvise] never".
+  THPMode mode = THPUnknown;
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp != NULL) {
+    char buf[64];
+    if (fgets(buf, sizeof(buf), fp) != NULL) {
+      if (strstr(buf, "[always]") != NULL) {
+        mode = THPAlways;
+      } else if (strstr(buf, "[madvise]") != NULL) {
+        mode = THPMadvise;
+      } else if (strstr(buf, "[never]") != NULL) {
+        mode = THPNever;
+      }
+    }
+    fclose(fp);
+  }
+  return mode;
+}
+
+const char* os::Linux::transparent_huge_pages_mode_name(THPMode mode) {
+  switch (mode) {
+    case THPAlways:  return "always";
+    case THPMadvise: return "madvise";
+    case THPNever:   return "never";
+    default:         return "unknown";
+  }
+}
+
+// Sum of the AnonHugePages lines of /proc/self/smaps, i.e. the anonymous
+// memory of this process that is actually backed by transparent huge pages.
+julong os::Linux::anon_huge_pages_size() {
+  julong total = 0;
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp != NULL) {
+    char buf[256];
+    while (fgets(buf, sizeof(buf), fp) != NULL) {
+      julong kb;
+      if (sscanf(buf, "AnonHugePages: " JULONG_FORMAT " kB", &kb) == 1) {
+        total += kb * K;
+      }
+    }
+    fclose(fp);
+  }
+  return total;
+}
+
 bool os::Linux::hugetlbfs_sanity_check(bool warn, size_t page_size) {
   bool result = false;
   void *p = mmap(NULL, page_size, PROT_READ|PROT_WRITE,
@@ -3762,12 +3820,31 @@ bool os::Linux::setup_large_page_type(size_t page_size) {
 
     // The type of large pages has not been specified by the user.
 
-    // Try UseHugeTLBFS and then UseSHM.
-    UseHugeTLBFS = UseSHM = true;
+    THPMode mode = THPUnknown;
+    if (UseTransparentHugePagesIfAvailable) {
+      mode = transparent_huge_pages_mode();
+      log_info(pagesize)("Transparent huge page mode: %s",
+                         transparent_huge_pages_mode_name(mode));
+    }
+
+    if (mode == THPMadvise || mode == THPAlways) {
+      // The kernel honors MADV_HUGEPAGE, so opt the heap, metaspace and
+      // code cache in without requiring a preallocated huge page pool.
+      UseTransparentHugePages = true;
+      UseHugeTLBFS = UseSHM = false;
+    } else if (UseTransparentHugePagesIfAvailable && FLAG_IS_DEFAULT(UseLargePages)) {
+      // Only transparent huge pages were asked for and the kernel
+      // does not provide them.
+      UseTransparentHugePages = UseHugeTLBFS = UseSHM = false;
+      return false;
+    } else {
+      // Try UseHugeTLBFS and then UseSHM.
+      UseHugeTLBFS = UseSHM = true;
 
-    // Don't try UseTransparentHugePages since there are known
-    // performance issues with it turned on. This might change in the future.
-    UseTransparentHugePages = false;
+      // Don't try UseTransparentHugePages since there are known
+      // performance issues with it turned on. This might change in the future.
+      UseTransparentHugePages = false;
+    }
   }
 
   if (UseTransparentHugePages) {
@@ -3795,6 +3872,7 @@ bool os::Linux::setup_large_page_type(size_t page_size) {
 void os::large_page_init() {
   if (!UseLargePages &&
       !UseTransparentHugePages &&
+      !UseTransparentHugePagesIfAvailable &&
       !UseHugeTLBFS &&
       !UseSHM) {
     // Not using large pages.
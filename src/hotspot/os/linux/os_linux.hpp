@@ -66,6 +66,14 @@ class Linux {
 
  protected:
 
+  // Mode of /sys/kernel/mm/transparent_hugepage/enabled
+  enum THPMode {
+    THPUnknown,
+    THPAlways,
+    THPMadvise,
+    THPNever
+  };
+
   static julong _physical_memory;
   static pthread_t _main_thread;
   static Mutex* _createThread_lock;
@@ -95,6 +103,9 @@ class Linux {
 
   static bool setup_large_page_type(size_t page_size);
   static bool transparent_huge_pages_sanity_check(bool warn, size_t pages_size);
+  static THPMode transparent_huge_pages_mode();
+  static const char* transparent_huge_pages_mode_name(THPMode mode);
+  static julong anon_huge_pages_size();
   static bool hugetlbfs_sanity_check(bool warn, size_t page_size);
 
   static char* reserve_memory_special_shm(size_t bytes, size_t alignment, char* req_addr, bool exec);
@@ -107,6 +118,7 @@ class Linux {
   static bool release_memory_special_huge_tlbfs(char* base, size_t bytes);
 
   static void print_full_memory_info(outputStream* st);
+  static void print_transparent_huge_pages_info(outputStream* st);
   static void print_container_info(outputStream* st);
   static void print_steal_info(outputStream* st);
   static void print_distro_info(outputStream* st);
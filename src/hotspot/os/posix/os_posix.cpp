@@ -2164,6 +2164,14 @@ void os::PlatformEvent::unpark() {
 // on the condvar. Contention seen when trying to park implies that someone
 // is unparking you, so don't wait. And spurious returns are fine, so there
 // is no need to track notifications.
+//
+// Threads handing work to each other through j.u.c. locks and queues are
+// often unparked within a very short time. Park therefore briefly spins for
+// the permit before blocking, and unpark skips the mutex and the signal
+// entirely if a permit is already available.
+
+// Number of SpinPause() iterations park spins for a permit before blocking.
+static const int Knob_ParkSpinLimit = 100;
 
 void Parker::park(bool isAbsolute, jlong time) {
 
@@ -2192,6 +2200,20 @@ void Parker::park(bool isAbsolute, jlong time) {
     to_abstime(&absTime, time, isAbsolute, false);
   }
 
+  // Spin for a permit. Spinning is futile on a uniprocessor, where the
+  // unparking thread cannot run while we spin.
+  if (os::processor_count() > 1) {
+    for (int i = 0; i < Knob_ParkSpinLimit; i++) {
+      SpinPause();
+      if (_counter > 0 && Atomic::xchg(0, &_counter) > 0) {
+        return;
+      }
+      if (Thread::is_interrupted(thread, false)) {
+        return;
+      }
+    }
+  }
+
   // Enter safepoint region
   // Beware of deadlocks such as 6317397.
   // The per-thread Parker:: mutex is a classic leaf-lock.
@@ -2250,6 +2272,13 @@ void Parker::park(bool isAbsolute, jlong time) {
 }
 
 void Parker::unpark() {
+  // If a permit is already available the parked thread either consumes it
+  // before waiting, or is about to be signaled by whoever made it available.
+  OrderAccess::fence();
+  if (_counter > 0) {
+    return;
+  }
+
   int status = pthread_mutex_lock(_mutex);
   assert_status(status == 0, status, "invariant");
   const int s = _counter;
@@ -208,6 +208,15 @@ ZPhysicalMemory ZPhysicalMemoryBacking::alloc(size_t size) {
 
   ZPhysicalMemory pmem;
 
+  // Try allocate a single contiguous segment. This keeps medium and
+  // large pages backed by one mapping, and leaves the remaining free
+  // ranges intact so that they can later be uncommitted as a whole.
+  const uintptr_t start = _committed.alloc_from_front(size);
+  if (start != UINTPTR_MAX) {
+    pmem.add_segment(ZPhysicalMemorySegment(start, size));
+    return pmem;
+  }
+
   // Allocate segments
   for (size_t allocated = 0; allocated < size; allocated += ZGranuleSize) {
     const uintptr_t start = _committed.alloc_from_front(ZGranuleSize);
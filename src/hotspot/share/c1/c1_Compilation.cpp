@@ -35,7 +35,9 @@
 #include "code/debugInfoRec.hpp"
 #include "compiler/compileLog.hpp"
 #include "compiler/compilerDirectives.hpp"
+#include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/timerTrace.hpp"
 
@@ -80,12 +82,17 @@ class PhaseTraceTime: public TraceTime {
   JavaThread* _thread;
   CompileLog* _log;
   TimerName _timer;
+  jlong _start;
 
  public:
   PhaseTraceTime(TimerName timer)
   : TraceTime("", &timers[timer], CITime || CITimeEach, Verbose),
-    _log(NULL), _timer(timer)
+    _log(NULL), _timer(timer), _start(0)
   {
+    if (log_is_enabled(Debug, jit, compilation)) {
+      _start = os::elapsed_counter();
+    }
+
     if (Compilation::current() != NULL) {
       _log = Compilation::current()->log();
     }
@@ -100,6 +107,12 @@ class PhaseTraceTime: public TraceTime {
   ~PhaseTraceTime() {
     if (_log != NULL)
       _log->done("phase name='%s'", timer_name[_timer]);
+
+    if (_start != 0 && Compilation::current() != NULL) {
+      double ms = (double)(os::elapsed_counter() - _start) * 1000.0 / os::elapsed_frequency();
+      log_debug(jit, compilation)("C1 %u %s: %.3f ms", Compilation::current()->env()->compile_id(),
+                                  timer_name[_timer], ms);
+    }
   }
 };
 
@@ -929,7 +929,53 @@ LIR_Opr LIRGenerator::force_to_spill(LIR_Opr value, BasicType t) {
   return tmp;
 }
 
-void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
+// Returns N if branch profiles of this compilation should only be updated
+// on about every N-th execution, with each update weighted by N. N is a
+// power of two, so that the jittered interval can be computed with a mask.
+int LIRGenerator::profile_sample_rate() {
+  int rate = (int)compilation()->directive()->C1ProfileSampleRateOption;
+  return rate > 1 ? 1 << log2_int(rate) : 1;
+}
+
+// Counts down the per-thread sample counter and branches to skip unless it
+// reached zero, in which case the update proceeds and the counter is reset
+// to a pseudo-random interval in [rate/2, 3*rate/2). A fixed interval would
+// make loops whose trip count shares a factor with the rate always sample
+// the same branches. The per-thread seed is advanced with a xorshift step.
+// Kills the condition codes.
+void LIRGenerator::profile_sample_check(int rate, LabelObj* skip) {
+  assert(is_power_of_2(rate), "must be");
+  LIR_Address* counter_addr = new LIR_Address(getThreadPointer(),
+                                              in_bytes(JavaThread::profile_sample_counter_offset()),
+                                              T_INT);
+  LIR_Opr counter = new_register(T_INT);
+  __ move(counter_addr, counter);
+  __ sub(counter, LIR_OprFact::intConst(1), counter);
+  __ move(counter, counter_addr);
+  __ cmp(lir_cond_greater, counter, LIR_OprFact::intConst(0));
+  __ branch(lir_cond_greater, T_INT, skip->label());
+
+  LIR_Address* seed_addr = new LIR_Address(getThreadPointer(),
+                                           in_bytes(JavaThread::profile_sample_seed_offset()),
+                                           T_INT);
+  LIR_Opr seed = new_register(T_INT);
+  LIR_Opr tmp = new_register(T_INT);
+  __ move(seed_addr, seed);
+  __ shift_left(seed, 13, tmp);
+  __ logical_xor(seed, tmp, seed);
+  __ unsigned_shift_right(seed, 17, tmp);
+  __ logical_xor(seed, tmp, seed);
+  __ shift_left(seed, 5, tmp);
+  __ logical_xor(seed, tmp, seed);
+  __ move(seed, seed_addr);
+
+  LIR_Opr reset = new_register(T_INT);
+  __ logical_and(seed, LIR_OprFact::intConst(rate - 1), reset);
+  __ add(reset, LIR_OprFact::intConst(rate / 2), reset);
+  __ move(reset, counter_addr);
+}
+
+void LIRGenerator::profile_branch(If* if_instr, If::Condition cond, LIR_Opr left, LIR_Opr right) {
   if (if_instr->should_profile()) {
     ciMethod* method = if_instr->profiled_method();
     assert(method != NULL, "method should be set if branch is profiled");
@@ -955,14 +1001,33 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
              LIR_OprFact::intptrConst(not_taken_count_offset),
              data_offset_reg, as_BasicType(if_instr->x()->type()));
 
+    // Sampling kills the condition codes, so the caller's compare has to
+    // be redone afterwards. That is only possible if it does not destroy
+    // its operands, which double word and x87 compares do on 32-bit.
+    int rate = profile_sample_rate();
+    if (rate > 1 && (!left->is_valid() || !right->is_valid()
+                     NOT_LP64(|| left->type() == T_LONG || left->is_float_kind()))) {
+      rate = 1;
+    }
+    LabelObj* skip = NULL;
+    if (rate > 1) {
+      skip = new LabelObj();
+      profile_sample_check(rate, skip);
+    }
+
     // MDO cells are intptr_t, so the data_reg width is arch-dependent.
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
     // Use leal instead of add to avoid destroying condition codes on x86
-    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment, T_INT);
+    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment * rate, T_INT);
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
+
+    if (rate > 1) {
+      __ branch_destination(skip->label());
+      __ cmp(lir_cond(cond), left, right);
+    }
   }
 }
 
@@ -2473,8 +2538,17 @@ void LIRGenerator::do_Goto(Goto* x) {
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
+    int rate = profile_sample_rate();
+    LabelObj* skip = NULL;
+    if (rate > 1) {
+      skip = new LabelObj();
+      profile_sample_check(rate, skip);
+    }
     increment_counter(new LIR_Address(md_reg, offset,
-                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
+                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment * rate);
+    if (rate > 1) {
+      __ branch_destination(skip->label());
+    }
   }
 
   // emit phi-instruction move after safepoint since this simplifies
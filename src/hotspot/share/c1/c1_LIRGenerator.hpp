@@ -394,7 +394,10 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   LIR_Opr safepoint_poll_register();
 
-  void profile_branch(If* if_instr, If::Condition cond);
+  void profile_branch(If* if_instr, If::Condition cond,
+                      LIR_Opr left = LIR_OprFact::illegalOpr, LIR_Opr right = LIR_OprFact::illegalOpr);
+  int  profile_sample_rate();
+  void profile_sample_check(int rate, LabelObj* skip);
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, LIR_Opr step, int frequency,
                                     int bci, bool backedge, bool notify);
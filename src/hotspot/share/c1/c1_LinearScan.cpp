@@ -5068,6 +5068,12 @@ int LinearScanWalker::find_optimal_split_pos(Interval* it, int min_split_pos, in
       TRACE_LINEAR_SCAN(4, tty->print_cr("      cannot move split pos to block boundary because min_pos and max_pos are in same block"));
       optimal_split_pos = max_split_pos;
 
+    } else if (allocator()->max_lir_op_id() > (C1LinearScanFastModeThreshold << 1)) {
+      // huge method: searching for the optimal block boundary is too expensive,
+      // so split as late as possible
+      TRACE_LINEAR_SCAN(4, tty->print_cr("      method is too large for split pos optimization"));
+      optimal_split_pos = max_split_pos;
+
     } else if (it->has_hole_between(max_split_pos - 1, max_split_pos) && !allocator()->is_block_begin(max_split_pos)) {
       // Do not move split position if the interval has a hole before max_split_pos.
       // Intervals resulting from Phi-Functions have more than one definition (marked
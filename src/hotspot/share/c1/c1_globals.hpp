@@ -212,6 +212,11 @@
   product(bool, TimeLinearScan, false,                                      \
           "detailed timing of LinearScan phases")                           \
                                                                             \
+  product(intx, C1LinearScanFastModeThreshold, 30000,                       \
+          "Number of LIR instructions above which LinearScan does not "     \
+          "search for optimal split positions")                             \
+          range(0, max_jint)                                                \
+                                                                            \
   develop(bool, TimeEachLinearScan, false,                                  \
           "print detailed timing of each LinearScan run")                   \
                                                                             \
@@ -312,6 +317,13 @@
   product(bool, C1ProfileBranches, true,                                    \
           "Profile branches when generating code for updating MDOs")        \
                                                                             \
+  product(intx, C1ProfileSampleRate, 1,                                     \
+          "Update branch profiles in MDOs about once every this many "      \
+          "executions per thread, weighting each update accordingly. "      \
+          "Rounded down to a power of two. 1 updates them on every "        \
+          "execution")                                                      \
+          range(1, 1024)                                                    \
+                                                                            \
   product(bool, C1ProfileCheckcasts, true,                                  \
           "Profile checkcasts when generating code for updating MDOs")      \
                                                                             \
@@ -152,11 +152,10 @@ void ClassFileParser::parse_constant_pool_entries(const ClassFileStream* const s
   assert(cfs->allocated_on_stack(), "should be local");
   debug_only(const u1* const old_current = stream->current();)
 
-  // Used for batching symbol allocations.
+  // Used for batching symbol lookups and allocations.
   const char* names[SymbolTable::symbol_alloc_batch_size];
   int lengths[SymbolTable::symbol_alloc_batch_size];
   int indices[SymbolTable::symbol_alloc_batch_size];
-  unsigned int hashValues[SymbolTable::symbol_alloc_batch_size];
   int names_count = 0;
 
   // parsing  Index 0 is unused
@@ -321,27 +320,17 @@ void ClassFileParser::parse_constant_pool_entries(const ClassFileStream* const s
           utf8_length = (u2) strlen(str);
         }
 
-        unsigned int hash;
-        Symbol* const result = SymbolTable::lookup_only((const char*)utf8_buffer,
-                                                        utf8_length,
-                                                        hash);
-        if (result == NULL) {
-          names[names_count] = (const char*)utf8_buffer;
-          lengths[names_count] = utf8_length;
-          indices[names_count] = index;
-          hashValues[names_count++] = hash;
-          if (names_count == SymbolTable::symbol_alloc_batch_size) {
-            SymbolTable::new_symbols(_loader_data,
-                                     cp,
-                                     names_count,
-                                     names,
-                                     lengths,
-                                     indices,
-                                     hashValues);
-            names_count = 0;
-          }
-        } else {
-          cp->symbol_at_put(index, result);
+        names[names_count] = (const char*)utf8_buffer;
+        lengths[names_count] = utf8_length;
+        indices[names_count++] = index;
+        if (names_count == SymbolTable::symbol_alloc_batch_size) {
+          SymbolTable::lookup_or_new_symbols(_loader_data,
+                                             cp,
+                                             names_count,
+                                             names,
+                                             lengths,
+                                             indices);
+          names_count = 0;
         }
         break;
       }
@@ -366,15 +355,14 @@ void ClassFileParser::parse_constant_pool_entries(const ClassFileStream* const s
     } // end of switch(tag)
   } // end of for
 
-  // Allocate the remaining symbols
+  // Look up or allocate the remaining symbols
   if (names_count > 0) {
-    SymbolTable::new_symbols(_loader_data,
-                             cp,
-                             names_count,
-                             names,
-                             lengths,
-                             indices,
-                             hashValues);
+    SymbolTable::lookup_or_new_symbols(_loader_data,
+                                       cp,
+                                       names_count,
+                                       names,
+                                       lengths,
+                                       indices);
   }
 
   // Copy _current pointer of local copy back to stream.
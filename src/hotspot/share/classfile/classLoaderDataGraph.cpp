@@ -30,6 +30,8 @@
 #include "classfile/moduleEntry.hpp"
 #include "classfile/packageEntry.hpp"
 #include "code/dependencyContext.hpp"
+#include "gc/shared/allocationProfile.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -38,6 +40,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
@@ -190,6 +193,7 @@ ClassLoaderData* ClassLoaderDataGraph::_saved_unloading = NULL;
 ClassLoaderData* ClassLoaderDataGraph::_saved_head = NULL;
 
 bool ClassLoaderDataGraph::_should_purge = false;
+bool ClassLoaderDataGraph::_deferred_purge = false;
 bool ClassLoaderDataGraph::_should_clean_deallocate_lists = false;
 bool ClassLoaderDataGraph::_safepoint_cleanup_needed = false;
 bool ClassLoaderDataGraph::_metaspace_oom = false;
@@ -566,6 +570,10 @@ bool ClassLoaderDataGraph::do_unloading() {
 
   log_debug(class, loader, data)("do_unloading: loaders processed %u, loaders removed %u", loaders_processed, loaders_removed);
 
+  if (seen_dead_loader) {
+    AllocationProfile::do_unloading();
+  }
+
   return seen_dead_loader;
 }
 
@@ -595,6 +603,7 @@ void ClassLoaderDataGraph::clean_module_and_package_info() {
 void ClassLoaderDataGraph::purge() {
   ClassLoaderData* list = _unloading;
   _unloading = NULL;
+  _deferred_purge = false;
   ClassLoaderData* next = list;
   bool classes_unloaded = false;
   while (next != NULL) {
@@ -610,6 +619,57 @@ void ClassLoaderDataGraph::purge() {
   DependencyContext::purge_dependency_contexts();
 }
 
+// Each CLD is unlinked from the head of the list before it is deleted, so
+// a safepoint while yielding, e.g. a Full GC, may unlink and purge further
+// CLDs itself without the two walks overlapping.
+void ClassLoaderDataGraph::purge_yielding() {
+  assert(Thread::current()->is_suspendible_thread(), "must be in the suspendible thread set");
+  bool classes_unloaded = false;
+  while (_unloading != NULL) {
+    ClassLoaderData* purge_me = _unloading;
+    _unloading = purge_me->next();
+    delete purge_me;
+    classes_unloaded = true;
+    SuspendibleThreadSet::yield();
+  }
+  if (classes_unloaded) {
+    Metaspace::purge();
+    set_metaspace_oom(false);
+  }
+  DependencyContext::purge_dependency_contexts();
+}
+
+void ClassLoaderDataGraph::purge_or_defer(GCCause::Cause cause) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+  switch (cause) {
+    case GCCause::_metadata_GC_threshold:
+    case GCCause::_metadata_GC_clear_soft_refs:
+    case GCCause::_last_ditch_collection:
+      // The failed metadata allocation is retried right after the GC.
+      purge();
+      return;
+    default:
+      break;
+  }
+  if (_unloading == NULL) {
+    DependencyContext::purge_dependency_contexts();
+    return;
+  }
+  MutexLocker ml(Service_lock, Mutex::_no_safepoint_check_flag);
+  _deferred_purge = true;
+  Service_lock->notify_all();
+}
+
+// The ServiceThread runs this in VM state, so no safepoint can unlink more
+// CLDs or purge synchronously while the list is being freed.
+void ClassLoaderDataGraph::purge_deferred() {
+  assert(Thread::current()->is_Java_thread(), "must be the ServiceThread");
+  assert(!SafepointSynchronize::is_at_safepoint(), "should not be at safepoint");
+  if (_deferred_purge) {
+    purge();
+  }
+}
+
 int ClassLoaderDataGraph::resize_dictionaries() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
   int resized = 0;
@@ -26,6 +26,7 @@
 #define SHARE_CLASSFILE_CLASSLOADERDATAGRAPH_HPP
 
 #include "classfile/classLoaderData.hpp"
+#include "gc/shared/gcCause.hpp"
 #include "memory/allocation.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
@@ -47,6 +48,8 @@ class ClassLoaderDataGraph : public AllStatic {
   static ClassLoaderData* _saved_head;
   static ClassLoaderData* _saved_unloading;
   static bool _should_purge;
+  // Set if unlinked CLDs are waiting to be freed by the ServiceThread.
+  static bool _deferred_purge;
 
   // Set if there's anything to purge in the deallocate lists or previous versions
   // during a safepoint after class unloading in a full GC.
@@ -67,6 +70,15 @@ class ClassLoaderDataGraph : public AllStatic {
   static ClassLoaderData* find_or_create(Handle class_loader);
   static void clean_module_and_package_info();
   static void purge();
+  // Like purge(), but for a concurrent GC thread in the suspendible thread
+  // set, which yields to safepoints between CLDs.
+  static void purge_yielding();
+  // Called at the end of a stop-the-world collection. Unless the collection
+  // was triggered by a metadata allocation that is about to be retried, the
+  // unlinked CLDs and their metaspace are freed later by the ServiceThread.
+  static void purge_or_defer(GCCause::Cause cause);
+  static bool has_deferred_purge() { return _deferred_purge; }
+  static void purge_deferred();
   static void clear_claimed_marks();
   static void clear_claimed_marks(int claim);
   // Iteration through CLDG inside a safepoint; GC support
@@ -53,6 +53,7 @@
 #include "oops/typeArrayOop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/resolvedMethodTable.hpp"
+#include "runtime/continuation.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
@@ -2323,10 +2324,12 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
   bool skip_fillInStackTrace_check = false;
   bool skip_throwableInit_check = false;
   bool skip_hidden = !ShowHiddenFrames;
+  FrozenFrameStream frozen(thread);
 
   for (frame fr = thread->last_frame(); max_depth == 0 || max_depth != total_count;) {
     Method* method = NULL;
     int bci = 0;
+    bool is_frozen = false;
 
     // Compiled java method case.
     if (decode_offset != 0) {
@@ -2334,8 +2337,15 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
       decode_offset = stream.read_int();
       method = (Method*)nm->metadata_at(stream.read_int());
       bci = stream.read_bci();
+    } else if (frozen.is_walking()) {
+      // Frames of a lazily thawed continuation, still frozen below fr
+      method = frozen.method();
+      bci = frozen.bci();
+      frozen.next();
+      is_frozen = true;
     } else {
       if (fr.is_first_frame()) break;
+      if (frozen.enter_at(fr.id())) continue;
       address pc = fr.pc();
       if (fr.is_interpreted_frame()) {
         address bcp = fr.interpreter_frame_bcp();
@@ -2364,13 +2374,16 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
       }
     }
 #ifdef ASSERT
-    assert(st_method() == method && st.bci() == bci,
-           "Wrong stack trace");
-    st.next();
-    // vframeStream::method isn't GC-safe so store off a copy
-    // of the Method* in case we GC.
-    if (!st.at_end()) {
-      st_method = st.method();
+    // vframeStream skips frozen frames.
+    if (!is_frozen) {
+      assert(st_method() == method && st.bci() == bci,
+             "Wrong stack trace");
+      st.next();
+      // vframeStream::method isn't GC-safe so store off a copy
+      // of the Method* in case we GC.
+      if (!st.at_end()) {
+        st_method = st.method();
+      }
     }
 #endif
 
@@ -2717,6 +2730,40 @@ void java_lang_LiveStackFrameInfo::serialize_offsets(SerializeClosure* f) {
 }
 #endif
 
+#define CONTINUATION_FIELDS_DO(macro) \
+  macro(_stack_offset,      k, "stack",       long_array_signature,   false); \
+  macro(_refStack_offset,   k, "refStack",    object_array_signature, false)
+
+void java_lang_Continuation::compute_offsets() {
+  InstanceKlass* k = SystemDictionary::Continuation_klass();
+  if (k == NULL) {
+    return;   // not provided by the class library
+  }
+  CONTINUATION_FIELDS_DO(FIELD_COMPUTE_OFFSET);
+}
+
+#if INCLUDE_CDS
+void java_lang_Continuation::serialize_offsets(SerializeClosure* f) {
+  CONTINUATION_FIELDS_DO(FIELD_SERIALIZE_OFFSET);
+}
+#endif
+
+typeArrayOop java_lang_Continuation::stack(oop cont) {
+  return (typeArrayOop)cont->obj_field(_stack_offset);
+}
+
+objArrayOop java_lang_Continuation::refStack(oop cont) {
+  return (objArrayOop)cont->obj_field(_refStack_offset);
+}
+
+void java_lang_Continuation::set_stack(oop cont, typeArrayOop value) {
+  cont->obj_field_put(_stack_offset, value);
+}
+
+void java_lang_Continuation::set_refStack(oop cont, objArrayOop value) {
+  cont->obj_field_put(_refStack_offset, value);
+}
+
 #define ACCESSIBLEOBJECT_FIELDS_DO(macro) \
   macro(override_offset, k, "override", bool_signature, false)
 
@@ -4151,6 +4198,8 @@ int java_lang_LiveStackFrameInfo::_monitors_offset;
 int java_lang_LiveStackFrameInfo::_locals_offset;
 int java_lang_LiveStackFrameInfo::_operands_offset;
 int java_lang_LiveStackFrameInfo::_mode_offset;
+int java_lang_Continuation::_stack_offset;
+int java_lang_Continuation::_refStack_offset;
 int java_lang_AssertionStatusDirectives::classes_offset;
 int java_lang_AssertionStatusDirectives::classEnabled_offset;
 int java_lang_AssertionStatusDirectives::packages_offset;
@@ -80,6 +80,7 @@
   f(java_lang_StackTraceElement) \
   f(java_lang_StackFrameInfo) \
   f(java_lang_LiveStackFrameInfo) \
+  f(java_lang_Continuation) \
   f(java_util_concurrent_locks_AbstractOwnableSynchronizer) \
   f(jdk_internal_misc_UnsafeConstants) \
   //end
@@ -1443,6 +1444,28 @@ class java_lang_LiveStackFrameInfo: AllStatic {
   friend class JavaClasses;
 };
 
+// Interface to java.lang.Continuation objects. A frozen continuation keeps
+// its raw stack words in a long[] and the oops found in those frames in a
+// parallel Object[], so that the collectors need no special support.
+
+class java_lang_Continuation: AllStatic {
+ private:
+  static int _stack_offset;
+  static int _refStack_offset;
+
+ public:
+  static typeArrayOop stack(oop cont);
+  static objArrayOop  refStack(oop cont);
+  static void set_stack(oop cont, typeArrayOop value);
+  static void set_refStack(oop cont, objArrayOop value);
+
+  static void compute_offsets();
+  static void serialize_offsets(SerializeClosure* f) NOT_CDS_RETURN;
+
+  // Debugging
+  friend class JavaClasses;
+};
+
 // Interface to java.lang.AssertionStatusDirectives objects
 
 class java_lang_AssertionStatusDirectives: AllStatic {
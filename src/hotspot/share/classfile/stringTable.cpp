@@ -91,6 +91,29 @@ OopStorage* StringTable::_weak_handles = NULL;
 static size_t _current_size = 0;
 static volatile size_t _items_count = 0;
 
+// Intern statistics, reported by the StringTableStatistics event. Each
+// thread counts its interns locally and adds them here in batches, so that
+// interning threads do not contend on these counters. The totals lag by up
+// to intern_count_batch - 1 interns per thread.
+static volatile size_t _intern_count = 0;
+static volatile size_t _intern_miss_count = 0;
+static const uint intern_count_batch = 64;
+
+static void count_intern(Thread* thread, bool miss) {
+  ThreadStatisticalInfo& info = thread->statistical_info();
+  if (miss) {
+    info.pending_intern_misses()++;
+  }
+  if (++info.pending_interns() == intern_count_batch) {
+    Atomic::add((size_t)intern_count_batch, &_intern_count);
+    if (info.pending_intern_misses() > 0) {
+      Atomic::add((size_t)info.pending_intern_misses(), &_intern_miss_count);
+    }
+    info.pending_interns() = 0;
+    info.pending_intern_misses() = 0;
+  }
+}
+
 volatile bool _alt_hash = false;
 static juint murmur_seed = 0;
 
@@ -333,6 +356,7 @@ oop StringTable::intern(Handle string_or_null_h, const jchar* name, int len, TRA
   unsigned int hash = java_lang_String::hash_code(name, len);
   oop found_string = lookup_shared(name, len, hash);
   if (found_string != NULL) {
+    count_intern(THREAD, false);
     return found_string;
   }
   if (_alt_hash) {
@@ -340,8 +364,10 @@ oop StringTable::intern(Handle string_or_null_h, const jchar* name, int len, TRA
   }
   found_string = do_lookup(name, len, hash);
   if (found_string != NULL) {
+    count_intern(THREAD, false);
     return found_string;
   }
+  count_intern(THREAD, true);
   return do_intern(string_or_null_h, name, len, hash, THREAD);
 }
 
@@ -576,6 +602,16 @@ TableStatistics StringTable::get_table_statistics() {
   return ts;
 }
 
+size_t StringTable::intern_count() {
+  return _intern_count;
+}
+
+size_t StringTable::intern_hit_count() {
+  size_t misses = _intern_miss_count;
+  size_t total = _intern_count;
+  return total > misses ? total - misses : 0;
+}
+
 void StringTable::print_table_statistics(outputStream* st,
                                          const char* table_name) {
   SizeFunc sz;
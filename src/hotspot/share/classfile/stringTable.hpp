@@ -77,6 +77,8 @@ class StringTable : public CHeapObj<mtSymbol>{
  public:
   static size_t table_size();
   static TableStatistics get_table_statistics();
+  static size_t intern_count();
+  static size_t intern_hit_count();
 
   static OopStorage* weak_storage() { return _weak_handles; }
 
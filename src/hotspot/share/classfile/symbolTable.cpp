@@ -471,6 +471,67 @@ void SymbolTable::new_symbols(ClassLoaderData* loader_data, const constantPoolHa
   }
 }
 
+void SymbolTable::lookup_or_new_symbols(ClassLoaderData* loader_data, const constantPoolHandle& cp,
+                                        int names_count, const char** names, int* lengths,
+                                        int* cp_indices) {
+  assert(names_count <= symbol_alloc_batch_size, "batch too large");
+  const char* new_names[symbol_alloc_batch_size];
+  int new_lengths[symbol_alloc_batch_size];
+  int new_indices[symbol_alloc_batch_size];
+  unsigned int new_hashValues[symbol_alloc_batch_size];
+  int new_count = 0;
+  bool rehash_warning = false;
+  Thread* THREAD = Thread::current();
+
+  {
+    // Enter the critical section once for the whole batch instead of
+    // once per lookup.
+    SymbolTableHash::MultiGetHandle mgh(THREAD, _local_table);
+    for (int i = 0; i < names_count; i++) {
+      const char* name = names[i];
+      int len = lengths[i];
+      unsigned int hash = hash_symbol(name, len, _alt_hash);
+      // Same adaptive order as lookup_common(): try first whichever of the
+      // shared and local tables hit last.
+      bool shared_first = _lookup_shared_first;
+      Symbol* sym = NULL;
+      if (shared_first) {
+        sym = lookup_shared(name, len, hash);
+        if (sym == NULL) {
+          _lookup_shared_first = false;
+        }
+      }
+      if (sym == NULL) {
+        SymbolTableLookup lookup(name, len, hash);
+        Symbol** res = mgh.get(lookup, &rehash_warning);
+        if (res != NULL) {
+          sym = *res;
+          assert(sym->refcount() != 0, "found dead symbol");
+        } else if (!shared_first) {
+          sym = lookup_shared(name, len, hash);
+          if (sym != NULL) {
+            _lookup_shared_first = true;
+          }
+        }
+      }
+      if (sym != NULL) {
+        cp->symbol_at_put(cp_indices[i], sym);
+      } else {
+        new_names[new_count] = name;
+        new_lengths[new_count] = len;
+        new_indices[new_count] = cp_indices[i];
+        new_hashValues[new_count++] = hash;
+      }
+    }
+  }
+
+  update_needs_rehash(rehash_warning);
+
+  if (new_count > 0) {
+    new_symbols(loader_data, cp, new_count, new_names, new_lengths, new_indices, new_hashValues);
+  }
+}
+
 Symbol* SymbolTable::do_add_if_needed(const char* name, int len, uintx hash, bool heap) {
   SymbolTableLookup lookup(name, len, hash);
   SymbolTableGet stg;
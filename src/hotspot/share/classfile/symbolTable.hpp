@@ -137,6 +137,14 @@ class SymbolTable : public AllStatic {
                           const char** name, int* lengths,
                           int* cp_indices, unsigned int* hashValues);
 
+  // Looks up all names within one read-side critical section of the table
+  // and puts them into cp, adding those that are missing with new_symbols().
+  // Used by the ClassfileParser.
+  static void lookup_or_new_symbols(ClassLoaderData* loader_data,
+                                    const constantPoolHandle& cp, int names_count,
+                                    const char** names, int* lengths,
+                                    int* cp_indices);
+
   static Symbol* lookup_shared(const char* name, int len, unsigned int hash) NOT_CDS_RETURN_(NULL);
   static Symbol* lookup_dynamic(const char* name, int len, unsigned int hash);
   static Symbol* lookup_common(const char* name, int len, unsigned int hash);
@@ -105,6 +105,8 @@ InstanceKlass*      SystemDictionary::_well_known_klasses[SystemDictionary::WKID
 
 InstanceKlass*      SystemDictionary::_box_klasses[T_VOID+1]      =  { NULL /*, NULL...*/ };
 
+InstanceKlass*      SystemDictionary::_continuation_klass         =  NULL;
+
 oop         SystemDictionary::_java_system_loader         =  NULL;
 oop         SystemDictionary::_java_platform_loader       =  NULL;
 
@@ -2022,6 +2024,12 @@ void SystemDictionary::resolve_well_known_classes(TRAPS) {
   //_box_klasses[T_OBJECT]  = WK_KLASS(object_klass);
   //_box_klasses[T_ARRAY]   = WK_KLASS(object_klass);
 
+  // Continuations are only supported if the class library has the class.
+  Klass* cont = resolve_or_null(vmSymbols::java_lang_Continuation(), CHECK);
+  if (cont != NULL) {
+    _continuation_klass = InstanceKlass::cast(cont);
+  }
+
   { // Compute whether we should use checkPackageAccess or NOT
     Method* method = InstanceKlass::cast(ClassLoader_klass())->find_method(vmSymbols::checkPackageAccess_name(), vmSymbols::class_protectiondomain_signature());
     _has_checkPackageAccess = (method != NULL);
@@ -415,6 +415,9 @@ public:
     return check_klass(_box_klasses[t]);
   }
   static BasicType box_klass_type(Klass* k);  // inverse of box_klass
+
+  // java.lang.Continuation, or NULL if the class library does not provide it
+  static InstanceKlass* Continuation_klass() { return _continuation_klass; }
 #ifdef ASSERT
   static bool is_well_known_klass(Klass* k) {
     return is_well_known_klass(k->name());
@@ -671,6 +674,9 @@ protected:
   // table of box klasses (int_klass, etc.)
   static InstanceKlass* _box_klasses[T_VOID+1];
 
+  // Optional, so not among the well-known klasses
+  static InstanceKlass* _continuation_klass;
+
 private:
   static oop  _java_system_loader;
   static oop  _java_platform_loader;
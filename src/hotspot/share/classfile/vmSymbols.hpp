@@ -331,6 +331,10 @@
   template(java_lang_StackStreamFactory_AbstractStackWalker, "java/lang/StackStreamFactory$AbstractStackWalker") \
   template(doStackWalk_signature,                     "(JIIII)Ljava/lang/Object;")                \
   template(asPrimitive_name,                          "asPrimitive")                              \
+                                                                                                  \
+  /* Support for continuations */                                                                 \
+  template(java_lang_Continuation,                    "java/lang/Continuation")                   \
+  template(long_array_signature,                      "[J")                                       \
   template(asPrimitive_int_signature,                 "(I)Ljava/lang/LiveStackFrame$PrimitiveSlot;") \
   template(asPrimitive_long_signature,                "(J)Ljava/lang/LiveStackFrame$PrimitiveSlot;") \
                                                                                                   \
@@ -1007,6 +1011,15 @@
   /* java/lang/ref/Reference */                                                                                         \
   do_intrinsic(_Reference_get,            java_lang_ref_Reference, get_name,    void_object_signature, F_R)             \
                                                                                                                         \
+  /* java/lang/Continuation: frame boundary, freeze and thaw entry points */                                            \
+  do_intrinsic(_Continuation_enter,       java_lang_Continuation, enter_name,      void_method_signature, F_R)          \
+   do_name(     enter_name,                                      "enter")                                               \
+  do_intrinsic(_Continuation_doContinue,  java_lang_Continuation, doContinue_name, void_method_signature, F_R)          \
+   do_name(     doContinue_name,                                 "doContinue")                                          \
+  do_intrinsic(_Continuation_doYield,     java_lang_Continuation, doYield_name,    continuation_int_signature, F_S)     \
+   do_name(     doYield_name,                                    "doYield")                                             \
+   do_signature(continuation_int_signature,                      "(Ljava/lang/Continuation;)I")                         \
+                                                                                                                        \
   /* support for com.sun.crypto.provider.AESCrypt and some of its callers */                                            \
   do_class(com_sun_crypto_provider_aescrypt,      "com/sun/crypto/provider/AESCrypt")                                   \
   do_intrinsic(_aescrypt_encryptBlock, com_sun_crypto_provider_aescrypt, encryptBlock_name, byteArray_int_byteArray_int_signature, F_R)   \
@@ -1997,6 +1997,12 @@ void KlassDepChange::initialize() {
     assert(!InstanceKlass::cast(d)->is_marked_dependent(), "checking");
     InstanceKlass::cast(d)->set_is_marked_dependent(true);
   }
+
+  // A new type can only violate a no_finalizable_subclasses dependency
+  // if it is finalizable itself, so skip those when it is not.
+  if (Dependencies::find_finalizable_subclass(_new_type) == NULL) {
+    _affected_dep_types &= ~(1 << Dependencies::no_finalizable_subclasses);
+  }
 }
 
 KlassDepChange::~KlassDepChange() {
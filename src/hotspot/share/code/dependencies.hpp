@@ -687,6 +687,9 @@ class DepChange : public StackObj {
 
   virtual void mark_for_deoptimization(nmethod* nm) = 0;
 
+  // Dependency types this change can invalidate, one bit per DepType.
+  virtual int affected_dep_types() const { return Dependencies::all_types; }
+
   // Subclass casting with assertions.
   KlassDepChange*    as_klass_change() {
     assert(is_klass_change(), "bad cast");
@@ -759,13 +762,14 @@ class KlassDepChange : public DepChange {
  private:
   // each change set is rooted in exactly one new type (at present):
   Klass* _new_type;
+  int    _affected_dep_types;
 
   void initialize();
 
  public:
   // notes the new type, marks it and all its super-types
   KlassDepChange(Klass* new_type)
-    : _new_type(new_type)
+    : _new_type(new_type), _affected_dep_types(Dependencies::klass_types)
   {
     initialize();
   }
@@ -780,6 +784,8 @@ class KlassDepChange : public DepChange {
     nm->mark_for_deoptimization(/*inc_recompile_counts=*/true);
   }
 
+  virtual int affected_dep_types() const { return _affected_dep_types; }
+
   Klass* new_type() { return _new_type; }
 
   // involves_context(k) is true if k is new_type or any of the super types
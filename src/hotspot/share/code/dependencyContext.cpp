@@ -31,6 +31,9 @@
 #include "runtime/perfData.hpp"
 #include "utilities/exceptions.hpp"
 
+// nmethodBucket::_dep_types has one bit per dependency type.
+STATIC_ASSERT(Dependencies::TYPE_LIMIT <= 16);
+
 PerfCounter* DependencyContext::_perf_total_buckets_allocated_count   = NULL;
 PerfCounter* DependencyContext::_perf_total_buckets_deallocated_count = NULL;
 PerfCounter* DependencyContext::_perf_total_buckets_stale_count       = NULL;
@@ -62,13 +65,19 @@ void DependencyContext::init() {
 // are dependent on the changes that were passed in and mark them for
 // deoptimization.  Returns the number of nmethods found.
 //
-int DependencyContext::mark_dependent_nmethods(DepChange& changes) {
+int DependencyContext::mark_dependent_nmethods(DepChange& changes, Klass* context) {
   int found = 0;
+  int affected_types = changes.affected_dep_types();
   for (nmethodBucket* b = dependencies_not_unloading(); b != NULL; b = b->next_not_unloading()) {
+    // Skip nmethods whose dependencies on this context cannot be
+    // invalidated by the change without decoding their dependencies.
+    if ((b->dep_types() & affected_types) == 0) {
+      continue;
+    }
     nmethod* nm = b->get_nmethod();
     // since dependencies aren't removed until an nmethod becomes a zombie,
     // the dependency list may contain nmethods which aren't alive.
-    if (b->count() > 0 && nm->is_alive() && !nm->is_marked_for_deoptimization() && nm->check_dependency_on(changes)) {
+    if (b->count() > 0 && nm->is_alive() && !nm->is_marked_for_deoptimization() && nm->check_dependency_on(changes, context)) {
       if (TraceDependencies) {
         ResourceMark rm;
         tty->print_cr("Marked for deoptimization");
@@ -87,17 +96,20 @@ int DependencyContext::mark_dependent_nmethods(DepChange& changes) {
 // Add an nmethod to the dependency context.
 // It's possible that an nmethod has multiple dependencies on a klass
 // so a count is kept for each bucket to guarantee that creation and
-// deletion of dependencies is consistent.
+// deletion of dependencies is consistent. The bucket also accumulates
+// the types of those dependencies, so that class loading can skip
+// nmethods whose dependencies on this context it cannot invalidate.
 //
-void DependencyContext::add_dependent_nmethod(nmethod* nm) {
+void DependencyContext::add_dependent_nmethod(nmethod* nm, int dep_types) {
   assert_lock_strong(CodeCache_lock);
   for (nmethodBucket* b = dependencies_not_unloading(); b != NULL; b = b->next_not_unloading()) {
     if (nm == b->get_nmethod()) {
       b->increment();
+      b->add_dep_types(dep_types);
       return;
     }
   }
-  nmethodBucket* new_head = new nmethodBucket(nm, NULL);
+  nmethodBucket* new_head = new nmethodBucket(nm, NULL, dep_types);
   for (;;) {
     nmethodBucket* head = Atomic::load(_dependency_context_addr);
     new_head->set_next(head);
@@ -49,15 +49,23 @@ class nmethodBucket: public CHeapObj<mtClass> {
  private:
   nmethod*       _nmethod;
   volatile int   _count;
+  // Dependency types the nmethod has on this context, one bit per
+  // Dependencies::DepType (checked to fit in dependencyContext.cpp).
+  // Protected by CodeCache_lock.
+  uint16_t       _dep_types;
   nmethodBucket* volatile _next;
   nmethodBucket* volatile _purge_list_next;
 
  public:
-  nmethodBucket(nmethod* nmethod, nmethodBucket* next) :
-    _nmethod(nmethod), _count(1), _next(next), _purge_list_next(NULL) {}
+  static const uint16_t all_dep_types = 0xFFFF;
+
+  nmethodBucket(nmethod* nmethod, nmethodBucket* next, int dep_types) :
+    _nmethod(nmethod), _count(1), _dep_types((uint16_t)dep_types), _next(next), _purge_list_next(NULL) {}
 
   int count()                                { return _count; }
   int increment()                            { _count += 1; return _count; }
+  int dep_types() const                      { return _dep_types; }
+  void add_dep_types(int dep_types)          { _dep_types |= (uint16_t)dep_types; }
   int decrement();
   nmethodBucket* next();
   nmethodBucket* next_not_unloading();
@@ -117,8 +125,8 @@ class DependencyContext : public StackObj {
 
   static void init();
 
-  int  mark_dependent_nmethods(DepChange& changes);
-  void add_dependent_nmethod(nmethod* nm);
+  int  mark_dependent_nmethods(DepChange& changes, Klass* context = NULL);
+  void add_dependent_nmethod(nmethod* nm, int dep_types = nmethodBucket::all_dep_types);
   void remove_dependent_nmethod(nmethod* nm);
   int  remove_all_dependents();
   void clean_unloading_dependents();
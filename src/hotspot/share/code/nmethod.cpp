@@ -564,7 +564,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
             continue;  // ignore things like evol_method
           }
           // record this nmethod as dependent on this klass
-          InstanceKlass::cast(klass)->add_dependent_nmethod(nm);
+          InstanceKlass::cast(klass)->add_dependent_nmethod(nm, deps.type());
         }
       }
       NOT_PRODUCT(if (nm != NULL)  note_java_nmethod(nm));
@@ -1324,7 +1324,8 @@ bool nmethod::make_not_entrant_or_zombie(int state) {
 
   {
     // invalidate osr nmethod before acquiring the patching lock since
-    // they both acquire leaf locks and we don't want a deadlock.
+    // OsrList_lock and Patching_lock have the same rank (special-1) and
+    // cannot be nested.
     // This logic is equivalent to the logic below for patching the
     // verified entry point of regular methods. We check that the
     // nmethod is in use to ensure that it is invalidated only once.
@@ -2101,13 +2102,22 @@ void nmethod::check_all_dependencies(DepChange& changes) {
   }
 }
 
-bool nmethod::check_dependency_on(DepChange& changes) {
+bool nmethod::check_dependency_on(DepChange& changes, Klass* context) {
   // What has happened:
   // 1) a new class dependee has been added
   // 2) dependee and all its super classes have been marked
   bool found_check = false;  // set true if we are upset
+  int affected_types = changes.affected_dep_types();
   for (Dependencies::DepStream deps(this); deps.next(); ) {
-    // Evaluate only relevant dependencies.
+    // Evaluate only relevant dependencies. When called for the dependents
+    // of a context klass, dependencies on other involved contexts are
+    // checked when the dependents of those contexts are visited.
+    if (((1 << deps.type()) & affected_types) == 0) {
+      continue;
+    }
+    if (context != NULL && deps.context_type() != context) {
+      continue;
+    }
     if (deps.spot_check_dependency_at(changes) != NULL) {
       found_check = true;
       NOT_DEBUG(break);
@@ -585,7 +585,7 @@ public:
 
   // tells if this compiled method is dependent on the given changes,
   // and the changes have invalidated it
-  bool check_dependency_on(DepChange& changes);
+  bool check_dependency_on(DepChange& changes, Klass* context = NULL);
 
   // Fast breakpoint support. Tells if this compiled method is
   // dependent on the given method. Returns true if this nmethod
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "code/codeCache.hpp"
+#include "compiler/compilationProfile.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+struct CompilationProfileKey {
+  Symbol* _klass_name;
+  Symbol* _name;
+  Symbol* _signature;
+
+  static unsigned hash(const CompilationProfileKey& k) {
+    return k._klass_name->identity_hash() ^
+           (k._name->identity_hash() * 31) ^
+           (k._signature->identity_hash() * 961);
+  }
+
+  static bool equals(const CompilationProfileKey& a, const CompilationProfileKey& b) {
+    return a._klass_name == b._klass_name &&
+           a._name == b._name &&
+           a._signature == b._signature;
+  }
+};
+
+// Filled in once by load() before any method is compiled and only read
+// afterwards, so lookups need no lock.
+typedef ResourceHashtable<CompilationProfileKey, int,
+                          CompilationProfileKey::hash,
+                          CompilationProfileKey::equals,
+                          4099, ResourceObj::C_HEAP, mtCompiler> CompilationProfileTable;
+
+static CompilationProfileTable* _table = NULL;
+
+bool CompilationProfile::_is_loaded = false;
+
+void CompilationProfile::load() {
+  if (LoadCompilationProfile == NULL) {
+    return;
+  }
+  FILE* stream = os::fopen(LoadCompilationProfile, "rt");
+  if (stream == NULL) {
+    warning("Could not open compilation profile %s", LoadCompilationProfile);
+    return;
+  }
+
+  _table = new (ResourceObj::C_HEAP, mtCompiler) CompilationProfileTable();
+  int entries = 0;
+  int skipped = 0;
+  char line[3 * 1024];
+  char klass_name[1024];
+  char name[1024];
+  char signature[1024];
+  while (fgets(line, sizeof(line), stream) != NULL) {
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    }
+    int level;
+    if (sscanf(line, "%d %1023s %1023s %1023s", &level, klass_name, name, signature) != 4 ||
+        level <= CompLevel_none || level > CompLevel_full_optimization) {
+      skipped++;
+      continue;
+    }
+    CompilationProfileKey key;
+    key._klass_name = SymbolTable::new_permanent_symbol(klass_name);
+    key._name       = SymbolTable::new_permanent_symbol(name);
+    key._signature  = SymbolTable::new_permanent_symbol(signature);
+    int* recorded = _table->get(key);
+    if (recorded == NULL) {
+      _table->put(key, level);
+      entries++;
+    } else if (*recorded < level) {
+      *recorded = level;
+    }
+  }
+  fclose(stream);
+
+  _is_loaded = entries > 0;
+  log_info(jit, compilation)("Loaded %d methods from compilation profile %s (%d lines skipped)",
+                             entries, LoadCompilationProfile, skipped);
+}
+
+CompLevel CompilationProfile::recorded_level(const Method* m) {
+  CompilationProfileKey key;
+  key._klass_name = m->klass_name();
+  key._name       = m->name();
+  key._signature  = m->signature();
+  int* level = _table->get(key);
+  return level == NULL ? CompLevel_none : (CompLevel)*level;
+}
+
+double CompilationProfile::threshold_scale_slow(const Method* m, CompLevel cur_level) {
+  CompLevel level = recorded_level(m);
+  if (level == CompLevel_none) {
+    return 1.0;
+  }
+  if (cur_level == CompLevel_full_profile && level != CompLevel_full_optimization) {
+    // C2 did not compile it last time, let the profile decide again
+    return 1.0;
+  }
+  return CompilationProfileThresholdScaling;
+}
+
+bool CompilationProfile::dump(const char* path, outputStream* err) {
+  // Format the profile while holding CodeCache_lock, but do the file
+  // I/O only after releasing it, so that a slow disk does not stall
+  // compiler threads and the sweeper.
+  ResourceMark rm;
+  stringStream ss;
+  int count = 0;
+  {
+    MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CompiledMethodIterator iter(CompiledMethodIterator::only_alive_and_not_unloading);
+    while (iter.next()) {
+      CompiledMethod* cm = iter.method();
+      if (!cm->is_nmethod() || cm->method() == NULL) {
+        continue;
+      }
+      Method* m = cm->method();
+      ss.print_cr("%d %s %s %s", cm->comp_level(),
+                  m->klass_name()->as_C_string(),
+                  m->name()->as_C_string(),
+                  m->signature()->as_C_string());
+      count++;
+    }
+  }
+
+  fileStream fs(path, "w");
+  if (!fs.is_open()) {
+    err->print_cr("Could not open %s for writing", path);
+    return false;
+  }
+  fs.print_cr("# compilation profile: <level> <class> <method> <signature>");
+  fs.write(ss.base(), ss.size());
+  log_info(jit, compilation)("Wrote %d compiled methods to compilation profile %s", count, path);
+  return true;
+}
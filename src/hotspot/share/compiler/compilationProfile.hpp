@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_COMPILER_COMPILATIONPROFILE_HPP
+#define SHARE_COMPILER_COMPILATIONPROFILE_HPP
+
+#include "compiler/compilerDefinitions.hpp"
+#include "memory/allocation.hpp"
+
+class Method;
+class outputStream;
+
+// CompilationProfile carries the compilation decisions of one run over to
+// the next one, so that a restarted VM does not have to rediscover its hot
+// methods through the full tiered thresholds.
+//
+// DumpCompilationProfile (at exit) and the Compiler.profile_dump diagnostic
+// command write one line per compiled method in the code cache:
+//
+//   <level> <class name> <method name> <signature>
+//
+// and LoadCompilationProfile reads such a file at startup. For the methods it
+// lists, the invocation and backedge thresholds of the tiered policy are
+// scaled by CompilationProfileThresholdScaling: the first transition for
+// every listed method, and the transition to C2 only for methods that were
+// compiled by C2 in the recorded run. Profiles themselves are not recorded;
+// a method still goes through tier 3 and collects a fresh MethodData before
+// C2 compiles it, just much earlier.
+class CompilationProfile : AllStatic {
+ private:
+  static bool _is_loaded;
+
+  static CompLevel recorded_level(const Method* m);
+
+ public:
+  // Reads the file named by LoadCompilationProfile, if any.
+  static void load();
+
+  // Writes the currently compiled methods to path. Returns false and
+  // reports to err if the file cannot be written.
+  static bool dump(const char* path, outputStream* err);
+
+  // Factor for the thresholds that lead from cur_level to the next level.
+  static double threshold_scale(const Method* m, CompLevel cur_level) {
+    return _is_loaded ? threshold_scale_slow(m, cur_level) : 1.0;
+  }
+  static double threshold_scale_slow(const Method* m, CompLevel cur_level);
+};
+
+#endif // SHARE_COMPILER_COMPILATIONPROFILE_HPP
@@ -296,6 +296,22 @@ CompileTaskWrapper::~CompileTaskWrapper() {
   }
 }
 
+/**
+ * Number of compiler threads of both compilers together that may be running,
+ * given the processors currently available to the VM.
+ */
+static int compiler_threads_cpu_limit() {
+  int limit = (int)(os::active_processor_count() * CompilerThreadsCPUPercent / 100);
+  return MAX2(limit, 2);
+}
+
+static int running_compiler_threads() {
+  AbstractCompiler* c1 = CompileBroker::compiler(CompLevel_simple);
+  AbstractCompiler* c2 = CompileBroker::compiler(CompLevel_full_optimization);
+  return (c1 != NULL ? c1->num_compiler_threads() : 0) +
+         (c2 != NULL && c2 != c1 ? c2->num_compiler_threads() : 0);
+}
+
 /**
  * Check if a CompilerThread can be removed and update count if requested.
  */
@@ -310,8 +326,10 @@ static bool can_remove(CompilerThread *ct, bool do_it) {
   // Keep at least 1 compiler thread of each type.
   if (compiler_count < 2) return false;
 
-  // Keep thread alive for at least some time.
-  if (ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
+  // Keep thread alive for at least some time, unless there are more
+  // threads than the processors available to the VM allow for.
+  bool over_limit = running_compiler_threads() > compiler_threads_cpu_limit();
+  if (!over_limit && ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
 
   // We only allow the last compiler thread of each type to get removed.
   jobject last_compiler = c1 ? CompileBroker::compiler1_object(compiler_count - 1)
@@ -898,12 +916,18 @@ void CompileBroker::possibly_add_compiler_threads() {
   // Only do attempt to start additional threads if the lock is free.
   if (!CompileThread_lock->try_lock()) return;
 
+  // Leave the other compiler its threads when the processor limit is
+  // shared out; quotas are re-read since they can change at runtime.
+  int cpu_limit = compiler_threads_cpu_limit();
+
   if (_c2_compile_queue != NULL) {
     int old_c2_count = _compilers[1]->num_compiler_threads();
+    int c1_running = _compilers[0] != NULL ? _compilers[0]->num_compiler_threads() : 0;
     int new_c2_count = MIN4(_c2_count,
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
+    new_c2_count = MIN2(new_c2_count, cpu_limit - c1_running);
 
     for (int i = old_c2_count; i < new_c2_count; i++) {
       JavaThread *ct = make_thread(compiler2_object(i), _c2_compile_queue, _compilers[1], CHECK);
@@ -920,10 +944,12 @@ void CompileBroker::possibly_add_compiler_threads() {
 
   if (_c1_compile_queue != NULL) {
     int old_c1_count = _compilers[0]->num_compiler_threads();
+    int c2_running = _compilers[1] != NULL ? _compilers[1]->num_compiler_threads() : 0;
     int new_c1_count = MIN4(_c1_count,
         _c1_compile_queue->size() / 4,
         (int)(available_memory / (100*M)),
         (int)(available_cc_p / (128*K)));
+    new_c1_count = MIN2(new_c1_count, cpu_limit - c2_running);
 
     for (int i = old_c1_count; i < new_c1_count; i++) {
       JavaThread *ct = make_thread(compiler1_object(i), _c1_compile_queue, _compilers[0], CHECK);
@@ -49,7 +49,8 @@
     cflags(DisableIntrinsic,        ccstrlist, DisableIntrinsic, DisableIntrinsic)
 
 #ifdef COMPILER1
-  #define compilerdirectives_c1_flags(cflags)
+  #define compilerdirectives_c1_flags(cflags) \
+    cflags(C1ProfileSampleRate,     intx, C1ProfileSampleRate, C1ProfileSampleRate)
 #else
   #define compilerdirectives_c1_flags(cflags)
 #endif
@@ -25,6 +25,8 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1Analytics.hpp"
 #include "gc/g1/g1Predictions.hpp"
+#include "logging/log.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/numberSeq.hpp"
@@ -90,6 +92,11 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
     _pending_cards_seq(new TruncatedSeq(TruncatedSeqLength)),
     _rs_length_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_byte_ms_during_cm_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _log_buffer_cost(),
+    _young_remset_cost(),
+    _mixed_remset_cost(),
+    _copy_cost(),
+    _copy_during_cm_cost(),
     _recent_prev_end_times_for_all_gcs_sec(new TruncatedSeq(NumPrevPausesForHeuristics)),
     _recent_avg_pause_time_ratio(0.0),
     _last_pause_time_ratio(0.0) {
@@ -123,6 +130,24 @@ size_t G1Analytics::get_new_size_prediction(TruncatedSeq const* seq) const {
   return (size_t)get_new_prediction(seq);
 }
 
+const G1CostRegression* G1Analytics::regression_or_null(const G1CostRegression* r) const {
+  return (G1UsePhaseCostRegression && r->is_valid()) ? r : NULL;
+}
+
+const G1CostRegression* G1Analytics::remset_cost(bool for_young_gc) const {
+  if (!for_young_gc && _mixed_remset_cost.is_valid()) {
+    return regression_or_null(&_mixed_remset_cost);
+  }
+  return regression_or_null(&_young_remset_cost);
+}
+
+const G1CostRegression* G1Analytics::copy_cost(bool during_concurrent_mark) const {
+  if (during_concurrent_mark && _copy_during_cm_cost.is_valid()) {
+    return regression_or_null(&_copy_during_cm_cost);
+  }
+  return regression_or_null(&_copy_cost);
+}
+
 int G1Analytics::num_alloc_rate_ms() const {
   return _alloc_rate_ms_seq->num();
 }
@@ -214,6 +239,40 @@ void G1Analytics::report_rs_length(double rs_length) {
   _rs_length_seq->add(rs_length);
 }
 
+void G1Analytics::report_log_buffer_cost(size_t entries, double time_ms) {
+  _log_buffer_cost.add((double)entries, time_ms);
+}
+
+void G1Analytics::report_remset_cost(size_t cards, double time_ms, bool for_young_gc) {
+  if (for_young_gc) {
+    _young_remset_cost.add((double)cards, time_ms);
+  } else {
+    _mixed_remset_cost.add((double)cards, time_ms);
+  }
+}
+
+void G1Analytics::report_object_copy_cost(size_t bytes, double time_ms, bool mark_or_rebuild_in_progress) {
+  if (mark_or_rebuild_in_progress) {
+    _copy_during_cm_cost.add((double)bytes, time_ms);
+  } else {
+    _copy_cost.add((double)bytes, time_ms);
+  }
+}
+
+static void log_cost_regression(const char* name, const char* unit, const G1CostRegression& r) {
+  log_debug(gc, ergo)("Cost regression %s: %1.3fms + %1.3fns/%s (stddev %1.3fms, samples %u%s)",
+                      name, r.intercept(), r.slope() * NANOSECS_PER_MILLISEC, unit, r.stddev(),
+                      r.num(), r.is_valid() ? "" : ", not used yet");
+}
+
+void G1Analytics::log_cost_regressions() const {
+  log_cost_regression("merge log buffers", "card", _log_buffer_cost);
+  log_cost_regression("young remset scan", "card", _young_remset_cost);
+  log_cost_regression("mixed remset scan", "card", _mixed_remset_cost);
+  log_cost_regression("object copy", "byte", _copy_cost);
+  log_cost_regression("object copy during mark", "byte", _copy_during_cm_cost);
+}
+
 size_t G1Analytics::predict_rs_length_diff() const {
   return get_new_size_prediction(_rs_length_diff_seq);
 }
@@ -231,6 +290,10 @@ double G1Analytics::predict_scan_hcc_ms() const {
 }
 
 double G1Analytics::predict_rs_update_time_ms(size_t pending_cards) const {
+  const G1CostRegression* r = regression_or_null(&_log_buffer_cost);
+  if (r != NULL) {
+    return r->fixed_cost(_predictor->sigma()) + pending_cards * r->unit_cost() + predict_scan_hcc_ms();
+  }
   return pending_cards * predict_cost_per_log_buffer_entry_ms() + predict_scan_hcc_ms();
 }
 
@@ -255,6 +318,10 @@ size_t G1Analytics::predict_card_num(size_t rs_length, bool for_young_gc) const
 }
 
 double G1Analytics::predict_rs_scan_time_ms(size_t card_num, bool for_young_gc) const {
+  const G1CostRegression* r = remset_cost(for_young_gc);
+  if (r != NULL) {
+    return card_num * r->unit_cost();
+  }
   if (for_young_gc) {
     return card_num * get_new_prediction(_young_only_cost_per_remset_card_ms_seq);
   } else {
@@ -279,6 +346,10 @@ double G1Analytics::predict_object_copy_time_ms_during_cm(size_t bytes_to_copy)
 }
 
 double G1Analytics::predict_object_copy_time_ms(size_t bytes_to_copy, bool during_concurrent_mark) const {
+  const G1CostRegression* r = copy_cost(during_concurrent_mark);
+  if (r != NULL) {
+    return bytes_to_copy * r->unit_cost();
+  }
   if (during_concurrent_mark) {
     return predict_object_copy_time_ms_during_cm(bytes_to_copy);
   } else {
@@ -290,6 +361,19 @@ double G1Analytics::predict_cost_per_byte_ms() const {
   return get_new_prediction(_cost_per_byte_ms_seq);
 }
 
+double G1Analytics::predict_fixed_phase_time_ms(bool for_young_gc, bool during_concurrent_mark) const {
+  double result = 0.0;
+  const G1CostRegression* r = remset_cost(for_young_gc);
+  if (r != NULL) {
+    result += r->fixed_cost(_predictor->sigma());
+  }
+  r = copy_cost(during_concurrent_mark);
+  if (r != NULL) {
+    result += r->fixed_cost(_predictor->sigma());
+  }
+  return result;
+}
+
 double G1Analytics::predict_constant_other_time_ms() const {
   return get_new_prediction(_constant_other_time_ms_seq);
 }
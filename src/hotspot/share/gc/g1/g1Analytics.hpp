@@ -25,6 +25,7 @@
 #ifndef SHARE_GC_G1_G1ANALYTICS_HPP
 #define SHARE_GC_G1_G1ANALYTICS_HPP
 
+#include "gc/g1/g1CostRegression.hpp"
 #include "memory/allocation.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -62,6 +63,13 @@ class G1Analytics: public CHeapObj<mtGC> {
 
   TruncatedSeq* _cost_per_byte_ms_during_cm_seq;
 
+  // Fits of the phase costs to the work done, see G1UsePhaseCostRegression.
+  G1CostRegression _log_buffer_cost;
+  G1CostRegression _young_remset_cost;
+  G1CostRegression _mixed_remset_cost;
+  G1CostRegression _copy_cost;
+  G1CostRegression _copy_during_cm_cost;
+
   // Statistics kept per GC stoppage, pause or full.
   TruncatedSeq* _recent_prev_end_times_for_all_gcs_sec;
 
@@ -73,6 +81,11 @@ class G1Analytics: public CHeapObj<mtGC> {
   double get_new_prediction(TruncatedSeq const* seq) const;
   size_t get_new_size_prediction(TruncatedSeq const* seq) const;
 
+  // The fit used for predictions, or NULL if the averages are to be used.
+  const G1CostRegression* remset_cost(bool for_young_gc) const;
+  const G1CostRegression* copy_cost(bool during_concurrent_mark) const;
+  const G1CostRegression* regression_or_null(const G1CostRegression* r) const;
+
 public:
   G1Analytics(const G1Predictions* predictor);
 
@@ -111,6 +124,11 @@ public:
   void report_pending_cards(double pending_cards);
   void report_rs_length(double rs_length);
 
+  void report_log_buffer_cost(size_t entries, double time_ms);
+  void report_remset_cost(size_t cards, double time_ms, bool for_young_gc);
+  void report_object_copy_cost(size_t bytes, double time_ms, bool mark_or_rebuild_in_progress);
+  void log_cost_regressions() const;
+
   size_t predict_rs_length_diff() const;
 
   double predict_alloc_rate_ms() const;
@@ -151,6 +169,11 @@ public:
 
   double predict_cost_per_byte_ms() const;
 
+  // The part of the remembered set scan and object copy time that does not
+  // depend on the regions in the collection set. Zero unless predicting
+  // from the phase cost regressions.
+  double predict_fixed_phase_time_ms(bool for_young_gc, bool during_concurrent_mark) const;
+
   // Add a new GC of the given duration and end time to the record.
   void update_recent_gc_times(double end_time_sec, double elapsed_ms);
   void compute_pause_time_ratio(double interval_ms, double pause_time_ms);
@@ -97,6 +97,11 @@ public:
   inline size_t index_for(const void* p) const;
   inline size_t index_for_raw(const void* p) const;
 
+  // The address of the entry for "p", to prefetch it.
+  const volatile u_char* entry_addr_for(const void* p) const {
+    return _offset_array + index_for_raw(p);
+  }
+
   // Return the address indicating the start of the region corresponding to
   // "index" in "_offset_array".
   inline HeapWord* address_for_index(size_t index) const;
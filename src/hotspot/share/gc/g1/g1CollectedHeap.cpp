@@ -59,6 +59,7 @@
 #include "gc/g1/g1SATBMarkQueueSet.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/g1/g1ThreadLocalData.hpp"
+#include "gc/g1/g1UncommitRegionThread.hpp"
 #include "gc/g1/g1YCTypes.hpp"
 #include "gc/g1/g1YoungRemSetSamplingThread.hpp"
 #include "gc/g1/g1VMOperations.hpp"
@@ -170,12 +171,15 @@ HeapRegion* G1CollectedHeap::new_heap_region(uint hrs_index,
 
 // Private methods.
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size,
+                                        HeapRegionType type,
+                                        bool do_expand,
+                                        uint node_index) {
   assert(!is_humongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
 
-  HeapRegion* res = _hrm->allocate_free_region(type);
+  HeapRegion* res = _hrm->allocate_free_region(type, node_index);
 
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -192,7 +196,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, b
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm->allocate_free_region(type);
+      res = _hrm->allocate_free_region(type, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -1399,6 +1403,9 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
                             shrink_bytes, aligned_shrink_bytes, shrunk_bytes);
   if (num_regions_removed > 0) {
     policy()->record_new_heap_size(num_regions());
+    if (_uncommit_thread != NULL) {
+      _uncommit_thread->notify_regions_to_uncommit();
+    }
   } else {
     log_debug(gc, ergo, heap)("Did not expand the heap (heap shrinking operation failed)");
   }
@@ -1488,6 +1495,7 @@ public:
 G1CollectedHeap::G1CollectedHeap() :
   CollectedHeap(),
   _young_gen_sampling_thread(NULL),
+  _uncommit_thread(NULL),
   _workers(NULL),
   _card_table(NULL),
   _soft_ref_policy(),
@@ -1497,6 +1505,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _bot(NULL),
   _listener(),
   _hrm(NULL),
+  _numa(G1NUMA::create()),
   _allocator(NULL),
   _verifier(NULL),
   _summary_bytes_used(0),
@@ -1525,6 +1534,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _cr(NULL),
   _task_queues(NULL),
   _evacuation_failed(false),
+  _to_space_exhausted(false),
   _evacuation_failed_info_array(NULL),
   _preserved_marks_set(true /* in_c_heap */),
 #ifndef PRODUCT
@@ -1629,6 +1639,15 @@ jint G1CollectedHeap::initialize_young_gen_sampling_thread() {
   return JNI_OK;
 }
 
+jint G1CollectedHeap::initialize_uncommit_thread() {
+  _uncommit_thread = new G1UncommitRegionThread();
+  if (_uncommit_thread->osthread() == NULL) {
+    vm_shutdown_during_initialization("Could not create G1UncommitRegionThread");
+    return JNI_ENOMEM;
+  }
+  return JNI_OK;
+}
+
 jint G1CollectedHeap::initialize() {
   os::enable_vtime();
 
@@ -1695,6 +1714,7 @@ jint G1CollectedHeap::initialize() {
   // Carve out the G1 part of the heap.
   ReservedSpace g1_rs = heap_rs.first_part(reserved_byte_size);
   size_t page_size = actual_reserved_page_size(heap_rs);
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_heap_mapper(g1_rs,
                                               g1_rs.size(),
@@ -1810,6 +1830,13 @@ jint G1CollectedHeap::initialize() {
     return ecode;
   }
 
+  if (G1ConcurrentUncommit) {
+    ecode = initialize_uncommit_thread();
+    if (ecode != JNI_OK) {
+      return ecode;
+    }
+  }
+
   {
     G1DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
     dcqs.set_process_completed_buffers_threshold(concurrent_refine()->yellow_zone());
@@ -1850,6 +1877,9 @@ void G1CollectedHeap::stop() {
   // that are destroyed during shutdown.
   _cr->stop();
   _young_gen_sampling_thread->stop();
+  if (_uncommit_thread != NULL) {
+    _uncommit_thread->stop();
+  }
   _cm_thread->stop();
   if (G1StringDedup::is_enabled()) {
     G1StringDedup::stop();
@@ -2224,6 +2254,30 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+class G1ParallelObjectIterator : public ParallelObjectIterator {
+private:
+  G1CollectedHeap*  _heap;
+  HeapRegionClaimer _claimer;
+
+public:
+  G1ParallelObjectIterator(uint thread_num) :
+      _heap(G1CollectedHeap::heap()),
+      _claimer(thread_num) {}
+
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) {
+    _heap->object_iterate_parallel(cl, worker_id, &_claimer);
+  }
+};
+
+ParallelObjectIterator* G1CollectedHeap::parallel_object_iterator(uint thread_num) {
+  return new G1ParallelObjectIterator(thread_num);
+}
+
+void G1CollectedHeap::object_iterate_parallel(ObjectClosure* cl, uint worker_id, HeapRegionClaimer* claimer) {
+  IterateObjectClosureRegionClosure blk(cl);
+  heap_region_par_iterate_from_worker_offset(&blk, claimer, worker_id);
+}
+
 void G1CollectedHeap::heap_region_iterate(HeapRegionClosure* cl) const {
   _hrm->iterate(cl);
 }
@@ -2316,6 +2370,21 @@ void G1CollectedHeap::verify(VerifyOption vo) {
   _verifier->verify(vo);
 }
 
+bool G1CollectedHeap::supports_object_pinning() const {
+  return G1UseRegionPinning;
+}
+
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  assert(G1UseRegionPinning, "must be");
+  heap_region_containing(obj)->increment_pinned_object_count();
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  assert(G1UseRegionPinning, "must be");
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 bool G1CollectedHeap::supports_concurrent_phase_control() const {
   return true;
 }
@@ -2420,6 +2489,9 @@ void G1CollectedHeap::print_gc_threads_on(outputStream* st) const {
   _cm->print_worker_threads_on(st);
   _cr->print_threads_on(st);
   _young_gen_sampling_thread->print_on(st);
+  if (_uncommit_thread != NULL) {
+    _uncommit_thread->print_on(st);
+  }
   if (G1StringDedup::is_enabled()) {
     G1StringDedup::print_worker_threads_on(st);
   }
@@ -2431,6 +2503,9 @@ void G1CollectedHeap::gc_threads_do(ThreadClosure* tc) const {
   _cm->threads_do(tc);
   _cr->threads_do(tc);
   tc->do_thread(_young_gen_sampling_thread);
+  if (_uncommit_thread != NULL) {
+    tc->do_thread(_uncommit_thread);
+  }
   if (G1StringDedup::is_enabled()) {
     G1StringDedup::threads_do(tc);
   }
@@ -2633,6 +2708,7 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
  private:
   size_t _total_humongous;
   size_t _candidate_humongous;
+  size_t _pinned_regions;
 
   bool humongous_region_is_candidate(G1CollectedHeap* g1h, HeapRegion* region) const {
     assert(region->is_starts_humongous(), "Must start a humongous object");
@@ -2650,6 +2726,11 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
     if (!region->rem_set()->is_complete()) {
       return false;
     }
+
+    // Pinned objects are in use by a JNI critical section.
+    if (region->has_pinned_objects()) {
+      return false;
+    }
     // Candidate selection must satisfy the following constraints
     // while concurrent marking is in progress:
     //
@@ -2671,10 +2752,14 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
     // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
+    // set entries on other regions. Those entries become stale when the
+    // object is reclaimed, which card scanning tolerates since it only
+    // looks at regions that are old or humongous at the start of a pause,
+    // and only up to their top. We therefore nominate is_objArray()
+    // objects too, but only while neither concurrent marking nor the
+    // remembered set rebuild is in progress, as both may be scanning the
+    // object's references concurrently.
     //
     // We also treat is_typeArray() objects specially, allowing them
     // to be reclaimed even if allocated before the start of
@@ -2686,14 +2771,20 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
     // important use case for eager reclaim, and this special handling
     // may reduce needed headroom.
 
-    return obj->is_typeArray() &&
+    if (obj->is_typeArray()) {
+      return g1h->is_potential_eager_reclaim_candidate(region);
+    }
+    return G1EagerReclaimHumongousObjArrays &&
+           obj->is_objArray() &&
+           !g1h->collector_state()->mark_or_rebuild_in_progress() &&
            g1h->is_potential_eager_reclaim_candidate(region);
   }
 
  public:
   RegisterRegionsWithRegionAttrTableClosure()
   : _total_humongous(0),
-    _candidate_humongous(0) {
+    _candidate_humongous(0),
+    _pinned_regions(0) {
   }
 
   virtual bool do_heap_region(HeapRegion* r) {
@@ -2701,6 +2792,13 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
 
     if (!r->is_starts_humongous()) {
       g1h->register_region_with_region_attr(r);
+      // Eden regions are added to the region attribute table when they are
+      // retired, before their objects may have been pinned, so determine
+      // pinning of the collection set here, within the pause.
+      if (r->has_pinned_objects() && g1h->is_in_cset(r)) {
+        g1h->register_pinned_region_with_region_attr(r);
+        _pinned_regions++;
+      }
       return false;
     }
 
@@ -2721,6 +2819,7 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
 
   size_t total_humongous() const { return _total_humongous; }
   size_t candidate_humongous() const { return _candidate_humongous; }
+  size_t pinned_regions() const { return _pinned_regions; }
 };
 
 void G1CollectedHeap::register_regions_with_region_attr() {
@@ -2733,6 +2832,9 @@ void G1CollectedHeap::register_regions_with_region_attr() {
                                          cl.total_humongous(),
                                          cl.candidate_humongous());
   _has_humongous_reclaim_candidates = cl.candidate_humongous() > 0;
+  if (cl.pinned_regions() > 0) {
+    log_debug(gc, cset)("Collection set regions with pinned objects: " SIZE_FORMAT, cl.pinned_regions());
+  }
 }
 
 #ifndef PRODUCT
@@ -3075,7 +3177,7 @@ bool G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_
     }
 
     // Print the remainder of the GC log output.
-    if (evacuation_failed()) {
+    if (to_space_exhausted()) {
       log_info(gc)("To-space exhausted");
     }
 
@@ -3134,12 +3236,17 @@ void G1CollectedHeap::restore_after_evac_failure(G1RedirtyCardsQueueSet* rdcqs)
   phase_times()->record_evac_fail_remove_self_forwards((os::elapsedTime() - remove_self_forwards_start) * 1000.0);
 }
 
-void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m) {
+void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m, bool is_pinned) {
   if (!_evacuation_failed) {
     _evacuation_failed = true;
   }
 
-  _evacuation_failed_info_array[worker_id].register_copy_failure(obj->size());
+  if (!is_pinned) {
+    if (!_to_space_exhausted) {
+      _to_space_exhausted = true;
+    }
+    _evacuation_failed_info_array[worker_id].register_copy_failure(obj->size());
+  }
   _preserved_marks_set.get(worker_id)->push_if_necessary(obj, m);
 }
 
@@ -3562,6 +3669,7 @@ void G1CollectedHeap::merge_per_thread_state_info(G1ParScanThreadStateSet* per_t
 void G1CollectedHeap::pre_evacuate_collection_set(G1EvacuationInfo& evacuation_info, G1ParScanThreadStateSet* per_thread_states) {
   _expand_heap_after_alloc_failure = true;
   _evacuation_failed = false;
+  _to_space_exhausted = false;
 
   // Disable the hot card cache.
   _hot_card_cache->reset_hot_cache_claimed_index();
@@ -3772,7 +3880,7 @@ void G1CollectedHeap::evacuate_next_optional_regions(G1ParScanThreadStateSet* pe
 void G1CollectedHeap::evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states) {
   const double gc_start_time_ms = phase_times()->cur_collection_start_sec() * 1000.0;
 
-  while (!evacuation_failed() && _collection_set.optional_region_length() > 0) {
+  while (!to_space_exhausted() && _collection_set.optional_region_length() > 0) {
 
     double time_used_ms = os::elapsedTime() * 1000.0 - gc_start_time_ms;
     double time_left_ms = MaxGCPauseMillis - time_used_ms;
@@ -3871,6 +3979,8 @@ void G1CollectedHeap::post_evacuate_collection_set(G1EvacuationInfo& evacuation_
 
   eagerly_reclaim_humongous_regions();
 
+  HeapRegionRemSet::release_free_bitmaps();
+
   record_obj_copy_mem_stats();
 
   evacuation_info.set_collectionset_used_before(collection_set()->bytes_used_before());
@@ -3925,6 +4035,53 @@ void G1CollectedHeap::free_humongous_region(HeapRegion* hr,
   free_region(hr, free_list, false /* skip_remset */, false /* skip_hcc */, true /* locked */);
 }
 
+void G1CollectedHeap::move_humongous_object(HeapRegion* first_from, HeapRegion* first_to) {
+  assert_at_safepoint_on_vm_thread();
+  assert(first_from->is_starts_humongous(), "must be");
+
+  oop obj = oop(first_from->bottom());
+  size_t const word_size = obj->size();
+  uint const num_regions = (uint)humongous_obj_size_in_regions(word_size);
+  uint const from = first_from->hrm_index();
+  uint const to = first_to->hrm_index();
+  assert(to + num_regions <= from, "destination regions %u-%u must be below %u", to, to + num_regions - 1, from);
+
+  // The object and the filler objects after it.
+  HeapRegion* last_from = region_at(from + num_regions - 1);
+  size_t const used_words = pointer_delta(last_from->top(), first_from->bottom());
+  size_t const last_used_words = pointer_delta(last_from->top(), last_from->bottom());
+  HeapWord* const new_obj = first_to->bottom();
+  Copy::aligned_disjoint_words(first_from->bottom(), new_obj, used_words);
+
+  FreeRegionList dummy_free_list("Dummy Free List for Humongous Move");
+  for (uint i = from; i < from + num_regions; i++) {
+    HeapRegion* hr = region_at(i);
+    hr->set_containing_set(NULL);
+    free_humongous_region(hr, &dummy_free_list);
+  }
+  dummy_free_list.remove_all();
+  remove_from_old_sets(0, num_regions);
+
+  for (uint i = to; i < to + num_regions; i++) {
+    HeapRegion* hr = region_at(i);
+    assert(hr->is_empty() && !hr->is_pinned(), "destination region %u must be empty", i);
+    hr->set_free();
+  }
+  first_to->set_starts_humongous(new_obj + word_size, used_words - word_size);
+  for (uint i = to + 1; i < to + num_regions; i++) {
+    region_at(i)->set_continues_humongous(first_to);
+  }
+  for (uint i = to; i < to + num_regions - 1; i++) {
+    HeapRegion* hr = region_at(i);
+    hr->set_top(hr->end());
+  }
+  HeapRegion* last_to = region_at(to + num_regions - 1);
+  last_to->set_top(last_to->bottom() + last_used_words);
+  for (uint i = to; i < to + num_regions; i++) {
+    _humongous_set.add(region_at(i));
+  }
+}
+
 void G1CollectedHeap::remove_from_old_sets(const uint old_regions_removed,
                                            const uint humongous_regions_removed) {
   if (old_regions_removed > 0 || humongous_regions_removed > 0) {
@@ -4274,10 +4431,9 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays are only considered outside of concurrent marking and
+    // rebuild, see humongous_region_is_candidate(). The remembered set entries
+    // induced by their references are left stale.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -4294,8 +4450,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              "Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || (G1EagerReclaimHumongousObjArrays && obj->is_objArray()),
+              "Only eagerly reclaiming type and object arrays is supported, but the object "
               PTR_FORMAT " is not.", p2i(r->bottom()));
 
     log_debug(gc, humongous)("Dead humongous region %u object size " SIZE_FORMAT " start " PTR_FORMAT " with remset " SIZE_FORMAT " code roots " SIZE_FORMAT " is marked %d reclaim candidate %d type array %d",
@@ -4561,13 +4717,15 @@ void G1CollectedHeap::rebuild_region_sets(bool free_list_only) {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   bool should_allocate = policy()->should_allocate_mutator_region();
   if (force || should_allocate) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               HeapRegionType::Eden,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, !should_allocate);
@@ -4605,7 +4763,7 @@ bool G1CollectedHeap::has_more_regions(G1HeapRegionAttr dest) {
   }
 }
 
-HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest) {
+HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest, uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (!has_more_regions(dest)) {
@@ -4621,7 +4779,8 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionA
 
   HeapRegion* new_alloc_region = new_region(word_size,
                                             type,
-                                            true /* do_expand */);
+                                            true /* do_expand */,
+                                            node_index);
 
   if (new_alloc_region != NULL) {
     if (type.is_survivor()) {
@@ -41,6 +41,7 @@
 #include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1HeapRegionAttr.hpp"
 #include "gc/g1/g1MonitoringSupport.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1RedirtyCardsQueue.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
 #include "gc/g1/g1YCTypes.hpp"
@@ -79,6 +80,7 @@ class G1Policy;
 class G1HotCardCache;
 class G1RemSet;
 class G1YoungRemSetSamplingThread;
+class G1UncommitRegionThread;
 class G1ConcurrentMark;
 class G1ConcurrentMarkThread;
 class G1ConcurrentRefine;
@@ -153,6 +155,7 @@ class G1CollectedHeap : public CollectedHeap {
 
 private:
   G1YoungRemSetSamplingThread* _young_gen_sampling_thread;
+  G1UncommitRegionThread* _uncommit_thread;
 
   WorkGang* _workers;
   G1CardTable* _card_table;
@@ -195,6 +198,9 @@ private:
   // The sequence of all heap regions in the heap.
   HeapRegionManager* _hrm;
 
+  // The NUMA nodes regions are allocated on.
+  G1NUMA* _numa;
+
   // Manages all allocations with regions except humongous object allocations.
   G1Allocator* _allocator;
 
@@ -387,8 +393,12 @@ private:
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. 'type' takes the type of region to be allocated. (Use constants
-  // Old, Eden, Humongous, Survivor defined in HeapRegionType.)
-  HeapRegion* new_region(size_t word_size, HeapRegionType type, bool do_expand);
+  // Old, Eden, Humongous, Survivor defined in HeapRegionType.) The region
+  // is preferably taken from the NUMA node with the given index.
+  HeapRegion* new_region(size_t word_size,
+                         HeapRegionType type,
+                         bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -463,13 +473,13 @@ private:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   bool has_more_regions(G1HeapRegionAttr dest);
-  HeapRegion* new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest);
+  HeapRegion* new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, G1HeapRegionAttr dest);
 
@@ -537,6 +547,8 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const { return _numa; }
+
   G1HeapVerifier* verifier() {
     return _verifier;
   }
@@ -588,6 +600,10 @@ public:
   inline void register_region_with_region_attr(HeapRegion* r);
   inline void register_old_region_with_region_attr(HeapRegion* r);
   inline void register_optional_region_with_region_attr(HeapRegion* r);
+  // Mark the given collection set region as containing pinned objects.
+  void register_pinned_region_with_region_attr(HeapRegion* r) {
+    _region_attr.set_is_pinned(r->hrm_index(), true);
+  }
 
   void clear_region_attr(const HeapRegion* hr) {
     _region_attr.clear(hr);
@@ -667,6 +683,12 @@ public:
   void free_humongous_region(HeapRegion* hr,
                              FreeRegionList* free_list);
 
+  // Moves the humongous object starting in first_from to the empty regions
+  // starting with first_to, which must all be below first_from. The source
+  // regions are freed and the destination ones made humongous. Only used by
+  // full gc after compaction.
+  void move_humongous_object(HeapRegion* first_from, HeapRegion* first_to);
+
   // Facility for allocating in 'archive' regions in high heap memory and
   // recording the allocated ranges. These should all be called from the
   // VM thread at safepoints, without the heap lock held. They can be used
@@ -796,6 +818,9 @@ public:
 
   // True iff a evacuation has failed in the current collection.
   bool _evacuation_failed;
+  // True iff an evacuation has failed in the current collection for lack of
+  // space, as opposed to only because of pinned regions.
+  bool _to_space_exhausted;
 
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
@@ -810,8 +835,9 @@ public:
   PreservedMarksSet _preserved_marks_set;
 
   // Preserve the mark of "obj", if necessary, in preparation for its mark
-  // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m);
+  // word being overwritten with a self-forwarding-pointer. is_pinned tells
+  // whether "obj" is not evacuated because its region is pinned.
+  void preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m, bool is_pinned);
 
 #ifndef PRODUCT
   // Support for forcing evacuation failures. Analogous to
@@ -941,6 +967,7 @@ public:
 private:
   jint initialize_concurrent_refinement();
   jint initialize_young_gen_sampling_thread();
+  jint initialize_uncommit_thread();
 public:
   // Initialize the G1CollectedHeap to have the initial and
   // maximum sizes and remembered and barrier sets
@@ -1086,6 +1113,8 @@ public:
 
   // True iff an evacuation has failed in the most-recent collection.
   bool evacuation_failed() { return _evacuation_failed; }
+  // True iff an evacuation failed for lack of space in the most-recent collection.
+  bool to_space_exhausted() { return _to_space_exhausted; }
 
   void remove_from_old_sets(const uint old_regions_removed, const uint humongous_regions_removed);
   void prepend_to_freelist(FreeRegionList* list);
@@ -1144,6 +1173,11 @@ public:
     object_iterate(cl);
   }
 
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num);
+
+  // Iterate over the objects in the regions claimed by the given claimer.
+  void object_iterate_parallel(ObjectClosure* cl, uint worker_id, HeapRegionClaimer* claimer);
+
   // Iterate over heap regions, in address order, terminating the
   // iteration early if the "do_heap_region" method returns "true".
   void heap_region_iterate(HeapRegionClosure* blk) const;
@@ -1393,6 +1427,12 @@ public:
 
   virtual WorkGang* get_safepoint_workers() { return _workers; }
 
+  // Pinning of the regions containing the objects of JNI critical sections,
+  // instead of locking out GC, if G1UseRegionPinning.
+  virtual bool supports_object_pinning() const;
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // The methods below are here for convenience and dispatch the
   // appropriate method depending on value of the given VerifyOption
   // parameter. The values for that parameter, and their meanings,
@@ -1201,11 +1201,8 @@ void G1ConcurrentMark::remark() {
       reclaim_empty_regions();
     }
 
-    // Clean out dead classes
-    if (ClassUnloadingWithConcurrentMark) {
-      GCTraceTime(Debug, gc, phases) debug("Purge Metaspace", _gc_timer_cm);
-      ClassLoaderDataGraph::purge();
-    }
+    // Dead classes were unlinked above, but freeing them and their
+    // metaspace is left to the concurrent purge phase that follows.
 
     _g1h->resize_heap_if_necessary();
 
@@ -2006,6 +2003,16 @@ void G1ConcurrentMark::verify_no_collection_set_oops() {
 }
 #endif // PRODUCT
 
+void G1ConcurrentMark::purge_class_loader_data_concurrently() {
+  // The unloading list is only reachable from here once Remark has ended,
+  // so freeing it only has to be kept apart from other safepoint-time
+  // purges, e.g. by a Full GC.  Joining the suspendible thread set
+  // achieves that, and purging yields between CLDs so that freeing many
+  // of them does not hold up safepoints.
+  SuspendibleThreadSetJoiner sts_join;
+  ClassLoaderDataGraph::purge_yielding();
+}
+
 void G1ConcurrentMark::rebuild_rem_set_concurrently() {
   _g1h->rem_set()->rebuild_rem_set(this, _concurrent_workers, _worker_id_offset);
 }
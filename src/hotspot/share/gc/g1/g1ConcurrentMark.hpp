@@ -610,6 +610,10 @@ public:
   G1OldTracer* gc_tracer_cm() const { return _gc_tracer_cm; }
 
 private:
+  // Frees the class loader data unlinked by the Remark pause, together with
+  // any metaspace it leaves unused, concurrently to the application.
+  void purge_class_loader_data_concurrently();
+
   // Rebuilds the remembered sets for chosen regions in parallel and concurrently to the application.
   void rebuild_rem_set_concurrently();
 };
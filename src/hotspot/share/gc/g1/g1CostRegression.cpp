@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CostRegression.hpp"
+
+// About the same memory as the TruncatedSeqs used by G1Analytics.
+const double G1CostRegression::Decay = 0.9;
+
+G1CostRegression::G1CostRegression() :
+  _num(0),
+  _sw(0.0),
+  _sx(0.0),
+  _sy(0.0),
+  _sxx(0.0),
+  _sxy(0.0),
+  _sse(0.0),
+  _sw_err(0.0),
+  _intercept(0.0),
+  _slope(0.0) { }
+
+void G1CostRegression::add(double x, double y) {
+  if (is_valid()) {
+    double error = y - predict(x);
+    _sse = Decay * _sse + error * error;
+    _sw_err = Decay * _sw_err + 1.0;
+  }
+
+  _sw = Decay * _sw + 1.0;
+  _sx = Decay * _sx + x;
+  _sy = Decay * _sy + y;
+  _sxx = Decay * _sxx + x * x;
+  _sxy = Decay * _sxy + x * y;
+  _num++;
+
+  fit();
+}
+
+void G1CostRegression::fit() {
+  double const mean_x = _sx / _sw;
+  double const mean_y = _sy / _sw;
+  double const var_x = _sxx / _sw - mean_x * mean_x;
+  double const cov_xy = _sxy / _sw - mean_x * mean_y;
+
+  if (var_x <= mean_x * mean_x * 1e-6) {
+    // All samples did about the same amount of work: attribute the cost
+    // to the work, as the per unit averages do.
+    _slope = mean_x > 0.0 ? mean_y / mean_x : 0.0;
+    _intercept = 0.0;
+    return;
+  }
+  // Costs do not shrink with more work, and phases do not take negative
+  // time; clamp the fit to the plausible range.
+  _slope = MAX2(cov_xy / var_x, 0.0);
+  _intercept = MAX2(mean_y - _slope * mean_x, 0.0);
+}
+
+bool G1CostRegression::is_valid() const {
+  return _num >= MinSamples;
+}
+
+double G1CostRegression::stddev() const {
+  if (_sw_err == 0.0) {
+    return 0.0;
+  }
+  return sqrt(_sse / _sw_err);
+}
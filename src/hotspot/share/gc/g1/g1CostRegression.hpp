@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1COSTREGRESSION_HPP
+#define SHARE_GC_G1_G1COSTREGRESSION_HPP
+
+#include "utilities/globalDefinitions.hpp"
+
+// Online least squares fit of the cost of a pause phase, y = a + b * x, where
+// x is the amount of work the phase did (e.g. cards or bytes). Older samples
+// decay exponentially so that the fit follows changes of the application.
+//
+// The error of the fit is measured on every sample before it is added, so the
+// stddev reflects how well the model predicted phases it had not seen yet.
+class G1CostRegression {
+  // Weight of a sample relative to the one after it.
+  static const double Decay;
+  // Number of samples before the fit is used.
+  static const uint MinSamples = 5;
+
+  uint _num;
+  // Decayed sums of weights, x, y, x * x and x * y.
+  double _sw;
+  double _sx;
+  double _sy;
+  double _sxx;
+  double _sxy;
+  // Decayed sum of squared prediction errors, and its weight.
+  double _sse;
+  double _sw_err;
+
+  double _intercept;
+  double _slope;
+
+  void fit();
+
+public:
+  G1CostRegression();
+
+  void add(double x, double y);
+
+  // True once the fit is based on at least MinSamples samples.
+  bool is_valid() const;
+
+  uint num() const          { return _num; }
+  double intercept() const  { return _intercept; }
+  double slope() const      { return _slope; }
+  double stddev() const;
+
+  // The cost of the phase doing x units of work, and the additional
+  // cost per unit of work.
+  double predict(double x) const { return _intercept + _slope * x; }
+  // The fixed cost of the phase, raised by sigma times the stddev.
+  double fixed_cost(double sigma) const { return _intercept + sigma * stddev(); }
+  double unit_cost() const  { return _slope; }
+};
+
+#endif // SHARE_GC_G1_G1COSTREGRESSION_HPP
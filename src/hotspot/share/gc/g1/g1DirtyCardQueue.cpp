@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/g1/g1BlockOffsetTable.inline.hpp"
 #include "gc/g1/g1CardTableEntryClosure.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1DirtyCardQueue.hpp"
@@ -36,9 +37,11 @@
 #include "runtime/atomic.hpp"
 #include "runtime/flags/flagSetting.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
+#include "utilities/quickSort.hpp"
 
 // Closure used for updating remembered sets and recording references that
 // point into the collection set while the mutator is running.
@@ -58,6 +61,45 @@ public:
   }
 };
 
+static int compare_cards(void* const& a, void* const& b) {
+  if (a < b) {
+    return -1;
+  } else if (a > b) {
+    return 1;
+  }
+  return 0;
+}
+
+// Sorts the unprocessed cards of the buffer by address, so that refinement
+// goes through each region once and in address order, and removes the
+// duplicates by moving the index past them.
+static void sort_and_dedup_buffer(BufferNode* node, size_t buffer_size) {
+  void** buf = BufferNode::make_buffer_from_node(node);
+  size_t start = node->index();
+  if (buffer_size - start < 2) {
+    return;
+  }
+  QuickSort::sort(buf + start, buffer_size - start, compare_cards, false);
+  // Keep one card of each run of equal ones, at the end of the buffer.
+  size_t dst = buffer_size;
+  for (size_t i = buffer_size; i > start; i--) {
+    void* card = buf[i - 1];
+    if (dst == buffer_size || buf[dst] != card) {
+      buf[--dst] = card;
+    }
+  }
+  node->set_index(dst);
+}
+
+// Prefetches what refining the card reads first: the block offset table
+// entry used to find the first object on the card, and the card's words.
+// Prefetching does not fault on cards of uncommitted regions.
+static void prefetch_card(G1CollectedHeap* g1h, CardTable::CardValue* card_ptr) {
+  HeapWord* start = g1h->card_table()->addr_for(card_ptr);
+  Prefetch::read((void*)g1h->bot()->entry_addr_for(start), 0);
+  Prefetch::read(start, 0);
+}
+
 G1DirtyCardQueue::G1DirtyCardQueue(G1DirtyCardQueueSet* qset) :
   // Dirty card queues are always active, so we create them with their
   // active field set to true.
@@ -293,8 +335,7 @@ bool G1DirtyCardQueueSet::mut_process_buffer(BufferNode* node) {
   guarantee(_free_ids != NULL, "must be");
 
   uint worker_i = _free_ids->claim_par_id(); // temporarily claim an id
-  G1RefineCardConcurrentlyClosure cl;
-  bool result = apply_closure_to_buffer(&cl, node, worker_i);
+  bool result = refine_buffer(node, worker_i);
   _free_ids->release_par_id(worker_i); // release the id
 
   if (result) {
@@ -304,9 +345,54 @@ bool G1DirtyCardQueueSet::mut_process_buffer(BufferNode* node) {
   return result;
 }
 
+bool G1DirtyCardQueueSet::refine_buffer(BufferNode* node, uint worker_i) {
+  if (!G1BatchedConcRefinement) {
+    G1RefineCardConcurrentlyClosure cl;
+    return apply_closure_to_buffer(&cl, node, worker_i);
+  }
+
+  sort_and_dedup_buffer(node, buffer_size());
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  G1RemSet* rem_set = g1h->rem_set();
+  void** buf = BufferNode::make_buffer_from_node(node);
+  size_t const limit = buffer_size();
+  size_t const distance = G1ConcRefinementPrefetchDistance;
+  size_t i = node->index();
+  for (size_t p = i; p < MIN2(i + distance, limit); p++) {
+    prefetch_card(g1h, static_cast<CardTable::CardValue*>(buf[p]));
+  }
+  bool result = true;
+  for ( ; i < limit; ++i) {
+    if (i + distance < limit) {
+      prefetch_card(g1h, static_cast<CardTable::CardValue*>(buf[i + distance]));
+    }
+    CardTable::CardValue* card_ptr = static_cast<CardTable::CardValue*>(buf[i]);
+    assert(card_ptr != NULL, "invariant");
+    rem_set->refine_card_concurrently(card_ptr, worker_i);
+    if (SuspendibleThreadSet::should_yield()) {
+      result = false;           // Incomplete processing, the caller yields.
+      break;
+    }
+  }
+  node->set_index(i);
+  return result;
+}
+
 bool G1DirtyCardQueueSet::refine_completed_buffer_concurrently(uint worker_i, size_t stop_at) {
-  G1RefineCardConcurrentlyClosure cl;
-  return apply_closure_to_completed_buffer(&cl, worker_i, stop_at, false);
+  BufferNode* nd = get_completed_buffer(stop_at);
+  if (nd == NULL) {
+    return false;
+  }
+  if (refine_buffer(nd, worker_i)) {
+    assert_fully_consumed(nd, buffer_size());
+    // Done with fully processed buffer.
+    deallocate_buffer(nd);
+    Atomic::inc(&_processed_buffers_rs_thread);
+  } else {
+    // Return partially processed buffer to the queue.
+    enqueue_completed_buffer(nd);
+  }
+  return true;
 }
 
 bool G1DirtyCardQueueSet::apply_closure_during_gc(G1CardTableEntryClosure* cl, uint worker_i) {
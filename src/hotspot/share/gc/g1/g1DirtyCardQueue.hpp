@@ -112,6 +112,12 @@ class G1DirtyCardQueueSet: public PtrQueueSet {
 
   bool mut_process_buffer(BufferNode* node);
 
+  // Refines the active cards of the buffer, stopping early if the thread
+  // should yield, and updates its index like apply_closure_to_buffer. With
+  // G1BatchedConcRefinement the cards are first sorted and deduplicated and
+  // the cards ahead are prefetched.
+  bool refine_buffer(BufferNode* node, uint worker_i);
+
   // If the queue contains more buffers than configured here, the
   // mutator must start doing some of the concurrent refinement work,
   size_t _max_completed_buffers;
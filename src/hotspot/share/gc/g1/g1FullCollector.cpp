@@ -111,6 +111,7 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap, bool explicit_gc, bool c
     _array_queue_set(_num_workers),
     _preserved_marks_set(true),
     _serial_compaction_point(),
+    _humongous_moves(new (ResourceObj::C_HEAP, mtGC) GrowableArray<G1HumongousMove>(8, true, mtGC)),
     _is_alive(heap->concurrent_mark()->next_mark_bitmap()),
     _is_alive_mutator(heap->ref_processor_stw(), &_is_alive),
     _always_subject_to_discovery(),
@@ -135,6 +136,7 @@ G1FullCollector::~G1FullCollector() {
   }
   FREE_C_HEAP_ARRAY(G1FullGCMarker*, _markers);
   FREE_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _compaction_points);
+  delete _humongous_moves;
 }
 
 void G1FullCollector::prepare_collection() {
@@ -236,6 +238,10 @@ void G1FullCollector::phase2_prepare_compaction() {
   if (!task.has_freed_regions()) {
     task.prepare_serial_compaction();
   }
+
+  if (G1FullGCCompactHumongousObjects) {
+    task.prepare_humongous_compaction();
+  }
 }
 
 void G1FullCollector::phase3_adjust_pointers() {
@@ -256,6 +262,11 @@ void G1FullCollector::phase4_do_compaction() {
   if (serial_compaction_point()->has_regions()) {
     task.serial_compaction();
   }
+
+  // Humongous objects move into regions emptied by the compaction above.
+  if (!humongous_moves()->is_empty()) {
+    task.humongous_compaction();
+  }
 }
 
 void G1FullCollector::restore_marks() {
@@ -52,6 +52,16 @@ public:
   }
 };
 
+// A live humongous object moved to lower regions by compaction.
+class G1HumongousMove {
+public:
+  uint _from; // index of its starts humongous region
+  uint _to;   // index of the starts humongous region after compaction
+
+  G1HumongousMove() : _from(0), _to(0) { }
+  G1HumongousMove(uint from, uint to) : _from(from), _to(to) { }
+};
+
 // The G1FullCollector holds data associated with the current Full GC.
 class G1FullCollector : StackObj {
   G1CollectedHeap*          _heap;
@@ -63,6 +73,7 @@ class G1FullCollector : StackObj {
   ObjArrayTaskQueueSet      _array_queue_set;
   PreservedMarksSet         _preserved_marks_set;
   G1FullGCCompactionPoint   _serial_compaction_point;
+  GrowableArray<G1HumongousMove>* _humongous_moves;
   G1IsAliveClosure          _is_alive;
   ReferenceProcessorIsAliveMutator _is_alive_mutator;
 
@@ -87,6 +98,7 @@ public:
   ObjArrayTaskQueueSet*    array_queue_set() { return &_array_queue_set; }
   PreservedMarksSet*       preserved_mark_set() { return &_preserved_marks_set; }
   G1FullGCCompactionPoint* serial_compaction_point() { return &_serial_compaction_point; }
+  GrowableArray<G1HumongousMove>* humongous_moves() { return _humongous_moves; }
   G1CMBitMap*              mark_bitmap();
   ReferenceProcessor*      reference_processor();
 
@@ -34,11 +34,63 @@
 #include "oops/oop.inline.hpp"
 #include "utilities/ticks.hpp"
 
-class G1ResetHumongousClosure : public HeapRegionClosure {
+// Restores the marks of live objects that stayed in place during compaction,
+// in humongous regions and regions with objects pinned by JNI critical
+// sections. The dead objects of the latter are overwritten with filler
+// objects as their classes may have been unloaded.
+class G1ResetPinnedClosure : public HeapRegionClosure {
   G1CMBitMap* _bitmap;
 
+  class G1ResetPinnedLiveClosure : public StackObj {
+    HeapRegion* _hr;
+    HeapWord* _last_live_end;
+
+    void fill_dead_range(HeapWord* start, HeapWord* end) {
+      if (start == end) {
+        return;
+      }
+      CollectedHeap::fill_with_objects(start, pointer_delta(end, start));
+      // Fill_with_objects() may have created more than one object.
+      for (HeapWord* cur = start; cur < end; ) {
+        HeapWord* next = cur + oop(cur)->size();
+        _hr->cross_threshold(cur, next);
+        cur = next;
+      }
+    }
+
+  public:
+    G1ResetPinnedLiveClosure(HeapRegion* hr) :
+        _hr(hr),
+        _last_live_end(hr->bottom()) { }
+
+    size_t apply(oop obj) {
+      HeapWord* obj_addr = (HeapWord*)obj;
+      size_t size = obj->size();
+      assert(obj->forwardee() == obj, "live objects in pinned regions are forwarded to themselves");
+
+      fill_dead_range(_last_live_end, obj_addr);
+      obj->init_mark_raw();
+      _last_live_end = obj_addr + size;
+      _hr->cross_threshold(obj_addr, _last_live_end);
+      return size;
+    }
+
+    void fill_remainder() {
+      fill_dead_range(_last_live_end, _hr->top());
+    }
+  };
+
+  void reset_pinned_region(HeapRegion* hr) {
+    // The block offset table is rebuilt along the live and filler objects.
+    hr->reset_bot();
+    G1ResetPinnedLiveClosure reset_live(hr);
+    hr->apply_to_marked_objects(_bitmap, &reset_live);
+    reset_live.fill_remainder();
+    _bitmap->clear_region(hr);
+  }
+
 public:
-  G1ResetHumongousClosure(G1CMBitMap* bitmap) :
+  G1ResetPinnedClosure(G1CMBitMap* bitmap) :
       _bitmap(bitmap) { }
 
   bool do_heap_region(HeapRegion* current) {
@@ -54,6 +106,8 @@ public:
         }
       }
       current->reset_during_compaction();
+    } else if (current->has_pinned_objects() && !current->is_pinned()) {
+      reset_pinned_region(current);
     }
     return false;
   }
@@ -87,20 +141,61 @@ void G1FullGCCompactTask::compact_region(HeapRegion* hr) {
   hr->complete_compaction();
 }
 
+void G1FullGCCompactTask::compact_claimed_region(G1FullGCCompactionPoint* cp, int index) {
+  cp->wait_for_destinations(index);
+  compact_region(cp->regions()->at(index));
+  cp->set_compacted(index);
+}
+
+uint G1FullGCCompactTask::steal_regions(uint worker_id) {
+  uint stolen = 0;
+  uint num_workers = collector()->workers();
+  for (uint i = 1; i < num_workers; i++) {
+    G1FullGCCompactionPoint* cp = collector()->compaction_point((worker_id + i) % num_workers);
+    int index;
+    while ((index = cp->claim_region()) != -1) {
+      compact_claimed_region(cp, index);
+      stolen++;
+    }
+  }
+  return stolen;
+}
+
+G1FullGCCompactTask::G1FullGCCompactTask(G1FullCollector* collector) :
+    G1FullGCTask("G1 Compact Task", collector),
+    _claimer(collector->workers()) {
+  for (uint i = 0; i < collector->workers(); i++) {
+    collector->compaction_point(i)->prepare_claiming();
+  }
+}
+
 void G1FullGCCompactTask::work(uint worker_id) {
   Ticks start = Ticks::now();
-  GrowableArray<HeapRegion*>* compaction_queue = collector()->compaction_point(worker_id)->regions();
-  for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
-       it != compaction_queue->end();
-       ++it) {
-    compact_region(*it);
+  G1FullGCCompactionPoint* cp = collector()->compaction_point(worker_id);
+  int index;
+  while ((index = cp->claim_region()) != -1) {
+    compact_claimed_region(cp, index);
   }
+  uint stolen = steal_regions(worker_id);
 
-  G1ResetHumongousClosure hc(collector()->mark_bitmap());
+  G1ResetPinnedClosure hc(collector()->mark_bitmap());
   G1CollectedHeap::heap()->heap_region_par_iterate_from_worker_offset(&hc, &_claimer, worker_id);
+  log_trace(gc, phases)("Compaction task (%u) stole %u regions", worker_id, stolen);
   log_task("Compaction task", worker_id, start);
 }
 
+void G1FullGCCompactTask::humongous_compaction() {
+  GCTraceTime(Debug, gc, phases) tm("Phase 4: Humongous Compaction", collector()->scope()->timer());
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  GrowableArray<G1HumongousMove>* moves = collector()->humongous_moves();
+  // In the order prepared: an object may move into the regions of one
+  // moved before it.
+  for (int i = 0; i < moves->length(); i++) {
+    G1HumongousMove move = moves->at(i);
+    g1h->move_humongous_object(g1h->region_at(move._from), g1h->region_at(move._to));
+  }
+}
+
 void G1FullGCCompactTask::serial_compaction() {
   GCTraceTime(Debug, gc, phases) tm("Phase 4: Serial Compaction", collector()->scope()->timer());
   GrowableArray<HeapRegion*>* compaction_queue = collector()->serial_compaction_point()->regions();
@@ -41,13 +41,14 @@ protected:
 
 private:
   void compact_region(HeapRegion* hr);
+  void compact_claimed_region(G1FullGCCompactionPoint* cp, int index);
+  uint steal_regions(uint worker_id);
 
 public:
-  G1FullGCCompactTask(G1FullCollector* collector) :
-    G1FullGCTask("G1 Compact Task", collector),
-    _claimer(collector->workers()) { }
+  G1FullGCCompactTask(G1FullCollector* collector);
   void work(uint worker_id);
   void serial_compaction();
+  void humongous_compaction();
 
   class G1CompactRegionClosure : public StackObj {
     G1CMBitMap* _bitmap;
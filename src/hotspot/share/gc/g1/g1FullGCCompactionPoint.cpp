@@ -26,18 +26,31 @@
 #include "gc/g1/g1FullGCCompactionPoint.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 
 G1FullGCCompactionPoint::G1FullGCCompactionPoint() :
     _current_region(NULL),
     _threshold(NULL),
-    _compaction_top(NULL) {
+    _compaction_top(NULL),
+    _current_index(0),
+    _next_claim(0),
+    _compacted(NULL) {
   _compaction_regions = new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(32, true, mtGC);
   _compaction_region_iterator = _compaction_regions->begin();
+  _first_destinations = new (ResourceObj::C_HEAP, mtGC) GrowableArray<int>(32, true, mtGC);
+  _last_destinations = new (ResourceObj::C_HEAP, mtGC) GrowableArray<int>(32, true, mtGC);
 }
 
 G1FullGCCompactionPoint::~G1FullGCCompactionPoint() {
   delete _compaction_regions;
+  delete _first_destinations;
+  delete _last_destinations;
+  if (_compacted != NULL) {
+    FREE_C_HEAP_ARRAY(jbyte, _compacted);
+  }
 }
 
 void G1FullGCCompactionPoint::update() {
@@ -90,6 +103,7 @@ void G1FullGCCompactionPoint::switch_region() {
   _current_region->set_compaction_top(_compaction_top);
   // Get the next region and re-initialize the values.
   _current_region = next_region();
+  _current_index++;
   initialize_values(true);
 }
 
@@ -140,6 +154,50 @@ void G1FullGCCompactionPoint::merge(G1FullGCCompactionPoint* other) {
    _compaction_regions->appendAll(other->regions());
 }
 
+void G1FullGCCompactionPoint::record_destinations(int first) {
+  assert(_first_destinations->length() == _compaction_regions->length() - 1, "one record per region");
+  assert(first <= _current_index && _current_index < _compaction_regions->length(), "invalid destinations");
+  _first_destinations->append(first);
+  _last_destinations->append(_current_index);
+}
+
 HeapRegion* G1FullGCCompactionPoint::remove_last() {
+  if (_last_destinations->length() == _compaction_regions->length()) {
+    // Objects are only forwarded into earlier regions, so the removed
+    // region is the destination of no other one.
+    _first_destinations->pop();
+    _last_destinations->pop();
+  }
   return _compaction_regions->pop();
 }
+
+void G1FullGCCompactionPoint::prepare_claiming() {
+  assert(_last_destinations->length() == _compaction_regions->length(), "destinations must be recorded");
+  int length = _compaction_regions->length();
+  _compacted = NEW_C_HEAP_ARRAY(jbyte, MAX2(length, 1), mtGC);
+  memset((void*)_compacted, 0, MAX2(length, 1) * sizeof(jbyte));
+  _next_claim = 0;
+}
+
+int G1FullGCCompactionPoint::claim_region() {
+  if (Atomic::load(&_next_claim) >= _compaction_regions->length()) {
+    return -1;
+  }
+  int index = Atomic::add(1, &_next_claim) - 1;
+  return index < _compaction_regions->length() ? index : -1;
+}
+
+void G1FullGCCompactionPoint::wait_for_destinations(int index) {
+  // The region at index itself is compacted by the caller, in address order.
+  int last = MIN2(_last_destinations->at(index), index - 1);
+  for (int i = _first_destinations->at(index); i <= last; i++) {
+    // All regions before index have been claimed, so this terminates.
+    while (OrderAccess::load_acquire(&_compacted[i]) == 0) {
+      SpinPause();
+    }
+  }
+}
+
+void G1FullGCCompactionPoint::set_compacted(int index) {
+  OrderAccess::release_store(&_compacted[index], (jbyte)1);
+}
@@ -31,12 +31,27 @@
 
 class HeapRegion;
 
+// The regions of a compaction queue are compacted in queue order by the
+// worker that prepared them, while other workers with no regions left steal
+// the next ones. The objects of a region are only forwarded into regions at
+// or before it in the queue, so a region can be compacted as soon as the
+// regions its objects are forwarded into, other than itself, have been.
 class G1FullGCCompactionPoint : public CHeapObj<mtGC> {
   HeapRegion* _current_region;
   HeapWord*   _threshold;
   HeapWord*   _compaction_top;
   GrowableArray<HeapRegion*>* _compaction_regions;
   GrowableArrayIterator<HeapRegion*> _compaction_region_iterator;
+  int         _current_index;
+
+  // Per queue region, the index of the first and last regions its objects
+  // are forwarded into.
+  GrowableArray<int>* _first_destinations;
+  GrowableArray<int>* _last_destinations;
+
+  // Compaction claiming state.
+  volatile int    _next_claim;
+  volatile jbyte* _compacted;
 
   bool object_will_fit(size_t size);
   void initialize_values(bool init_threshold);
@@ -55,6 +70,21 @@ public:
   void add(HeapRegion* hr);
   void merge(G1FullGCCompactionPoint* other);
 
+  // Index of the region objects are currently forwarded into.
+  int current_index() const { return _current_index; }
+  // Records that the objects of the last added region were forwarded into
+  // the regions from index first up to the current one.
+  void record_destinations(int first);
+
+  // Compaction: prepare_claiming() must be called before the regions are
+  // claimed, by index, with claim_region(), which returns -1 once all have
+  // been. A claimed region is compacted after wait_for_destinations(), and
+  // set_compacted() once done.
+  void prepare_claiming();
+  int claim_region();
+  void wait_for_destinations(int index);
+  void set_compacted(int index);
+
   HeapRegion* remove_last();
   HeapRegion* current_region();
 
@@ -50,7 +50,11 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
       free_humongous_region(hr);
     }
   } else if (!hr->is_pinned()) {
-    prepare_for_compaction(hr);
+    if (hr->has_pinned_objects()) {
+      prepare_pinned_region(hr);
+    } else {
+      prepare_for_compaction(hr);
+    }
   }
 
   // Reset data structures not valid after Full GC.
@@ -110,6 +114,15 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::free_humongous_region(Heap
   dummy_free_list.remove_all();
 }
 
+void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_pinned_region(HeapRegion* hr) {
+  // Objects in use by JNI critical sections must not move, so the region
+  // is neither compacted nor compacted into. Its live objects stay in place
+  // like those of humongous regions, and its dead ones are filled in the
+  // compaction phase.
+  G1PreparePinnedLiveClosure prepare_pinned;
+  hr->apply_to_marked_objects(_bitmap, &prepare_pinned);
+}
+
 void G1FullGCPrepareTask::G1CalculatePointersClosure::reset_region_metadata(HeapRegion* hr) {
   hr->rem_set()->clear();
   hr->clear_cardtable();
@@ -128,6 +141,11 @@ size_t G1FullGCPrepareTask::G1PrepareCompactLiveClosure::apply(oop object) {
   return size;
 }
 
+size_t G1FullGCPrepareTask::G1PreparePinnedLiveClosure::apply(oop object) {
+  object->forward_to(object);
+  return object->size();
+}
+
 size_t G1FullGCPrepareTask::G1RePrepareClosure::apply(oop obj) {
   // We only re-prepare objects forwarded within the current region, so
   // skip objects that are already forwarded to another region.
@@ -157,7 +175,9 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(Hea
   }
   // Add region to the compaction queue and prepare it.
   _cp->add(hr);
+  int first = _cp->current_index();
   prepare_for_compaction_work(_cp, hr);
+  _cp->record_destinations(first);
 }
 
 void G1FullGCPrepareTask::prepare_serial_compaction() {
@@ -192,6 +212,61 @@ void G1FullGCPrepareTask::prepare_serial_compaction() {
   cp->update();
 }
 
+// A region is empty after compaction if it takes part in it and nothing is
+// forwarded into it.
+static bool is_empty_after_compaction(HeapRegion* hr) {
+  return hr != NULL && !hr->is_pinned() && !hr->has_pinned_objects() &&
+         hr->compaction_top() == hr->bottom();
+}
+
+// Returns the first index of the lowest run of num empty regions that ends at
+// or below limit, or G1_NO_HRM_INDEX.
+static uint find_empty_run(const bool* empty, uint num, uint limit) {
+  uint run = 0;
+  for (uint i = 0; i < limit; i++) {
+    run = empty[i] ? run + 1 : 0;
+    if (run == num) {
+      return i + 1 - num;
+    }
+  }
+  return G1_NO_HRM_INDEX;
+}
+
+void G1FullGCPrepareTask::prepare_humongous_compaction() {
+  GCTraceTime(Debug, gc, phases) debug("Phase 2: Prepare Humongous Compaction", collector()->scope()->timer());
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  uint const max_regions = g1h->max_regions();
+  bool* empty = NEW_C_HEAP_ARRAY(bool, max_regions, mtGC);
+  for (uint i = 0; i < max_regions; i++) {
+    empty[i] = is_empty_after_compaction(g1h->region_at_or_null(i));
+  }
+
+  // Going up, every object moving frees its regions for the ones above.
+  GrowableArray<G1HumongousMove>* moves = collector()->humongous_moves();
+  for (uint i = 0; i < max_regions; i++) {
+    HeapRegion* hr = g1h->region_at_or_null(i);
+    if (hr == NULL || !hr->is_starts_humongous()) {
+      continue;
+    }
+    oop obj = oop(hr->bottom());
+    assert(collector()->mark_bitmap()->is_marked(obj), "dead humongous objects are freed");
+    uint num_regions = (uint)g1h->humongous_obj_size_in_regions(obj->size());
+    // Pinned humongous objects stay where they are.
+    uint to = hr->has_pinned_objects() ? G1_NO_HRM_INDEX : find_empty_run(empty, num_regions, i);
+    if (to != G1_NO_HRM_INDEX) {
+      obj->forward_to(oop(g1h->region_at(to)->bottom()));
+      for (uint j = 0; j < num_regions; j++) {
+        empty[to + j] = false;
+        empty[i + j] = true;
+      }
+      moves->append(G1HumongousMove(i, to));
+    }
+    i += num_regions - 1;
+  }
+  FREE_C_HEAP_ARRAY(bool, empty);
+  log_debug(gc, phases)("Moving %d humongous objects", moves->length());
+}
+
 void G1FullGCPrepareTask::G1CalculatePointersClosure::update_sets() {
   // We'll recalculate total used bytes and recreate the free list
   // at the end of the GC, so no point in updating those values here.
@@ -46,6 +46,9 @@ public:
   G1FullGCPrepareTask(G1FullCollector* collector);
   void work(uint worker_id);
   void prepare_serial_compaction();
+  // Forwards live humongous objects to the lowest runs of regions below them
+  // that are empty after compaction, recording the moves in the collector.
+  void prepare_humongous_compaction();
   bool has_freed_regions();
 
 protected:
@@ -59,6 +62,7 @@ protected:
     virtual void prepare_for_compaction(HeapRegion* hr);
     void prepare_for_compaction_work(G1FullGCCompactionPoint* cp, HeapRegion* hr);
     void free_humongous_region(HeapRegion* hr);
+    void prepare_pinned_region(HeapRegion* hr);
     void reset_region_metadata(HeapRegion* hr);
 
   public:
@@ -78,6 +82,12 @@ protected:
     size_t apply(oop object);
   };
 
+  // Forwards the live objects of regions with pinned objects to themselves.
+  class G1PreparePinnedLiveClosure : public StackObj {
+  public:
+    size_t apply(oop object);
+  };
+
   class G1RePrepareClosure : public StackObj {
     G1FullGCCompactionPoint* _cp;
     HeapRegion* _current;
@@ -97,7 +97,8 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     ScanHRScannedBlocks,
     ScanHRClaimedChunks,
     ScanHRScannedOptRefs,
-    ScanHRUsedMemory
+    ScanHRUsedMemory,
+    ScanHRSkippedCards
   };
 
   enum GCMergeHCCWorkItems {
@@ -136,6 +137,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   WorkerDataArray<size_t>* _scan_hr_scanned_cards;
   WorkerDataArray<size_t>* _scan_hr_scanned_blocks;
   WorkerDataArray<size_t>* _scan_hr_claimed_chunks;
+  WorkerDataArray<size_t>* _scan_hr_skipped_cards;
 
   WorkerDataArray<size_t>* _opt_merge_rs_merged_sparse;
   WorkerDataArray<size_t>* _opt_merge_rs_merged_fine;
@@ -144,6 +146,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   WorkerDataArray<size_t>* _opt_scan_hr_scanned_cards;
   WorkerDataArray<size_t>* _opt_scan_hr_scanned_blocks;
   WorkerDataArray<size_t>* _opt_scan_hr_claimed_chunks;
+  WorkerDataArray<size_t>* _opt_scan_hr_skipped_cards;
   WorkerDataArray<size_t>* _opt_scan_hr_scanned_opt_refs;
   WorkerDataArray<size_t>* _opt_scan_hr_used_memory;
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_GC_G1_G1NUMA_HPP
+#define SHARE_GC_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+
+// Maps the NUMA nodes of the machine to indices 0..num_active_nodes()-1 and
+// heap regions to their preferred node. Regions are spread over the nodes
+// round robin, a page at a time when a page spans several regions, and the
+// memory of committed regions is requested from their preferred node.
+// Without UseNUMA, or with a single node, all regions are on node 0.
+class G1NUMA: public CHeapObj<mtGC> {
+  // Node ids of the active nodes, by node index.
+  int* _node_ids;
+  uint _num_active_node_ids;
+  // Node index by node id, up to the highest active id.
+  uint* _node_id_to_index_map;
+  int _len_node_id_to_index_map;
+
+  size_t _region_size;
+  size_t _page_size;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+  void initialize_without_numa();
+
+  uint index_of_node_id(int node_id) const;
+
+public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Sets the heap region size and the page size backing the heap.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  bool is_enabled() const { return num_active_nodes() > 1; }
+  uint num_active_nodes() const { return _num_active_node_ids; }
+  const int* node_ids() const { return _node_ids; }
+
+  // The index of the node the current thread runs on.
+  uint index_of_current_thread() const;
+
+  // The index of the node the region, by its index, is allocated on.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Requests that the memory of a committed region, or of the page holding
+  // it if regions are smaller than pages, be allocated on the region's
+  // preferred node.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // How many free regions to look at for one on a requested node before
+  // taking any region.
+  uint max_search_depth() const;
+};
+
+#endif // SHARE_GC_G1_G1NUMA_HPP
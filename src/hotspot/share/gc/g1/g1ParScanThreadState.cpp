@@ -219,6 +219,12 @@ void G1ParScanThreadState::report_promotion_event(G1HeapRegionAttr const dest_at
 oop G1ParScanThreadState::copy_to_survivor_space(G1HeapRegionAttr const region_attr,
                                                  oop const old,
                                                  markWord const old_mark) {
+  // Objects in pinned regions stay in place, like those that failed to be
+  // evacuated, and their regions are retained.
+  if (region_attr.is_pinned()) {
+    return handle_evacuation_failure_par(old, old_mark, true /* is_pinned */);
+  }
+
   const size_t word_sz = old->size();
 
   uint age = 0;
@@ -372,7 +378,7 @@ void G1ParScanThreadStateSet::record_unused_optional_region(HeapRegion* hr) {
   }
 }
 
-oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m) {
+oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m, bool is_pinned) {
   assert(_g1h->is_in_cset(old), "Object " PTR_FORMAT " should be in the CSet", p2i(old));
 
   oop forward_ptr = old->forward_to_atomic(old, m, memory_order_relaxed);
@@ -385,7 +391,7 @@ oop G1ParScanThreadState::handle_evacuation_failure_par(oop old, markWord m) {
      _g1h->hr_printer()->evac_failure(r);
     }
 
-    _g1h->preserve_mark_during_evac_failure(_worker_id, old, m);
+    _g1h->preserve_mark_during_evac_failure(_worker_id, old, m, is_pinned);
 
     G1ScanInYoungSetter x(&_scanner, r->is_young());
     old->oop_iterate_backwards(&_scanner);
@@ -186,6 +186,13 @@ private:
 
   inline void dispatch_reference(StarTask ref);
 
+  // Largest batch of references taken from the task queue at once, see
+  // G1EvacuationPrefetchBatch.
+  static const uint MaxPrefetchBatch = 16;
+
+  // Prefetches the header of the object ref refers to, if any.
+  inline void prefetch_reference(StarTask ref) const;
+
   // Tries to allocate word_sz in the PLAB of the next "generation" after trying to
   // allocate into dest. State is the original (source) cset state for the object
   // that is allocated for. Previous_plab_refill_failed indicates whether previously
@@ -219,8 +226,9 @@ public:
 
   inline void steal_and_trim_queue(RefToScanQueueSet *task_queues);
 
-  // An attempt to evacuate "obj" has failed; take necessary steps.
-  oop handle_evacuation_failure_par(oop obj, markWord m);
+  // An attempt to evacuate "obj" has failed, or "obj" is in a pinned region
+  // and must not be moved; take necessary steps.
+  oop handle_evacuation_failure_par(oop obj, markWord m, bool is_pinned = false);
 
   template <typename T>
   inline void remember_root_into_optional_region(T* p);
@@ -31,6 +31,7 @@
 #include "gc/g1/g1RemSet.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 template <class T> void G1ParScanThreadState::do_oop_evac(T* p) {
   // Reference should not be NULL here as such are never pushed to the task queue.
@@ -149,6 +150,22 @@ inline void G1ParScanThreadState::dispatch_reference(StarTask ref) {
   }
 }
 
+inline void G1ParScanThreadState::prefetch_reference(StarTask ref) const {
+  oop obj;
+  if (ref.is_narrow()) {
+    obj = RawAccess<>::oop_load((narrowOop*)ref);
+  } else if (!has_partial_array_mask((oop*)ref)) {
+    obj = RawAccess<>::oop_load((oop*)ref);
+  } else {
+    return;
+  }
+  if (obj != NULL) {
+    // We will look at the mark and klass, and most likely install a forwarding
+    // pointer.
+    Prefetch::write(obj->mark_addr_raw(), 0);
+  }
+}
+
 void G1ParScanThreadState::steal_and_trim_queue(RefToScanQueueSet *task_queues) {
   StarTask stolen_task;
   while (task_queues->steal(_worker_id, stolen_task)) {
@@ -179,9 +196,28 @@ inline void G1ParScanThreadState::trim_queue_to_threshold(uint threshold) {
     }
   }
 
-  while (_refs->pop_local(ref, threshold)) {
-    dispatch_reference(ref);
+  if (G1EvacuationPrefetchBatch == 1) {
+    while (_refs->pop_local(ref, threshold)) {
+      dispatch_reference(ref);
+    }
+    return;
   }
+
+  // Take a few references at once and prefetch the objects they refer to, so
+  // that the cache misses on their headers overlap instead of stalling the
+  // copying of every single object.
+  StarTask batch[MaxPrefetchBatch];
+  uint num;
+  do {
+    num = 0;
+    while (num < G1EvacuationPrefetchBatch && _refs->pop_local(batch[num], threshold)) {
+      prefetch_reference(batch[num]);
+      num++;
+    }
+    for (uint i = 0; i < num; i++) {
+      dispatch_reference(batch[i]);
+    }
+  } while (num > 0);
 }
 
 inline void G1ParScanThreadState::trim_queue_partially() {
@@ -668,6 +668,7 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t heap_use
       cost_per_log_buffer_entry = log_buffer_processing_time() / pending_log_buffer_entries;
       _analytics->report_cost_per_log_buffer_entry_ms(cost_per_log_buffer_entry);
     }
+    _analytics->report_log_buffer_cost(pending_log_buffer_entries, log_buffer_processing_time());
     _analytics->report_cost_scan_hcc(scan_hcc_time_ms);
 
     size_t const total_cards_scanned = p->sum_thread_work_items(G1GCPhaseTimes::ScanHR, G1GCPhaseTimes::ScanHRScannedCards) +
@@ -681,16 +682,18 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t heap_use
     }
 
     double cost_per_remset_card_ms = 0.0;
+    double avg_time_remset_scan = average_time_ms(G1GCPhaseTimes::MergeER) +
+                                  average_time_ms(G1GCPhaseTimes::MergeRS) +
+                                  average_time_ms(G1GCPhaseTimes::OptMergeRS);
+    if (total_cards_scanned > 0) {
+      avg_time_remset_scan += (average_time_ms(G1GCPhaseTimes::ScanHR) + average_time_ms(G1GCPhaseTimes::OptScanHR)) *
+                              remset_cards_scanned / total_cards_scanned;
+    }
     if (remset_cards_scanned > 10) {
-      double avg_time_remset_scan = ((average_time_ms(G1GCPhaseTimes::ScanHR) + average_time_ms(G1GCPhaseTimes::OptScanHR)) *
-                                     remset_cards_scanned / total_cards_scanned) +
-                                     average_time_ms(G1GCPhaseTimes::MergeER) +
-                                     average_time_ms(G1GCPhaseTimes::MergeRS) +
-                                     average_time_ms(G1GCPhaseTimes::OptMergeRS);
-
       cost_per_remset_card_ms = avg_time_remset_scan / remset_cards_scanned;
       _analytics->report_cost_per_remset_card_ms(cost_per_remset_card_ms, this_pause_was_young_only);
     }
+    _analytics->report_remset_cost(remset_cards_scanned, avg_time_remset_scan, this_pause_was_young_only);
 
     if (_max_rs_length > 0) {
       double cards_per_entry_ratio =
@@ -721,11 +724,13 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t heap_use
     size_t freed_bytes = heap_used_bytes_before_gc - cur_used_bytes;
     size_t copied_bytes = _collection_set->bytes_used_before() - freed_bytes;
     double cost_per_byte_ms = 0.0;
+    double const copy_time_ms = average_time_ms(G1GCPhaseTimes::ObjCopy) + average_time_ms(G1GCPhaseTimes::OptObjCopy);
 
     if (copied_bytes > 0) {
-      cost_per_byte_ms = (average_time_ms(G1GCPhaseTimes::ObjCopy) + average_time_ms(G1GCPhaseTimes::OptObjCopy)) / (double) copied_bytes;
+      cost_per_byte_ms = copy_time_ms / (double) copied_bytes;
       _analytics->report_cost_per_byte_ms(cost_per_byte_ms, collector_state()->mark_or_rebuild_in_progress());
     }
+    _analytics->report_object_copy_cost(copied_bytes, copy_time_ms, collector_state()->mark_or_rebuild_in_progress());
 
     if (_collection_set->young_region_length() > 0) {
       _analytics->report_young_other_cost_per_region_ms(young_other_time_ms() /
@@ -747,6 +752,8 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t heap_use
       _analytics->report_pending_cards((double) _pending_cards);
       _analytics->report_rs_length((double) _max_rs_length);
     }
+
+    _analytics->log_cost_regressions();
   }
 
   assert(!(this_pause_included_initial_mark && collector_state()->mark_or_rebuild_in_progress()),
@@ -885,6 +892,8 @@ double G1Policy::predict_base_elapsed_time_ms(size_t pending_cards,
   return
     _analytics->predict_rs_update_time_ms(pending_cards) +
     _analytics->predict_rs_scan_time_ms(scanned_cards, collector_state()->in_young_only_phase()) +
+    _analytics->predict_fixed_phase_time_ms(collector_state()->in_young_only_phase(),
+                                            collector_state()->mark_or_rebuild_in_progress()) +
     _analytics->predict_constant_other_time_ms();
 }
 
@@ -1276,6 +1285,15 @@ void G1Policy::calculate_old_collection_set_regions(G1CollectionSetCandidates* c
       break;
     }
 
+    // Candidates are taken in order, so stop at a region that cannot be
+    // evacuated now because its objects are pinned by JNI critical sections.
+    if (hr->has_pinned_objects()) {
+      log_debug(gc, ergo, cset)("Finish adding old regions to collection set (Region %u has pinned objects). "
+                                "Initial %u regions, optional %u regions",
+                                hr->hrm_index(), num_initial_regions, num_optional_regions);
+      break;
+    }
+
     double predicted_time_ms = predict_region_elapsed_time_ms(hr, false);
     time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
     // Add regions to old set until we reach the minimum amount
@@ -1336,6 +1354,10 @@ void G1Policy::calculate_optional_collection_set_regions(G1CollectionSetCandidat
   HeapRegion* r = candidates->at(candidate_idx);
   while (num_optional_regions < max_optional_regions) {
     assert(r != NULL, "Region must exist");
+    if (r->has_pinned_objects()) {
+      log_debug(gc, ergo, cset)("Region %u has pinned objects.", r->hrm_index());
+      break;
+    }
     prediction_ms += predict_region_elapsed_time_ms(r, false);
 
     if (prediction_ms > time_remaining_ms) {
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1BiasedArray.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1RegionToSpaceMapper.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
@@ -44,7 +45,8 @@ G1RegionToSpaceMapper::G1RegionToSpaceMapper(ReservedSpace rs,
   _listener(NULL),
   _storage(rs, used_size, page_size),
   _region_granularity(region_granularity),
-  _commit_map(rs.size() * commit_factor / region_granularity, mtGC) {
+  _commit_map(rs.size() * commit_factor / region_granularity, mtGC),
+  _memory_type(type) {
   guarantee(is_power_of_2(page_size), "must be");
   guarantee(is_power_of_2(region_granularity), "must be");
 
@@ -74,6 +76,12 @@ class G1RegionsLargerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   virtual void commit_regions(uint start_idx, size_t num_regions, WorkGang* pretouch_gang) {
     size_t const start_page = (size_t)start_idx * _pages_per_region;
     bool zero_filled = _storage.commit(start_page, num_regions * _pages_per_region);
+    if (_memory_type == mtJavaHeap) {
+      char* base = (char*)_storage.reserved().start();
+      for (uint region_idx = start_idx; region_idx < start_idx + num_regions; region_idx++) {
+        numa_request_on_node(base + region_idx * _region_granularity, _region_granularity, region_idx);
+      }
+    }
     if (AlwaysPreTouch) {
       _storage.pretouch(start_page, num_regions * _pages_per_region, pretouch_gang);
     }
@@ -141,6 +149,10 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
           num_committed++;
         }
         zero_filled = _storage.commit(idx, 1);
+        if (_memory_type == mtJavaHeap) {
+          size_t page_bytes = _region_granularity * _regions_per_page;
+          numa_request_on_node((char*)_storage.reserved().start() + idx * page_bytes, page_bytes, i);
+        }
       }
       all_zero_filled &= zero_filled;
 
@@ -168,12 +180,23 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   }
 };
 
+void G1RegionToSpaceMapper::numa_request_on_node(char* address, size_t size, uint region_idx) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa != NULL) {
+    numa->request_memory_on_node(address, size, region_idx);
+  }
+}
+
 void G1RegionToSpaceMapper::fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled) {
   if (_listener != NULL) {
     _listener->on_commit(start_idx, num_regions, zero_filled);
   }
 }
 
+void G1RegionToSpaceMapper::signal_mapping_changed(uint start_idx, size_t num_regions) {
+  fire_on_commit(start_idx, num_regions, false);
+}
+
 static bool map_nvdimm_space(ReservedSpace rs) {
   assert(AllocateOldGenAt != NULL, "");
   int _backing_fd = os::create_file_for_heap(AllocateOldGenAt);
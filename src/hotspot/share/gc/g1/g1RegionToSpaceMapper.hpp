@@ -53,8 +53,14 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   // Mapping management
   CHeapBitMap _commit_map;
 
+  MemoryType _memory_type;
+
   G1RegionToSpaceMapper(ReservedSpace rs, size_t used_size, size_t page_size, size_t region_granularity, size_t commit_factor, MemoryType type);
 
+  // Requests the just committed memory of the Java heap at address, backing
+  // the region at region_idx, from the region's preferred NUMA node.
+  void numa_request_on_node(char* address, size_t size, uint region_idx);
+
   void fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled);
  public:
   MemRegion reserved() { return _storage.reserved(); }
@@ -74,6 +80,10 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   virtual void commit_regions(uint start_idx, size_t num_regions = 1, WorkGang* pretouch_workers = NULL) = 0;
   virtual void uncommit_regions(uint start_idx, size_t num_regions = 1) = 0;
 
+  // Notifies the listener that the still committed memory of the regions is
+  // reused, as if it had been committed again, without committing it.
+  void signal_mapping_changed(uint start_idx, size_t num_regions);
+
   // Creates an appropriate G1RegionToSpaceMapper for the given parameters.
   // The actual space to be used within the given reservation is given by actual_size.
   // This is because some OSes need to round up the reservation size to guarantee
@@ -519,6 +519,9 @@ private:
   CardValue* _cur_addr;
   CardValue* const _end_addr;
 
+  // Number of strides without any card to scan skipped by find_next_dirty().
+  size_t _strides_skipped;
+
   static const size_t ToScanMask = G1CardTable::g1_card_already_scanned;
   static const size_t ExpandedToScanMask = G1CardTable::WordAlreadyScanned;
 
@@ -526,6 +529,35 @@ private:
     return ((uintptr_t)_cur_addr) % sizeof(size_t) == 0;
   }
 
+  bool cur_addr_stride_aligned() const {
+    return ((uintptr_t)_cur_addr) % StrideBytes == 0;
+  }
+
+  bool has_stride_left() const {
+    return pointer_delta(_end_addr, _cur_addr, sizeof(CardValue)) >= StrideBytes;
+  }
+
+  // Combine the words of the stride at the current address with a single
+  // and/or across independent loads, which compilers turn into vector
+  // compares where the platform has them.
+  size_t cur_stride_and() const {
+    const size_t* words = (const size_t*)_cur_addr;
+    return (words[0] & words[1]) & (words[2] & words[3]);
+  }
+
+  size_t cur_stride_or() const {
+    const size_t* words = (const size_t*)_cur_addr;
+    return (words[0] | words[1]) | (words[2] | words[3]);
+  }
+
+  bool cur_stride_contains_any_dirty_card() const {
+    return (~cur_stride_and() & ExpandedToScanMask) != 0;
+  }
+
+  bool cur_stride_all_dirty_cards() const {
+    return cur_stride_or() == G1CardTable::WordAllDirty;
+  }
+
   bool cur_card_is_dirty() const {
     CardValue value = *_cur_addr;
     return (value & ToScanMask) == 0;
@@ -548,10 +580,16 @@ private:
   }
 
 public:
+  // Number of words the scanner looks at at once when looking for the next
+  // change between dirty and non-dirty cards.
+  static const size_t StrideWords = 4;
+  static const size_t StrideBytes = StrideWords * sizeof(size_t);
+
   G1CardTableScanner(CardValue* start_card, size_t size) :
     _base_addr(start_card),
     _cur_addr(start_card),
-    _end_addr(start_card + size) {
+    _end_addr(start_card + size),
+    _strides_skipped(0) {
 
     assert(is_aligned(start_card, sizeof(size_t)), "Unaligned start addr " PTR_FORMAT, p2i(start_card));
     assert(is_aligned(size, sizeof(size_t)), "Unaligned size " SIZE_FORMAT, size);
@@ -567,6 +605,11 @@ public:
 
     assert(cur_addr_aligned(), "Current address should be aligned now.");
     while (_cur_addr != _end_addr) {
+      if (cur_addr_stride_aligned() && has_stride_left() && !cur_stride_contains_any_dirty_card()) {
+        _cur_addr += StrideBytes;
+        _strides_skipped++;
+        continue;
+      }
       if (cur_word_of_cards_contains_any_dirty_card()) {
         for (size_t i = 0; i < sizeof(size_t); i++) {
           if (cur_card_is_dirty()) {
@@ -593,6 +636,10 @@ public:
 
     assert(cur_addr_aligned(), "Current address should be aligned now.");
     while (_cur_addr != _end_addr) {
+      if (cur_addr_stride_aligned() && has_stride_left() && cur_stride_all_dirty_cards()) {
+        _cur_addr += StrideBytes;
+        continue;
+      }
       if (!cur_word_of_cards_all_dirty_cards()) {
         for (size_t i = 0; i < sizeof(size_t); i++) {
           if (!cur_card_is_dirty()) {
@@ -606,6 +653,8 @@ public:
     }
     return get_and_advance_pos();
   }
+
+  size_t cards_skipped() const { return _strides_skipped * StrideBytes; }
 };
 
 // Helper class to claim dirty chunks within the card table.
@@ -655,6 +704,7 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
   size_t _cards_scanned;
   size_t _blocks_scanned;
   size_t _chunks_claimed;
+  size_t _cards_skipped;
 
   Tickspan _rem_set_root_scan_time;
   Tickspan _rem_set_trim_partially_time;
@@ -738,6 +788,7 @@ class G1ScanHRForRegionClosure : public HeapRegionClosure {
 
         first_scan_idx = scan.find_next_dirty();
       }
+      _cards_skipped += scan.cards_skipped();
       _chunks_claimed++;
     }
 
@@ -759,6 +810,7 @@ public:
     _cards_scanned(0),
     _blocks_scanned(0),
     _chunks_claimed(0),
+    _cards_skipped(0),
     _rem_set_root_scan_time(),
     _rem_set_trim_partially_time(),
     _scanned_to(NULL) {
@@ -783,6 +835,7 @@ public:
   size_t cards_scanned() const { return _cards_scanned; }
   size_t blocks_scanned() const { return _blocks_scanned; }
   size_t chunks_claimed() const { return _chunks_claimed; }
+  size_t cards_skipped() const { return _cards_skipped; }
 };
 
 void G1RemSet::scan_heap_roots(G1ParScanThreadState* pss,
@@ -800,6 +853,7 @@ void G1RemSet::scan_heap_roots(G1ParScanThreadState* pss,
   p->record_or_add_thread_work_item(scan_phase, worker_id, cl.cards_scanned(), G1GCPhaseTimes::ScanHRScannedCards);
   p->record_or_add_thread_work_item(scan_phase, worker_id, cl.blocks_scanned(), G1GCPhaseTimes::ScanHRScannedBlocks);
   p->record_or_add_thread_work_item(scan_phase, worker_id, cl.chunks_claimed(), G1GCPhaseTimes::ScanHRClaimedChunks);
+  p->record_or_add_thread_work_item(scan_phase, worker_id, cl.cards_skipped(), G1GCPhaseTimes::ScanHRSkippedCards);
 }
 
 // Heap region closure to be applied to all regions in the current collection set
@@ -956,7 +1010,20 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       _scan_state->set_chunk_region_dirty(region_base_idx);
     }
 
-    void next_fine_prt(uint const region_idx, BitMap* bm) {
+    class MergeFineCardClosure : public StackObj {
+      G1MergeCardSetClosure* _cl;
+      size_t const           _region_base_idx;
+    public:
+      MergeFineCardClosure(G1MergeCardSetClosure* cl, size_t region_base_idx) :
+        _cl(cl), _region_base_idx(region_base_idx) { }
+
+      void do_card(uint const card) {
+        _cl->_ct->mark_clean_as_dirty(_region_base_idx + card);
+        _cl->_scan_state->set_chunk_dirty(_region_base_idx + card);
+      }
+    };
+
+    void next_fine_prt(uint const region_idx, PerRegionTable* prt) {
       if (!remember_if_interesting(region_idx)) {
         return;
       }
@@ -964,12 +1031,8 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       _merged_fine++;
 
       size_t const region_base_idx = (size_t)region_idx << HeapRegion::LogCardsPerRegion;
-      BitMap::idx_t cur = bm->get_next_one_offset(0);
-      while (cur != bm->size()) {
-        _ct->mark_clean_as_dirty(region_base_idx + cur);
-        _scan_state->set_chunk_dirty(region_base_idx + cur);
-        cur = bm->get_next_one_offset(cur + 1);
-      }
+      MergeFineCardClosure cl(this, region_base_idx);
+      prt->iterate_cards(cl);
     }
 
     void next_sparse_prt(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
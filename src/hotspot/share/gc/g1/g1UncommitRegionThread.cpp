@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CollectedHeap.hpp"
+#include "gc/g1/g1UncommitRegionThread.hpp"
+#include "gc/g1/heapRegion.hpp"
+#include "gc/g1/heapRegionManager.hpp"
+#include "logging/log.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+
+G1UncommitRegionThread::G1UncommitRegionThread() :
+    ConcurrentGCThread(),
+    _monitor(Mutex::nonleaf,
+             "G1UncommitRegionThread monitor",
+             true,
+             Monitor::_safepoint_check_never),
+    _has_work(false) {
+  set_name("G1 Uncommit");
+  create_and_start();
+}
+
+void G1UncommitRegionThread::notify_regions_to_uncommit() {
+  MonitorLocker ml(&_monitor, Mutex::_no_safepoint_check_flag);
+  _has_work = true;
+  ml.notify();
+}
+
+bool G1UncommitRegionThread::wait_for_work() {
+  MonitorLocker ml(&_monitor, Mutex::_no_safepoint_check_flag);
+  while (!_has_work && !should_terminate()) {
+    ml.wait();
+  }
+  _has_work = false;
+  return !should_terminate();
+}
+
+void G1UncommitRegionThread::run_service() {
+  HeapRegionManager* hrm = G1CollectedHeap::heap()->hrm();
+  uint const batch_regions = (uint)MAX2(G1UncommitBatchSize / HeapRegion::GrainBytes, (size_t)1);
+
+  while (wait_for_work()) {
+    double start = os::elapsedTime();
+    uint uncommitted = 0;
+    while (hrm->has_inactive_regions() && !should_terminate()) {
+      uncommitted += hrm->uncommit_inactive_regions(batch_regions);
+    }
+    if (uncommitted > 0) {
+      log_debug(gc, heap)("Concurrent uncommit: " SIZE_FORMAT "M (%u regions) in %1.3fms",
+                          (uncommitted * HeapRegion::GrainBytes) / M, uncommitted,
+                          (os::elapsedTime() - start) * MILLIUNITS);
+    }
+  }
+}
+
+void G1UncommitRegionThread::stop_service() {
+  MonitorLocker ml(&_monitor, Mutex::_no_safepoint_check_flag);
+  ml.notify();
+}
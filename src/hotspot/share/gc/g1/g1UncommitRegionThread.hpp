@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1UNCOMMITREGIONTHREAD_HPP
+#define SHARE_GC_G1_G1UNCOMMITREGIONTHREAD_HPP
+
+#include "gc/shared/concurrentGCThread.hpp"
+#include "runtime/mutex.hpp"
+
+// The G1UncommitRegionThread uncommits the memory of regions the heap shrank
+// by, outside of the pause that shrank it (see G1ConcurrentUncommit). Memory
+// is returned in batches of G1UncommitBatchSize so that committing regions,
+// which waits for a batch in progress, is not held up for long.
+class G1UncommitRegionThread: public ConcurrentGCThread {
+private:
+  Monitor _monitor;
+  bool _has_work;
+
+  void run_service();
+  void stop_service();
+
+  // Wait until there are regions to uncommit or the thread is to terminate.
+  // Returns false in the latter case.
+  bool wait_for_work();
+
+public:
+  G1UncommitRegionThread();
+
+  // Wake up the thread to uncommit inactive regions.
+  void notify_regions_to_uncommit();
+};
+
+#endif // SHARE_GC_G1_G1UNCOMMITREGIONTHREAD_HPP
@@ -152,6 +152,16 @@
           "Select green, yellow and red zones adaptively to meet the "      \
           "the pause requirements.")                                        \
                                                                             \
+  experimental(bool, G1BatchedConcRefinement, false,                        \
+          "Refine the cards of a buffer sorted by address, without "        \
+          "duplicates, prefetching the block offset table entries and "     \
+          "heap words of the cards ahead.")                                 \
+                                                                            \
+  experimental(uint, G1ConcRefinementPrefetchDistance, 4,                   \
+          "Number of cards ahead of the card being refined to prefetch "    \
+          "with G1BatchedConcRefinement.")                                  \
+          range(1, 64)                                                      \
+                                                                            \
   product(size_t, G1ConcRSLogCacheSize, 10,                                 \
           "Log base 2 of the length of conc RS hot-card cache.")            \
           range(0, 27)                                                      \
@@ -181,6 +191,11 @@
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetSparseRegionEntriesConstraintFunc,AfterErgo)     \
                                                                             \
+  experimental(uint, G1RSetFineArrayEntriesMax, 256,                        \
+          "Max number of cards a fine grain remembered set table keeps "    \
+          "in an array before it allocates a bitmap. 0 disables arrays.")   \
+          range(0, 64*K)                                                    \
+                                                                            \
   develop(intx, G1MaxVerifyFailures, -1,                                    \
           "The maximum number of verification failures to print.  "         \
           "-1 means print all.")                                            \
@@ -255,6 +270,32 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(bool, G1EagerReclaimHumongousObjArrays, false,               \
+          "Also try to reclaim dead large object arrays at young GCs "      \
+          "outside of concurrent marking and remembered set rebuild.")      \
+                                                                            \
+  experimental(bool, G1FullGCCompactHumongousObjects, false,                \
+          "Move live large objects to lower free regions during full GC "   \
+          "to reduce fragmentation.")                                       \
+                                                                            \
+  experimental(bool, G1UseRegionPinning, false,                             \
+          "Pin the regions containing the objects used by JNI critical "    \
+          "sections instead of blocking garbage collection while any "      \
+          "critical section is active. Pinned regions are not evacuated "   \
+          "or compacted.")                                                  \
+                                                                            \
+  experimental(uint, G1EvacuationPrefetchBatch, 4,                          \
+          "Number of references taken from the task queue at once during "  \
+          "evacuation, prefetching the headers of the objects they refer "  \
+          "to before processing any of them. One disables batching.")       \
+          range(1, 16)                                                      \
+                                                                            \
+  experimental(bool, G1UsePhaseCostRegression, false,                       \
+          "Predict the cost of merging log buffers, scanning the "          \
+          "remembered sets and copying objects from a linear regression "   \
+          "over recent pauses instead of from average costs per unit of "   \
+          "work.")                                                          \
+                                                                            \
   experimental(size_t, G1RebuildRemSetChunkSize, 256 * K,                   \
           "Chunk size used for rebuilding the remembered set.")             \
           range(4 * K, 32 * M)                                              \
@@ -319,6 +360,15 @@
           "disables this check.")                                           \
           range(0.0, (double)max_uintx)                                     \
                                                                             \
+  experimental(bool, G1ConcurrentUncommit, false,                            \
+          "Uncommit the memory of regions the heap shrank by in a "         \
+          "background thread instead of in the pause.")                     \
+                                                                            \
+  experimental(size_t, G1UncommitBatchSize, 32 * M,                         \
+          "The amount of memory the concurrent uncommit returns to the "    \
+          "operating system at a time, rounded down to whole regions.")     \
+          range(1, max_uintx)                                               \
+                                                                            \
   experimental(uintx, G1YoungExpansionBufferPercent, 10,                    \
                "When heterogenous heap is enabled by AllocateOldGenAt "     \
                "option, after every GC, young gen is re-sized which "       \
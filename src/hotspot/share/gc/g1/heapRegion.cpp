@@ -28,6 +28,7 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1HeapRegionTraceType.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionBounds.inline.hpp"
@@ -62,6 +63,10 @@ size_t HeapRegion::min_region_size_in_words() {
   return HeapRegionBounds::min_size() >> LogHeapWordSize;
 }
 
+uint HeapRegion::node_index() const {
+  return G1NUMA::numa()->preferred_node_index_for_index(hrm_index());
+}
+
 void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_heap_size) {
   size_t region_size = G1HeapRegionSize;
   if (FLAG_IS_DEFAULT(G1HeapRegionSize)) {
@@ -118,6 +123,8 @@ void HeapRegion::hr_clear(bool keep_remset, bool clear_space, bool locked) {
          "we should have already filtered out humongous regions");
   assert(!in_collection_set(),
          "Should not clear heap region %u in the collection set", hrm_index());
+  assert(!has_pinned_objects(),
+         "Should not clear heap region %u with pinned objects", hrm_index());
 
   clear_young_index_in_cset();
   clear_index_in_opt_cset();
@@ -240,6 +247,7 @@ HeapRegion::HeapRegion(uint hrm_index,
     _type(),
     _humongous_start_region(NULL),
     _evacuation_failed(false),
+    _pinned_object_count(0),
     _next(NULL), _prev(NULL),
 #ifdef ASSERT
     _containing_set(NULL),
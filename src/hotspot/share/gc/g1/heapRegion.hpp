@@ -235,6 +235,10 @@ class HeapRegion: public G1ContiguousSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // Number of objects in the region currently pinned by JNI critical
+  // sections. The region is not evacuated or compacted while non-zero.
+  volatile size_t _pinned_object_count;
+
   // Fields used by the HeapRegionSetBase class and subclasses.
   HeapRegion* _next;
   HeapRegion* _prev;
@@ -377,6 +381,9 @@ class HeapRegion: public G1ContiguousSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The index of the NUMA node the memory of the region is allocated on.
+  uint node_index() const;
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -653,6 +660,13 @@ class HeapRegion: public G1ContiguousSpace {
     }
   }
 
+  // Pinning of objects in the region by JNI critical sections. These may be
+  // called concurrently by Java threads; the count only needs to be stable
+  // during a safepoint, when no thread can enter or leave a critical section.
+  inline void increment_pinned_object_count();
+  inline void decrement_pinned_object_count();
+  inline bool has_pinned_objects() const;
+
   // Iterate over the objects overlapping the given memory region, applying cl
   // to all references in the region.  This is a helper for
   // G1RemSet::refine_card*, and is tightly coupled with them.
@@ -256,6 +256,20 @@ inline bool HeapRegion::in_collection_set() const {
   return G1CollectedHeap::heap()->is_in_cset(this);
 }
 
+inline void HeapRegion::increment_pinned_object_count() {
+  assert(!is_free(), "Cannot pin an object in free region %u", hrm_index());
+  Atomic::inc(&_pinned_object_count);
+}
+
+inline void HeapRegion::decrement_pinned_object_count() {
+  size_t const result = Atomic::sub((size_t)1, &_pinned_object_count);
+  assert(result != SIZE_MAX, "Unbalanced unpin in region %u", hrm_index());
+}
+
+inline bool HeapRegion::has_pinned_objects() const {
+  return Atomic::load(&_pinned_object_count) > 0;
+}
+
 template <class Closure, bool is_gc_active>
 HeapWord* HeapRegion::do_oops_on_memregion_in_humongous(MemRegion mr,
                                                         Closure* cl,
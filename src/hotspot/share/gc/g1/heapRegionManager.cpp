@@ -26,11 +26,14 @@
 #include "gc/g1/g1Arguments.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
 #include "gc/g1/heterogeneousHeapRegionManager.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "utilities/bitMap.inline.hpp"
 
 class MasterFreeRegionListChecker : public HeapRegionSetChecker {
@@ -62,6 +65,9 @@ HeapRegionManager::HeapRegionManager() :
   _available_map(mtGC),
   _num_committed(0),
   _allocated_heapregions_length(0),
+  _inactive_map(mtGC),
+  _num_inactive(0),
+  _commit_lock(Mutex::leaf, "G1 HeapRegionManager commit lock", true, Mutex::_safepoint_check_never),
   _regions(), _heap_mapper(NULL),
   _prev_bitmap_mapper(NULL),
   _next_bitmap_mapper(NULL),
@@ -97,6 +103,7 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
   _regions.initialize(reserved.start(), reserved.end(), HeapRegion::GrainBytes);
 
   _available_map.initialize(_regions.length());
+  _inactive_map.initialize(_regions.length());
 }
 
 bool HeapRegionManager::is_available(uint region) const {
@@ -117,12 +124,53 @@ HeapRegion* HeapRegionManager::new_heap_region(uint hrm_index) {
   return g1h->new_heap_region(hrm_index, mr);
 }
 
+HeapRegion* HeapRegionManager::allocate_free_region(HeapRegionType type, uint requested_node_index) {
+  HeapRegion* hr = NULL;
+  bool from_head = !type.is_young();
+
+  if (requested_node_index != G1NUMA::AnyNodeIndex && G1NUMA::numa()->is_enabled()) {
+    // Try to allocate with requested node index.
+    hr = _free_list.remove_region_with_node_index(from_head, requested_node_index);
+  }
+
+  if (hr == NULL) {
+    // If there's a single active node or we did not get a region from our requested node,
+    // try without requested node index.
+    hr = _free_list.remove_region(from_head);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+  return hr;
+}
+
 void HeapRegionManager::commit_regions(uint index, size_t num_regions, WorkGang* pretouch_gang) {
   guarantee(num_regions > 0, "Must commit more than zero regions");
   guarantee(_num_committed + num_regions <= max_length(), "Cannot commit more than the maximum amount of regions");
 
   _num_committed += (uint)num_regions;
 
+  MutexLocker ml(&_commit_lock, Mutex::_no_safepoint_check_flag);
+  // Regions whose memory is still to be uncommitted just keep it.
+  uint end = index + (uint)num_regions;
+  uint cur = index;
+  while (cur < end) {
+    uint run_end;
+    if (_inactive_map.at(cur)) {
+      run_end = (uint)_inactive_map.get_next_zero_offset(cur, end);
+      reactivate_regions(cur, run_end - cur);
+    } else {
+      run_end = (uint)_inactive_map.get_next_one_offset(cur, end);
+      commit_memory(cur, run_end - cur, pretouch_gang);
+    }
+    cur = run_end;
+  }
+}
+
+void HeapRegionManager::commit_memory(uint index, size_t num_regions, WorkGang* pretouch_gang) {
+  assert_lock_strong(&_commit_lock);
   _heap_mapper->commit_regions(index, num_regions, pretouch_gang);
 
   // Also commit auxiliary data
@@ -135,6 +183,23 @@ void HeapRegionManager::commit_regions(uint index, size_t num_regions, WorkGang*
   _card_counts_mapper->commit_regions(index, num_regions, pretouch_gang);
 }
 
+void HeapRegionManager::reactivate_regions(uint index, size_t num_regions) {
+  assert_lock_strong(&_commit_lock);
+  _inactive_map.clear_range(index, index + num_regions);
+  Atomic::sub((uint)num_regions, &_num_inactive);
+
+  // The listeners clear the data of the regions, as for newly committed memory.
+  _heap_mapper->signal_mapping_changed(index, num_regions);
+
+  _prev_bitmap_mapper->signal_mapping_changed(index, num_regions);
+  _next_bitmap_mapper->signal_mapping_changed(index, num_regions);
+
+  _bot_mapper->signal_mapping_changed(index, num_regions);
+  _cardtable_mapper->signal_mapping_changed(index, num_regions);
+
+  _card_counts_mapper->signal_mapping_changed(index, num_regions);
+}
+
 void HeapRegionManager::uncommit_regions(uint start, size_t num_regions) {
   guarantee(num_regions >= 1, "Need to specify at least one region to uncommit, tried to uncommit zero regions at %u", start);
   guarantee(_num_committed >= num_regions, "pre-condition");
@@ -150,6 +215,18 @@ void HeapRegionManager::uncommit_regions(uint start, size_t num_regions) {
   _num_committed -= (uint)num_regions;
 
   _available_map.par_clear_range(start, start + num_regions, BitMap::unknown_range);
+
+  MutexLocker ml(&_commit_lock, Mutex::_no_safepoint_check_flag);
+  if (G1ConcurrentUncommit) {
+    _inactive_map.set_range(start, start + num_regions);
+    Atomic::add((uint)num_regions, &_num_inactive);
+  } else {
+    uncommit_memory(start, num_regions);
+  }
+}
+
+void HeapRegionManager::uncommit_memory(uint start, size_t num_regions) {
+  assert_lock_strong(&_commit_lock);
   _heap_mapper->uncommit_regions(start, num_regions);
 
   // Also uncommit auxiliary data
@@ -162,6 +239,27 @@ void HeapRegionManager::uncommit_regions(uint start, size_t num_regions) {
   _card_counts_mapper->uncommit_regions(start, num_regions);
 }
 
+uint HeapRegionManager::uncommit_inactive_regions(uint limit) {
+  MutexLocker ml(&_commit_lock, Mutex::_no_safepoint_check_flag);
+  if (_num_inactive == 0) {
+    return 0;
+  }
+  // Find the highest run of inactive regions, and uncommit its top limit regions.
+  uint end = max_length();
+  while (end > 0 && !_inactive_map.at(end - 1)) {
+    end--;
+  }
+  uint start = end;
+  while (start > 0 && _inactive_map.at(start - 1) && end - start < limit) {
+    start--;
+  }
+  assert(start < end, "must have found inactive regions");
+  _inactive_map.clear_range(start, end);
+  Atomic::sub(end - start, &_num_inactive);
+  uncommit_memory(start, end - start);
+  return end - start;
+}
+
 void HeapRegionManager::make_regions_available(uint start, uint num_regions, WorkGang* pretouch_gang) {
   guarantee(num_regions > 0, "No point in calling this for zero regions");
   commit_regions(start, num_regions, pretouch_gang);
@@ -28,6 +28,8 @@
 #include "gc/g1/g1BiasedArray.hpp"
 #include "gc/g1/g1RegionToSpaceMapper.hpp"
 #include "gc/g1/heapRegionSet.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutex.hpp"
 #include "services/memoryUsage.hpp"
 
 class HeapRegion;
@@ -66,6 +68,12 @@ class G1HeapRegionTable : public G1BiasedMappedArray<HeapRegion*> {
 //   number of regions+1 for which we have HeapRegions.
 // * max_length() returns the maximum number of regions the heap can have.
 //
+// With G1ConcurrentUncommit, regions removed from the heap at a safepoint are
+// only made unavailable there; the G1UncommitRegionThread uncommits their
+// memory later in small batches. Committing and uncommitting memory is
+// serialized by the _commit_lock, and committing a region whose memory is
+// still to be uncommitted reuses that memory instead.
+//
 
 class HeapRegionManager: public CHeapObj<mtGC> {
   friend class VMStructs;
@@ -85,6 +93,12 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // Internal only. The highest heap region +1 we allocated a HeapRegion instance for.
   uint _allocated_heapregions_length;
 
+  // Each bit in this bitmap indicates that the corresponding region is not
+  // available any more but its memory has not been uncommitted yet.
+  CHeapBitMap _inactive_map;
+  volatile uint _num_inactive;
+  Mutex _commit_lock;
+
   HeapWord* heap_bottom() const { return _regions.bottom_address_mapped(); }
   HeapWord* heap_end() const {return _regions.end_address_mapped(); }
 
@@ -94,6 +108,13 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // Notify other data structures about change in the heap layout.
   void update_committed_space(HeapWord* old_end, HeapWord* new_end);
 
+  // Pass down uncommit calls to the VirtualSpace. Requires the _commit_lock.
+  void uncommit_memory(uint index, size_t num_regions);
+  // Pass down commit calls to the VirtualSpace. Requires the _commit_lock.
+  void commit_memory(uint index, size_t num_regions, WorkGang* pretouch_gang);
+  // Make inactive regions usable again, keeping their committed memory.
+  void reactivate_regions(uint index, size_t num_regions);
+
   // Find a contiguous set of empty or uncommitted regions of length num and return
   // the index of the first region or G1_NO_HRM_INDEX if the search was unsuccessful.
   // If only_empty is true, only empty regions are considered.
@@ -174,15 +195,9 @@ public:
     _free_list.add_ordered(list);
   }
 
-  virtual HeapRegion* allocate_free_region(HeapRegionType type) {
-    HeapRegion* hr = _free_list.remove_region(!type.is_young());
-
-    if (hr != NULL) {
-      assert(hr->next() == NULL, "Single region should not have next");
-      assert(is_available(hr->hrm_index()), "Must be committed");
-    }
-    return hr;
-  }
+  // Allocate a free region of the given type, preferably on the NUMA node
+  // with the given index unless that is G1NUMA::AnyNodeIndex.
+  virtual HeapRegion* allocate_free_region(HeapRegionType type, uint requested_node_index);
 
   inline void allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -260,6 +275,13 @@ public:
   // empty, and free.
   void shrink_at(uint index, size_t num_regions);
 
+  // Whether regions removed from the heap still hold committed memory.
+  bool has_inactive_regions() const { return Atomic::load(&_num_inactive) > 0; }
+
+  // Uncommit the memory of up to limit inactive regions, the highest first.
+  // Called concurrently. Returns the number of regions uncommitted.
+  uint uncommit_inactive_regions(uint limit);
+
   virtual void verify();
 
   // Do some sanity checking.
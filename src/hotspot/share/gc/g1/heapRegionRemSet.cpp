@@ -33,6 +33,7 @@
 #include "memory/padded.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -42,6 +43,47 @@
 const char* HeapRegionRemSet::_state_strings[] =  {"Untracked", "Updating", "Complete"};
 const char* HeapRegionRemSet::_short_state_strings[] =  {"UNTRA", "UPDAT", "CMPLT"};
 
+uint PerRegionTable::_card_array_capacity = 0;
+
+// The array takes at most a quarter of the space of the bitmap.
+void PerRegionTable::setup_card_array_capacity() {
+  size_t capacity = BitMap::calc_size_in_bytes(HeapRegion::CardsPerRegion) / 4 / sizeof(CardIdx_t);
+  _card_array_capacity = (uint)MIN2(capacity, (size_t)G1RSetFineArrayEntriesMax);
+}
+
+PerRegionTable::PerRegionTable(HeapRegion* hr) :
+  _hr(hr),
+  _cards(NEW_C_HEAP_ARRAY(CardIdx_t, _card_array_capacity, mtGC)),
+  _num_cards(0),
+  _bm_words(NULL),
+  _occupied(0),
+  _next(NULL), _prev(NULL),
+  _collision_list_next(NULL)
+{
+  for (uint i = 0; i < _card_array_capacity; i++) {
+    _cards[i] = NoCard;
+  }
+}
+
+void PerRegionTable::install_bitmap() {
+  size_t words = bitmap_size_in_words();
+  BitMap::bm_word_t* map = NEW_C_HEAP_ARRAY(BitMap::bm_word_t, words, mtGC);
+  memset(map, 0, words * sizeof(BitMap::bm_word_t));
+  if (Atomic::cmpxchg(map, &_bm_words, (BitMap::bm_word_t*)NULL) != NULL) {
+    FREE_C_HEAP_ARRAY(BitMap::bm_word_t, map);
+  }
+}
+
+void PerRegionTable::release_free_bitmaps() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  for (PerRegionTable* cur = _free_list; cur != NULL; cur = cur->next()) {
+    if (cur->_bm_words != NULL) {
+      FREE_C_HEAP_ARRAY(BitMap::bm_word_t, cur->_bm_words);
+      cur->_bm_words = NULL;
+    }
+  }
+}
+
 PerRegionTable* PerRegionTable::alloc(HeapRegion* hr) {
   PerRegionTable* fl = _free_list;
   while (fl != NULL) {
@@ -361,11 +403,9 @@ size_t OtherRegionsTable::occ_sparse() const {
 
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
-  // all PRTs are of the same size so it is sufficient to query only one of them.
-  if (_first_all_fine_prts != NULL) {
-    assert(_last_all_fine_prts != NULL &&
-      _first_all_fine_prts->mem_size() == _last_all_fine_prts->mem_size(), "check that mem_size() is constant");
-    sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
+  // PRTs differ in size by whether they have a bitmap.
+  for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+    sum += cur->mem_size();
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
   sum += (_coarse_map.size_in_words() * HeapWordSize);
@@ -451,6 +491,7 @@ void HeapRegionRemSet::setup_remset_size() {
     G1RSetRegionEntries = G1RSetRegionEntriesBase * (region_size_log_mb + 1);
   }
   guarantee(G1RSetSparseRegionEntries > 0 && G1RSetRegionEntries > 0 , "Sanity");
+  PerRegionTable::setup_card_array_capacity();
 }
 
 void HeapRegionRemSet::clear(bool only_cardset) {
@@ -66,6 +66,15 @@ class nmethod;
 //      is represented.  If a deleted PRT is re-used, a thread adding a bit,
 //      thinking the PRT is for a different region, does no harm.
 
+// A PRT keeps its cards in one of two containers, chosen by how many cards
+// it holds: an array of card indices, sized to take a fraction of the
+// space of a bitmap, and once the array overflows, a bitmap with one bit
+// per card of the region, allocated then.  Cards are inserted into both
+// without locking.  Cards added to the array before it overflowed stay
+// there, so the set of cards is the union of both containers.  The sparse
+// table and the coarse map remain the containers for the fewest and the
+// most cards respectively.
+
 class OtherRegionsTable {
   G1CollectedHeap* _g1h;
   Mutex*           _m;
@@ -161,9 +170,22 @@ public:
 class PerRegionTable: public CHeapObj<mtGC> {
   friend class OtherRegionsTable;
 
+  // Marks the array slots that were claimed but not written yet.
+  static const CardIdx_t NoCard = -1;
+
+  // Number of cards the array container holds.
+  static uint _card_array_capacity;
+
   HeapRegion*     _hr;
-  CHeapBitMap     _bm;
-  jint            _occupied;
+
+  // The array container.  Slots are claimed by incrementing _num_cards,
+  // which goes past the capacity when the array overflows.
+  CardIdx_t*      _cards;
+  volatile uint   _num_cards;
+
+  // The bitmap container, NULL until the array overflows.
+  BitMap::bm_word_t* volatile _bm_words;
+  jint            _occupied;      // cards in the bitmap
 
   // next pointer for free/allocated 'all' list
   PerRegionTable* _next;
@@ -178,30 +200,38 @@ class PerRegionTable: public CHeapObj<mtGC> {
   static PerRegionTable* volatile _free_list;
 
 protected:
-  PerRegionTable(HeapRegion* hr) :
-    _hr(hr),
-    _bm(HeapRegion::CardsPerRegion, mtGC),
-    _occupied(0),
-    _next(NULL), _prev(NULL),
-    _collision_list_next(NULL)
-  {}
+  PerRegionTable(HeapRegion* hr);
+
+  uint num_array_cards() const { return MIN2(_num_cards, _card_array_capacity); }
+  bool array_contains(CardIdx_t card) const;
+
+  BitMapView bitmap() const {
+    return BitMapView(OrderAccess::load_acquire(&_bm_words), HeapRegion::CardsPerRegion);
+  }
+  static size_t bitmap_size_in_words() { return BitMap::calc_size_in_words(HeapRegion::CardsPerRegion); }
+  // Allocates the bitmap unless another thread did.
+  void install_bitmap();
 
   inline void add_card_work(CardIdx_t from_card, bool par);
 
   inline void add_reference_work(OopOrNarrowOopStar from, bool par);
 
 public:
-  // We need access in order to union things into the base table.
-  BitMap* bm() { return &_bm; }
+  // Sizes the array container after the bitmap.
+  static void setup_card_array_capacity();
 
   HeapRegion* hr() const { return OrderAccess::load_acquire(&_hr); }
 
+  // Cards added to both containers concurrently may be counted twice.
   jint occupied() const {
-    // Overkill, but if we ever need it...
-    // guarantee(_occupied == _bm.count_one_bits(), "Check");
-    return _occupied;
+    return (jint)num_array_cards() + _occupied;
   }
 
+  // Applies cl.do_card(card_index) to all cards, at a safepoint.  A card
+  // may be visited twice.
+  template <class CardClosure>
+  inline void iterate_cards(CardClosure& cl) const;
+
   void init(HeapRegion* hr, bool clear_links_to_all_list);
 
   inline void add_reference(OopOrNarrowOopStar from);
@@ -212,23 +242,25 @@ public:
 
   void seq_add_card(CardIdx_t from_card_index);
 
-  // (Destructively) union the bitmap of the current table into the given
-  // bitmap (which is assumed to be of the same size.)
-  void union_bitmap_into(BitMap* bm) {
-    bm->set_union(_bm);
-  }
-
   // Mem size in bytes.
   size_t mem_size() const {
-    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize;
+    size_t size = sizeof(PerRegionTable) + _card_array_capacity * sizeof(CardIdx_t);
+    if (_bm_words != NULL) {
+      size += bitmap_size_in_words() * HeapWordSize;
+    }
+    return size;
   }
 
   // Requires "from" to be in "hr()".
   bool contains_reference(OopOrNarrowOopStar from) const {
     assert(hr()->is_in_reserved(from), "Precondition.");
-    size_t card_ind = pointer_delta(from, hr()->bottom(),
-                                    G1CardTable::card_size);
-    return _bm.at(card_ind);
+    CardIdx_t card_ind = (CardIdx_t)pointer_delta(from, hr()->bottom(),
+                                                  G1CardTable::card_size);
+    if (array_contains(card_ind)) {
+      return true;
+    }
+    BitMapView bm = bitmap();
+    return bm.map() != NULL && bm.at(card_ind);
   }
 
   // Bulk-free the PRTs from prt to last, assumes that they are
@@ -287,6 +319,10 @@ public:
     return res;
   }
 
+  // Frees the bitmaps of the PRTs in the free list, at a safepoint where
+  // no thread is adding cards.
+  static void release_free_bitmaps();
+
   static void test_fl_mem_size();
 };
 
@@ -432,6 +468,11 @@ public:
     return OtherRegionsTable::fl_mem_size();
   }
 
+  // Returns the memory of the bitmap containers of unused PRTs.
+  static void release_free_bitmaps() {
+    PerRegionTable::release_free_bitmaps();
+  }
+
   bool contains_reference(OopOrNarrowOopStar from) const {
     return _other_regions.contains_reference(from);
   }
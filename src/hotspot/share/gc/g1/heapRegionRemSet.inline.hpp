@@ -35,19 +35,59 @@ inline void HeapRegionRemSet::iterate_prts(Closure& cl) {
   _other_regions.iterate(cl);
 }
 
+inline bool PerRegionTable::array_contains(CardIdx_t card) const {
+  uint n = num_array_cards();
+  for (uint i = 0; i < n; i++) {
+    if (Atomic::load(&_cards[i]) == card) {
+      return true;
+    }
+  }
+  return false;
+}
+
 inline void PerRegionTable::add_card_work(CardIdx_t from_card, bool par) {
-  if (!_bm.at(from_card)) {
+  if (_bm_words == NULL) {
+    if (array_contains(from_card)) {
+      return;
+    }
+    uint slot = par ? Atomic::add(1u, &_num_cards) - 1 : _num_cards++;
+    if (slot < _card_array_capacity) {
+      Atomic::store(from_card, &_cards[slot]);
+      return;
+    }
+    // The array overflowed: this and all later cards go to the bitmap.
+    install_bitmap();
+  }
+  BitMapView bm = bitmap();
+  if (!bm.at(from_card)) {
     if (par) {
-      if (_bm.par_set_bit(from_card)) {
+      if (bm.par_set_bit(from_card)) {
         Atomic::inc(&_occupied);
       }
     } else {
-      _bm.set_bit(from_card);
+      bm.set_bit(from_card);
       _occupied++;
     }
   }
 }
 
+template <class CardClosure>
+inline void PerRegionTable::iterate_cards(CardClosure& cl) const {
+  uint n = num_array_cards();
+  for (uint i = 0; i < n; i++) {
+    assert(_cards[i] != NoCard, "all claimed slots are written at a safepoint");
+    cl.do_card((uint)_cards[i]);
+  }
+  BitMapView bm = bitmap();
+  if (bm.map() != NULL) {
+    BitMap::idx_t cur = bm.get_next_one_offset(0);
+    while (cur != bm.size()) {
+      cl.do_card((uint)cur);
+      cur = bm.get_next_one_offset(cur + 1);
+    }
+  }
+}
+
 inline void PerRegionTable::add_reference_work(OopOrNarrowOopStar from, bool par) {
   // Must make this robust in case "from" is not in "_hr", because of
   // concurrency.
@@ -85,8 +125,17 @@ inline void PerRegionTable::init(HeapRegion* hr, bool clear_links_to_all_list) {
   }
   _collision_list_next = NULL;
   _occupied = 0;
-  _bm.clear();
-  // Make sure that the bitmap clearing above has been finished before publishing
+  for (uint i = 0; i < _card_array_capacity; i++) {
+    _cards[i] = NoCard;
+  }
+  _num_cards = 0;
+  // A bitmap kept from the previous use may still be written by threads
+  // adding to the PRT it was, so it is only cleared.
+  BitMapView bm = bitmap();
+  if (bm.map() != NULL) {
+    bm.clear();
+  }
+  // Make sure that the clearing above has been finished before publishing
   // this PRT to concurrent threads.
   OrderAccess::release_store(&_hr, hr);
 }
@@ -103,7 +152,7 @@ void OtherRegionsTable::iterate(Closure& cl) {
   {
     PerRegionTable* cur = _first_all_fine_prts;
     while (cur != NULL) {
-      cl.next_fine_prt(cur->hr()->hrm_index(), cur->bm());
+      cl.next_fine_prt(cur->hr()->hrm_index(), cur);
       cur = cur->next();
     }
   }
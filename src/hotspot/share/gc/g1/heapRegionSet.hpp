@@ -181,6 +181,11 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region on the requested NUMA node found within the
+  // G1NUMA::max_search_depth() regions nearest to the head or tail, or
+  // returns NULL if there is none.
+  HeapRegion* remove_region_with_node_index(bool from_head, uint requested_node_index);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -250,7 +250,7 @@ bool PSMarkSweep::invoke_no_policy(bool clear_all_softrefs) {
     }
 
     // Delete metaspaces for unloaded class loaders and clean up loader_data graph
-    ClassLoaderDataGraph::purge();
+    ClassLoaderDataGraph::purge_or_defer(heap->gc_cause());
     MetaspaceUtils::verify_metrics();
 
     BiasedLocking::restore_marks();
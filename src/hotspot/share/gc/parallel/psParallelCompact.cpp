@@ -860,7 +860,8 @@ public:
       true,                // mt discovery
       ParallelGCThreads,   // mt discovery degree
       true,                // atomic_discovery
-      is_alive_non_header) {
+      is_alive_non_header,
+      true) {              // allow changes to number of processing threads
   }
 
   template<typename T> bool discover(oop obj, ReferenceType type) {
@@ -952,17 +953,14 @@ void
 PSParallelCompact::clear_data_covering_space(SpaceId id)
 {
   // At this point, top is the value before GC, new_top() is the value that will
-  // be set at the end of GC.  The marking bitmap is cleared to top; nothing
-  // should be marked above top.  The summary data is cleared to the larger of
+  // be set at the end of GC.  The summary data is cleared to the larger of
   // top & new_top.
   MutableSpace* const space = _space_info[id].space();
   HeapWord* const bot = space->bottom();
   HeapWord* const top = space->top();
   HeapWord* const max_top = MAX2(top, _space_info[id].new_top());
 
-  const idx_t beg_bit = _mark_bitmap.addr_to_bit(bot);
-  const idx_t end_bit = BitMap::word_align_up(_mark_bitmap.addr_to_bit(top));
-  _mark_bitmap.clear_range(beg_bit, end_bit);
+  // The marking bitmap is cleared in parallel, see ClearMarkBitmapTask.
 
   const size_t beg_region = _summary_data.addr_to_region_idx(bot);
   const size_t end_region =
@@ -977,6 +975,51 @@ PSParallelCompact::clear_data_covering_space(SpaceId id)
   DEBUG_ONLY(split_info.verify_clear();)
 }
 
+// Clears the marking bitmap covering all spaces. The bitmap is cleared to
+// top, the value before GC; nothing should be marked above top. The bitmap
+// is 1/32 of the heap, so clearing it serially dominates post compact on
+// large heaps. Workers claim word aligned chunks of each space's range.
+class ClearMarkBitmapTask : public AbstractGangTask {
+private:
+  typedef ParMarkBitMap::idx_t idx_t;
+
+  static const idx_t chunk_bits = (idx_t)1 << 24; // 2M per bitmap
+
+  idx_t          _beg_bit[PSParallelCompact::last_space_id];
+  idx_t          _end_bit[PSParallelCompact::last_space_id];
+  volatile idx_t _claimed[PSParallelCompact::last_space_id];
+
+public:
+  ClearMarkBitmapTask() :
+      AbstractGangTask("ClearMarkBitmapTask") {
+    ParMarkBitMap* const bitmap = PSParallelCompact::mark_bitmap();
+    for (unsigned int id = PSParallelCompact::old_space_id; id < PSParallelCompact::last_space_id; ++id) {
+      const MutableSpace* const space = PSParallelCompact::space(PSParallelCompact::SpaceId(id));
+      _beg_bit[id] = bitmap->addr_to_bit(space->bottom());
+      _end_bit[id] = BitMap::word_align_up(bitmap->addr_to_bit(space->top()));
+      _claimed[id] = 0;
+    }
+  }
+
+  virtual void work(uint worker_id) {
+    ParMarkBitMap* const bitmap = PSParallelCompact::mark_bitmap();
+    for (unsigned int id = PSParallelCompact::old_space_id; id < PSParallelCompact::last_space_id; ++id) {
+      const idx_t beg_bit = _beg_bit[id];
+      const idx_t end_bit = _end_bit[id];
+      const idx_t base_bit = align_down(beg_bit, chunk_bits);
+      for (;;) {
+        const idx_t chunk = Atomic::add((idx_t)1, &_claimed[id]) - 1;
+        const idx_t chunk_beg = MAX2(base_bit + chunk * chunk_bits, beg_bit);
+        if (chunk_beg >= end_bit) {
+          break;
+        }
+        const idx_t chunk_end = MIN2(base_bit + (chunk + 1) * chunk_bits, end_bit);
+        bitmap->clear_range(chunk_beg, chunk_end);
+      }
+    }
+  }
+};
+
 void PSParallelCompact::pre_compact()
 {
   // Update the from & to space pointers in space_info, since they are swapped
@@ -1024,8 +1067,14 @@ void PSParallelCompact::post_compact()
 {
   GCTraceTime(Info, gc, phases) tm("Post Compact", &_gc_timer);
 
+  {
+    GCTraceTime(Debug, gc, phases) tm("Clear Mark Bitmap", &_gc_timer);
+    ClearMarkBitmapTask task;
+    ParallelScavengeHeap::heap()->workers().run_task(&task);
+  }
+
   for (unsigned int id = old_space_id; id < last_space_id; ++id) {
-    // Clear the marking bitmap, summary data and split info.
+    // Clear the summary data and split info.
     clear_data_covering_space(SpaceId(id));
     // Update top().  Must be done after clearing the bitmap and summary data.
     _space_info[id].publish_new_top();
@@ -1058,7 +1107,7 @@ void PSParallelCompact::post_compact()
   }
 
   // Delete metaspaces for unloaded class loaders and clean up loader_data graph
-  ClassLoaderDataGraph::purge();
+  ClassLoaderDataGraph::purge_or_defer(heap->gc_cause());
   MetaspaceUtils::verify_metrics();
 
   heap->prune_scavengable_nmethods();
@@ -2232,12 +2281,12 @@ public:
 
 class RefProcTaskExecutor: public AbstractRefProcTaskExecutor {
   void execute(ProcessTask& process_task, uint ergo_workers) {
-    assert(ParallelScavengeHeap::heap()->workers().active_workers() == ergo_workers,
-           "Ergonomically chosen workers (%u) must be equal to active workers (%u)",
+    assert(ParallelScavengeHeap::heap()->workers().active_workers() >= ergo_workers,
+           "Ergonomically chosen workers (%u) should be less than or equal to active workers (%u)",
            ergo_workers, ParallelScavengeHeap::heap()->workers().active_workers());
 
     PCRefProcTask task(process_task, ergo_workers);
-    ParallelScavengeHeap::heap()->workers().run_task(&task);
+    ParallelScavengeHeap::heap()->workers().run_task(&task, ergo_workers);
   }
 };
 
@@ -246,8 +246,11 @@ public:
 };
 
 void PSRefProcTaskExecutor::execute(ProcessTask& process_task, uint ergo_workers) {
+  assert(ParallelScavengeHeap::heap()->workers().active_workers() >= ergo_workers,
+         "Ergonomically chosen workers (%u) should be less than or equal to active workers (%u)",
+         ergo_workers, ParallelScavengeHeap::heap()->workers().active_workers());
   PSRefProcTask task(process_task, ergo_workers);
-  ParallelScavengeHeap::heap()->workers().run_task(&task);
+  ParallelScavengeHeap::heap()->workers().run_task(&task, ergo_workers);
 }
 
 // This method contains all heap specific policy for invoking scavenge.
@@ -851,7 +854,7 @@ void PSScavenge::initialize() {
                            ParallelGCThreads,          // mt discovery degree
                            true,                       // atomic_discovery
                            NULL,                       // header provides liveness info
-                           false);
+                           true);                      // allow changes to number of processing threads
 
   // Cache the cardtable
   _card_table = heap->card_table();
@@ -25,10 +25,13 @@
 #include "precompiled.hpp"
 #include "gc/shared/allocTracer.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/handles.hpp"
+#include "runtime/thread.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_JFR
+#include "jfr/recorder/jfrEventSetting.inline.hpp"
 #include "jfr/support/jfrAllocationTracer.hpp"
 #endif
 
@@ -53,6 +56,37 @@ void AllocTracer::send_allocation_in_new_tlab(Klass* klass, HeapWord* obj, size_
   }
 }
 
+// Emits at most one sample per FlightRecorderAllocationSampleInterval bytes
+// allocated by the thread. The weight carries the bytes allocated since the
+// previous sample so that consumers can scale samples back to totals.
+void AllocTracer::send_allocation_sample(Klass* klass, HeapWord* obj, size_t alloc_size, Thread* thread) {
+#if INCLUDE_JFR
+  EventObjectAllocationSample event;
+  if (!event.should_commit()) {
+    return;
+  }
+  JfrThreadLocal* const tl = thread->jfr_thread_local();
+  const jlong allocated_bytes = thread->cooked_allocated_bytes();
+  const u4 generation = JfrEventSetting::enabled_generation(EventObjectAllocationSample::eventId);
+  if (tl->allocation_sample_generation() != generation) {
+    // First slow-path allocation since the event was enabled: start
+    // counting here, rather than weighing the first sample with
+    // everything the thread allocated before the recording.
+    tl->set_allocation_sample_generation(generation);
+    tl->set_last_allocation_sample_bytes(allocated_bytes - alloc_size);
+  }
+  const jlong weight = allocated_bytes - tl->last_allocation_sample_bytes();
+  if (weight < (jlong)FlightRecorderAllocationSampleInterval) {
+    return;
+  }
+  tl->set_last_allocation_sample_bytes(allocated_bytes);
+  JfrAllocationTracer tracer(obj, alloc_size, thread);
+  event.set_objectClass(klass);
+  event.set_weight((u8)weight);
+  event.commit();
+#endif
+}
+
 void AllocTracer::send_allocation_requiring_gc_event(size_t size, uint gcId) {
   EventAllocationRequiringGC event;
   if (event.should_commit()) {
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/moduleEntry.hpp"
+#include "gc/shared/allocationProfile.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/klass.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/safepoint.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+
+// Marks a slot whose class was unloaded. Such slots are skipped by lookups
+// and not handed out again until the table is rebuilt at a safepoint, so a
+// class later loaded at the same address does not inherit the old totals.
+static Klass* const retired_klass = (Klass*)(uintptr_t)1;
+
+AllocationProfile::Entry AllocationProfile::_table[AllocationProfile::table_size];
+volatile size_t AllocationProfile::_dropped_bytes = 0;
+
+size_t AllocationProfile::index_for(const Klass* klass) {
+  uintptr_t hash = (uintptr_t)klass >> LogBytesPerWord;
+  hash ^= hash >> 16;
+  return hash & (table_size - 1);
+}
+
+void AllocationProfile::record(Klass* klass, size_t bytes) {
+  size_t index = index_for(klass);
+  for (uint i = 0; i < max_probes; i++, index = (index + 1) & (table_size - 1)) {
+    Entry* e = &_table[index];
+    Klass* k = Atomic::load(&e->_klass);
+    if (k == NULL) {
+      k = Atomic::cmpxchg(klass, &e->_klass, (Klass*)NULL);
+      if (k == NULL) {
+        k = klass;
+      }
+    }
+    if (k == klass) {
+      Atomic::add(bytes, &e->_bytes);
+      Atomic::add((size_t)1, &e->_samples);
+      return;
+    }
+  }
+  Atomic::add(bytes, &_dropped_bytes);
+}
+
+void AllocationProfile::do_unloading() {
+  assert_locked_or_safepoint(ClassLoaderDataGraph_lock);
+  for (size_t i = 0; i < table_size; i++) {
+    Entry* e = &_table[i];
+    Klass* k = Atomic::load(&e->_klass);
+    if (k != NULL && k != retired_klass && k->class_loader_data()->is_unloading()) {
+      Atomic::store(retired_klass, &e->_klass);
+    }
+  }
+  // Outside of a safepoint, allocating threads may be probing the table, so
+  // the retired slots can only be reclaimed by a later safepoint unloading.
+  if (SafepointSynchronize::is_at_safepoint()) {
+    rebuild();
+  }
+}
+
+void AllocationProfile::rebuild() {
+  assert_at_safepoint();
+  ResourceMark rm;
+  GrowableArray<Entry> live(64);
+  bool has_retired = false;
+  for (size_t i = 0; i < table_size; i++) {
+    Entry* e = &_table[i];
+    if (e->_klass == retired_klass) {
+      has_retired = true;
+    } else if (e->_klass != NULL) {
+      live.append(*e);
+    }
+  }
+  if (!has_retired) {
+    return;
+  }
+
+  memset(_table, 0, sizeof(_table));
+  for (int i = 0; i < live.length(); i++) {
+    const Entry& e = live.at(i);
+    size_t index = index_for(e._klass);
+    while (_table[index]._klass != NULL) {
+      index = (index + 1) & (table_size - 1);
+    }
+    _table[index] = e;
+  }
+}
+
+int AllocationProfile::compare_by_bytes(Entry* e1, Entry* e2) {
+  if (e1->_bytes > e2->_bytes) {
+    return -1;
+  } else if (e1->_bytes < e2->_bytes) {
+    return 1;
+  }
+  return 0;
+}
+
+void AllocationProfile::print_on(outputStream* st, size_t max_classes) {
+  ResourceMark rm;
+  // Holding the lock keeps the classes from being unloaded while printing.
+  MutexLocker ml(ClassLoaderDataGraph_lock);
+
+  GrowableArray<Entry> entries(64);
+  size_t total_bytes = 0;
+  size_t total_samples = 0;
+  for (size_t i = 0; i < table_size; i++) {
+    Entry e;
+    e._klass = Atomic::load(&_table[i]._klass);
+    if (e._klass == NULL || e._klass == retired_klass) {
+      continue;
+    }
+    e._bytes = Atomic::load(&_table[i]._bytes);
+    e._samples = Atomic::load(&_table[i]._samples);
+    total_bytes += e._bytes;
+    total_samples += e._samples;
+    entries.append(e);
+  }
+  entries.sort(compare_by_bytes);
+
+  st->print_cr(" num      #samples  #sampled bytes  class name (module)");
+  st->print_cr("-------------------------------------------------------");
+  for (int i = 0; i < entries.length() && (size_t)i < max_classes; i++) {
+    Entry& e = entries.at(i);
+    st->print("%4d: " SIZE_FORMAT_W(12) " " SIZE_FORMAT_W(15) "  %s",
+              i + 1, e._samples, e._bytes, e._klass->external_name());
+    ModuleEntry* module = e._klass->module();
+    if (module->is_named()) {
+      st->print(" (%s", module->name()->as_C_string());
+      if (module->version() != NULL) {
+        st->print("@%s", module->version()->as_C_string());
+      }
+      st->print(")");
+    }
+    st->cr();
+  }
+  st->print_cr("Total " SIZE_FORMAT_W(12) " " SIZE_FORMAT_W(15), total_samples, total_bytes);
+  size_t dropped = Atomic::load(&_dropped_bytes);
+  if (dropped > 0) {
+    st->print_cr("Bytes not attributed (table full): " SIZE_FORMAT, dropped);
+  }
+}
+
+void AllocationProfile::send_events() {
+  MutexLocker ml(ClassLoaderDataGraph_lock);
+  for (size_t i = 0; i < table_size; i++) {
+    Klass* k = Atomic::load(&_table[i]._klass);
+    if (k == NULL || k == retired_klass) {
+      continue;
+    }
+    EventObjectAllocationProfile event;
+    event.set_objectClass(k);
+    event.set_samples(Atomic::load(&_table[i]._samples));
+    event.set_weight(Atomic::load(&_table[i]._bytes));
+    event.commit();
+  }
+}
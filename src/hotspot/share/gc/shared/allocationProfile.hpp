@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_ALLOCATIONPROFILE_HPP
+#define SHARE_GC_SHARED_ALLOCATIONPROFILE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class Klass;
+class outputStream;
+
+// Per-class allocation totals sampled on the allocation slow path. Each
+// TLAB refill charges the whole new TLAB to the class of the object that
+// caused it, and each allocation outside a TLAB charges its own size, the
+// same weighting the JFR allocation events use. Over many refills the
+// sampled bytes approach the real distribution of allocated bytes.
+//
+// Entries are inserted lock-free into a fixed-size open-addressed table.
+// Entries of unloaded classes are retired, and class unloading at a
+// safepoint rebuilds the table to reclaim their slots. Allocations that
+// find no free slot are only counted in the dropped total.
+class AllocationProfile : AllStatic {
+  class Entry {
+   public:
+    Klass* volatile _klass;
+    volatile size_t _bytes;
+    volatile size_t _samples;
+  };
+
+  static const size_t table_size = 4096;
+  static const uint   max_probes = 32;
+
+  static Entry           _table[table_size];
+  static volatile size_t _dropped_bytes;
+
+  static size_t index_for(const Klass* klass);
+  static int compare_by_bytes(Entry* e1, Entry* e2);
+
+  // Reinsert the live entries, dropping the retired ones. Requires a
+  // safepoint, so no allocating thread is probing the table.
+  static void rebuild();
+
+ public:
+  // Called by allocating threads when the slow path refills a TLAB or
+  // allocates outside of one.
+  static void record(Klass* klass, size_t bytes);
+
+  // Retire entries for classes whose loader is being unloaded, and reclaim
+  // the retired slots when called at a safepoint.
+  static void do_unloading();
+
+  static void print_on(outputStream* st, size_t max_classes);
+  static void send_events();
+};
+
+#endif // SHARE_GC_SHARED_ALLOCATIONPROFILE_HPP
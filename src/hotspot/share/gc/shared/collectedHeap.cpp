@@ -66,12 +66,14 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
   }
 
   double timestamp = fetch_timestamp();
-  MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
-  int index = compute_log_index();
-  _records[index].thread = NULL; // Its the GC thread so it's not that interesting.
-  _records[index].timestamp = timestamp;
-  _records[index].data.is_before = before;
-  stringStream st(_records[index].data.buffer(), _records[index].data.size());
+  size_t seq;
+  if (!claim_record(&seq)) {
+    return;
+  }
+  record_at(seq).thread = NULL; // Its the GC thread so it's not that interesting.
+  record_at(seq).timestamp = timestamp;
+  record_at(seq).data.is_before = before;
+  stringStream st(record_at(seq).data.buffer(), record_at(seq).data.size());
 
   st.print_cr("{Heap %s GC invocations=%u (full %u):",
                  before ? "before" : "after",
@@ -80,6 +82,7 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
 
   heap->print_on(&st);
   st.print_cr("}");
+  commit_record(seq);
 }
 
 size_t CollectedHeap::unused() const {
@@ -68,6 +68,15 @@ class GCMessage : public FormatBuffer<1024> {
 
 class CollectedHeap;
 
+// Iterates over the heap objects in parallel. Each worker calls
+// object_iterate() with its own worker id; the iterator distributes
+// the heap between them.
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+ public:
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+  virtual ~ParallelObjectIterator() {}
+};
+
 class GCHeapLog : public EventLogBase<GCMessage> {
  private:
   void log_heap(CollectedHeap* heap, bool before);
@@ -402,6 +411,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns an iterator for use by thread_num workers iterating over all
+  // objects in parallel at a safepoint, or NULL if the collector does
+  // not support it. The caller deletes the iterator.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
   // NOTE! There is no requirement that a collector implement these
   // functions.
   //
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/gcPhaseCounters.hpp"
+#include "gc/shared/gcTimer.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
+#include "runtime/perfData.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/ticks.hpp"
+
+GCPhaseCounters::Entry GCPhaseCounters::_entries[GCPhaseCounters::MaxPhases];
+uint                   GCPhaseCounters::_num_entries = 0;
+volatile int           GCPhaseCounters::_lock = 0;
+
+static void sanitize_phase_name(const char* phase_name, char* buf, size_t len) {
+  size_t pos = 0;
+  for (const char* p = phase_name; *p != '\0' && pos < len - 1; p++) {
+    if (isalnum(*p)) {
+      buf[pos++] = *p;
+    }
+  }
+  buf[pos] = '\0';
+}
+
+GCPhaseCounters::Entry* GCPhaseCounters::find_or_create(const char* phase_name) {
+  char name[64];
+  sanitize_phase_name(phase_name, name, sizeof(name));
+  if (name[0] == '\0') {
+    return NULL;
+  }
+
+  for (uint i = 0; i < _num_entries; i++) {
+    if (strcmp(_entries[i]._name, name) == 0) {
+      return &_entries[i];
+    }
+  }
+
+  if (_num_entries == MaxPhases) {
+    log_debug(gc, phases)("Too many GC phases for PerfData, not exporting %s", phase_name);
+    return NULL;
+  }
+
+  EXCEPTION_MARK;
+  ResourceMark rm;
+
+  const char* ns = PerfDataManager::name_space("phases", name);
+
+  char* cname = PerfDataManager::counter_name(ns, "invocations");
+  PerfCounter* invocations = PerfDataManager::create_counter(SUN_GC, cname,
+                                                             PerfData::U_Events, CHECK_NULL);
+
+  cname = PerfDataManager::counter_name(ns, "time");
+  PerfCounter* time = PerfDataManager::create_counter(SUN_GC, cname,
+                                                      PerfData::U_Ticks, CHECK_NULL);
+
+  Entry* entry = &_entries[_num_entries++];
+  entry->_name = os::strdup_check_oom(name, mtGC);
+  entry->_invocations = invocations;
+  entry->_time = time;
+  return entry;
+}
+
+void GCPhaseCounters::update(TimePartitions* time_partitions) {
+  if (!UsePerfData) {
+    return;
+  }
+
+  // Collectors can finish GCs concurrently, e.g. a G1 young pause and
+  // the end of a concurrent cycle.
+  Thread::SpinAcquire(&_lock, "GCPhaseCounters");
+
+  TimePartitionPhasesIterator iter(time_partitions);
+  while (iter.has_next()) {
+    GCPhase* phase = iter.next();
+    if (phase->level() > MaxExportedLevel) {
+      continue;
+    }
+    Entry* entry = find_or_create(phase->name());
+    if (entry != NULL) {
+      entry->_invocations->inc();
+      entry->_time->inc((phase->end() - phase->start()).value());
+    }
+  }
+
+  Thread::SpinRelease(&_lock);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_GCPHASECOUNTERS_HPP
+#define SHARE_GC_SHARED_GCPHASECOUNTERS_HPP
+
+#include "memory/allocation.hpp"
+
+class PerfCounter;
+class TimePartitions;
+
+// GCPhaseCounters exports the phases a collector registers with its
+// GCTimer as PerfData counters, so that all collectors report their
+// phase breakdown through the same hsperfdata surface as they report it
+// through the GCPhasePause* and GCPhaseConcurrent JFR events.
+//
+// Only the top two phase levels are exported. A counter pair
+// sun.gc.phases.<name>.invocations and sun.gc.phases.<name>.time is
+// created the first time a phase name is seen, where <name> is the phase
+// name with all non-alphanumeric characters removed.
+
+class GCPhaseCounters : public AllStatic {
+  static const uint MaxPhases = 128;
+  static const int  MaxExportedLevel = 1;
+
+  struct Entry {
+    char*        _name;
+    PerfCounter* _invocations;
+    PerfCounter* _time;
+  };
+
+  static Entry        _entries[MaxPhases];
+  static uint         _num_entries;
+  static volatile int _lock;
+
+  static Entry* find_or_create(const char* phase_name);
+
+public:
+  // Accumulate the phases of a finished GC.
+  static void update(TimePartitions* time_partitions);
+};
+
+#endif // SHARE_GC_SHARED_GCPHASECOUNTERS_HPP
@@ -26,6 +26,7 @@
 #include "gc/shared/copyFailedInfo.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcId.hpp"
+#include "gc/shared/gcPhaseCounters.hpp"
 #include "gc/shared/gcTimer.hpp"
 #include "gc/shared/gcTrace.hpp"
 #include "gc/shared/objectCountEventSender.hpp"
@@ -56,6 +57,8 @@ void GCTracer::report_gc_end_impl(const Ticks& timestamp, TimePartitions* time_p
 
   send_phase_events(time_partitions);
   send_garbage_collection_event();
+
+  GCPhaseCounters::update(time_partitions);
 }
 
 void GCTracer::report_gc_end(const Ticks& timestamp, TimePartitions* time_partitions) {
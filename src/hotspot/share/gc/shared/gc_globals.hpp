@@ -413,6 +413,10 @@
   product(bool, TLABStats, true,                                            \
           "Provide more detailed and expensive TLAB statistics.")           \
                                                                             \
+  product(bool, AllocationProfiling, true,                                  \
+          "Aggregate sampled allocation bytes per class at TLAB refills "   \
+          "and allocations outside TLABs. See GC.alloc_profile")            \
+                                                                            \
   product_pd(bool, NeverActAsServerClassMachine,                            \
           "Never act like a server-class machine")                          \
                                                                             \
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
 #include "gc/shared/allocTracer.hpp"
+#include "gc/shared/allocationProfile.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/memAllocator.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
@@ -58,6 +59,7 @@ class MemAllocator::Allocation: StackObj {
   void notify_allocation_jvmti_sampler();
   void notify_allocation_low_memory_detector();
   void notify_allocation_jfr_sampler();
+  void notify_allocation_profile();
   void notify_allocation_dtrace_sampler();
   void check_for_bad_heap_word_value() const;
 #ifdef ASSERT
@@ -231,6 +233,21 @@ void MemAllocator::Allocation::notify_allocation_jfr_sampler() {
     // TLAB was refilled
     AllocTracer::send_allocation_in_new_tlab(_allocator._klass, mem, _allocated_tlab_size * HeapWordSize,
                                              size_in_bytes, _thread);
+  } else {
+    return;
+  }
+  AllocTracer::send_allocation_sample(_allocator._klass, mem, size_in_bytes, _thread);
+}
+
+void MemAllocator::Allocation::notify_allocation_profile() {
+  if (!AllocationProfiling) {
+    return;
+  }
+  if (_allocated_outside_tlab) {
+    AllocationProfile::record(_allocator._klass, _allocator._word_size * HeapWordSize);
+  } else if (_allocated_tlab_size != 0) {
+    // TLAB was refilled
+    AllocationProfile::record(_allocator._klass, _allocated_tlab_size * HeapWordSize);
   }
 }
 
@@ -248,6 +265,7 @@ void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
 void MemAllocator::Allocation::notify_allocation() {
   notify_allocation_low_memory_detector();
   notify_allocation_jfr_sampler();
+  notify_allocation_profile();
   notify_allocation_dtrace_sampler();
   notify_allocation_jvmti_sampler();
 }
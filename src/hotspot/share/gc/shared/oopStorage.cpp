@@ -39,12 +39,14 @@
 #include "runtime/safepoint.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/thread.hpp"
+#include "runtime/timer.hpp"
 #include "utilities/align.hpp"
 #include "utilities/count_trailing_zeros.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/ostream.hpp"
+#include "utilities/population_count.hpp"
 
 OopStorage::AllocationListEntry::AllocationListEntry() : _prev(NULL), _next(NULL) {}
 
@@ -434,6 +436,35 @@ oop* OopStorage::allocate() {
   return result;
 }
 
+size_t OopStorage::allocate(oop** ptrs, size_t size) {
+  assert(size > 0, "precondition");
+  MutexLocker ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
+
+  Block* block = block_for_allocation();
+  if (block == NULL) return 0; // Block allocation failed.
+  assert(!block->is_full(), "invariant");
+  if (block->is_empty()) {
+    // Transitioning from empty to not empty.
+    log_trace(oopstorage, blocks)("%s: block not empty " PTR_FORMAT, name(), p2i(block));
+  }
+  size_t count = 0;
+  do {
+    oop* result = block->allocate();
+    assert(result != NULL, "allocation failed");
+    log_trace(oopstorage, ref)("%s: allocated " PTR_FORMAT, name(), p2i(result));
+    ptrs[count++] = result;
+  } while ((count < size) && !block->is_full());
+  assert(!block->is_empty(), "postcondition");
+  Atomic::add(count, &_allocation_count); // release updates outside lock.
+  if (block->is_full()) {
+    // Transitioning from not full to full.
+    // Remove full blocks from consideration by future allocates.
+    log_trace(oopstorage, blocks)("%s: block full " PTR_FORMAT, name(), p2i(block));
+    _allocation_list.unlink(*block);
+  }
+  return count;
+}
+
 bool OopStorage::try_add_block() {
   assert_lock_strong(_allocation_mutex);
   Block* block;
@@ -991,7 +1022,21 @@ void OopStorage::BasicParState::update_concurrent_iteration_count(int value) {
   }
 }
 
+size_t OopStorage::BasicParState::count_entries(size_t start, size_t end) const {
+  // Racy for concurrent iteration, but only used for statistics.
+  size_t entries = 0;
+  for (size_t i = start; i < end; ++i) {
+    entries += population_count((uint64_t)_active_array->at(i)->allocated_bitmask());
+  }
+  return entries;
+}
+
 bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
+  if (data->_start_ticks == 0) {
+    // First claim by this thread.
+    data->_collect_stats = log_is_enabled(Debug, oopstorage, blocks, stats);
+    data->_start_ticks = os::elapsed_counter();
+  }
   data->_processed += data->_segment_end - data->_segment_start;
   size_t start = OrderAccess::load_acquire(&_next_block);
   if (start >= _block_count) {
@@ -1003,9 +1048,14 @@ bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
   // the remaining largish amount of work, leaving nothing for other
   // threads to do.  But too small a step can lead to contention
   // over _next_block, esp. when the work per block is small.
-  size_t max_step = 10;
+  //
+  // So the step is a fraction of the remaining blocks per thread: large
+  // while there is plenty of work left, shrinking to a single block near
+  // the end so that threads finish at about the same time.  A delayed
+  // thread holds at most 1/(2 * thread count) of the remaining work.
+  const size_t max_step = 64;
   size_t remaining = _block_count - start;
-  size_t step = MIN2(max_step, 1 + (remaining / _estimated_thread_count));
+  size_t step = MAX2((size_t)1, MIN2(max_step, remaining / (2 * _estimated_thread_count)));
   // Atomic::add with possible overshoot.  This can perform better
   // than a CAS loop on some platforms when there is contention.
   // We can cope with the uncertainty by recomputing start/end from
@@ -1020,6 +1070,9 @@ bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
     // Record claimed segment for iteration.
     data->_segment_start = start;
     data->_segment_end = end;
+    if (data->_collect_stats) {
+      data->_entries += count_entries(start, end);
+    }
     return true;                // Success.
   } else {
     // No more blocks to claim.
@@ -1033,6 +1086,14 @@ bool OopStorage::BasicParState::finish_iteration(const IterationData* data) cons
            ", processed = " SIZE_FORMAT " (%2.f%%)",
            _storage->name(), _block_count, data->_processed,
            percent_of(data->_processed, _block_count));
+  if (data->_collect_stats) {
+    double elapsed_us = TimeHelper::counter_to_millis(os::elapsed_counter() - data->_start_ticks) * 1000.0;
+    log_debug(oopstorage, blocks, stats)
+            ("Parallel iteration on %s: entries = " SIZE_FORMAT
+             ", time = %.3fus, rate = %.3f entries/us",
+             _storage->name(), data->_entries, elapsed_us,
+             elapsed_us > 0.0 ? data->_entries / elapsed_us : 0.0);
+  }
   return false;
 }
 
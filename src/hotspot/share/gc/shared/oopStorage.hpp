@@ -104,6 +104,15 @@ public:
   // postcondition: *result == NULL.
   oop* allocate();
 
+  // Allocates up to size new entries, storing them in ptrs.  All the
+  // entries come from a single block, so fewer than size may be returned
+  // even when more memory is available.  Returns the number of entries
+  // allocated, which is zero if memory allocation failed.  Locks
+  // _allocation_mutex once for the whole batch.
+  // precondition: size > 0.
+  // postcondition: *ptrs[i] == NULL, for i in [0,result).
+  size_t allocate(oop** ptrs, size_t size);
+
   // Deallocates ptr.  No locking.
   // precondition: ptr is a valid allocated entry.
   // precondition: *ptr == NULL.
@@ -141,6 +141,7 @@ class OopStorage::BasicParState {
   struct IterationData;
 
   void update_concurrent_iteration_count(int value);
+  size_t count_entries(size_t start, size_t end) const;
   bool claim_next_segment(IterationData* data);
   bool finish_iteration(const IterationData* data) const;
 
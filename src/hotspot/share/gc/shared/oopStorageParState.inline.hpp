@@ -45,6 +45,9 @@ struct OopStorage::BasicParState::IterationData {
   size_t _segment_start;
   size_t _segment_end;
   size_t _processed;
+  size_t _entries;              // Only counted when stats logging is enabled.
+  jlong _start_ticks;
+  bool _collect_stats;
 };
 
 template<bool is_const, typename F>
@@ -24,7 +24,9 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/gcId.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -57,22 +59,25 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
 
   print_stats("gc");
 
-  if (_number_of_refills > 0) {
-    // Update allocation history if a reasonable amount of eden was allocated.
-    bool update_allocation_history = used > 0.5 * capacity;
-
-    if (update_allocation_history) {
-      // Average the fraction of eden allocated in a tlab by this
-      // thread for use in the next resize operation.
-      // _gc_waste is not subtracted because it's included in
-      // "used".
-      // The result can be larger than 1.0 due to direct to old allocations.
-      // These allocations should ideally not be counted but since it is not possible
-      // to filter them out here we just cap the fraction to be at most 1.0.
-      double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
-      _allocation_fraction.sample(alloc_frac);
-    }
+  // Update allocation history if a reasonable amount of eden was allocated.
+  // This is done even if the thread did not refill its TLAB since the last
+  // GC, so that the TLABs of idle threads shrink instead of keeping the
+  // size they had when the thread was last busy.
+  bool update_allocation_history = used > 0.5 * capacity;
+
+  if (update_allocation_history) {
+    // Average the fraction of eden allocated in a tlab by this
+    // thread for use in the next resize operation.
+    // _gc_waste is not subtracted because it's included in
+    // "used".
+    // The result can be larger than 1.0 due to direct to old allocations.
+    // These allocations should ideally not be counted but since it is not possible
+    // to filter them out here we just cap the fraction to be at most 1.0.
+    double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
+    _allocation_fraction.sample(alloc_frac);
+  }
 
+  if (_number_of_refills > 0) {
     stats->update_fast_allocations(_number_of_refills,
                                    _allocated_size,
                                    _gc_waste,
@@ -441,6 +446,20 @@ void ThreadLocalAllocStats::publish() {
                       _total_slow_refill_waste * HeapWordSize, _max_slow_refill_waste * HeapWordSize,
                       _total_fast_refill_waste * HeapWordSize, _max_fast_refill_waste * HeapWordSize);
 
+  EventTLABStatistics e;
+  if (e.should_commit()) {
+    e.set_gcId(GCId::current_or_undefined());
+    e.set_allocatingThreads(_allocating_threads);
+    e.set_refills(_total_refills);
+    e.set_maxRefills(_max_refills);
+    e.set_allocated(_total_allocations * HeapWordSize);
+    e.set_gcWaste(_total_gc_waste * HeapWordSize);
+    e.set_slowRefillWaste(_total_slow_refill_waste * HeapWordSize);
+    e.set_fastRefillWaste(_total_fast_refill_waste * HeapWordSize);
+    e.set_slowAllocations(_total_slow_allocations);
+    e.commit();
+  }
+
   if (UsePerfData) {
     _perf_allocating_threads      ->set_value(_allocating_threads);
     _perf_total_refills           ->set_value(_total_refills);
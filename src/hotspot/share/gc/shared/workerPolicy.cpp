@@ -121,6 +121,12 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
 
   new_active_workers = MIN2(max_active_workers, (uintx) total_workers);
 
+  // Don't use more workers than there are processors available right now.
+  // The number of workers is sized from the processor count at startup,
+  // but a container's CPU limit may have been lowered since.
+  uintx available_processors = MAX2((uintx) os::active_processor_count(), min_workers);
+  new_active_workers = MIN2(new_active_workers, available_processors);
+
   // Increase GC workers instantly but decrease them more
   // slowly.
   if (new_active_workers < prev_active_workers) {
@@ -156,9 +162,10 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
   log_trace(gc, task)("WorkerPolicy::calc_default_active_workers() : "
     "active_workers(): " UINTX_FORMAT "  new_active_workers: " UINTX_FORMAT "  "
     "prev_active_workers: " UINTX_FORMAT "\n"
-    " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT,
+    " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT
+    "  available_processors: " UINTX_FORMAT,
     active_workers, new_active_workers, prev_active_workers,
-    active_workers_by_JT, active_workers_by_heap_size);
+    active_workers_by_JT, active_workers_by_heap_size, available_processors);
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
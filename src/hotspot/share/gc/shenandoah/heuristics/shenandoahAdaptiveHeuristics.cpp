@@ -29,13 +29,69 @@
 #include "gc/shenandoah/shenandoahHeapRegion.hpp"
 #include "logging/log.hpp"
 #include "logging/logTag.hpp"
+#include "runtime/os.hpp"
 #include "utilities/quickSort.hpp"
 
+ShenandoahAllocationRate::ShenandoahAllocationRate() :
+  _last_sample_time(os::elapsedTime()),
+  _last_sample_value(0),
+  _interval_sec(1.0 / ShenandoahAdaptiveSampleFrequencyHz),
+  _rate((int)(ShenandoahAdaptiveSampleSizeSeconds * ShenandoahAdaptiveSampleFrequencyHz)) {}
+
+void ShenandoahAllocationRate::allocation_counter_reset() {
+  _last_sample_time = os::elapsedTime();
+  _last_sample_value = 0;
+}
+
+double ShenandoahAllocationRate::sample(size_t allocated) {
+  const double now = os::elapsedTime();
+  const double elapsed = now - _last_sample_time;
+  if (elapsed < _interval_sec) {
+    // Too early for a new sample
+    return 0.0;
+  }
+
+  double rate = 0.0;
+  if (allocated >= _last_sample_value) {
+    // The counter is reset when a cycle starts, skip samples spanning a reset
+    rate = (allocated - _last_sample_value) / elapsed;
+    _rate.add(rate);
+  }
+
+  _last_sample_time = now;
+  _last_sample_value = allocated;
+
+  return rate;
+}
+
+double ShenandoahAllocationRate::avg() const {
+  return _rate.avg();
+}
+
+double ShenandoahAllocationRate::sd() const {
+  return _rate.sd();
+}
+
+bool ShenandoahAllocationRate::is_spiking(double rate) const {
+  if (rate <= 0.0) {
+    return false;
+  }
+
+  const double sd = _rate.sd();
+  if (sd <= 0.0) {
+    return false;
+  }
+
+  const double z_score = (rate - _rate.avg()) / sd;
+  return z_score > ShenandoahAdaptiveSpikeThreshold;
+}
+
 ShenandoahAdaptiveHeuristics::ShenandoahAdaptiveHeuristics() :
   ShenandoahHeuristics(),
   _cycle_gap_history(new TruncatedSeq(5)),
   _conc_mark_duration_history(new TruncatedSeq(5)),
-  _conc_uprefs_duration_history(new TruncatedSeq(5)) {}
+  _conc_uprefs_duration_history(new TruncatedSeq(5)),
+  _allocation_rate(new ShenandoahAllocationRate()) {}
 
 ShenandoahAdaptiveHeuristics::~ShenandoahAdaptiveHeuristics() {}
 
@@ -100,6 +156,7 @@ void ShenandoahAdaptiveHeuristics::record_cycle_start() {
   ShenandoahHeuristics::record_cycle_start();
   double last_cycle_gap = (_cycle_start - _last_cycle_end);
   _cycle_gap_history->add(last_cycle_gap);
+  _allocation_rate->allocation_counter_reset();
 }
 
 void ShenandoahAdaptiveHeuristics::record_phase_time(ShenandoahPhaseTimings::Phase phase, double secs) {
@@ -161,6 +218,22 @@ bool ShenandoahAdaptiveHeuristics::should_start_gc() const {
     return true;
   }
 
+  // The average allocation rate since the last cycle reacts slowly to bursts.
+  // Check if the recently sampled rate is a spike compared to the moving
+  // window of samples, and would deplete the headroom before a cycle completes.
+  const double sampled_rate = _allocation_rate->sample(heap->bytes_allocated_since_gc_start());
+  if (sampled_rate > 0.0) {
+    log_debug(gc, ergo)("Allocation rate: %.2f MB/s (sampled), %.2f MB/s (window avg), %.2f MB/s (window sd)",
+                        sampled_rate / M, _allocation_rate->avg() / M, _allocation_rate->sd() / M);
+  }
+  if (_allocation_rate->is_spiking(sampled_rate) && average_gc > allocation_headroom / sampled_rate) {
+    log_info(gc)("Trigger: Average GC time (%.2f ms) is above the time for sampled allocation rate (%.2f MB/s) to deplete free headroom (" SIZE_FORMAT "M) (spike threshold = %.2f)",
+                 average_gc * 1000, sampled_rate / M, allocation_headroom / M, ShenandoahAdaptiveSpikeThreshold);
+    log_info(gc, ergo)("Free headroom: " SIZE_FORMAT "M (free) - " SIZE_FORMAT "M (spike) - " SIZE_FORMAT "M (penalties) = " SIZE_FORMAT "M",
+                       available / M, spike_headroom / M, penalties / M, allocation_headroom / M);
+    return true;
+  }
+
   return ShenandoahHeuristics::should_start_gc();
 }
 
@@ -28,11 +28,34 @@
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
 #include "utilities/numberSeq.hpp"
 
+// Samples the allocation rate at a fixed frequency, and keeps a moving
+// window of the samples to detect allocation spikes.
+class ShenandoahAllocationRate : public CHeapObj<mtGC> {
+private:
+  double       _last_sample_time;
+  size_t       _last_sample_value;
+  const double _interval_sec;
+  TruncatedSeq _rate;
+
+public:
+  ShenandoahAllocationRate();
+
+  void allocation_counter_reset();
+
+  // Returns the sampled rate, or zero if it is not yet time for a new sample.
+  double sample(size_t allocated);
+
+  double avg() const;
+  double sd() const;
+  bool is_spiking(double rate) const;
+};
+
 class ShenandoahAdaptiveHeuristics : public ShenandoahHeuristics {
 private:
   TruncatedSeq* _cycle_gap_history;
   TruncatedSeq* _conc_mark_duration_history;
   TruncatedSeq* _conc_uprefs_duration_history;
+  ShenandoahAllocationRate* _allocation_rate;
 
 public:
   ShenandoahAdaptiveHeuristics();
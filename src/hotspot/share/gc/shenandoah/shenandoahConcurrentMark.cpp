@@ -177,16 +177,29 @@ public:
 class ShenandoahSATBThreadsClosure : public ThreadClosure {
 private:
   ShenandoahSATBBufferClosure* _satb_cl;
-  uintx _claim_token;
 
 public:
   ShenandoahSATBThreadsClosure(ShenandoahSATBBufferClosure* satb_cl) :
-    _satb_cl(satb_cl),
+    _satb_cl(satb_cl) {}
+
+  void do_thread(Thread* thread) {
+    ShenandoahThreadLocalData::satb_mark_queue(thread).apply_closure_and_empty(_satb_cl);
+  }
+};
+
+class ShenandoahClaimThreadsClosure : public ThreadClosure {
+private:
+  ThreadClosure* const _cl;
+  const uintx          _claim_token;
+
+public:
+  ShenandoahClaimThreadsClosure(ThreadClosure* cl) :
+    _cl(cl),
     _claim_token(Threads::thread_claim_token()) {}
 
   void do_thread(Thread* thread) {
     if (thread->claim_threads_do(true, _claim_token)) {
-      ShenandoahThreadLocalData::satb_mark_queue(thread).apply_closure_and_empty(_satb_cl);
+      _cl->do_thread(thread);
     }
   }
 };
@@ -196,10 +209,12 @@ private:
   ShenandoahConcurrentMark* _cm;
   ShenandoahTaskTerminator* _terminator;
   bool _dedup_string;
+  ShenandoahThreadRoots _thread_roots;
 
 public:
   ShenandoahFinalMarkingTask(ShenandoahConcurrentMark* cm, ShenandoahTaskTerminator* terminator, bool dedup_string) :
-    AbstractGangTask("Shenandoah Final Marking"), _cm(cm), _terminator(terminator), _dedup_string(dedup_string) {
+    AbstractGangTask("Shenandoah Final Marking"), _cm(cm), _terminator(terminator), _dedup_string(dedup_string),
+    _thread_roots(true /* is_par */) {
   }
 
   void work(uint worker_id) {
@@ -216,8 +231,12 @@ public:
       ShenandoahSATBBufferClosure cl(q);
       SATBMarkQueueSet& satb_mq_set = ShenandoahBarrierSet::satb_mark_queue_set();
       while (satb_mq_set.apply_closure_to_completed_buffer(&cl));
+      // Java threads and the VM thread are handed out in strides, the
+      // remaining non-Java threads are few and claimed one by one.
       ShenandoahSATBThreadsClosure tc(&cl);
-      Threads::threads_do(&tc);
+      _thread_roots.java_threads_do(&tc);
+      ShenandoahClaimThreadsClosure claim_tc(&tc);
+      Threads::non_java_threads_do(&claim_tc);
     }
 
     ReferenceProcessor* rp;
@@ -29,13 +29,23 @@
 #include "gc/shenandoah/shenandoahMarkingContext.inline.hpp"
 #include "gc/shenandoah/shenandoahTraversalGC.hpp"
 #include "logging/logStream.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
 
 ShenandoahFreeSet::ShenandoahFreeSet(ShenandoahHeap* heap, size_t max_regions) :
   _heap(heap),
   _mutator_free_bitmap(max_regions, mtGC),
   _collector_free_bitmap(max_regions, mtGC),
-  _max(max_regions)
+  _max(max_regions),
+  _num_direct_regions((uint)ShenandoahDirectAllocRegions),
+  _direct_regions(NULL)
 {
+  if (_num_direct_regions > 0) {
+    _direct_regions = NEW_C_HEAP_ARRAY(ShenandoahHeapRegion* volatile, _num_direct_regions, mtGC);
+    for (uint i = 0; i < _num_direct_regions; i++) {
+      _direct_regions[i] = NULL;
+    }
+  }
   clear_internal();
 }
 
@@ -79,8 +89,13 @@ HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool&
       // Try to allocate in the mutator view
       for (size_t idx = _mutator_leftmost; idx <= _mutator_rightmost; idx++) {
         if (is_mutator_free(idx)) {
-          HeapWord* result = try_allocate_in(_heap->get_region(idx), req, in_new_region);
+          ShenandoahHeapRegion* r = _heap->get_region(idx);
+          HeapWord* result = try_allocate_in(r, req, in_new_region);
           if (result != NULL) {
+            if (_num_direct_regions > 0 && req.type() == ShenandoahAllocRequest::_alloc_tlab) {
+              // Let the next TLABs for this thread come from this region without the lock
+              install_direct_region(r);
+            }
             return result;
           }
         }
@@ -145,6 +160,65 @@ HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool&
   return NULL;
 }
 
+uint ShenandoahFreeSet::direct_region_index(Thread* thread) const {
+  // Spread threads over the slots, a thread always uses the same slot
+  const uintptr_t hash = (uintptr_t)thread >> LogBytesPerWord;
+  return (uint)((hash ^ (hash >> 16)) % _num_direct_regions);
+}
+
+// Only called after the region in the slot failed the request under the
+// lock, so that threads sharing the slot do not replace each other's
+// fresh regions.
+void ShenandoahFreeSet::install_direct_region(ShenandoahHeapRegion* r) {
+  assert_heaplock_owned_by_current_thread();
+
+  const size_t num = r->region_number();
+  if (!is_mutator_free(num) || has_no_alloc_capacity(r)) {
+    // Retired, or about to be
+    return;
+  }
+
+  // Detach from the mutator view. The remaining space is accounted as used
+  // up front, since allocations in it are no longer seen by the free set.
+  increase_used(r->free());
+  _mutator_free_bitmap.clear_bit(num);
+  if (touches_bounds(num)) {
+    adjust_bounds();
+  }
+  assert_bounds();
+
+  ShenandoahHeapRegion* const prev = Atomic::xchg(r, &_direct_regions[direct_region_index(Thread::current())]);
+  if (prev != NULL) {
+    // The previously installed region is retired: its remainder has been
+    // accounted as used already, report it as waste like try_allocate_in()
+    // does. Allocations racing with the swap may still shrink it a little.
+    size_t waste = prev->free();
+    if (waste > 0) {
+      _heap->notify_mutator_alloc_words(waste >> LogHeapWordSize, true);
+    }
+  }
+}
+
+HeapWord* ShenandoahFreeSet::par_allocate_direct(ShenandoahAllocRequest& req) {
+  if (_num_direct_regions == 0 || req.type() != ShenandoahAllocRequest::_alloc_tlab) {
+    return NULL;
+  }
+
+  ShenandoahHeapRegion* const r = OrderAccess::load_acquire(&_direct_regions[direct_region_index(Thread::current())]);
+  if (r == NULL) {
+    return NULL;
+  }
+
+  size_t size = req.size();
+  const size_t min_size = ShenandoahElasticTLAB ? req.min_size() : size;
+  HeapWord* const result = r->par_allocate_lab(min_size, size);
+  if (result != NULL) {
+    req.set_actual_size(size);
+  }
+
+  return result;
+}
+
 HeapWord* ShenandoahFreeSet::try_allocate_in(ShenandoahHeapRegion* r, ShenandoahAllocRequest& req, bool& in_new_region) {
   assert (!has_no_alloc_capacity(r), "Performance: should avoid full regions on this path: " SIZE_FORMAT, r->region_number());
 
@@ -399,6 +473,13 @@ void ShenandoahFreeSet::clear() {
 }
 
 void ShenandoahFreeSet::clear_internal() {
+  // The free set is only cleared at a safepoint, or before mutators allocate,
+  // so no thread can be allocating in the direct regions. Their remaining
+  // space is picked up again when the free set is rebuilt.
+  for (uint i = 0; i < _num_direct_regions; i++) {
+    _direct_regions[i] = NULL;
+  }
+
   _mutator_free_bitmap.clear();
   _collector_free_bitmap.clear();
   _mutator_leftmost = _max;
@@ -42,6 +42,16 @@ private:
   size_t _capacity;
   size_t _used;
 
+  // Regions that mutator TLAB allocations bump-allocate in without taking
+  // the heap lock. A region is detached from the mutator view, and all its
+  // free space is accounted as used, when it is installed under the heap
+  // lock. The slots are dropped when the free set is cleared at a safepoint.
+  const uint                      _num_direct_regions;
+  ShenandoahHeapRegion* volatile* _direct_regions;
+
+  uint direct_region_index(Thread* thread) const;
+  void install_direct_region(ShenandoahHeapRegion* r);
+
   void assert_bounds() const NOT_DEBUG_RETURN;
   void assert_heaplock_owned_by_current_thread() const NOT_DEBUG_RETURN;
   void assert_heaplock_not_owned_by_current_thread() const NOT_DEBUG_RETURN;
@@ -89,6 +99,10 @@ public:
   }
 
   HeapWord* allocate(ShenandoahAllocRequest& req, bool& in_new_region);
+
+  // Tries to allocate a TLAB without taking the heap lock, returns NULL
+  // if the request has to go through allocate() instead.
+  HeapWord* par_allocate_direct(ShenandoahAllocRequest& req);
   size_t unsafe_peek_free() const;
 
   void print_on(outputStream* out) const;
@@ -861,7 +861,22 @@ HeapWord* ShenandoahHeap::allocate_memory(ShenandoahAllocRequest& req) {
 }
 
 HeapWord* ShenandoahHeap::allocate_memory_under_lock(ShenandoahAllocRequest& req, bool& in_new_region) {
+  HeapWord* const result = _free_set->par_allocate_direct(req);
+  if (result != NULL) {
+    in_new_region = false;
+    return result;
+  }
+
   ShenandoahHeapLocker locker(lock());
+
+  // Another thread sharing the direct slot may have installed a fresh
+  // region while we waited for the lock. Use it rather than install
+  // another one, which would retire it almost empty.
+  HeapWord* const direct = _free_set->par_allocate_direct(req);
+  if (direct != NULL) {
+    in_new_region = false;
+    return direct;
+  }
   return _free_set->allocate(req, in_new_region);
 }
 
@@ -216,7 +216,8 @@ private:
   static size_t MaxTLABSizeBytes;
   static size_t MaxTLABSizeWords;
 
-  // Global allocation counter, increased for each allocation under Shenandoah heap lock.
+  // Global allocation counter, increased for each allocation under Shenandoah heap lock,
+  // and atomically for lock-free TLAB allocations when those are enabled.
   // Padded to avoid false sharing with the read-only fields above.
   struct PaddedAllocSeqNum {
     DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(uint64_t));
@@ -231,6 +232,8 @@ private:
 
   static PaddedAllocSeqNum _alloc_seq_num;
 
+  inline static uint64_t next_alloc_seq_num();
+
   // Never updated fields
   ShenandoahHeap* _heap;
   MemRegion _reserved;
@@ -352,6 +355,12 @@ public:
   // Allocation (return NULL if full)
   inline HeapWord* allocate(size_t word_size, ShenandoahAllocRequest::Type type);
 
+  // Lock-free LAB allocation of at least min_size and at most word_size words.
+  // Returns NULL if the region can not fit min_size, otherwise updates
+  // word_size to the actually allocated size. Only used for TLABs in regions
+  // detached from the free set.
+  inline HeapWord* par_allocate_lab(size_t min_size, size_t& word_size);
+
   HeapWord* allocate(size_t word_size) shenandoah_not_implemented_return(NULL)
 
   void clear_live_data();
@@ -391,6 +400,7 @@ public:
   HeapWord* new_top() const { return _new_top; }
 
   inline void adjust_alloc_metadata(ShenandoahAllocRequest::Type type, size_t);
+  inline void par_adjust_alloc_metadata_tlab(size_t);
   void reset_alloc_metadata_to_shared();
   void reset_alloc_metadata();
   size_t get_shared_allocs() const;
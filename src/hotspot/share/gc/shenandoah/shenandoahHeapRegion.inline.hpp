@@ -28,6 +28,7 @@
 #include "gc/shenandoah/shenandoahHeapRegion.hpp"
 #include "gc/shenandoah/shenandoahPacer.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "utilities/align.hpp"
 
 HeapWord* ShenandoahHeapRegion::allocate(size_t size, ShenandoahAllocRequest::Type type) {
   _heap->assert_heaplock_or_safepoint();
@@ -51,13 +52,69 @@ HeapWord* ShenandoahHeapRegion::allocate(size_t size, ShenandoahAllocRequest::Ty
   }
 }
 
+HeapWord* ShenandoahHeapRegion::par_allocate_lab(size_t min_size, size_t& word_size) {
+  assert(is_object_aligned(word_size), "alloc size breaks alignment: " SIZE_FORMAT, word_size);
+
+  HeapWord* obj = top();
+  for (;;) {
+    const size_t free = align_down(pointer_delta(end(), obj), MinObjAlignment);
+    const size_t size = MIN2(word_size, free);
+    if (size < min_size) {
+      return NULL;
+    }
+
+    HeapWord* const prev_obj = Atomic::cmpxchg(obj + size, top_addr(), obj);
+    if (prev_obj == obj) {
+      // Success
+      par_adjust_alloc_metadata_tlab(size);
+      word_size = size;
+      return obj;
+    }
+
+    // Retry
+    obj = prev_obj;
+  }
+}
+
+inline uint64_t ShenandoahHeapRegion::next_alloc_seq_num() {
+  if (ShenandoahDirectAllocRegions == 0) {
+    // Only ever updated under the heap lock
+    return _alloc_seq_num.value++;
+  }
+  // Lock-free TLAB allocations update it too
+  uint64_t cur = Atomic::load(&_alloc_seq_num.value);
+  for (;;) {
+    uint64_t prev = Atomic::cmpxchg(cur + 1, &_alloc_seq_num.value, cur);
+    if (prev == cur) {
+      return cur;
+    }
+    cur = prev;
+  }
+}
+
+inline void ShenandoahHeapRegion::par_adjust_alloc_metadata_tlab(size_t size) {
+  // The region was allocated into under the lock before it was installed
+  // for lock-free allocation, so this is never its first mutator allocation.
+  assert(_seqnum_first_alloc_mutator != 0, "Region " SIZE_FORMAT " metadata is correct", _region_number);
+  uint64_t seqnum = next_alloc_seq_num();
+  uint64_t last = Atomic::load(&_seqnum_last_alloc_mutator);
+  while (last < seqnum) {
+    uint64_t prev = Atomic::cmpxchg(seqnum, &_seqnum_last_alloc_mutator, last);
+    if (prev == last) {
+      break;
+    }
+    last = prev;
+  }
+  Atomic::add(size, &_tlab_allocs);
+}
+
 inline void ShenandoahHeapRegion::adjust_alloc_metadata(ShenandoahAllocRequest::Type type, size_t size) {
   bool is_first_alloc = (top() == bottom());
 
   switch (type) {
     case ShenandoahAllocRequest::_alloc_shared:
     case ShenandoahAllocRequest::_alloc_tlab:
-      _seqnum_last_alloc_mutator = _alloc_seq_num.value++;
+      _seqnum_last_alloc_mutator = next_alloc_seq_num();
       if (is_first_alloc) {
         assert (_seqnum_first_alloc_mutator == 0, "Region " SIZE_FORMAT " metadata is correct", _region_number);
         _seqnum_first_alloc_mutator = _seqnum_last_alloc_mutator;
@@ -65,7 +122,7 @@ inline void ShenandoahHeapRegion::adjust_alloc_metadata(ShenandoahAllocRequest::
       break;
     case ShenandoahAllocRequest::_alloc_shared_gc:
     case ShenandoahAllocRequest::_alloc_gclab:
-      _seqnum_last_alloc_gc = _alloc_seq_num.value++;
+      _seqnum_last_alloc_gc = next_alloc_seq_num();
       if (is_first_alloc) {
         assert (_seqnum_first_alloc_gc == 0, "Region " SIZE_FORMAT " metadata is correct", _region_number);
         _seqnum_first_alloc_gc = _seqnum_last_alloc_gc;
@@ -37,7 +37,9 @@
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/thread.hpp"
+#include "runtime/vmThread.hpp"
 #include "services/management.hpp"
 
 ShenandoahSerialRoot::ShenandoahSerialRoot(ShenandoahSerialRoot::OopsDo oops_do, ShenandoahPhaseTimings::GCParPhases phase) :
@@ -107,22 +109,86 @@ void ShenandoahSerialWeakRoots::weak_oops_do(OopClosure* cl, uint worker_id) {
   weak_oops_do(&always_true, cl, worker_id);
 }
 
-ShenandoahThreadRoots::ShenandoahThreadRoots(bool is_par) : _is_par(is_par) {
+ShenandoahThreadRoots::ShenandoahThreadRoots(bool is_par) :
+  _is_par(is_par),
+  _java_threads(),
+  _java_threads_claimed(0) {
   Threads::change_thread_claim_token();
 }
 
+void ShenandoahThreadRoots::par_threads_do(ThreadClosure* tc) {
+  // Workers claim Java threads in strides from a shared index, instead of
+  // each worker walking all threads and racing to claim them one by one.
+  // This keeps the cost per worker proportional to the threads it visits,
+  // which matters with thousands of threads. Threads are still claimed,
+  // to keep the claim token verification working.
+  const uintx claim_token = Threads::thread_claim_token();
+  const uint length = _java_threads.length();
+
+  for (;;) {
+    const uint end = Atomic::add(java_threads_stride, &_java_threads_claimed);
+    const uint start = end - java_threads_stride;
+    if (start >= length) {
+      break;
+    }
+
+    for (uint i = start; i < MIN2(end, length); i++) {
+      JavaThread* const thread = _java_threads.list()->thread_at(i);
+      if (thread->claim_threads_do(true, claim_token)) {
+        tc->do_thread(thread);
+      }
+    }
+  }
+
+  VMThread* const vmt = VMThread::vm_thread();
+  if (vmt->claim_threads_do(true, claim_token)) {
+    tc->do_thread(vmt);
+  }
+}
+
+class ShenandoahParallelOopsDoThreadClosure : public ThreadClosure {
+private:
+  OopClosure* const      _oops_cl;
+  CodeBlobClosure* const _code_cl;
+
+public:
+  ShenandoahParallelOopsDoThreadClosure(OopClosure* oops_cl, CodeBlobClosure* code_cl) :
+    _oops_cl(oops_cl), _code_cl(code_cl) {}
+
+  void do_thread(Thread* thread) {
+    thread->oops_do(_oops_cl, _code_cl);
+  }
+};
+
 void ShenandoahThreadRoots::oops_do(OopClosure* oops_cl, CodeBlobClosure* code_cl, uint worker_id) {
   ShenandoahWorkerTimings* worker_times = ShenandoahHeap::heap()->phase_timings()->worker_times();
   ShenandoahWorkerTimingsTracker timer(worker_times, ShenandoahPhaseTimings::ThreadRoots, worker_id);
   ResourceMark rm;
-  Threads::possibly_parallel_oops_do(_is_par, oops_cl, code_cl);
+  if (_is_par) {
+    ShenandoahParallelOopsDoThreadClosure tc(oops_cl, code_cl);
+    par_threads_do(&tc);
+  } else {
+    Threads::possibly_parallel_oops_do(_is_par, oops_cl, code_cl);
+  }
 }
 
 void ShenandoahThreadRoots::threads_do(ThreadClosure* tc, uint worker_id) {
   ShenandoahWorkerTimings* worker_times = ShenandoahHeap::heap()->phase_timings()->worker_times();
   ShenandoahWorkerTimingsTracker timer(worker_times, ShenandoahPhaseTimings::ThreadRoots, worker_id);
   ResourceMark rm;
-  Threads::possibly_parallel_threads_do(_is_par, tc);
+  if (_is_par) {
+    par_threads_do(tc);
+  } else {
+    Threads::possibly_parallel_threads_do(_is_par, tc);
+  }
+}
+
+void ShenandoahThreadRoots::java_threads_do(ThreadClosure* tc) {
+  if (_is_par) {
+    par_threads_do(tc);
+  } else {
+    Threads::possibly_parallel_threads_do(_is_par, tc);
+  }
 }
 
 ShenandoahThreadRoots::~ShenandoahThreadRoots() {
@@ -31,6 +31,8 @@
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
 #include "gc/shenandoah/shenandoahSharedVariables.hpp"
 #include "memory/iterator.hpp"
+#include "memory/padded.hpp"
+#include "runtime/threadSMR.hpp"
 
 class ShenandoahSerialRoot {
 public:
@@ -170,13 +172,27 @@ public:
 
 class ShenandoahThreadRoots {
 private:
-  const bool _is_par;
+  // Number of Java threads claimed at a time by a parallel worker
+  static const uint java_threads_stride = 16;
+
+  const bool        _is_par;
+  ThreadsListHandle _java_threads;
+  DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, 0);
+  volatile uint     _java_threads_claimed;
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(volatile uint));
+
+  void par_threads_do(ThreadClosure* tc);
+
 public:
   ShenandoahThreadRoots(bool is_par);
   ~ShenandoahThreadRoots();
 
   void oops_do(OopClosure* oops_cl, CodeBlobClosure* code_cl, uint worker_id);
   void threads_do(ThreadClosure* tc, uint worker_id);
+
+  // Visits every Java thread and the VM thread exactly once across all
+  // workers. Unlike threads_do(), this is not accounted as thread roots.
+  void java_threads_do(ThreadClosure* tc);
 };
 
 class ShenandoahStringDedupRoots {
@@ -124,6 +124,25 @@
           "and GC performance for adaptive heuristics.")                    \
           range(0,100)                                                      \
                                                                             \
+  experimental(uintx, ShenandoahAdaptiveSampleFrequencyHz, 10,              \
+          "The number of times per second to sample the allocation rate "   \
+          "for spike detection in adaptive heuristics.")                    \
+          range(1, 1000)                                                    \
+                                                                            \
+  experimental(uintx, ShenandoahAdaptiveSampleSizeSeconds, 10,              \
+          "The size of the moving window over which allocation rate "       \
+          "samples are kept. The number of samples is the product of "      \
+          "this and ShenandoahAdaptiveSampleFrequencyHz.")                  \
+          range(1, 1000)                                                    \
+                                                                            \
+  experimental(double, ShenandoahAdaptiveSpikeThreshold, 1.8,               \
+          "Start a cycle early if the sampled allocation rate is more than "\
+          "this many standard deviations above the moving average, and "    \
+          "the free headroom would be depleted at that rate before an "     \
+          "average cycle completes. Lower values make adaptive heuristics " \
+          "more sensitive to allocation spikes.")                           \
+          range(0.0, 100.0)                                                 \
+                                                                            \
   experimental(uintx, ShenandoahImmediateThreshold, 90,                     \
           "If mark identifies more than this much immediate garbage "       \
           "regions, it shall recycle them, and shall not continue the "     \
@@ -211,6 +230,15 @@
           "Allow mixing mutator and collector allocations in a single "     \
           "region")                                                         \
                                                                             \
+  experimental(uintx, ShenandoahDirectAllocRegions, 0,                      \
+          "Number of regions that mutator threads allocate TLABs in "       \
+          "without taking the heap lock. Threads are spread over these "    \
+          "regions. Larger values reduce heap lock contention with many "   \
+          "allocating threads, at the expense of more partially used "      \
+          "regions between cycles. Zero disables lock-free TLAB "           \
+          "allocation.")                                                    \
+          range(0, 1024)                                                    \
+                                                                            \
   experimental(uintx, ShenandoahAllocSpikeFactor, 5,                        \
           "The amount of heap space to reserve for absorbing the "          \
           "allocation spikes. Larger value wastes more memory in "          \
@@ -118,8 +118,12 @@ bool ZDirector::rule_allocation_rate() const {
   // that with an allocation spike tolerance factor to guard against unforeseen
   // phase changes in the allocate rate. We then add ~3.3 sigma to account for
   // the allocation rate variance, which means the probability is 1 in 1000
-  // that a sample is outside of the confidence interval.
-  const double max_alloc_rate = (ZStatAllocRate::avg() * ZAllocationSpikeTolerance) + (ZStatAllocRate::avg_sd() * one_in_1000);
+  // that a sample is outside of the confidence interval. The moving average
+  // lags behind a sudden increase in the allocation rate by up to a sample
+  // window, so the most recent sample is used instead if it is higher, to
+  // start the GC early enough when such a spike begins.
+  const double alloc_rate = MAX2(ZStatAllocRate::avg() * ZAllocationSpikeTolerance, ZStatAllocRate::last());
+  const double max_alloc_rate = alloc_rate + (ZStatAllocRate::avg_sd() * one_in_1000);
   const double time_until_oom = free / (max_alloc_rate + 1.0); // Plus 1.0B/s to avoid division by zero
 
   // Calculate max duration of a GC cycle. The duration of GC is a moving
@@ -144,7 +144,7 @@ const size_t      ZMarkStackMagazineSlots       = (ZMarkStackMagazineSize / ZMar
 const size_t      ZMarkStripeShift              = ZGranuleSizeShift;
 
 // Max number of mark stripes
-const size_t      ZMarkStripesMax               = 16; // Must be a power of two
+const size_t      ZMarkStripesMax               = 64; // Must be a power of two
 
 // Mark cache size
 const size_t      ZMarkCacheSize                = 1024; // Must be a power of two
@@ -472,6 +472,10 @@ void ZHeap::relocate() {
                                  used(), used_high(), used_low());
 }
 
+void ZHeap::relocate_assist(size_t npages) {
+  _relocate.assist(npages);
+}
+
 void ZHeap::object_iterate(ObjectClosure* cl, bool visit_weaks) {
   assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
 
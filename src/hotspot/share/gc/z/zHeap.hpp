@@ -159,6 +159,7 @@ public:
   uintptr_t relocate_object(uintptr_t addr);
   uintptr_t remap_object(uintptr_t addr);
   void relocate();
+  void relocate_assist(size_t npages);
 
   // Iteration
   void object_iterate(ObjectClosure* cl, bool visit_weaks);
@@ -26,6 +26,7 @@
 
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zMarkStackEntry.hpp"
+#include "memory/allocation.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 template <typename T, size_t S>
@@ -108,7 +109,9 @@ public:
 
 class ZMarkStackAllocator;
 
-class ZMarkThreadLocalStacks {
+// Allocated separately from ZThreadLocalData, since the array of stacks,
+// one per stripe, does not fit in the thread's GC data.
+class ZMarkThreadLocalStacks : public CHeapObj<mtGC> {
 private:
   ZMarkStackMagazine* _magazine;
   ZMarkStack*         _stacks[ZMarkStripesMax];
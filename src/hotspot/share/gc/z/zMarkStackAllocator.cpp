@@ -28,6 +28,7 @@
 #include "logging/log.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
+#include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 
 uintptr_t ZMarkStackSpaceStart;
@@ -90,11 +91,16 @@ uintptr_t ZMarkStackSpace::expand_and_alloc_space(size_t size) {
     return addr;
   }
 
-  // Check expansion limit
-  const size_t expand_size = ZMarkStackSpaceExpandSize;
+  // Expand in proportion to the current size, so that the number of
+  // expansions (each taken under the expand lock) stays low when many
+  // workers are marking. Never expand beyond the limit.
   const size_t old_size = _end - _start;
+  const size_t expand_size = MIN2(MAX2(old_size, ZMarkStackSpaceExpandSize),
+                                  align_down(ZMarkStackSpaceLimit - old_size, ZMarkStackSpaceExpandSize));
   const size_t new_size = old_size + expand_size;
-  if (new_size > ZMarkStackSpaceLimit) {
+
+  // Check expansion limit
+  if (expand_size < size) {
     // Expansion limit reached. This is a fatal error since we
     // currently can't recover from running out of mark stack space.
     fatal("Mark stack space exhausted. Use -XX:ZMarkStackSpaceLimit=<size> to increase the "
@@ -310,7 +310,7 @@ void ZObjectAllocator::retire_pages() {
   _undone.set_all(0);
 
   // Reset allocation pages
-  _shared_medium_page.set(NULL);
+  _shared_medium_page.set_all(NULL);
   _shared_small_page.set_all(NULL);
   _worker_small_page.set_all(NULL);
 }
@@ -27,12 +27,14 @@
 #include "gc/z/zCollectedHeap.hpp"
 #include "gc/z/zFuture.inline.hpp"
 #include "gc/z/zGlobals.hpp"
+#include "gc/z/zHeap.hpp"
 #include "gc/z/zLock.inline.hpp"
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zPageAllocator.hpp"
 #include "gc/z/zPageCache.inline.hpp"
 #include "gc/z/zSafeDelete.inline.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zThread.hpp"
 #include "gc/z/zTracer.inline.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/init.hpp"
@@ -428,6 +430,13 @@ ZPage* ZPageAllocator::alloc_page_blocking(uint8_t type, size_t size, ZAllocatio
       // Start asynchronous GC
       ZCollectedHeap::heap()->collect(GCCause::_z_allocation_stall);
 
+      // Help relocating the relocation set, if relocation is in progress.
+      // Every page relocated is freed, which can satisfy this or other
+      // queued requests before the GC cycle ends.
+      if (ZRelocationAssistPages > 0 && ZThread::is_java()) {
+        ZHeap::heap()->relocate_assist(ZRelocationAssistPages);
+      }
+
       // Wait for allocation to complete or fail
       page = request.wait();
     } while (page == gc_marker);
@@ -48,12 +48,12 @@ ZPageCache::ZPageCache() :
     _medium(),
     _large() {}
 
-ZPage* ZPageCache::alloc_small_page() {
+ZPage* ZPageCache::alloc_numa_page(ZPerNUMA<ZList<ZPage> >* lists) {
   const uint32_t numa_id = ZNUMA::id();
   const uint32_t numa_count = ZNUMA::count();
 
   // Try NUMA local page cache
-  ZPage* const l1_page = _small.get(numa_id).remove_first();
+  ZPage* const l1_page = lists->get(numa_id).remove_first();
   if (l1_page != NULL) {
     ZStatInc(ZCounterPageCacheHitL1);
     return l1_page;
@@ -67,7 +67,7 @@ ZPage* ZPageCache::alloc_small_page() {
       remote_numa_id = 0;
     }
 
-    ZPage* const l2_page = _small.get(remote_numa_id).remove_first();
+    ZPage* const l2_page = lists->get(remote_numa_id).remove_first();
     if (l2_page != NULL) {
       ZStatInc(ZCounterPageCacheHitL2);
       return l2_page;
@@ -79,14 +79,12 @@ ZPage* ZPageCache::alloc_small_page() {
   return NULL;
 }
 
-ZPage* ZPageCache::alloc_medium_page() {
-  ZPage* const page = _medium.remove_first();
-  if (page != NULL) {
-    ZStatInc(ZCounterPageCacheHitL1);
-    return page;
-  }
+ZPage* ZPageCache::alloc_small_page() {
+  return alloc_numa_page(&_small);
+}
 
-  return NULL;
+ZPage* ZPageCache::alloc_medium_page() {
+  return alloc_numa_page(&_medium);
 }
 
 ZPage* ZPageCache::alloc_large_page(size_t size) {
@@ -106,7 +104,15 @@ ZPage* ZPageCache::alloc_large_page(size_t size) {
 
 ZPage* ZPageCache::alloc_oversized_medium_page(size_t size) {
   if (size <= ZPageSizeMedium) {
-    return _medium.remove_first();
+    // Prefer a NUMA local page, like for exact allocations
+    const uint32_t numa_id = ZNUMA::id();
+    const uint32_t numa_count = ZNUMA::count();
+    for (uint32_t i = 0; i < numa_count; i++) {
+      ZPage* const page = _medium.get((numa_id + i) % numa_count).remove_first();
+      if (page != NULL) {
+        return page;
+      }
+    }
   }
 
   return NULL;
@@ -182,7 +188,7 @@ void ZPageCache::free_page_inner(ZPage* page) {
   if (type == ZPageTypeSmall) {
     _small.get(page->numa_id()).insert_first(page);
   } else if (type == ZPageTypeMedium) {
-    _medium.insert_first(page);
+    _medium.get(page->numa_id()).insert_first(page);
   } else {
     _large.insert_first(page);
   }
@@ -236,6 +242,6 @@ void ZPageCache::flush_per_numa_lists(ZPageCacheFlushClosure* cl, ZPerNUMA<ZList
 void ZPageCache::flush(ZPageCacheFlushClosure* cl, ZList<ZPage>* to) {
   // Prefer flushing large, then medium and last small pages
   flush_list(cl, &_large, to);
-  flush_list(cl, &_medium, to);
+  flush_per_numa_lists(cl, &_medium, to);
   flush_per_numa_lists(cl, &_small, to);
 }
@@ -44,9 +44,10 @@ class ZPageCache {
 private:
   size_t                  _available;
   ZPerNUMA<ZList<ZPage> > _small;
-  ZList<ZPage>            _medium;
+  ZPerNUMA<ZList<ZPage> > _medium;
   ZList<ZPage>            _large;
 
+  ZPage* alloc_numa_page(ZPerNUMA<ZList<ZPage> >* lists);
   ZPage* alloc_small_page();
   ZPage* alloc_medium_page();
   ZPage* alloc_large_page(size_t size);
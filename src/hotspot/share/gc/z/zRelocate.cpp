@@ -36,11 +36,18 @@
 #include "gc/z/zThreadLocalAllocBuffer.hpp"
 #include "gc/z/zWorkers.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 
 static const ZStatCounter ZCounterRelocationContention("Contention", "Relocation Contention", ZStatUnitOpsPerSecond);
+static const ZStatCounter ZCounterRelocationAssist("Memory", "Relocation Assist", ZStatUnitOpsPerSecond);
 
 ZRelocate::ZRelocate(ZWorkers* workers) :
-    _workers(workers) {}
+    _workers(workers),
+    _assist_iter(NULL),
+    _nassisting(0),
+    _assist_failed(false) {}
 
 class ZRelocateRootsIteratorClosure : public ZRootsIteratorClosure {
 public:
@@ -171,25 +178,32 @@ public:
   }
 };
 
+bool ZRelocate::relocate_page(ZForwarding* forwarding) {
+  // Relocate objects in page
+  ZRelocateObjectClosure cl(this, forwarding);
+  forwarding->page()->object_iterate(&cl);
+
+  if (ZVerifyForwarding) {
+    forwarding->verify();
+  }
+
+  if (forwarding->is_pinned()) {
+    // Relocation failed, page is now pinned
+    return false;
+  }
+
+  // Relocation succeeded, release page
+  forwarding->release_page();
+  return true;
+}
+
 bool ZRelocate::work(ZRelocationSetParallelIterator* iter) {
   bool success = true;
 
   // Relocate pages in the relocation set
   for (ZForwarding* forwarding; iter->next(&forwarding);) {
-    // Relocate objects in page
-    ZRelocateObjectClosure cl(this, forwarding);
-    forwarding->page()->object_iterate(&cl);
-
-    if (ZVerifyForwarding) {
-      forwarding->verify();
-    }
-
-    if (forwarding->is_pinned()) {
-      // Relocation failed, page is now pinned
+    if (!relocate_page(forwarding)) {
       success = false;
-    } else {
-      // Relocation succeeded, release page
-      forwarding->release_page();
     }
   }
 
@@ -215,13 +229,60 @@ public:
     }
   }
 
+  ZRelocationSetParallelIterator* iter() {
+    return &_iter;
+  }
+
   bool failed() const {
     return _failed;
   }
 };
 
+void ZRelocate::assist_begin(ZRelocationSetParallelIterator* iter) {
+  assert(Atomic::load(&_nassisting) == 0, "Should not be assisted");
+  _assist_failed = false;
+  OrderAccess::release_store(&_assist_iter, iter);
+}
+
+bool ZRelocate::assist_end() {
+  Atomic::store((ZRelocationSetParallelIterator*)NULL, &_assist_iter);
+  OrderAccess::fence();
+
+  // Wait for Java threads still relocating a page they claimed. Each of
+  // them relocates at most a few pages, so this is short.
+  while (Atomic::load(&_nassisting) > 0) {
+    os::naked_yield();
+  }
+
+  return !Atomic::load(&_assist_failed);
+}
+
+void ZRelocate::assist(size_t npages) {
+  assert(ZThread::is_java(), "Should be a Java thread");
+
+  // Announce ourselves before looking for the iterator, so that the
+  // relocation set is not torn down while we use it. Atomic::inc() is
+  // a full fence, ordering it with the load below.
+  Atomic::inc(&_nassisting);
+
+  ZRelocationSetParallelIterator* const iter = OrderAccess::load_acquire(&_assist_iter);
+  if (iter != NULL) {
+    ZForwarding* forwarding;
+    for (size_t i = 0; i < npages && iter->next(&forwarding); i++) {
+      ZStatInc(ZCounterRelocationAssist);
+      if (!relocate_page(forwarding)) {
+        Atomic::store(true, &_assist_failed);
+      }
+    }
+  }
+
+  Atomic::dec(&_nassisting);
+}
+
 bool ZRelocate::relocate(ZRelocationSet* relocation_set) {
   ZRelocateTask task(this, relocation_set);
+  assist_begin(task.iter());
   _workers->run_concurrent(&task);
-  return !task.failed();
+  const bool assist_success = assist_end();
+  return !task.failed() && assist_success;
 }
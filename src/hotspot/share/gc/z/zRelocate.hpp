@@ -34,12 +34,19 @@ class ZRelocate {
   friend class ZRelocateTask;
 
 private:
-  ZWorkers* const _workers;
+  ZWorkers* const                          _workers;
+  ZRelocationSetParallelIterator* volatile _assist_iter;
+  volatile uint                            _nassisting;
+  volatile bool                            _assist_failed;
 
   ZForwarding* forwarding_for_page(ZPage* page) const;
   uintptr_t relocate_object_inner(ZForwarding* forwarding, uintptr_t from_index, uintptr_t from_offset) const;
+  bool relocate_page(ZForwarding* forwarding);
   bool work(ZRelocationSetParallelIterator* iter);
 
+  void assist_begin(ZRelocationSetParallelIterator* iter);
+  bool assist_end();
+
 public:
   ZRelocate(ZWorkers* workers);
 
@@ -48,6 +55,10 @@ public:
 
   void start();
   bool relocate(ZRelocationSet* relocation_set);
+
+  // Relocates up to npages pages of the relocation set on behalf of the
+  // calling Java thread, if concurrent relocation is in progress.
+  void assist(size_t npages);
 };
 
 #endif // SHARE_GC_Z_ZRELOCATE_HPP
@@ -823,6 +823,10 @@ uint64_t ZStatAllocRate::sample_and_reset() {
   return bytes_per_second;
 }
 
+double ZStatAllocRate::last() {
+  return _rate.last();
+}
+
 double ZStatAllocRate::avg() {
   return _rate.avg();
 }
@@ -334,6 +334,7 @@ public:
   static const ZStatUnsampledCounter& counter();
   static uint64_t sample_and_reset();
 
+  static double last();
   static double avg();
   static double avg_sd();
 };
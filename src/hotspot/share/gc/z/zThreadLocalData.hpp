@@ -32,12 +32,16 @@
 
 class ZThreadLocalData {
 private:
-  uintptr_t              _address_bad_mask;
-  ZMarkThreadLocalStacks _stacks;
+  uintptr_t               _address_bad_mask;
+  ZMarkThreadLocalStacks* _stacks;
 
   ZThreadLocalData() :
       _address_bad_mask(0),
-      _stacks() {}
+      _stacks(new ZMarkThreadLocalStacks()) {}
+
+  ~ZThreadLocalData() {
+    delete _stacks;
+  }
 
   static ZThreadLocalData* data(Thread* thread) {
     return thread->gc_data<ZThreadLocalData>();
@@ -57,7 +61,7 @@ public:
   }
 
   static ZMarkThreadLocalStacks* stacks(Thread* thread) {
-    return &data(thread)->_stacks;
+    return data(thread)->_stacks;
   }
 
   static ByteSize address_bad_mask_offset() {
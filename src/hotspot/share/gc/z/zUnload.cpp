@@ -37,6 +37,11 @@
 #include "oops/access.inline.hpp"
 
 static const ZStatSubPhase ZSubPhaseConcurrentClassesUnload("Concurrent Classes Unload");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesUnlink("Concurrent Classes Unlink");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesUnlinkNMethods("Concurrent Classes Unlink NMethods");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesHandshake("Concurrent Classes Handshake");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesPurgeNMethods("Concurrent Classes Purge NMethods");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesPurge("Concurrent Classes Purge");
 
 class ZIsUnloadingOopClosure : public OopClosure {
 private:
@@ -130,23 +135,32 @@ void ZUnload::unlink() {
   bool unloading_occurred;
 
   {
-    MutexLocker ml(ClassLoaderDataGraph_lock);
-    unloading_occurred = SystemDictionary::do_unloading(ZStatPhase::timer());
-  }
+    ZStatTimer timer(ZSubPhaseConcurrentClassesUnlink);
+
+    {
+      MutexLocker ml(ClassLoaderDataGraph_lock);
+      unloading_occurred = SystemDictionary::do_unloading(ZStatPhase::timer());
+    }
 
-  Klass::clean_weak_klass_links(unloading_occurred);
+    Klass::clean_weak_klass_links(unloading_occurred);
+  }
 
-  ZNMethod::unlink(_workers, unloading_occurred);
+  {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesUnlinkNMethods);
+    ZNMethod::unlink(_workers, unloading_occurred);
+  }
 
   DependencyContext::cleaning_end();
 }
 
 void ZUnload::purge() {
   {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesPurgeNMethods);
     SuspendibleThreadSetJoiner sts;
     ZNMethod::purge(_workers);
   }
 
+  ZStatTimer timer(ZSubPhaseConcurrentClassesPurge);
   ClassLoaderDataGraph::purge();
   CodeCache::purge_exception_caches();
 }
@@ -167,8 +181,11 @@ void ZUnload::unload() {
   unlink();
 
   // Make sure stale metadata and nmethods are no longer observable
-  ZUnloadRendezvousClosure cl;
-  Handshake::execute(&cl);
+  {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesHandshake);
+    ZUnloadRendezvousClosure cl;
+    Handshake::execute(&cl);
+  }
 
   // Purge stale metadata and nmethods that were unlinked
   purge();
@@ -100,7 +100,9 @@ public:
 class ZPerNUMAStorage : public ZValueStorage<ZPerNUMAStorage> {
 public:
   static size_t alignment() {
-    return sizeof(uintptr_t);
+    // Per-NUMA values are shared by all threads on a node and
+    // can be heavily contended, so give each its own cache line.
+    return ZCacheLineSize;
   }
 
   static uint32_t count() {
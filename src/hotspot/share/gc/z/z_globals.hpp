@@ -53,6 +53,12 @@
           "Maximum number of bytes allocated for mark stacks")              \
           range(32*M, 1024*G)                                               \
                                                                             \
+  experimental(uint, ZRelocationAssistPages, 0,                             \
+          "Number of pages of the relocation set a Java thread relocates "  \
+          "itself when its allocation stalls during concurrent "            \
+          "relocation, before waiting for the GC (0 disables)")             \
+          range(0, 1024)                                                    \
+                                                                            \
   experimental(uint, ZCollectionInterval, 0,                                \
           "Force GC at a fixed time interval (in seconds)")                 \
                                                                             \
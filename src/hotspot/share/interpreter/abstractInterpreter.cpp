@@ -139,6 +139,9 @@ AbstractInterpreter::MethodKind AbstractInterpreter::method_kind(const methodHan
     case vmIntrinsics::_floatToRawIntBits:   return java_lang_Float_floatToRawIntBits;
     case vmIntrinsics::_longBitsToDouble:    return java_lang_Double_longBitsToDouble;
     case vmIntrinsics::_doubleToRawLongBits: return java_lang_Double_doubleToRawLongBits;
+    // Continuation freeze and thaw are implemented by generated stubs.
+    case vmIntrinsics::_Continuation_doYield:    return java_lang_Continuation_doYield;
+    case vmIntrinsics::_Continuation_doContinue: return java_lang_Continuation_doContinue;
     default:                                 break;
   }
 #endif // CC_INTERP
@@ -312,6 +315,8 @@ void AbstractInterpreter::print_method_kind(MethodKind kind) {
     case java_util_zip_CRC32_updateByteBuffer : tty->print("java_util_zip_CRC32_updateByteBuffer"); break;
     case java_util_zip_CRC32C_updateBytes     : tty->print("java_util_zip_CRC32C_updateBytes"); break;
     case java_util_zip_CRC32C_updateDirectByteBuffer: tty->print("java_util_zip_CRC32C_updateDirectByteByffer"); break;
+    case java_lang_Continuation_doYield       : tty->print("java_lang_Continuation_doYield"); break;
+    case java_lang_Continuation_doContinue    : tty->print("java_lang_Continuation_doContinue"); break;
     default:
       if (kind >= method_handle_invoke_FIRST &&
           kind <= method_handle_invoke_LAST) {
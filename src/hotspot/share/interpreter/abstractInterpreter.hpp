@@ -89,6 +89,8 @@ class AbstractInterpreter: AllStatic {
     java_lang_Float_floatToRawIntBits,                          // implementation of java.lang.Float.floatToRawIntBits()
     java_lang_Double_longBitsToDouble,                          // implementation of java.lang.Double.longBitsToDouble()
     java_lang_Double_doubleToRawLongBits,                       // implementation of java.lang.Double.doubleToRawLongBits()
+    java_lang_Continuation_doYield,                             // implementation of java.lang.Continuation.doYield()
+    java_lang_Continuation_doContinue,                          // implementation of java.lang.Continuation.doContinue()
     number_of_method_entries,
     invalid = -1
   };
@@ -166,6 +168,8 @@ class AbstractInterpreter: AllStatic {
       case vmIntrinsics::_dexp  : // fall thru
       case vmIntrinsics::_fmaD  : // fall thru
       case vmIntrinsics::_fmaF  : // fall thru
+      case vmIntrinsics::_Continuation_doYield   : // fall thru
+      case vmIntrinsics::_Continuation_doContinue: // fall thru
         return false;
       default:
         return true;
@@ -425,15 +425,23 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int bci) const {
   // We use method->code_size() rather than method->identity_hash() below since
   // the mark may not be present if a pointer to the method is already reversed.
+  // The Method* address separates methods of the same shape.
   return   ((unsigned int) bci)
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
-         ^ ((unsigned int) method->size_of_parameters() << 6);
+         ^ ((unsigned int) method->size_of_parameters() << 6)
+         ^ ((unsigned int) (p2i(method()) >> LogBytesPerWord) * 31);
 }
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
 
-OopMapCache::OopMapCache() {
+OopMapCache::OopMapCache(int method_count) {
+  // Scale the table with the number of methods in the class so that
+  // large classes do not keep evicting each other's entries.
+  _size = _min_size;
+  while (_size < _max_size && _size < method_count * _entries_per_method) {
+    _size <<= 1;
+  }
   _array  = NEW_C_HEAP_ARRAY(OopMapCacheEntry*, _size, mtClass);
   for(int i = 0; i < _size; i++) _array[i] = NULL;
 }
@@ -448,11 +456,11 @@ OopMapCache::~OopMapCache() {
 }
 
 OopMapCacheEntry* OopMapCache::entry_at(int i) const {
-  return OrderAccess::load_acquire(&(_array[i % _size]));
+  return OrderAccess::load_acquire(&(_array[i & (_size - 1)]));
 }
 
 bool OopMapCache::put_at(int i, OopMapCacheEntry* entry, OopMapCacheEntry* old) {
-  return Atomic::cmpxchg(entry, &_array[i % _size], old) == old;
+  return Atomic::cmpxchg(entry, &_array[i & (_size - 1)], old) == old;
 }
 
 void OopMapCache::flush() {
@@ -147,10 +147,13 @@ class InterpreterOopMap: ResourceObj {
 class OopMapCache : public CHeapObj<mtClass> {
  static OopMapCacheEntry* volatile _old_entries;
  private:
-  enum { _size        = 32,     // Use fixed size for now
-         _probe_depth = 3       // probe depth in case of collisions
+  enum { _min_size           = 32,    // table size for small classes
+         _max_size           = 1024,  // table size cap for large classes
+         _entries_per_method = 4,     // expected cached bcis per method
+         _probe_depth        = 3      // probe depth in case of collisions
   };
 
+  int _size;                         // power of two, fixed at creation
   OopMapCacheEntry* volatile * _array;
 
   unsigned int hash_value_for(const methodHandle& method, int bci) const;
@@ -162,7 +165,7 @@ class OopMapCache : public CHeapObj<mtClass> {
   void flush();
 
  public:
-  OopMapCache();
+  OopMapCache(int method_count);
   ~OopMapCache();                                // free up memory
 
   // flush cache entry is occupied by an obsolete method
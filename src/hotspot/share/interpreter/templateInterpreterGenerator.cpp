@@ -31,6 +31,7 @@
 #include "interpreter/templateInterpreterGenerator.hpp"
 #include "interpreter/templateTable.hpp"
 #include "oops/methodData.hpp"
+#include "runtime/stubRoutines.hpp"
 
 #ifndef CC_INTERP
 
@@ -228,6 +229,9 @@ void TemplateInterpreterGenerator::generate_all() {
   method_entry(java_lang_Double_longBitsToDouble);
   method_entry(java_lang_Double_doubleToRawLongBits);
 
+  method_entry(java_lang_Continuation_doYield)
+  method_entry(java_lang_Continuation_doContinue)
+
 #undef method_entry
 
   // Bytecodes
@@ -461,6 +465,12 @@ address TemplateInterpreterGenerator::generate_method_entry(
     native = true;
     break;
 #endif // !IA32
+  // The continuation entries jump straight into the freeze/thaw stubs. On
+  // platforms without them the Java fallback body of the method is used.
+  case Interpreter::java_lang_Continuation_doYield
+                                           : entry_point = StubRoutines::cont_doYield(); break;
+  case Interpreter::java_lang_Continuation_doContinue
+                                           : entry_point = StubRoutines::cont_doContinue(); break;
   default:
     fatal("unexpected method kind: %d", kind);
     break;
@@ -33,6 +33,7 @@
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "gc/g1/g1HeapRegionEventSender.hpp"
+#include "gc/shared/allocationProfile.hpp"
 #include "gc/shared/gcConfiguration.hpp"
 #include "gc/shared/gcTrace.hpp"
 #include "gc/shared/gcVMOperations.hpp"
@@ -437,6 +438,12 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
   }
 }
 
+TRACE_REQUEST_FUNC(ObjectAllocationProfile) {
+  if (AllocationProfiling) {
+    AllocationProfile::send_events();
+  }
+}
+
 /**
  *  PhysicalMemory event represents:
  *
@@ -518,8 +525,7 @@ TRACE_REQUEST_FUNC(ClassLoaderStatistics) {
 }
 
 template<typename EVENT>
-static void emit_table_statistics(TableStatistics statistics) {
-  EVENT event;
+static void set_table_statistics(EVENT& event, TableStatistics statistics) {
   event.set_bucketCount(statistics._number_of_buckets);
   event.set_entryCount(statistics._number_of_entries);
   event.set_totalFootprint(statistics._total_footprint);
@@ -529,6 +535,12 @@ static void emit_table_statistics(TableStatistics statistics) {
   event.set_bucketCountStandardDeviation(statistics._stddev_of_bucket_size);
   event.set_insertionRate(statistics._add_rate);
   event.set_removalRate(statistics._remove_rate);
+}
+
+template<typename EVENT>
+static void emit_table_statistics(TableStatistics statistics) {
+  EVENT event;
+  set_table_statistics(event, statistics);
   event.commit();
 }
 
@@ -539,7 +551,11 @@ TRACE_REQUEST_FUNC(SymbolTableStatistics) {
 
 TRACE_REQUEST_FUNC(StringTableStatistics) {
   TableStatistics statistics = StringTable::get_table_statistics();
-  emit_table_statistics<EventStringTableStatistics>(statistics);
+  EventStringTableStatistics event;
+  set_table_statistics(event, statistics);
+  event.set_internCount(StringTable::intern_count());
+  event.set_internHitCount(StringTable::intern_hit_count());
+  event.commit();
 }
 
 TRACE_REQUEST_FUNC(PlaceholderTableStatistics) {
@@ -32,6 +32,7 @@
 #include "jfr/support/jfrThreadId.hpp"
 #include "jfr/utilities/jfrTime.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/os.hpp"
 #include "runtime/semaphore.hpp"
@@ -190,6 +191,7 @@ void OSThreadSampler::protected_task(const os::SuspendedThreadTaskContext& conte
       ev->set_endtime(_suspend_time); // fake to not take an end time
       ev->set_sampledThread(JFR_THREAD_ID(jth));
       ev->set_state(java_lang_Thread::get_thread_status(jth->threadObj()));
+      ev->set_continuation(jth->cont_mount_id());
     }
   }
 }
@@ -285,6 +287,11 @@ bool JfrThreadSampleClosure::sample_thread_in_native(JavaThread* thread, JfrStac
 static const uint MAX_NR_OF_JAVA_SAMPLES = 5;
 static const uint MAX_NR_OF_NATIVE_SAMPLES = 1;
 
+// Set by every Java sampling round. Continuations are sampled when they
+// yield rather than while they are unmounted, since there may be millions
+// of them and the VM does not keep track of those not mounted.
+static volatile int _yield_sample_pending = 0;
+
 void JfrThreadSampleClosure::commit_events(JfrSampleType type) {
   if (JAVA_SAMPLE == type) {
     assert(_added_java > 0 && _added_java <= MAX_NR_OF_JAVA_SAMPLES, "invariant");
@@ -503,6 +510,9 @@ void JfrThreadSampler::post_run() {
 
 
 void JfrThreadSampler::task_stacktrace(JfrSampleType type, JavaThread** last_thread) {
+  if (JAVA_SAMPLE == type) {
+    Atomic::store(1, &_yield_sample_pending);
+  }
   ResourceMark rm;
   EventExecutionSample samples[MAX_NR_OF_JAVA_SAMPLES];
   EventNativeMethodSample samples_native[MAX_NR_OF_NATIVE_SAMPLES];
@@ -633,3 +643,7 @@ void JfrThreadSampling::set_native_sample_interval(size_t period) {
 void JfrThreadSampling::on_javathread_suspend(JavaThread* thread) {
   JfrThreadSampler::on_javathread_suspend(thread);
 }
+
+bool JfrThreadSampling::claim_yield_sample() {
+  return _yield_sample_pending != 0 && Atomic::cmpxchg(0, &_yield_sample_pending, 1) == 1;
+}
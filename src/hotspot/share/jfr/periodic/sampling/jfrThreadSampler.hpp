@@ -50,6 +50,9 @@ class JfrThreadSampling : public JfrCHeapObj {
   static void set_java_sample_interval(size_t period);
   static void set_native_sample_interval(size_t period);
   static void on_javathread_suspend(JavaThread* thread);
+  // True for the first yield of a continuation since the last Java
+  // sampling round, which samples it
+  static bool claim_yield_sample();
 };
 
 #endif // SHARE_JFR_PERIODIC_SAMPLING_JFRTHREADSAMPLER_HPP
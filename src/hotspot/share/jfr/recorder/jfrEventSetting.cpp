@@ -26,6 +26,7 @@
 #include "jfr/recorder/jfrEventSetting.inline.hpp"
 
 JfrNativeSettings JfrEventSetting::_jvm_event_settings;
+volatile u4 JfrEventSetting::_enabled_generation[MaxJfrEventId];
 
 bool JfrEventSetting::set_threshold(jlong id, jlong threshold_ticks) {
   JfrEventId event_id = (JfrEventId)id;
@@ -50,6 +51,9 @@ void JfrEventSetting::set_stacktrace(jlong id, bool enabled) {
 void JfrEventSetting::set_enabled(jlong id, bool enabled) {
   JfrEventId event_id = (JfrEventId)id;
   assert(bounds_check_event(event_id), "invariant");
+  if (enabled && !is_enabled(event_id)) {
+    _enabled_generation[event_id]++;
+  }
   setting(event_id).enabled = enabled;
 }
 
@@ -35,6 +35,7 @@
 class JfrEventSetting : AllStatic {
  private:
   static JfrNativeSettings _jvm_event_settings;
+  static volatile u4 _enabled_generation[MaxJfrEventId];
   static jfrNativeEventSetting& setting(JfrEventId event_id);
 
  public:
@@ -46,6 +47,9 @@ class JfrEventSetting : AllStatic {
   static jlong threshold(JfrEventId event_id);
   static bool set_cutoff(jlong event_id, jlong cutoff_ticks);
   static jlong cutoff(JfrEventId event_id);
+  // Incremented each time the event is enabled, so that per-thread sampling
+  // state left over from an earlier recording can be told apart.
+  static u4 enabled_generation(JfrEventId event_id);
   DEBUG_ONLY(static bool bounds_check_event(jlong id);)
 };
 
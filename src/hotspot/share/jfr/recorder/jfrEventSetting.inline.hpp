@@ -47,4 +47,8 @@ inline jlong JfrEventSetting::cutoff(JfrEventId event_id) {
   return setting(event_id).cutoff_ticks;
 }
 
+inline u4 JfrEventSetting::enabled_generation(JfrEventId event_id) {
+  return _enabled_generation[event_id];
+}
+
 #endif // SHARE_JFR_RECORDER_JFREVENTSETTING_INLINE_HPP
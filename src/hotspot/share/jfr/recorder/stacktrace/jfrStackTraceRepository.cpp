@@ -30,11 +30,15 @@
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/continuation.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.inline.hpp"
+#include "utilities/globalCounter.inline.hpp"
+#include "utilities/vmError.hpp"
 
 class vframeStreamSamples : public vframeStreamCommon {
  public:
@@ -101,7 +105,7 @@ void JfrStackTraceRepository::destroy() {
 }
 
 JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0) {
-  memset(_table, 0, sizeof(_table));
+  memset((void*)_table, 0, sizeof(_table));
 }
 class JfrFrameType : public JfrSerializer {
  public:
@@ -122,28 +126,75 @@ bool JfrStackTraceRepository::initialize() {
   return JfrSerializer::register_serializer(TYPE_FRAMETYPE, false, true, new JfrFrameType());
 }
 
-size_t JfrStackTraceRepository::clear() {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  if (_entries == 0) {
-    return 0;
+// Entries are looked up without the lock (see add_trace), so they are
+// detached from the table under the lock and only deleted once no reader
+// can still see them.
+JfrStackTraceRepository::StackTrace** JfrStackTraceRepository::detach_entries() {
+  assert(JfrStacktrace_lock->owned_by_self(), "invariant");
+  StackTrace** const detached = NEW_C_HEAP_ARRAY(StackTrace*, TABLE_SIZE, mtTracing);
+  memcpy(detached, (void*)_table, sizeof(_table));
+  memset((void*)_table, 0, sizeof(_table));
+  _entries = 0;
+  return detached;
+}
+
+void JfrStackTraceRepository::delete_entries(StackTrace** detached) {
+  assert(!JfrStacktrace_lock->owned_by_self(), "invariant");
+  if (VMError::is_error_reported()) {
+    // Readers may never leave their critical sections, leak instead.
+    return;
   }
+  GlobalCounter::write_synchronize();
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
+    StackTrace* stacktrace = detached[i];
     while (stacktrace != NULL) {
-      JfrStackTraceRepository::StackTrace* next = stacktrace->next();
+      StackTrace* next = stacktrace->next();
       delete stacktrace;
       stacktrace = next;
     }
   }
-  memset(_table, 0, sizeof(_table));
-  const size_t processed = _entries;
-  _entries = 0;
+  FREE_C_HEAP_ARRAY(StackTrace*, detached);
+}
+
+size_t JfrStackTraceRepository::clear() {
+  StackTrace** detached;
+  size_t processed;
+  {
+    MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+    if (_entries == 0) {
+      return 0;
+    }
+    processed = _entries;
+    detached = detach_entries();
+  }
+  delete_entries(detached);
   return processed;
 }
 
+traceid JfrStackTraceRepository::lookup(size_t index, const JfrStackTrace& stacktrace) const {
+  const StackTrace* table_entry = OrderAccess::load_acquire(&_table[index]);
+  while (table_entry != NULL) {
+    if (table_entry->equals(stacktrace)) {
+      return table_entry->id();
+    }
+    table_entry = table_entry->next();
+  }
+  return 0;
+}
+
 traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   const size_t index = stacktrace._hash % TABLE_SIZE;
+  {
+    // Most stack traces are already known, so look for them without the lock.
+    // Entries are immutable once published and are only prepended to a bucket.
+    GlobalCounter::CriticalSection cs(Thread::current());
+    const traceid id = lookup(index, stacktrace);
+    if (id != 0) {
+      return id;
+    }
+  }
+
+  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   const StackTrace* table_entry = _table[index];
 
   while (table_entry != NULL) {
@@ -158,7 +209,7 @@ traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
   }
 
   traceid id = ++_next_id;
-  _table[index] = new StackTrace(id, stacktrace, _table[index]);
+  OrderAccess::release_store(&_table[index], new StackTrace(id, stacktrace, _table[index]));
   ++_entries;
   return id;
 }
@@ -219,26 +270,27 @@ bool JfrStackTraceRepository::fill_stacktrace_for(JavaThread* thread, JfrStackTr
 }
 
 size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  assert(_entries > 0, "invariant");
+  StackTrace** detached = NULL;
   int count = 0;
-  for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
-    while (stacktrace != NULL) {
-      JfrStackTraceRepository::StackTrace* next = stacktrace->next();
-      if (stacktrace->should_write()) {
-        stacktrace->write(sw);
-        ++count;
-      }
-      if (clear) {
-        delete stacktrace;
+  {
+    MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+    assert(_entries > 0, "invariant");
+    for (u4 i = 0; i < TABLE_SIZE; ++i) {
+      const StackTrace* stacktrace = _table[i];
+      while (stacktrace != NULL) {
+        if (stacktrace->should_write()) {
+          stacktrace->write(sw);
+          ++count;
+        }
+        stacktrace = stacktrace->next();
       }
-      stacktrace = next;
+    }
+    if (clear) {
+      detached = detach_entries();
     }
   }
-  if (clear) {
-    memset(_table, 0, sizeof(_table));
-    _entries = 0;
+  if (detached != NULL) {
+    delete_entries(detached);
   }
   return count;
 }
@@ -366,6 +418,7 @@ void JfrStackTrace::resolve_linenos() const {
 bool JfrStackTrace::record_safe(JavaThread* thread, int skip, bool leakp /* false */) {
   assert(thread == Thread::current(), "Thread stack needs to be walkable");
   vframeStream vfs(thread);
+  FrozenFrameStream frozen(thread);
   u4 count = 0;
   _reached_root = true;
   for(int i = 0; i < skip; i++) {
@@ -380,19 +433,27 @@ bool JfrStackTrace::record_safe(JavaThread* thread, int skip, bool leakp /* fals
       _reached_root = false;
       break;
     }
-    const Method* method = vfs.method();
+    // The frames of a lazily thawed continuation still frozen below the barrier
+    frozen.enter_at(vfs.frame_id());
+    const bool is_frozen = frozen.is_walking();
+    const Method* method = is_frozen ? frozen.method() : vfs.method();
     const traceid mid = JfrTraceId::use(method, leakp);
-    int type = vfs.is_interpreted_frame() ? JfrStackFrame::FRAME_INTERPRETER : JfrStackFrame::FRAME_JIT;
+    const bool interpreted = is_frozen ? frozen.is_interpreted_frame() : vfs.is_interpreted_frame();
+    int type = interpreted ? JfrStackFrame::FRAME_INTERPRETER : JfrStackFrame::FRAME_JIT;
     int bci = 0;
     if (method->is_native()) {
       type = JfrStackFrame::FRAME_NATIVE;
     } else {
-      bci = vfs.bci();
+      bci = is_frozen ? frozen.bci() : vfs.bci();
     }
     // Can we determine if it's inlined?
     _hash = (_hash << 2) + (unsigned int)(((size_t)mid >> 2) + (bci << 4) + type);
     _frames[count] = JfrStackFrame(mid, bci, type, method);
-    vfs.next();
+    if (is_frozen) {
+      frozen.next();
+    } else {
+      vfs.next();
+    }
     count++;
   }
 
@@ -402,6 +463,7 @@ bool JfrStackTrace::record_safe(JavaThread* thread, int skip, bool leakp /* fals
 
 bool JfrStackTrace::record_thread(JavaThread& thread, frame& frame) {
   vframeStreamSamples st(&thread, frame, false);
+  FrozenFrameStream frozen(&thread);
   u4 count = 0;
   _reached_root = true;
 
@@ -410,25 +472,33 @@ bool JfrStackTrace::record_thread(JavaThread& thread, frame& frame) {
       _reached_root = false;
       break;
     }
-    const Method* method = st.method();
+    // Attribute the sample to the whole stack of a lazily thawed continuation.
+    frozen.enter_at(st.frame_id());
+    const bool is_frozen = frozen.is_walking();
+    const Method* method = is_frozen ? frozen.method() : st.method();
     if (!Method::is_valid_method(method)) {
       // we throw away everything we've gathered in this sample since
       // none of it is safe
       return false;
     }
     const traceid mid = JfrTraceId::use(method);
-    int type = st.is_interpreted_frame() ? JfrStackFrame::FRAME_INTERPRETER : JfrStackFrame::FRAME_JIT;
+    const bool interpreted = is_frozen ? frozen.is_interpreted_frame() : st.is_interpreted_frame();
+    int type = interpreted ? JfrStackFrame::FRAME_INTERPRETER : JfrStackFrame::FRAME_JIT;
     int bci = 0;
     if (method->is_native()) {
       type = JfrStackFrame::FRAME_NATIVE;
     } else {
-      bci = st.bci();
+      bci = is_frozen ? frozen.bci() : st.bci();
     }
     const int lineno = method->line_number_from_bci(bci);
     // Can we determine if it's inlined?
     _hash = (_hash << 2) + (unsigned int)(((size_t)mid >> 2) + (bci << 4) + type);
     _frames[count] = JfrStackFrame(mid, bci, type, lineno);
-    st.samples_next();
+    if (is_frozen) {
+      frozen.next();
+    } else {
+      st.samples_next();
+    }
     count++;
   }
 
@@ -125,11 +125,14 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
  private:
   static const u4 TABLE_SIZE = 2053;
-  StackTrace* _table[TABLE_SIZE];
+  StackTrace* volatile _table[TABLE_SIZE];
   traceid _next_id;
   u4 _entries;
 
+  traceid lookup(size_t index, const JfrStackTrace& stacktrace) const;
   traceid add_trace(const JfrStackTrace& stacktrace);
+  StackTrace** detach_entries();
+  static void delete_entries(StackTrace** detached);
   static traceid add(const JfrStackTrace* stacktrace, JavaThread* thread);
   traceid record_for(JavaThread* thread, int skip, JfrStackFrame* frames, u4 max_frames);
 
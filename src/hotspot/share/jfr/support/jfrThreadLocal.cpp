@@ -52,6 +52,8 @@ JfrThreadLocal::JfrThreadLocal() :
   _user_time(0),
   _cpu_time(0),
   _wallclock_time(os::javaTimeNanos()),
+  _last_allocation_sample_bytes(0),
+  _allocation_sample_generation(0),
   _stack_trace_hash(0),
   _stackdepth(0),
   _entering_suspend_flag(0),
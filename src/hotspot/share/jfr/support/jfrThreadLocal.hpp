@@ -47,6 +47,8 @@ class JfrThreadLocal {
   jlong _user_time;
   jlong _cpu_time;
   jlong _wallclock_time;
+  jlong _last_allocation_sample_bytes;
+  u4 _allocation_sample_generation;
   unsigned int _stack_trace_hash;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
@@ -191,6 +193,22 @@ class JfrThreadLocal {
     _wallclock_time = wallclock_time;
   }
 
+  jlong last_allocation_sample_bytes() const {
+    return _last_allocation_sample_bytes;
+  }
+
+  void set_last_allocation_sample_bytes(jlong allocated_bytes) {
+    _last_allocation_sample_bytes = allocated_bytes;
+  }
+
+  u4 allocation_sample_generation() const {
+    return _allocation_sample_generation;
+  }
+
+  void set_allocation_sample_generation(u4 generation) {
+    _allocation_sample_generation = generation;
+  }
+
   traceid trace_id() const {
     return _trace_id;
   }
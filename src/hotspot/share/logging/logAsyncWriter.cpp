@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logFileOutput.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+
+class AsyncLogWriter::Message {
+ public:
+  Message*       _next;
+  LogFileOutput* _output;
+  size_t         _size;
+  size_t         _dropped_before;  // Messages of _output dropped right before this one
+
+  char* line() { return (char*)(this + 1); }
+};
+
+AsyncLogWriter* AsyncLogWriter::_instance = NULL;
+
+AsyncLogWriter::AsyncLogWriter()
+  : _lock(1), _io_lock(1), _work(0),
+    _head(NULL), _tail(NULL), _buffered_bytes(0), _stopped(false) {
+}
+
+void AsyncLogWriter::initialize() {
+  if (!AsyncLogging) {
+    return;
+  }
+  assert(_instance == NULL, "initialize only once");
+  AsyncLogWriter* writer = new AsyncLogWriter();
+  if (os::create_thread(writer, os::os_thread)) {
+    _instance = writer;
+    os::start_thread(writer);
+  } else {
+    log_warning(logging)("Unable to create the asynchronous log writer, logging synchronously.");
+    delete writer;
+  }
+}
+
+AsyncLogWriter::Message* AsyncLogWriter::new_message(LogFileOutput* output, const char* prefix, const char* msg) {
+  size_t prefix_len = strlen(prefix);
+  size_t msg_len = strlen(msg);
+  size_t size = sizeof(Message) + prefix_len + msg_len + 2;  // '\n' and '\0'
+
+  Message* m = (Message*)NEW_C_HEAP_ARRAY(char, size, mtLogging);
+  m->_next = NULL;
+  m->_output = output;
+  m->_size = size;
+  m->_dropped_before = 0;
+  char* line = m->line();
+  memcpy(line, prefix, prefix_len);
+  memcpy(line + prefix_len, msg, msg_len);
+  line[prefix_len + msg_len] = '\n';
+  line[prefix_len + msg_len + 1] = '\0';
+  return m;
+}
+
+void AsyncLogWriter::free_messages(Message* m) {
+  while (m != NULL) {
+    Message* next = m->_next;
+    FREE_C_HEAP_ARRAY(char, m);
+    m = next;
+  }
+}
+
+bool AsyncLogWriter::enqueue_locked(Message* m) {
+  LogFileOutput* output = m->_output;
+  if (_buffered_bytes + m->_size > AsyncLogBufferSize) {
+    output->inc_async_dropped();
+    return false;
+  }
+
+  // The writer tells the reader about the gap before this message.
+  m->_dropped_before = output->async_dropped();
+  output->reset_async_dropped();
+
+  m->_next = NULL;
+  if (_tail == NULL) {
+    _head = m;
+  } else {
+    _tail->_next = m;
+  }
+  _tail = m;
+  _buffered_bytes += m->_size;
+  return true;
+}
+
+bool AsyncLogWriter::enqueue(LogFileOutput* output, const LogDecorations& decorations, const char* msg) {
+  // Copy the message before taking the lock, so that the C-heap allocation
+  // does not hold up other logging threads.
+  char prefix[LogFileStreamOutput::MaxDecorationsPrefixSize];
+  output->format_decorations(decorations, prefix, sizeof(prefix));
+  Message* m = new_message(output, prefix, msg);
+
+  _lock.wait();
+  if (_stopped) {
+    _lock.signal();
+    free_messages(m);
+    return false;
+  }
+  bool enqueued = enqueue_locked(m);
+  _lock.signal();
+
+  if (enqueued) {
+    _work.signal();
+  } else {
+    free_messages(m);
+  }
+  return true;
+}
+
+bool AsyncLogWriter::enqueue(LogFileOutput* output, LogMessageBuffer::Iterator msg_iterator) {
+  char prefix[LogFileStreamOutput::MaxDecorationsPrefixSize];
+  Message* first = NULL;
+  Message* last = NULL;
+  for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    output->format_decorations(msg_iterator.decorations(), prefix, sizeof(prefix));
+    Message* m = new_message(output, prefix, msg_iterator.message());
+    if (last == NULL) {
+      first = m;
+    } else {
+      last->_next = m;
+    }
+    last = m;
+  }
+
+  // Enqueue all lines under one lock so that they stay together.
+  Message* dropped = NULL;
+  _lock.wait();
+  if (_stopped) {
+    _lock.signal();
+    free_messages(first);
+    return false;
+  }
+  while (first != NULL) {
+    Message* m = first;
+    first = m->_next;
+    if (!enqueue_locked(m)) {
+      m->_next = dropped;
+      dropped = m;
+    }
+  }
+  _lock.signal();
+
+  free_messages(dropped);
+  _work.signal();
+  return true;
+}
+
+void AsyncLogWriter::write_pending(bool stop) {
+  _io_lock.wait();
+
+  _lock.wait();
+  Message* m = _head;
+  _head = _tail = NULL;
+  _buffered_bytes = 0;
+  if (stop) {
+    _stopped = true;
+  }
+  _lock.signal();
+
+  while (m != NULL) {
+    Message* next = m->_next;
+    if (m->_dropped_before > 0) {
+      char notice[64];
+      jio_snprintf(notice, sizeof(notice), "[" SIZE_FORMAT " messages dropped due to async logging]\n",
+                   m->_dropped_before);
+      m->_output->write_async_line(notice);
+    }
+    m->_output->write_async_line(m->line());
+    FREE_C_HEAP_ARRAY(char, m);
+    m = next;
+  }
+
+  _io_lock.signal();
+}
+
+void AsyncLogWriter::flush() {
+  if (_instance != NULL) {
+    _instance->write_pending(false);
+  }
+}
+
+void AsyncLogWriter::stop() {
+  if (_instance != NULL) {
+    _instance->write_pending(true);
+  }
+}
+
+void AsyncLogWriter::run() {
+  while (true) {
+    _work.wait();
+    write_pending(false);
+  }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_LOGGING_LOGASYNCWRITER_HPP
+
+#include "logging/logMessageBuffer.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class LogDecorations;
+class LogFileOutput;
+
+// Writer thread for file log outputs, enabled with -XX:+AsyncLogging.
+//
+// Logging threads render each message (with its decorations) into a
+// C-heap copy and append it to a FIFO; only the writer thread does file
+// I/O, so a slow file system does not stretch safepoints or GC pauses.
+// When more than AsyncLogBufferSize bytes are pending, further messages
+// are dropped and the number of dropped messages is reported in the
+// output once there is room again. After stop(), at VM exit, messages are
+// written synchronously by the logging threads again.
+class AsyncLogWriter : public NonJavaThread {
+  friend class AsyncLogWriterTest;
+  class Message;
+
+  static AsyncLogWriter* _instance;
+
+  Semaphore _lock;        // Protects the FIFO. A semaphore, so that any thread can log.
+  Semaphore _io_lock;     // Held while pending messages are written out.
+  Semaphore _work;        // Signalled when messages have been enqueued.
+  Message*  _head;
+  Message*  _tail;
+  size_t    _buffered_bytes;
+  bool      _stopped;
+
+  AsyncLogWriter();
+
+  static Message* new_message(LogFileOutput* output, const char* prefix, const char* msg);
+  static void free_messages(Message* m);
+
+  // Must be called with _lock held. Returns false if m was dropped.
+  bool enqueue_locked(Message* m);
+  void write_pending(bool stop);
+
+ public:
+  static void initialize();
+  static AsyncLogWriter* instance() { return _instance; }
+
+  // Return false if the writer has been stopped, in which case the caller
+  // writes the message itself.
+  bool enqueue(LogFileOutput* output, const LogDecorations& decorations, const char* msg);
+  bool enqueue(LogFileOutput* output, LogMessageBuffer::Iterator msg_iterator);
+
+  // Write out all messages enqueued so far. Must be called before an
+  // output is deleted.
+  static void flush();
+
+  // Write out all messages enqueued so far, and have later messages be
+  // written synchronously.
+  static void stop();
+
+  virtual void run();
+  virtual char* name() const { return (char*)"Async Log Writer"; }
+};
+
+#endif // SHARE_LOGGING_LOGASYNCWRITER_HPP
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -207,6 +208,8 @@ void LogConfiguration::delete_output(size_t idx) {
          "idx must be in range 1 < idx < _n_outputs, but idx = " SIZE_FORMAT
          " and _n_outputs = " SIZE_FORMAT, idx, _n_outputs);
   LogOutput* output = _outputs[idx];
+  // Make sure no pending asynchronous message refers to the output
+  AsyncLogWriter::flush();
   // Swap places with the last output and shrink the array
   _outputs[idx] = _outputs[--_n_outputs];
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
@@ -63,6 +63,10 @@ class LogFileOutput : public LogFileStreamOutput {
   // Semaphore used for synchronizing file rotations and writes
   Semaphore _rotation_semaphore;
 
+  // Messages dropped by the AsyncLogWriter since the last one written,
+  // only accessed with the writer's lock held.
+  size_t _async_dropped;
+
   void archive();
   void rotate();
   bool parse_options(const char* options, outputStream* errstream);
@@ -86,6 +90,13 @@ class LogFileOutput : public LogFileStreamOutput {
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
   virtual void force_rotate();
+
+  // Used by the AsyncLogWriter.
+  void write_async_line(const char* line);
+  size_t async_dropped() const { return _async_dropped; }
+  void inc_async_dropped()     { _async_dropped++; }
+  void reset_async_dropped()   { _async_dropped = 0; }
+
   virtual void describe(outputStream* out);
 
   virtual const char* name() const {
@@ -72,6 +72,33 @@ int LogFileStreamOutput::write_decorations(const LogDecorations& decorations) {
   return total_written;
 }
 
+void LogFileStreamOutput::format_decorations(const LogDecorations& decorations, char* buf, size_t len) {
+  assert(len > 0, "must have room for the terminator");
+  buf[0] = '\0';
+  if (_decorators.is_empty()) {
+    return;
+  }
+
+  size_t pos = 0;
+  for (uint i = 0; i < LogDecorators::Count && pos < len; i++) {
+    LogDecorators::Decorator decorator = static_cast<LogDecorators::Decorator>(i);
+    if (!_decorators.is_decorator(decorator)) {
+      continue;
+    }
+
+    int written = jio_snprintf(buf + pos, len - pos, "[%-*s]",
+                               _decorator_padding[decorator],
+                               decorations.decoration(decorator));
+    if (written <= 0) {
+      break;
+    } else if (static_cast<size_t>(written - 2) > _decorator_padding[decorator]) {
+      _decorator_padding[decorator] = written - 2;
+    }
+    pos = MIN2(pos + written, len - 1);
+  }
+  jio_snprintf(buf + pos, len - pos, " ");
+}
+
 int LogFileStreamOutput::write(const LogDecorations& decorations, const char* msg) {
   const bool use_decorations = !_decorators.is_empty();
 
@@ -53,6 +53,12 @@ class LogFileStreamOutput : public LogOutput {
   int write_decorations(const LogDecorations& decorations);
 
  public:
+  static const size_t MaxDecorationsPrefixSize = 512;
+
+  // Formats the decorations as write() would print them, including the
+  // separating space, truncating to len. Used for asynchronous logging.
+  void format_decorations(const LogDecorations& decorations, char* buf, size_t len);
+
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
 };
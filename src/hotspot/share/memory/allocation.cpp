@@ -50,14 +50,14 @@ char* AllocateHeap(size_t size,
 char* AllocateHeap(size_t size,
                    MEMFLAGS flags,
                    AllocFailType alloc_failmode /* = AllocFailStrategy::EXIT_OOM*/) {
-  return AllocateHeap(size, flags, CALLER_PC);
+  return AllocateHeap(size, flags, SAMPLED_CALLER_PC(size));
 }
 
 char* ReallocateHeap(char *old,
                      size_t size,
                      MEMFLAGS flag,
                      AllocFailType alloc_failmode) {
-  char* p = (char*) os::realloc(old, size, flag, CALLER_PC);
+  char* p = (char*) os::realloc(old, size, flag, SAMPLED_CALLER_PC(size));
   if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
     vm_exit_out_of_memory(size, OOM_MALLOC_ERROR, "ReallocateHeap");
   }
@@ -113,7 +113,7 @@ void* ResourceObj::operator new(size_t size, allocation_type type, MEMFLAGS flag
   address res = NULL;
   switch (type) {
    case C_HEAP:
-    res = (address)AllocateHeap(size, flags, CALLER_PC);
+    res = (address)AllocateHeap(size, flags, SAMPLED_CALLER_PC(size));
     DEBUG_ONLY(set_allocation_type(res, C_HEAP);)
     break;
    case RESOURCE_AREA:
@@ -136,7 +136,7 @@ void* ResourceObj::operator new(size_t size, const std::nothrow_t&  nothrow_cons
   address res = NULL;
   switch (type) {
    case C_HEAP:
-    res = (address)AllocateHeap(size, flags, CALLER_PC, AllocFailStrategy::RETURN_NULL);
+    res = (address)AllocateHeap(size, flags, SAMPLED_CALLER_PC(size), AllocFailStrategy::RETURN_NULL);
     DEBUG_ONLY(if (res!= NULL) set_allocation_type(res, C_HEAP);)
     break;
    case RESOURCE_AREA:
@@ -135,6 +135,7 @@ class AllocatedObj {
   f(mtModule,        "Module")                                                      \
   f(mtSafepoint,     "Safepoint")                                                   \
   f(mtSynchronizer,  "Synchronization")                                             \
+  f(mtContinuation,  "Continuation") /* carrier pool, frozen stack chunks        */ \
   f(mtNone,          "Unknown")                                                     \
   //end
 
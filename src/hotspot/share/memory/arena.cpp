@@ -30,6 +30,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -124,6 +125,26 @@ class ChunkPool: public CHeapObj<mtInternal> {
     }
   }
 
+  // Index of the pool for chunks of the given length, or -1
+  static int pool_index(size_t length) {
+    switch (length) {
+     case Chunk::size:        return 0;
+     case Chunk::medium_size: return 1;
+     case Chunk::init_size:   return 2;
+     case Chunk::tiny_size:   return 3;
+     default:                 return -1;
+    }
+  }
+
+  static ChunkPool* pool_at(int index) {
+    switch (index) {
+     case 0:  return large_pool();
+     case 1:  return medium_pool();
+     case 2:  return small_pool();
+     default: return tiny_pool();
+    }
+  }
+
   // Accessors to preallocated pool's
   static ChunkPool* large_pool()  { assert(_large_pool  != NULL, "must be initialized"); return _large_pool;  }
   static ChunkPool* medium_pool() { assert(_medium_pool != NULL, "must be initialized"); return _medium_pool; }
@@ -161,6 +182,46 @@ Chunk::clean_chunk_pool() {
 }
 
 
+//--------------------------------------------------------------------------------------
+// ChunkCache implementation
+
+void* ChunkCache::take(int pool_index) {
+  if (pool_index < first_cached_pool) {
+    return NULL;
+  }
+  Chunk* c = _chunks[pool_index];
+  _chunks[pool_index] = NULL;
+  return c;
+}
+
+bool ChunkCache::put(int pool_index, Chunk* c) {
+  if (!_enabled || pool_index < first_cached_pool || _chunks[pool_index] != NULL) {
+    return false;
+  }
+  _chunks[pool_index] = c;
+  return true;
+}
+
+bool ChunkCache::contains(const Chunk* c) const {
+  for (int i = 0; i < num_pools; i++) {
+    if (_chunks[i] == c) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ChunkCache::flush() {
+  _enabled = false;
+  for (int i = 0; i < num_pools; i++) {
+    Chunk* c = _chunks[i];
+    if (c != NULL) {
+      _chunks[i] = NULL;
+      ChunkPool::pool_at(i)->free(c);
+    }
+  }
+}
+
 //--------------------------------------------------------------------------------------
 // ChunkPoolCleaner implementation
 //
@@ -185,6 +246,16 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   // expect requested_size but if sizeof(Chunk) doesn't match isn't proper size we must align it.
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
+  int index = ChunkPool::pool_index(length);
+  if (index >= 0) {
+    Thread* thread = Thread::current_or_null();
+    if (thread != NULL) {
+      void* p = thread->chunk_cache()->take(index);
+      if (p != NULL) {
+        return p;
+      }
+    }
+  }
   switch (length) {
    case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
    case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
@@ -202,6 +273,13 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
 
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
+  int index = ChunkPool::pool_index(c->length());
+  if (index >= 0) {
+    Thread* thread = Thread::current_or_null();
+    if (thread != NULL && thread->chunk_cache()->put(index, c)) {
+      return;
+    }
+  }
   switch (c->length()) {
    case Chunk::size:        ChunkPool::large_pool()->free(c); break;
    case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
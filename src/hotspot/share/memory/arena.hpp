@@ -88,6 +88,38 @@ class Chunk: CHeapObj<mtChunk> {
   static void clean_chunk_pool();
 };
 
+// Per-thread cache holding at most one free small and one free tiny chunk,
+// so a thread that keeps creating and destroying arenas (compiler and GC
+// threads) mostly avoids the ThreadCritical lock of the global pools. The
+// larger chunk sizes are not cached: the ChunkPoolCleaner cannot prune the
+// caches, and an idle thread should not keep tens of KB alive. Only the
+// owning thread touches its cache; flush() returns the cached chunks to
+// the global pools when the thread goes away.
+class ChunkCache {
+  friend class Chunk;
+ private:
+  // Indices into _chunks follow the ChunkPool order: large, medium, small,
+  // tiny. Only the pools from first_cached_pool on are cached.
+  enum { num_pools = 4, first_cached_pool = 2 };
+  Chunk* _chunks[num_pools];
+  bool   _enabled;
+
+  void* take(int pool_index);
+  bool put(int pool_index, Chunk* c);
+
+ public:
+  ChunkCache() : _enabled(true) {
+    for (int i = 0; i < num_pools; i++) {
+      _chunks[i] = NULL;
+    }
+  }
+
+  bool contains(const Chunk* c) const;
+
+  // Return all cached chunks to the global pools and stop caching.
+  void flush();
+};
+
 //------------------------------Arena------------------------------------------
 // Fast allocation of memory
 class Arena : public CHeapObj<mtNone> {
@@ -28,11 +28,14 @@
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/reflectionAccessorImplKlassHelper.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
@@ -242,6 +245,55 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+// Return false if the entry could not be recorded on account
+// of running out of space required to create a new entry.
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  Klass*          k = cie->klass();
+  KlassInfoEntry* elt = lookup(k);
+  // elt may be NULL if it's a new klass for which we
+  // could not allocate space for a new entry in the hashtable.
+  if (elt != NULL) {
+    elt->set_count(elt->count() + cie->count());
+    elt->set_words(elt->words() + cie->words());
+    _size_of_instances_in_words += cie->words();
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  bool _success;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* table) : _dest(table), _success(true) {}
+  void do_cinfo(KlassInfoEntry* cie) {
+    _success &= _dest->merge_entry(cie);
+  }
+  bool success() { return _success; }
+};
+
+class KlassInfoResetClosure : public KlassInfoClosure {
+ public:
+  void do_cinfo(KlassInfoEntry* cie) {
+    cie->set_count(0);
+    cie->set_words(0);
+  }
+};
+
+void KlassInfoTable::reset_instance_counts() {
+  KlassInfoResetClosure closure;
+  iterate(&closure);
+  _size_of_instances_in_words = 0;
+}
+
+// Merge the entries of the given table into this one.
+bool KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.success();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -715,9 +767,88 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
-size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
-  ResourceMark rm;
+// Heap iteration for populate_table() done by the GC workers. Each worker
+// fills its own table, which is merged into the shared one at the end.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  KlassInfoTable* _shared_cit;
+  BoolObjectClosure* _filter;
+  size_t _missed_count;
+  bool _success;
+  Mutex _mutex;
+
+ public:
+  ParHeapInspectTask(ParallelObjectIterator* poi,
+                     KlassInfoTable* shared_cit,
+                     BoolObjectClosure* filter) :
+      AbstractGangTask("Iterating heap"),
+      _poi(poi),
+      _shared_cit(shared_cit),
+      _filter(filter),
+      _missed_count(0),
+      _success(true),
+      _mutex(Mutex::leaf, "Parallel heap iteration data merge lock", false,
+             Mutex::_safepoint_check_never) { }
+
+  size_t missed_count() const { return _missed_count; }
+  bool success()            { return _success; }
+
+  virtual void work(uint worker_id) {
+    size_t missed_count = 0;
+    bool merge_success = true;
+    if (!Atomic::load(&_success)) {
+      // other worker has failed on parallel iteration.
+      return;
+    }
 
+    KlassInfoTable cit(false);
+    if (cit.allocation_failed()) {
+      // fail to allocate memory, stop parallel mode
+      Atomic::store(false, &_success);
+      return;
+    }
+    RecordInstanceClosure ric(&cit, _filter);
+    _poi->object_iterate(&ric, worker_id);
+    missed_count = ric.missed_count();
+    {
+      MutexLocker x(&_mutex, Mutex::_no_safepoint_check_flag);
+      merge_success = _shared_cit->merge(&cit);
+    }
+    if (merge_success) {
+      Atomic::add(missed_count, &_missed_count);
+    } else {
+      Atomic::store(false, &_success);
+    }
+  }
+};
+
+size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter, uint parallel_thread_num) {
+  // Try parallel first.
+  if (parallel_thread_num > 1) {
+    ResourceMark rm;
+    WorkGang* gang = Universe::heap()->get_safepoint_workers();
+    if (gang != NULL) {
+      // The GC provided a WorkGang to be used during a safepoint.
+      // Can't run with more threads than provided by the WorkGang.
+      uint nworkers = MIN2(parallel_thread_num, gang->active_workers());
+      ParallelObjectIterator* poi = Universe::heap()->parallel_object_iterator(nworkers);
+      if (poi != NULL) {
+        ParHeapInspectTask task(poi, cit, filter);
+        gang->run_task(&task, nworkers);
+        delete poi;
+        if (task.success()) {
+          return task.missed_count();
+        }
+        // Fall back to the serial iteration below, dropping what the
+        // workers have merged so far.
+        cit->reset_instance_counts();
+      }
+    }
+  }
+
+  ResourceMark rm;
+  // If no parallel iteration available, run serially.
   RecordInstanceClosure ric(cit, filter);
   Universe::heap()->safe_object_iterate(&ric);
   return ric.missed_count();
@@ -746,8 +877,11 @@ void HeapInspection::heap_inspection(outputStream* st) {
 
   KlassInfoTable cit(_print_class_stats);
   if (!cit.allocation_failed()) {
-    // populate table with object allocation info
-    size_t missed_count = populate_table(&cit);
+    // populate table with object allocation info, using the GC
+    // workers if the collector supports parallel heap iteration
+    WorkGang* gang = Universe::heap()->get_safepoint_workers();
+    uint parallel_thread_num = gang != NULL ? gang->active_workers() : 1;
+    size_t missed_count = populate_table(&cit, NULL, parallel_thread_num);
     if (missed_count != 0) {
       st->print_cr("WARNING: Ran out of C-heap; undercounted " SIZE_FORMAT
                    " total instances in data below",
@@ -35,6 +35,7 @@
 #include "memory/metaspace/occupancyMap.hpp"
 #include "memory/metaspace/virtualSpaceNode.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ostream.hpp"
@@ -576,6 +577,13 @@ void ChunkManager::return_single_chunk(Metachunk* chunk) {
   // Chunk has been added; update counters.
   account_for_added_chunk(chunk);
 
+  // Medium and humongous chunks are not coalesced further, so their payload
+  // can be released right away. Large pages cannot be partially released.
+  if (MetaspaceReclaimFreeChunks && !UseLargePages &&
+      (index == MediumIndex || index == HumongousIndex)) {
+    reclaim_free_chunk_memory(chunk);
+  }
+
   // Attempt coalesce returned chunks with its neighboring chunks:
   // if this chunk is small or special, attempt to coalesce to a medium chunk.
   if (index == SmallIndex || index == SpecializedIndex) {
@@ -601,6 +609,25 @@ void ChunkManager::return_single_chunk(Metachunk* chunk) {
 
 }
 
+// Give the pages backing the payload of a free chunk back to the OS. The memory
+// stays committed, so the chunk can be handed out again without any further
+// action; the pages are simply faulted in again. The chunk header (and, for
+// humongous chunks, the tree node the dictionary keeps in the payload) must
+// stay intact.
+void ChunkManager::reclaim_free_chunk_memory(Metachunk* chunk) {
+  assert_lock_strong(MetaspaceExpand_lock);
+  const size_t page_size = os::vm_page_size();
+  const size_t header_size = MAX2(sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >),
+                                  Metachunk::overhead() * BytesPerWord);
+  char* start = align_up((char*)chunk + header_size, page_size);
+  char* end = align_down((char*)(chunk->bottom() + chunk->word_size()), page_size);
+  if (start < end) {
+    os::free_memory(start, end - start, page_size);
+    log_trace(gc, metaspace, freelist)("reclaimed " SIZE_FORMAT " bytes of free chunk at " PTR_FORMAT ".",
+        (size_t)(end - start), p2i(chunk));
+  }
+}
+
 void ChunkManager::return_chunk_list(Metachunk* chunks) {
   if (chunks == NULL) {
     return;
@@ -75,6 +75,9 @@ class ChunkManager : public CHeapObj<mtInternal> {
   void account_for_added_chunk(const Metachunk* c);
   void account_for_removed_chunk(const Metachunk* c);
 
+  // Releases the payload pages of a free chunk (see MetaspaceReclaimFreeChunks).
+  void reclaim_free_chunk_memory(Metachunk* chunk);
+
   // Given a pointer to a chunk, attempts to merge it with neighboring
   // free chunks to form a bigger chunk. Returns true if successful.
   bool attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex target_chunk_type);
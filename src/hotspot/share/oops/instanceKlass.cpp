@@ -1365,15 +1365,17 @@ void InstanceKlass::mask_for(const methodHandle& method, int bci,
   // Lock-free access requires load_acquire.
   OopMapCache* oop_map_cache = OrderAccess::load_acquire(&_oop_map_cache);
   if (oop_map_cache == NULL) {
-    MutexLocker x(OopMapCacheAlloc_lock);
-    // Check if _oop_map_cache was allocated while we were waiting for this lock
-    if ((oop_map_cache = _oop_map_cache) == NULL) {
-      oop_map_cache = new OopMapCache();
-      // Ensure _oop_map_cache is stable, since it is examined without a lock
-      OrderAccess::release_store(&_oop_map_cache, oop_map_cache);
+    // GC workers scanning stacks may race to create the cache. The first
+    // one to install it wins and the others discard their copy.
+    OopMapCache* new_cache = new OopMapCache(methods()->length());
+    oop_map_cache = Atomic::cmpxchg(new_cache, &_oop_map_cache, (OopMapCache*)NULL);
+    if (oop_map_cache == NULL) {
+      oop_map_cache = new_cache;
+    } else {
+      delete new_cache;
     }
   }
-  // _oop_map_cache is constant after init; lookup below does its own locking.
+  // _oop_map_cache is constant after init; lookup below is lock-free.
   oop_map_cache->lookup(method, bci, entry_for);
 }
 
@@ -2134,11 +2136,11 @@ inline DependencyContext InstanceKlass::dependencies() {
 }
 
 int InstanceKlass::mark_dependent_nmethods(KlassDepChange& changes) {
-  return dependencies().mark_dependent_nmethods(changes);
+  return dependencies().mark_dependent_nmethods(changes, this);
 }
 
-void InstanceKlass::add_dependent_nmethod(nmethod* nm) {
-  dependencies().add_dependent_nmethod(nm);
+void InstanceKlass::add_dependent_nmethod(nmethod* nm, int dep_type) {
+  dependencies().add_dependent_nmethod(nm, 1 << dep_type);
 }
 
 void InstanceKlass::remove_dependent_nmethod(nmethod* nm) {
@@ -949,7 +949,7 @@ public:
   // maintenance of deoptimization dependencies
   inline DependencyContext dependencies();
   int  mark_dependent_nmethods(KlassDepChange& changes);
-  void add_dependent_nmethod(nmethod* nm);
+  void add_dependent_nmethod(nmethod* nm, int dep_type);
   void remove_dependent_nmethod(nmethod* nm);
   void clean_dependency_context();
 
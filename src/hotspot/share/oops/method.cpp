@@ -1534,6 +1534,13 @@ void Method::init_intrinsic_id() {
       // Even if the intrinsic is rejected, we want to inline this simple method.
       set_force_inline(true);
     }
+    if (id == vmIntrinsics::_Continuation_enter ||
+        id == vmIntrinsics::_Continuation_doYield ||
+        id == vmIntrinsics::_Continuation_doContinue) {
+      // These must always be real frames: enter() delimits the frozen part
+      // of the stack, and the other two are entered through generated stubs.
+      set_dont_inline(true);
+    }
     return;
   }
 
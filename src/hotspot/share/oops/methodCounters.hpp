@@ -26,6 +26,7 @@
 #define SHARE_OOPS_METHODCOUNTERS_HPP
 
 #include "oops/metadata.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compilerDefinitions.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "interpreter/invocationCounter.hpp"
@@ -96,6 +97,7 @@ class MethodCounters : public Metadata {
     // Set per-method thresholds.
     double scale = 1.0;
     CompilerOracle::has_option_value(mh, "CompileThresholdScaling", scale);
+    scale *= CompilationProfile::threshold_scale(mh(), CompLevel_none);
 
     int compile_threshold = CompilerConfig::scaled_compile_threshold(CompileThreshold, scale);
     _interpreter_invocation_limit = compile_threshold << InvocationCounter::count_shift;
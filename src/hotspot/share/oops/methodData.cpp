@@ -1329,6 +1329,8 @@ void MethodData::init() {
   _nof_decompiles = 0;
   _nof_overflow_recompiles = 0;
   _nof_overflow_traps = 0;
+  _deopt_storm_count = 0;
+  _deopt_storm_start = 0;
   clear_escape_info();
   assert(sizeof(_trap_hist) % sizeof(HeapWord) == 0, "align");
   Copy::zero_to_words((HeapWord*) &_trap_hist,
@@ -2026,6 +2026,8 @@ private:
   uint _nof_decompiles;             // count of all nmethod removals
   uint _nof_overflow_recompiles;    // recompile count, excluding recomp. bits
   uint _nof_overflow_traps;         // trap count, excluding _trap_hist
+  volatile uint _deopt_storm_count; // deoptimizations in the current storm window
+  volatile jlong _deopt_storm_start; // start of the current storm window (ms)
   union {
     intptr_t _align;
     u1 _array[JVMCI_ONLY(2 *) _trap_hist_limit];
@@ -2395,6 +2397,24 @@ public:
       method()->set_not_compilable("decompile_count > PerMethodRecompilationCutoff", CompLevel_full_optimization);
     }
   }
+  // Count a deoptimization in the current DeoptStormWindow and return
+  // true if DeoptStormThreshold has been reached.  Threads deoptimizing
+  // the same method race here; only the thread whose increment reaches
+  // the threshold reports the storm, and only one thread opens a new window.
+  bool record_deopt_for_storm(jlong now_ms) {
+    jlong start = Atomic::load(&_deopt_storm_start);
+    if (now_ms - start > DeoptStormWindow &&
+        Atomic::cmpxchg(now_ms, &_deopt_storm_start, start) == start) {
+      Atomic::store(0u, &_deopt_storm_count);
+    }
+    uint count = Atomic::add(1u, &_deopt_storm_count);
+    if (count == (uint)DeoptStormThreshold) {
+      Atomic::store(now_ms, &_deopt_storm_start);
+      Atomic::store(0u, &_deopt_storm_count);
+      return true;
+    }
+    return false;
+  }
   uint tenure_traps() const {
     return _tenure_traps;
   }
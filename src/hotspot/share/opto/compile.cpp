@@ -2273,7 +2273,7 @@ void Compile::Optimize() {
   cleanup_expensive_nodes(igvn);
 
   if (!failing() && RenumberLiveNodes && live_nodes() + NodeLimitFudgeFactor < unique()) {
-    Compile::TracePhase tp("", &timers[_t_renumberLive]);
+    Compile::TracePhase tp("renumberLive", &timers[_t_renumberLive]);
     initial_gvn()->replace_with(&igvn);
     for_igvn()->clear();
     Unique_Node_List new_worklist(C->comp_arena());
@@ -2300,7 +2300,10 @@ void Compile::Optimize() {
     if (failing())  return;
 
     // Optimize out fields loads from scalar replaceable allocations.
-    igvn.optimize();
+    {
+      TracePhase tp("iterGVN", &timers[_t_iterGVN]);
+      igvn.optimize();
+    }
     print_method(PHASE_ITER_GVN_AFTER_EA, 2);
 
     if (failing())  return;
@@ -88,6 +88,7 @@ void Phase::print_timers() {
 
     double other = timers[_t_optimizer].seconds() -
       (timers[_t_escapeAnalysis].seconds() +
+       timers[_t_macroEliminate].seconds() +
        timers[_t_iterGVN].seconds() +
        timers[_t_incrInline].seconds() +
        timers[_t_renumberLive].seconds() +
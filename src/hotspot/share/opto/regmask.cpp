@@ -309,7 +309,7 @@ uint RegMask::Size() const {
   uint sum = 0;
   assert(valid_watermarks(), "sanity");
   for (int i = _lwm; i <= _hwm; i++) {
-    sum += population_count(_A[i]);
+    sum += population_count((uint32_t)_A[i]);
   }
   return sum;
 }
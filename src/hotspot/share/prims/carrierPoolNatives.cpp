@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jni.h"
+#include "jvm.h"
+#include "classfile/vmSymbols.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/carrierPool.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/jniHandles.inline.hpp"
+
+/*
+ *      Implementation of class jdk.internal.misc.CarrierPool
+ */
+
+JVM_ENTRY(jboolean, CarrierPool_Initialize(JNIEnv *env, jclass cls, jint n))
+  if (n <= 0) {
+    THROW_(vmSymbols::java_lang_IllegalArgumentException(), JNI_FALSE);
+  }
+  return CarrierPool::initialize((uint)n) ? JNI_TRUE : JNI_FALSE;
+JVM_END
+
+JVM_ENTRY(jint, CarrierPool_Register(JNIEnv *env, jclass cls))
+  if (!CarrierPool::is_initialized()) {
+    THROW_(vmSymbols::java_lang_IllegalStateException(), CarrierPool::no_carrier);
+  }
+  return CarrierPool::register_carrier(thread);
+JVM_END
+
+JVM_ENTRY(void, CarrierPool_Unregister(JNIEnv *env, jclass cls))
+  CarrierPool::unregister_carrier(thread);
+JVM_END
+
+JVM_ENTRY(jboolean, CarrierPool_Push(JNIEnv *env, jclass cls, jobject task))
+  if (task == NULL) {
+    THROW_(vmSymbols::java_lang_NullPointerException(), JNI_FALSE);
+  }
+  if (thread->carrier_id() == CarrierPool::no_carrier) {
+    THROW_(vmSymbols::java_lang_IllegalStateException(), JNI_FALSE);
+  }
+  return CarrierPool::push(thread, JNIHandles::resolve_non_null(task)) ? JNI_TRUE : JNI_FALSE;
+JVM_END
+
+JVM_ENTRY(jobject, CarrierPool_Poll(JNIEnv *env, jclass cls))
+  if (thread->carrier_id() == CarrierPool::no_carrier) {
+    THROW_NULL(vmSymbols::java_lang_IllegalStateException());
+  }
+  return JNIHandles::make_local(env, CarrierPool::poll(thread));
+JVM_END
+
+JVM_ENTRY(jint, CarrierPool_PushAll(JNIEnv *env, jclass cls, jobjectArray tasks, jint from, jint to))
+  if (tasks == NULL) {
+    THROW_0(vmSymbols::java_lang_NullPointerException());
+  }
+  objArrayHandle a(thread, objArrayOop(JNIHandles::resolve_non_null(tasks)));
+  if (from < 0 || from > to || to > a->length()) {
+    THROW_0(vmSymbols::java_lang_ArrayIndexOutOfBoundsException());
+  }
+  if (thread->carrier_id() == CarrierPool::no_carrier) {
+    THROW_0(vmSymbols::java_lang_IllegalStateException());
+  }
+  return CarrierPool::push_all(thread, a, from, to);
+JVM_END
+
+JVM_ENTRY(jobject, CarrierPool_Park(JNIEnv *env, jclass cls, jlong millis))
+  if (millis < 0) {
+    THROW_NULL(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  if (thread->carrier_id() == CarrierPool::no_carrier) {
+    THROW_NULL(vmSymbols::java_lang_IllegalStateException());
+  }
+  return JNIHandles::make_local(env, CarrierPool::park(thread, millis));
+JVM_END
+
+JVM_ENTRY(jlong, CarrierPool_NewJoin(JNIEnv *env, jclass cls, jobject parent, jint count))
+  if (parent == NULL) {
+    THROW_0(vmSymbols::java_lang_NullPointerException());
+  }
+  if (count <= 0) {
+    THROW_0(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  Handle h(thread, JNIHandles::resolve_non_null(parent));
+  return CarrierPool::new_join(h, count);
+JVM_END
+
+// Returns the parent if the last child arrived and it could not be pushed
+// to the caller's queue, for the caller to schedule, and NULL otherwise.
+JVM_ENTRY(jobject, CarrierPool_Arrive(JNIEnv *env, jclass cls, jlong join))
+  Handle parent;
+  if (!CarrierPool::arrive(thread, join, &parent)) {
+    THROW_NULL(vmSymbols::java_lang_IllegalStateException());
+  }
+  if (parent.is_null()) {
+    return NULL;
+  }
+  if (thread->carrier_id() != CarrierPool::no_carrier && CarrierPool::push(thread, parent())) {
+    return NULL;
+  }
+  return JNIHandles::make_local(env, parent());
+JVM_END
+
+JVM_ENTRY(void, CarrierPool_ReleaseJoin(JNIEnv *env, jclass cls, jlong join))
+  if (!CarrierPool::release_join(join)) {
+    THROW(vmSymbols::java_lang_IllegalStateException());
+  }
+JVM_END
+
+JVM_ENTRY(jint, CarrierPool_Tasks(JNIEnv *env, jclass cls))
+  return (jint)CarrierPool::tasks();
+JVM_END
+
+/// JVM_RegisterCarrierPoolMethods
+
+#define CC (char*)  /*cast a literal from (const char*)*/
+#define FN_PTR(f) CAST_FROM_FN_PTR(void*, &f)
+#define OBJ "Ljava/lang/Object;"
+#define OBJARR "[Ljava/lang/Object;"
+
+static JNINativeMethod carrierpoolmethods[] = {
+  {CC "initialize",          CC "(I)Z",           FN_PTR(CarrierPool_Initialize)},
+  {CC "register",            CC "()I",            FN_PTR(CarrierPool_Register)},
+  {CC "unregister",          CC "()V",            FN_PTR(CarrierPool_Unregister)},
+  {CC "push",                CC "(" OBJ ")Z",     FN_PTR(CarrierPool_Push)},
+  {CC "poll",                CC "()" OBJ,         FN_PTR(CarrierPool_Poll)},
+  {CC "pushAll",             CC "(" OBJARR "II)I", FN_PTR(CarrierPool_PushAll)},
+  {CC "park",                CC "(J)" OBJ,        FN_PTR(CarrierPool_Park)},
+  {CC "newJoin",             CC "(" OBJ "I)J",    FN_PTR(CarrierPool_NewJoin)},
+  {CC "arrive",              CC "(J)" OBJ,        FN_PTR(CarrierPool_Arrive)},
+  {CC "releaseJoin",         CC "(J)V",           FN_PTR(CarrierPool_ReleaseJoin)},
+  {CC "tasks",               CC "()I",            FN_PTR(CarrierPool_Tasks)}
+};
+
+#undef OBJARR
+#undef OBJ
+#undef FN_PTR
+#undef CC
+
+// This one function is exported, used by NativeLookup.
+JVM_ENTRY(void, JVM_RegisterCarrierPoolMethods(JNIEnv *env, jclass cls))
+  {
+    ThreadToNativeFromVM ttnfv(thread);
+    int ok = env->RegisterNatives(cls, carrierpoolmethods, sizeof(carrierpoolmethods)/sizeof(JNINativeMethod));
+    guarantee(ok == 0, "register carrier pool natives");
+  }
+JVM_END
@@ -60,6 +60,7 @@
 #include "prims/stackwalk.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/continuation.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/init.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
@@ -729,9 +730,10 @@ JVM_ENTRY(jclass, JVM_GetCallerClass(JNIEnv* env))
   // [.] [ (skipped intermediate frames)                                 ]
   // [n] [ caller                                                        ]
   vframeStream vfst(thread);
+  FrozenFrameStream frozen(thread);
   // Cf. LibraryCallKit::inline_native_Reflection_getCallerClass
-  for (int n = 0; !vfst.at_end(); vfst.security_next(), n++) {
-    Method* m = vfst.method();
+  for (int n = 0; !vfst.at_end(); n++) {
+    Method* m = frozen.is_walking() ? frozen.method() : vfst.method();
     assert(m != NULL, "sanity");
     switch (n) {
     case 0:
@@ -753,6 +755,14 @@ JVM_ENTRY(jclass, JVM_GetCallerClass(JNIEnv* env))
       }
       break;
     }
+    if (frozen.is_walking()) {
+      frozen.next();
+    } else {
+      vfst.security_next();
+      if (!vfst.at_end()) {
+        frozen.enter_at(vfst.frame_id());
+      }
+    }
   }
   return NULL;
 JVM_END
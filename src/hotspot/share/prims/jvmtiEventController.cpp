@@ -32,6 +32,7 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/jvmtiThreadState.inline.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/frame.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
@@ -39,6 +40,7 @@
 #include "runtime/vframe_hp.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
+#include "utilities/growableArray.hpp"
 
 #ifdef JVMTI_TRACE
 #define EC_TRACE(out) do { \
@@ -88,6 +90,8 @@ static const jlong  SAMPLED_OBJECT_ALLOC_BIT = (((jlong)1) << (JVMTI_EVENT_SAMPL
 
 // bits for extension events
 static const jlong  CLASS_UNLOAD_BIT = (((jlong)1) << (EXT_EVENT_CLASS_UNLOAD - TOTAL_MIN_EVENT_TYPE_VAL));
+static const jlong  CONTINUATION_MOUNT_BIT = (((jlong)1) << (EXT_EVENT_CONTINUATION_MOUNT - TOTAL_MIN_EVENT_TYPE_VAL));
+static const jlong  CONTINUATION_UNMOUNT_BIT = (((jlong)1) << (EXT_EVENT_CONTINUATION_UNMOUNT - TOTAL_MIN_EVENT_TYPE_VAL));
 
 
 static const jlong  MONITOR_BITS = MONITOR_CONTENDED_ENTER_BIT | MONITOR_CONTENDED_ENTERED_BIT |
@@ -106,6 +110,7 @@ static const jlong  EARLY_EVENT_BITS = CLASS_FILE_LOAD_HOOK_BIT | CLASS_LOAD_BIT
                                DYNAMIC_CODE_GENERATED_BIT;
 static const jlong  GLOBAL_EVENT_BITS = ~THREAD_FILTERED_EVENT_BITS;
 static const jlong  SHOULD_POST_ON_EXCEPTIONS_BITS = EXCEPTION_BITS | METHOD_EXIT_BIT | FRAME_POP_BIT;
+static const jlong  CONTINUATION_BITS = CONTINUATION_MOUNT_BIT | CONTINUATION_UNMOUNT_BIT;
 
 ///////////////////////////////////////////////////////////////
 //
@@ -239,8 +244,7 @@ void VM_EnterInterpOnlyMode::doit() {
       }
     }
     if (num_marked > 0) {
-      VM_Deoptimize op;
-      VMThread::execute(&op);
+      Deoptimization::deoptimize_all_marked();
     }
   }
 }
@@ -282,8 +286,24 @@ VM_ChangeSingleStep::VM_ChangeSingleStep(bool on)
 // hold the JvmtiThreadState_lock.
 //
 
+// The interpreter events a thread had enabled for an environment when
+// the continuation with the id unmounted.
+class JvmtiUnmountedEvents {
+public:
+  JvmtiEnvBase* _env;
+  jlong         _id;
+  jlong         _bits;
+
+  JvmtiUnmountedEvents() : _env(NULL), _id(0), _bits(0) {}
+  JvmtiUnmountedEvents(JvmtiEnvBase* env, jlong id, jlong bits) : _env(env), _id(id), _bits(bits) {}
+};
+
 class JvmtiEventControllerPrivate : public AllStatic {
   static bool _initialized;
+  // Continuations that are never mounted again are not noticed, so only the
+  // most recently unmounted ones keep their events.
+  static const int max_unmounted_events = 1024;
+  static GrowableArray<JvmtiUnmountedEvents>* _unmounted_events;
 public:
   static void set_should_post_single_step(bool on);
   static void enter_interp_only_mode(JvmtiThreadState *state);
@@ -312,6 +332,9 @@ public:
   static void thread_started(JavaThread *thread);
   static void thread_ended(JavaThread *thread);
 
+  static void continuation_unmounted(JavaThread *thread, jlong id);
+  static void continuation_mounted(JavaThread *thread, jlong id);
+
   static void env_initialize(JvmtiEnvBase *env);
   static void env_dispose(JvmtiEnvBase *env);
 
@@ -324,6 +347,7 @@ public:
 };
 
 bool JvmtiEventControllerPrivate::_initialized = false;
+GrowableArray<JvmtiUnmountedEvents>* JvmtiEventControllerPrivate::_unmounted_events = NULL;
 
 void JvmtiEventControllerPrivate::set_should_post_single_step(bool on) {
   // we have permission to do this, VM op doesn't
@@ -613,6 +637,8 @@ JvmtiEventControllerPrivate::recompute_enabled() {
     JvmtiExport::set_should_post_data_dump((any_env_thread_enabled & DATA_DUMP_BIT) != 0);
     JvmtiExport::set_should_post_class_prepare((any_env_thread_enabled & CLASS_PREPARE_BIT) != 0);
     JvmtiExport::set_should_post_class_unload((any_env_thread_enabled & CLASS_UNLOAD_BIT) != 0);
+    JvmtiExport::set_should_post_continuation_mount((any_env_thread_enabled & CONTINUATION_MOUNT_BIT) != 0);
+    JvmtiExport::set_should_post_continuation_unmount((any_env_thread_enabled & CONTINUATION_UNMOUNT_BIT) != 0);
     JvmtiExport::set_should_post_monitor_contended_enter((any_env_thread_enabled & MONITOR_CONTENDED_ENTER_BIT) != 0);
     JvmtiExport::set_should_post_monitor_contended_entered((any_env_thread_enabled & MONITOR_CONTENDED_ENTERED_BIT) != 0);
     JvmtiExport::set_should_post_monitor_wait((any_env_thread_enabled & MONITOR_WAIT_BIT) != 0);
@@ -654,6 +680,11 @@ JvmtiEventControllerPrivate::recompute_enabled() {
 
   }
 
+  // continuations must notify us if they may carry interpreter events
+  bool has_unmounted_events = _unmounted_events != NULL && !_unmounted_events->is_empty();
+  JvmtiExport::set_should_notify_continuations(
+    (any_env_thread_enabled & (INTERP_EVENT_BITS | CONTINUATION_BITS)) != 0 || has_unmounted_events);
+
   EC_TRACE(("[-] # recompute enabled - after " JULONG_FORMAT_X, any_env_thread_enabled));
 }
 
@@ -691,6 +722,70 @@ JvmtiEventControllerPrivate::thread_ended(JavaThread *thread) {
   delete state;
 }
 
+void
+JvmtiEventControllerPrivate::continuation_unmounted(JavaThread *thread, jlong id) {
+  assert(JvmtiThreadState_lock->is_locked(), "sanity check");
+
+  JvmtiThreadState *state = thread->jvmti_thread_state();
+  if (state == NULL) {
+    return;
+  }
+  bool moved = false;
+  JvmtiEnvThreadStateIterator it(state);
+  for (JvmtiEnvThreadState* ets = it.first(); ets != NULL; ets = it.next(ets)) {
+    JvmtiEventEnabled* user_enabled = &ets->event_enable()->_event_user_enabled;
+    jlong bits = user_enabled->get_bits() & INTERP_EVENT_BITS;
+    if (bits != 0 && ets->get_env()->is_valid()) {
+      if (_unmounted_events == NULL) {
+        _unmounted_events = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<JvmtiUnmountedEvents>(4, true);
+      }
+      if (_unmounted_events->length() >= max_unmounted_events) {
+        EC_TRACE(("[%s] # events of continuation " JLONG_FORMAT " dropped",
+                  JvmtiTrace::safe_get_thread_name(thread), _unmounted_events->at(0)._id));
+        _unmounted_events->remove_at(0);
+      }
+      _unmounted_events->append(JvmtiUnmountedEvents(ets->get_env(), id, bits));
+      user_enabled->set_bits(user_enabled->get_bits() & ~bits);
+      moved = true;
+    }
+  }
+  if (moved) {
+    EC_TRACE(("[%s] # continuation " JLONG_FORMAT " unmounted with interpreter events",
+              JvmtiTrace::safe_get_thread_name(thread), id));
+    recompute_enabled();
+  }
+}
+
+
+void
+JvmtiEventControllerPrivate::continuation_mounted(JavaThread *thread, jlong id) {
+  assert(JvmtiThreadState_lock->is_locked(), "sanity check");
+
+  if (_unmounted_events == NULL) {
+    return;
+  }
+  bool moved = false;
+  for (int i = _unmounted_events->length() - 1; i >= 0; i--) {
+    JvmtiUnmountedEvents events = _unmounted_events->at(i);
+    if (events._id != id) {
+      continue;
+    }
+    _unmounted_events->remove_at(i);
+    // create the thread state (if it didn't exist before)
+    JvmtiThreadState *state = JvmtiThreadState::state_for_while_locked(thread);
+    if (state != NULL) {
+      JvmtiEventEnabled* user_enabled = &state->env_thread_state(events._env)->event_enable()->_event_user_enabled;
+      user_enabled->set_bits(user_enabled->get_bits() | events._bits);
+    }
+    moved = true;
+  }
+  if (moved) {
+    EC_TRACE(("[%s] # continuation " JLONG_FORMAT " mounted with interpreter events",
+              JvmtiTrace::safe_get_thread_name(thread), id));
+    recompute_enabled();
+  }
+}
+
 void JvmtiEventControllerPrivate::set_event_callbacks(JvmtiEnvBase *env,
                                                       const jvmtiEventCallbacks* callbacks,
                                                       jint size_of_callbacks) {
@@ -740,6 +835,12 @@ JvmtiEventControllerPrivate::set_extension_event_callback(JvmtiEnvBase *env,
     case EXT_EVENT_CLASS_UNLOAD :
       ext_callbacks->ClassUnload = callback;
       break;
+    case EXT_EVENT_CONTINUATION_MOUNT :
+      ext_callbacks->ContinuationMount = callback;
+      break;
+    case EXT_EVENT_CONTINUATION_UNMOUNT :
+      ext_callbacks->ContinuationUnmount = callback;
+      break;
     default:
       ShouldNotReachHere();
   }
@@ -795,6 +896,16 @@ JvmtiEventControllerPrivate::env_dispose(JvmtiEnvBase *env) {
     set_extension_event_callback(env, extension_event_index, NULL);
   }
 
+  // Forget the events the environment enabled for unmounted continuations.
+  if (_unmounted_events != NULL) {
+    for (int i = _unmounted_events->length() - 1; i >= 0; i--) {
+      if (_unmounted_events->at(i)._env == env) {
+        _unmounted_events->remove_at(i);
+      }
+    }
+    recompute_enabled();
+  }
+
   // Let the environment finish disposing itself.
   env->env_dispose();
 }
@@ -1037,6 +1148,18 @@ JvmtiEventController::thread_ended(JavaThread *thread) {
   JvmtiEventControllerPrivate::thread_ended(thread);
 }
 
+void
+JvmtiEventController::continuation_unmounted(JavaThread *thread, jlong id) {
+  MutexLocker mu(JvmtiThreadState_lock);
+  JvmtiEventControllerPrivate::continuation_unmounted(thread, id);
+}
+
+void
+JvmtiEventController::continuation_mounted(JavaThread *thread, jlong id) {
+  MutexLocker mu(JvmtiThreadState_lock);
+  JvmtiEventControllerPrivate::continuation_mounted(thread, id);
+}
+
 void
 JvmtiEventController::env_initialize(JvmtiEnvBase *env) {
   if (Threads::number_of_threads() == 0) {
@@ -45,12 +45,16 @@ class JvmtiEnvBase;
 // Extension events start JVMTI_MIN_EVENT_TYPE_VAL-1 and work towards 0.
 typedef enum {
   EXT_EVENT_CLASS_UNLOAD = JVMTI_MIN_EVENT_TYPE_VAL-1,
-  EXT_MIN_EVENT_TYPE_VAL = EXT_EVENT_CLASS_UNLOAD,
+  EXT_EVENT_CONTINUATION_MOUNT = JVMTI_MIN_EVENT_TYPE_VAL-2,
+  EXT_EVENT_CONTINUATION_UNMOUNT = JVMTI_MIN_EVENT_TYPE_VAL-3,
+  EXT_MIN_EVENT_TYPE_VAL = EXT_EVENT_CONTINUATION_UNMOUNT,
   EXT_MAX_EVENT_TYPE_VAL = EXT_EVENT_CLASS_UNLOAD
 } jvmtiExtEvent;
 
 typedef struct {
   jvmtiExtensionEvent ClassUnload;
+  jvmtiExtensionEvent ContinuationMount;
+  jvmtiExtensionEvent ContinuationUnmount;
 } jvmtiExtEventCallbacks;
 
 
@@ -233,6 +237,14 @@ public:
   static void thread_started(JavaThread *thread);
   static void thread_ended(JavaThread *thread);
 
+  // The interpreter events (single step, method entry and exit, frame pop
+  // and field watches) enabled on a thread while a continuation is mounted
+  // belong to the continuation: they are disabled on the thread when it
+  // unmounts, and enabled on the thread it mounts on next, so that other
+  // continuations run by the thread need not run interpreted.
+  static void continuation_unmounted(JavaThread *thread, jlong id);
+  static void continuation_mounted(JavaThread *thread, jlong id);
+
   static void env_initialize(JvmtiEnvBase *env);
   static void env_dispose(JvmtiEnvBase *env);
 
@@ -228,6 +228,18 @@ public:
   jclass jni_class() { return _jc; }
 };
 
+class JvmtiContinuationEventMark : public JvmtiThreadEventMark {
+private:
+  jobject _jcont;
+
+public:
+  JvmtiContinuationEventMark(JavaThread *thread, Handle cont) :
+    JvmtiThreadEventMark(thread) {
+    _jcont = to_jobject(cont());
+  };
+  jobject jni_continuation() { return _jcont; }
+};
+
 class JvmtiMethodEventMark : public JvmtiThreadEventMark {
 private:
   jmethodID _mid;
@@ -324,6 +336,11 @@ address JvmtiExport::get_field_access_count_addr() {
   return (address)(&_field_access_count);
 }
 
+// the doContinue stub tests the flag before calling post_continuation_mount()
+address JvmtiExport::get_should_notify_continuations_addr() {
+  return (address)(&_should_notify_continuations);
+}
+
 //
 // field modification management
 //
@@ -1211,6 +1228,9 @@ bool              JvmtiExport::_should_post_field_modification            = fals
 bool              JvmtiExport::_should_post_class_load                    = false;
 bool              JvmtiExport::_should_post_class_prepare                 = false;
 bool              JvmtiExport::_should_post_class_unload                  = false;
+bool              JvmtiExport::_should_post_continuation_mount            = false;
+bool              JvmtiExport::_should_post_continuation_unmount          = false;
+bool              JvmtiExport::_should_notify_continuations               = false;
 bool              JvmtiExport::_should_post_thread_life                   = false;
 bool              JvmtiExport::_should_clean_up_heap_objects              = false;
 bool              JvmtiExport::_should_post_native_method_bind            = false;
@@ -1438,6 +1458,76 @@ void JvmtiExport::post_thread_start(JavaThread *thread) {
 }
 
 
+void JvmtiExport::post_continuation_unmount(JavaThread *thread, Handle cont, jlong id) {
+  if (JvmtiEnv::get_phase() < JVMTI_PHASE_PRIMORDIAL) {
+    return;
+  }
+  assert(thread->thread_state() == _thread_in_vm, "must be in vm state");
+  HandleMark hm(thread);
+
+  EVT_TRIG_TRACE(EXT_EVENT_CONTINUATION_UNMOUNT, ("[%s] Trg Continuation Unmount event triggered",
+                      JvmtiTrace::safe_get_thread_name(thread)));
+
+  if (JvmtiEventController::is_enabled((jvmtiEvent)EXT_EVENT_CONTINUATION_UNMOUNT)) {
+    JvmtiEnvIterator it;
+    for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
+      if (env->phase() == JVMTI_PHASE_PRIMORDIAL) {
+        continue;
+      }
+      if (env->is_enabled((jvmtiEvent)EXT_EVENT_CONTINUATION_UNMOUNT)) {
+        EVT_TRACE(EXT_EVENT_CONTINUATION_UNMOUNT, ("[%s] Evt Continuation Unmount sent " JLONG_FORMAT,
+                  JvmtiTrace::safe_get_thread_name(thread), id));
+
+        JvmtiContinuationEventMark jem(thread, cont);
+        JvmtiJavaThreadEventTransition jet(thread);
+        jvmtiExtensionEvent callback = env->ext_callbacks()->ContinuationUnmount;
+        if (callback != NULL) {
+          (*callback)(env->jvmti_external(), jem.jni_env(), jem.jni_thread(), jem.jni_continuation(), id);
+        }
+      }
+    }
+  }
+
+  // the interpreter events enabled on the thread leave with the continuation
+  JvmtiEventController::continuation_unmounted(thread, id);
+}
+
+
+void JvmtiExport::post_continuation_mount(JavaThread *thread, Handle cont, jlong id) {
+  if (JvmtiEnv::get_phase() < JVMTI_PHASE_PRIMORDIAL) {
+    return;
+  }
+  assert(thread->thread_state() == _thread_in_vm, "must be in vm state");
+  HandleMark hm(thread);
+
+  EVT_TRIG_TRACE(EXT_EVENT_CONTINUATION_MOUNT, ("[%s] Trg Continuation Mount event triggered",
+                      JvmtiTrace::safe_get_thread_name(thread)));
+
+  // the interpreter events the continuation left with are enabled here
+  JvmtiEventController::continuation_mounted(thread, id);
+
+  if (JvmtiEventController::is_enabled((jvmtiEvent)EXT_EVENT_CONTINUATION_MOUNT)) {
+    JvmtiEnvIterator it;
+    for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
+      if (env->phase() == JVMTI_PHASE_PRIMORDIAL) {
+        continue;
+      }
+      if (env->is_enabled((jvmtiEvent)EXT_EVENT_CONTINUATION_MOUNT)) {
+        EVT_TRACE(EXT_EVENT_CONTINUATION_MOUNT, ("[%s] Evt Continuation Mount sent " JLONG_FORMAT,
+                  JvmtiTrace::safe_get_thread_name(thread), id));
+
+        JvmtiContinuationEventMark jem(thread, cont);
+        JvmtiJavaThreadEventTransition jet(thread);
+        jvmtiExtensionEvent callback = env->ext_callbacks()->ContinuationMount;
+        if (callback != NULL) {
+          (*callback)(env->jvmti_external(), jem.jni_env(), jem.jni_thread(), jem.jni_continuation(), id);
+        }
+      }
+    }
+  }
+}
+
+
 void JvmtiExport::post_thread_end(JavaThread *thread) {
   if (JvmtiEnv::get_phase() < JVMTI_PHASE_PRIMORDIAL) {
     return;
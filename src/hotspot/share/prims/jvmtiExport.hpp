@@ -99,6 +99,9 @@ class JvmtiExport : public AllStatic {
   JVMTI_SUPPORT_FLAG(should_post_class_load)
   JVMTI_SUPPORT_FLAG(should_post_class_prepare)
   JVMTI_SUPPORT_FLAG(should_post_class_unload)
+  JVMTI_SUPPORT_FLAG(should_post_continuation_mount)
+  JVMTI_SUPPORT_FLAG(should_post_continuation_unmount)
+  JVMTI_SUPPORT_FLAG(should_notify_continuations)
   JVMTI_SUPPORT_FLAG(should_post_native_method_bind)
   JVMTI_SUPPORT_FLAG(should_post_compiled_method_load)
   JVMTI_SUPPORT_FLAG(should_post_compiled_method_unload)
@@ -255,6 +258,9 @@ class JvmtiExport : public AllStatic {
   // field modification management
   static address  get_field_modification_count_addr() NOT_JVMTI_RETURN_(0);
 
+  // tells the continuation stubs to call post_continuation_mount()
+  static address  get_should_notify_continuations_addr() NOT_JVMTI_RETURN_(0);
+
   // -----------------
 
   static bool is_jvmti_version(jint version)                      {
@@ -319,6 +325,11 @@ class JvmtiExport : public AllStatic {
   static void post_thread_start          (JavaThread *thread) NOT_JVMTI_RETURN;
   static void post_thread_end            (JavaThread *thread) NOT_JVMTI_RETURN;
 
+  // Called when should_notify_continuations(), after the continuation with
+  // the id froze its frames and before it thaws them.
+  static void post_continuation_unmount  (JavaThread *thread, Handle cont, jlong id) NOT_JVMTI_RETURN;
+  static void post_continuation_mount    (JavaThread *thread, Handle cont, jlong id) NOT_JVMTI_RETURN;
+
   // Support for java.lang.instrument agent loading.
   static bool _should_post_class_file_load_hook;
   inline static void set_should_post_class_file_load_hook(bool on)     { _should_post_class_file_load_hook = on;  }
@@ -44,9 +44,11 @@ static jvmtiError JNICALL IsClassUnloadingEnabled(const jvmtiEnv* env, jboolean*
 
 // register extension functions and events. In this implementation we
 // have a single extension function (to prove the API) that tests if class
-// unloading is enabled or disabled. We also have a single extension event
+// unloading is enabled or disabled. We also have an extension event
 // EXT_EVENT_CLASS_UNLOAD which is used to provide the JVMDI_EVENT_CLASS_UNLOAD
-// event. The function and the event are registered here.
+// event, and the events EXT_EVENT_CONTINUATION_MOUNT and UNMOUNT posted when
+// a continuation thaws its frames and after it froze them. The function and
+// the events are registered here.
 //
 void JvmtiExtensions::register_extensions() {
   _ext_functions = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jvmtiExtensionFunctionInfo*>(1,true);
@@ -82,6 +84,29 @@ void JvmtiExtensions::register_extensions() {
     event_params
   };
   _ext_events->append(&ext_event);
+
+  static jvmtiParamInfo continuation_event_params[] = {
+    { (char*)"JNI Environment", JVMTI_KIND_IN, JVMTI_TYPE_JNIENV, JNI_FALSE },
+    { (char*)"Thread", JVMTI_KIND_IN, JVMTI_TYPE_JTHREAD, JNI_FALSE },
+    { (char*)"Continuation", JVMTI_KIND_IN, JVMTI_TYPE_JOBJECT, JNI_FALSE },
+    { (char*)"Id", JVMTI_KIND_IN, JVMTI_TYPE_JLONG, JNI_FALSE }
+  };
+  static jvmtiExtensionEventInfo mount_event = {
+    EXT_EVENT_CONTINUATION_MOUNT,
+    (char*)"com.sun.hotspot.events.ContinuationMount",
+    (char*)"CONTINUATION_MOUNT event",
+    sizeof(continuation_event_params)/sizeof(continuation_event_params[0]),
+    continuation_event_params
+  };
+  _ext_events->append(&mount_event);
+  static jvmtiExtensionEventInfo unmount_event = {
+    EXT_EVENT_CONTINUATION_UNMOUNT,
+    (char*)"com.sun.hotspot.events.ContinuationUnmount",
+    (char*)"CONTINUATION_UNMOUNT event",
+    sizeof(continuation_event_params)/sizeof(continuation_event_params[0]),
+    continuation_event_params
+  };
+  _ext_events->append(&unmount_event);
 }
 
 
@@ -28,6 +28,8 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
@@ -1636,6 +1638,22 @@ class RestoreMarksClosure : public ObjectClosure {
   }
 };
 
+// Restores the mark bits of the objects handed out by the GC's parallel
+// heap iterator. Used by ObjectMarker::done() to reset the whole heap
+// with the GC workers rather than by the VM thread alone.
+class RestoreMarksTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+ public:
+  RestoreMarksTask(ParallelObjectIterator* poi) :
+    AbstractGangTask("Restoring JVMTI heap walk marks"), _poi(poi) { }
+
+  virtual void work(uint worker_id) {
+    RestoreMarksClosure blk;
+    _poi->object_iterate(&blk, worker_id);
+  }
+};
+
 // ObjectMarker provides the mark and visited functions
 class ObjectMarker : AllStatic {
  private:
@@ -1653,6 +1671,9 @@ class ObjectMarker : AllStatic {
 
   static inline bool needs_reset()            { return _needs_reset; }
   static inline void set_needs_reset(bool v)  { _needs_reset = v; }
+
+ private:
+  static void restore_all_marks();          // reset the mark bits of every object
 };
 
 GrowableArray<oop>* ObjectMarker::_saved_oop_stack = NULL;
@@ -1675,13 +1696,31 @@ void ObjectMarker::init() {
   }
 }
 
+// Reset the mark bits of all objects to their initial value. This is a
+// full heap walk that calls no agent code, so it is split between the GC
+// workers if the collector supports parallel heap iteration.
+void ObjectMarker::restore_all_marks() {
+  WorkGang* gang = Universe::heap()->get_safepoint_workers();
+  if (gang != NULL && gang->active_workers() > 1) {
+    uint nworkers = gang->active_workers();
+    ParallelObjectIterator* poi = Universe::heap()->parallel_object_iterator(nworkers);
+    if (poi != NULL) {
+      RestoreMarksTask task(poi);
+      gang->run_task(&task, nworkers);
+      delete poi;
+      return;
+    }
+  }
+  RestoreMarksClosure blk;
+  Universe::heap()->object_iterate(&blk);
+}
+
 // Object marking is done so restore object headers
 void ObjectMarker::done() {
   // iterate over all objects and restore the mark bits to
   // their initial value
-  RestoreMarksClosure blk;
   if (needs_reset()) {
-    Universe::heap()->object_iterate(&blk);
+    restore_all_marks();
   } else {
     // We don't need to reset mark bits on this call, but reset the
     // flag to the default for the next call.
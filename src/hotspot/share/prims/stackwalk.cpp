@@ -62,11 +62,21 @@ bool BaseFrameStream::cleanup_magic_on_exit(objArrayHandle frames_array) {
 }
 
 JavaFrameStream::JavaFrameStream(JavaThread* thread, int mode)
-  : BaseFrameStream(thread), _vfst(thread) {
+  : BaseFrameStream(thread), _vfst(thread), _frozen(thread) {
   _need_method_info = StackWalk::need_method_info(mode);
 }
 
-void JavaFrameStream::next() { _vfst.next();}
+void JavaFrameStream::next() {
+  if (_frozen.is_walking()) {
+    // The frame the return barrier returns to follows the frozen frames.
+    _frozen.next();
+    return;
+  }
+  _vfst.next();
+  if (!_vfst.at_end()) {
+    _frozen.enter_at(_vfst.frame_id());
+  }
+}
 
 // Returns the BaseFrameStream for the current stack being traversed.
 //
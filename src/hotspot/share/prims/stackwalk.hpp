@@ -27,12 +27,15 @@
 #define SHARE_PRIMS_STACKWALK_HPP
 
 #include "oops/oop.hpp"
+#include "runtime/continuation.hpp"
 #include "runtime/vframe.hpp"
 
 // BaseFrameStream is an abstract base class for encapsulating the VM-side
 // implementation of the StackWalker API.  There are two concrete subclasses:
 // - JavaFrameStream:
-//     -based on vframeStream; used in most instances
+//     -based on vframeStream; used in most instances. Also walks the frames
+//      of a lazily thawed continuation that are still frozen
+//      (see FrozenFrameStream)
 // - LiveFrameStream:
 //     -based on javaVFrame; used for retrieving locals/monitors/operands for
 //      LiveStackFrame
@@ -76,15 +79,16 @@ public:
 class JavaFrameStream : public BaseFrameStream {
 private:
   vframeStream          _vfst;
+  FrozenFrameStream     _frozen;
   bool                  _need_method_info;
 public:
   JavaFrameStream(JavaThread* thread, int mode);
 
   void next();
-  bool at_end()    { return _vfst.at_end(); }
+  bool at_end()    { return !_frozen.is_walking() && _vfst.at_end(); }
 
-  Method* method() { return _vfst.method(); }
-  int bci()        { return _vfst.bci(); }
+  Method* method() { return _frozen.is_walking() ? _frozen.method() : _vfst.method(); }
+  int bci()        { return _frozen.is_walking() ? _frozen.bci() : _vfst.bci(); }
 
   void fill_frame(int index, objArrayHandle  frames_array,
                   const methodHandle& method, TRAPS);
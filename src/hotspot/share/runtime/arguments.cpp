@@ -4120,10 +4120,12 @@ jint Arguments::adjust_after_os() {
     // platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
-    // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
-    // all platforms and ParallelGC on Windows will interleave all
-    // of the heap spaces across NUMA nodes.
+    // allocation policy for the eden space. G1 instead binds each
+    // region to a node when it is committed, which overrides the
+    // interleaving for the heap.
+    // Non NUMA-aware collectors such as CMS and Serial-GC on all
+    // platforms and ParallelGC on Windows will interleave all of
+    // the heap spaces across NUMA nodes.
     if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
       FLAG_SET_ERGO(UseNUMAInterleaving, true);
     }
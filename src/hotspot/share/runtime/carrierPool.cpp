@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/iterator.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/carrierPool.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/jniHandles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/thread.hpp"
+#include "services/continuationChunkTracker.hpp"
+#include "utilities/growableArray.hpp"
+
+CarrierQueueSet*      CarrierPool::_queues = NULL;
+JavaThread* volatile* CarrierPool::_carriers = NULL;
+volatile int          CarrierPool::_idle     = 0;
+
+GrowableArray<CarrierJoin*>* CarrierPool::_joins            = NULL;
+GrowableArray<juint>*        CarrierPool::_join_generations = NULL;
+GrowableArray<int>*          CarrierPool::_free_joins       = NULL;
+
+CarrierJoin::CarrierJoin(Handle parent, jint count) :
+  _count(count), _parent(JNIHandles::make_global(parent)) {
+  assert(count > 0, "nothing to join");
+}
+
+CarrierJoin::~CarrierJoin() {
+  JNIHandles::destroy_global(_parent);
+}
+
+oop CarrierJoin::arrive() {
+  jint count = Atomic::sub(1, &_count);
+  assert(count >= 0, "more arrivals than children");
+  // The children's writes happen before the parent resumes.
+  return count == 0 ? JNIHandles::resolve_non_null(_parent) : (oop)NULL;
+}
+
+bool CarrierPool::initialize(uint n) {
+  assert(n > 0, "no carriers");
+  MutexLocker ml(CarrierPool_lock);
+  if (_queues != NULL) {
+    return _queues->size() == n;
+  }
+  CarrierQueueSet* queues = new CarrierQueueSet(n);
+  for (uint i = 0; i < n; i++) {
+    CarrierQueue* q = new CarrierQueue();
+    q->initialize();
+    queues->register_queue(i, q);
+  }
+  _carriers = NEW_C_HEAP_ARRAY(JavaThread* volatile, n, mtContinuation);
+  for (uint i = 0; i < n; i++) {
+    _carriers[i] = NULL;
+  }
+  NMT_ONLY(ContinuationChunkTracker::initialize_carriers(n);)
+  // Publish the pool after its queues.
+  OrderAccess::release_store(&_queues, queues);
+  log_info(continuations)("carrier pool of %u queues", n);
+  return true;
+}
+
+int CarrierPool::register_carrier(JavaThread* thread) {
+  assert(thread == JavaThread::current(), "only the carrier itself");
+  if (thread->carrier_id() != no_carrier) {
+    return thread->carrier_id();
+  }
+  for (uint i = 0; i < size(); i++) {
+    if (_carriers[i] == NULL && Atomic::cmpxchg(thread, &_carriers[i], (JavaThread*)NULL) == NULL) {
+      // The previous owner's last pushes and pops happen before its
+      // unregistering, so they are visible to the new owner.
+      OrderAccess::acquire();
+      thread->set_carrier_id((int)i);
+      return (int)i;
+    }
+  }
+  return no_carrier;
+}
+
+void CarrierPool::unregister_carrier(JavaThread* thread) {
+  int id = thread->carrier_id();
+  if (id != no_carrier) {
+    assert(_carriers[id] == thread, "must own the queue");
+    thread->set_carrier_id(no_carrier);
+    OrderAccess::release_store(&_carriers[id], (JavaThread*)NULL);
+  }
+}
+
+bool CarrierPool::push(JavaThread* thread, oop task) {
+  int id = thread->carrier_id();
+  assert(id != no_carrier, "not a carrier");
+  if (!_queues->queue(id)->push(task)) {
+    return false;
+  }
+  wake_idle(1);
+  return true;
+}
+
+int CarrierPool::push_all(JavaThread* thread, objArrayHandle tasks, int from, int to) {
+  int id = thread->carrier_id();
+  assert(id != no_carrier, "not a carrier");
+  assert(0 <= from && from <= to && to <= tasks->length(), "out of bounds");
+  CarrierQueue* q = _queues->queue(id);
+  int pushed = 0;
+  for (int i = from; i < to; i++) {
+    oop task = tasks->obj_at(i);
+    if (task == NULL) {
+      continue;
+    }
+    if (!q->push(task)) {
+      break;
+    }
+    pushed++;
+  }
+  wake_idle(pushed);
+  return pushed;
+}
+
+// A parking carrier counts itself idle before it polls one last time, and
+// a pusher checks for idle carriers after its push, so that either the
+// carrier finds the task or the pusher finds the carrier.
+void CarrierPool::wake_idle(int tasks) {
+  if (tasks == 0) {
+    return;
+  }
+  OrderAccess::fence();
+  if (_idle == 0) {
+    return;
+  }
+  MonitorLocker ml(CarrierIdle_lock);
+  if (tasks == 1) {
+    ml.notify();
+  } else {
+    ml.notify_all();
+  }
+}
+
+oop CarrierPool::poll(JavaThread* thread) {
+  int id = thread->carrier_id();
+  assert(id != no_carrier, "not a carrier");
+  oop task;
+  if (_queues->queue(id)->pop_local(task) || _queues->steal(id, task)) {
+    return task;
+  }
+  return NULL;
+}
+
+oop CarrierPool::park(JavaThread* thread, jlong millis) {
+  oop task = poll(thread);
+  if (task != NULL) {
+    return task;
+  }
+  MonitorLocker ml(CarrierIdle_lock);
+  Atomic::inc(&_idle);
+  OrderAccess::fence();
+  task = poll(thread);
+  if (task == NULL) {
+    ml.wait(millis);
+    task = poll(thread);
+  }
+  Atomic::dec(&_idle);
+  return task;
+}
+
+// A handle is the index of the join's slot plus one in its low half, and
+// the generation of the slot in its high half.
+jlong CarrierPool::new_join(Handle parent, jint count) {
+  CarrierJoin* j = new CarrierJoin(parent, count);
+  MutexLocker ml(CarrierPool_lock);
+  if (_joins == NULL) {
+    _joins = new (ResourceObj::C_HEAP, mtContinuation) GrowableArray<CarrierJoin*>(16, true, mtContinuation);
+    _join_generations = new (ResourceObj::C_HEAP, mtContinuation) GrowableArray<juint>(16, true, mtContinuation);
+    _free_joins = new (ResourceObj::C_HEAP, mtContinuation) GrowableArray<int>(16, true, mtContinuation);
+  }
+  int index;
+  if (_free_joins->is_empty()) {
+    index = _joins->append(j);
+    _join_generations->append(0);
+  } else {
+    index = _free_joins->pop();
+    _joins->at_put(index, j);
+  }
+  return ((jlong)_join_generations->at(index) << 32) | (jlong)(index + 1);
+}
+
+CarrierJoin* CarrierPool::join_at(jlong join, int* index) {
+  assert_lock_strong(CarrierPool_lock);
+  jlong i = (join & max_juint) - 1;
+  if (_joins == NULL || i < 0 || i >= _joins->length() ||
+      _join_generations->at((int)i) != (juint)((julong)join >> 32)) {
+    return NULL;
+  }
+  *index = (int)i;
+  return _joins->at((int)i);
+}
+
+void CarrierPool::remove_join_at(int index) {
+  assert_lock_strong(CarrierPool_lock);
+  _joins->at_put(index, NULL);
+  _join_generations->at_put(index, _join_generations->at(index) + 1);
+  _free_joins->push(index);
+}
+
+bool CarrierPool::arrive(JavaThread* thread, jlong join, Handle* parent) {
+  CarrierJoin* done = NULL;
+  {
+    MutexLocker ml(CarrierPool_lock);
+    int index;
+    CarrierJoin* j = join_at(join, &index);
+    if (j == NULL) {
+      return false;
+    }
+    oop p = j->arrive();
+    if (p == NULL) {
+      return true;
+    }
+    *parent = Handle(thread, p);
+    remove_join_at(index);
+    done = j;
+  }
+  // Releases the global handle to the parent outside the lock.
+  delete done;
+  return true;
+}
+
+bool CarrierPool::release_join(jlong join) {
+  CarrierJoin* j;
+  {
+    MutexLocker ml(CarrierPool_lock);
+    int index;
+    j = join_at(join, &index);
+    if (j == NULL) {
+      return false;
+    }
+    remove_join_at(index);
+  }
+  delete j;
+  return true;
+}
+
+uint CarrierPool::tasks() {
+  return is_initialized() ? _queues->tasks() : 0;
+}
+
+class CarrierQueueOopsDo : public StackObj {
+ private:
+  OopClosure* _f;
+ public:
+  CarrierQueueOopsDo(OopClosure* f) : _f(f) {}
+  void operator()(oop& task) const { _f->do_oop(&task); }
+};
+
+void CarrierPool::oops_do(OopClosure* f) {
+  if (!is_initialized()) {
+    return;
+  }
+  CarrierQueueOopsDo cl(f);
+  for (uint i = 0; i < size(); i++) {
+    _queues->queue(i)->iterate(cl);
+  }
+}
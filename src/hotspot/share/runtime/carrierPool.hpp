@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_RUNTIME_CARRIERPOOL_HPP
+#define SHARE_RUNTIME_CARRIERPOOL_HPP
+
+#include "gc/shared/taskqueue.hpp"
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "runtime/handles.hpp"
+
+class JavaThread;
+class OopClosure;
+template <class E> class GrowableArray;
+
+// Run queues for a pool of carrier threads scheduling continuations.
+//
+// Each carrier owns a work-stealing queue of tasks (continuations or the
+// objects that run them): it pushes and pops at one end without atomic
+// read-modify-write operations, and idle carriers steal from the other
+// end of the queues of others, as GC workers do (see taskqueue.hpp). A
+// queue outlives its carrier: a carrier that exits leaves its tasks to be
+// stolen, or taken over with the queue by the next carrier registering.
+//
+// The tasks are strong roots, visited with the VM thread's roots. They are
+// only changed in the VM, so never while a safepoint is in progress.
+//
+// Carriers finding no task wait in park() until tasks are pushed. Pushes
+// only take the lock the carriers wait on when some are idle, and a batch
+// of tasks pushed with push_all() wakes them at most once.
+//
+// A CarrierJoin lets a parent task wait for its children without being
+// woken by each of them: every child arrives at the join when it completes,
+// and the last one resubmits the parent to its own queue. Joins are owned
+// by the pool and known to Java by handle; a handle is never valid again
+// once its join completed or was released.
+typedef GenericTaskQueue<oop, mtContinuation, 8 * K> CarrierQueue;
+typedef GenericTaskQueueSet<CarrierQueue, mtContinuation> CarrierQueueSet;
+
+class CarrierJoin : public CHeapObj<mtContinuation> {
+ private:
+  volatile jint _count;
+  jobject       _parent;    // global handle
+
+ public:
+  CarrierJoin(Handle parent, jint count);
+  ~CarrierJoin();
+
+  // Counts the arrival of a child. Returns the parent if it was the last
+  // one to arrive, NULL otherwise.
+  oop arrive();
+};
+
+class CarrierPool : AllStatic {
+ private:
+  static CarrierQueueSet*     _queues;
+  static JavaThread* volatile* _carriers;   // the owner of each queue
+  static volatile int          _idle;       // carriers waiting in park()
+
+  static void wake_idle(int tasks);
+
+  // The joins by handle index, NULL for free slots, with the generation
+  // of each slot. Guarded by CarrierPool_lock.
+  static GrowableArray<CarrierJoin*>* _joins;
+  static GrowableArray<juint>*        _join_generations;
+  static GrowableArray<int>*          _free_joins;
+
+  static CarrierJoin* join_at(jlong join, int* index);
+  static void remove_join_at(int index);
+
+ public:
+  static const int no_carrier = -1;
+
+  // Creates the queues of a pool of up to n carriers. Returns false if the
+  // pool exists already with a different size.
+  static bool initialize(uint n);
+  static bool is_initialized() { return _queues != NULL; }
+  static uint size()           { return _queues->size(); }
+
+  // The owner of queue i, or NULL
+  static JavaThread* carrier_at(uint i) { return _carriers[i]; }
+
+  // Makes thread the owner of a queue no one owns. Returns the queue's
+  // index, or no_carrier if all are owned.
+  static int register_carrier(JavaThread* thread);
+  static void unregister_carrier(JavaThread* thread);
+
+  // Pushes task to the queue of the carrier thread. Returns false if full.
+  static bool push(JavaThread* thread, oop task);
+
+  // Pushes the tasks [from, to) to the queue of the carrier thread, waking
+  // idle carriers once. Returns the number of tasks pushed, fewer than
+  // requested if the queue is full.
+  static int push_all(JavaThread* thread, objArrayHandle tasks, int from, int to);
+
+  // Pops the task pushed last to the queue of the carrier thread, or else
+  // steals the one pushed first to some other queue. Returns NULL if no
+  // task was found.
+  static oop poll(JavaThread* thread);
+
+  // Polls, waiting up to millis milliseconds (0 for no limit) for a task
+  // to be pushed if none is found.
+  static oop park(JavaThread* thread, jlong millis);
+
+  // Creates a join for count children of parent and returns its handle,
+  // which is never 0.
+  static jlong new_join(Handle parent, jint count);
+
+  // Counts the arrival of a child at a join. Returns false if the handle is
+  // not valid. The last child to arrive gets the parent, and frees the join.
+  static bool arrive(JavaThread* thread, jlong join, Handle* parent);
+
+  // Frees a join whose children will not all arrive. Returns false if the
+  // handle is not valid.
+  static bool release_join(jlong join);
+
+  // Number of tasks in all queues, approximate if they are in use
+  static uint tasks();
+
+  static void oops_do(OopClosure* f);
+};
+
+#endif // SHARE_RUNTIME_CARRIERPOOL_HPP
@@ -0,0 +1,1206 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/compiledMethod.inline.hpp"
+#include "code/debugInfo.hpp"
+#include "code/debugInfoRec.hpp"
+#include "code/nmethod.hpp"
+#include "code/scopeDesc.hpp"
+#include "compiler/oopMap.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "logging/log.hpp"
+#include "memory/oopFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/compressedOops.inline.hpp"
+#include "oops/method.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "oops/typeArrayOop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/biasedLocking.hpp"
+#include "runtime/continuation.hpp"
+#include "runtime/frame.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/objectMonitor.inline.hpp"
+#include "runtime/registerMap.hpp"
+#include "runtime/safepointVerifiers.hpp"
+#include "runtime/stackValue.hpp"
+#include "runtime/stubRoutines.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.inline.hpp"
+#include "services/continuationChunkTracker.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/copy.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/macros.hpp"
+#ifdef SUPPORT_CONTINUATIONS
+#include CPU_HEADER_INLINE(continuation)
+#endif
+#if INCLUDE_JFR
+#include "jfr/periodic/sampling/jfrThreadSampler.hpp"
+#endif
+
+bool Continuation::is_supported() {
+  return StubRoutines::cont_doYield() != NULL && StubRoutines::cont_doContinue() != NULL;
+}
+
+static volatile jlong _next_id = 0;
+
+jlong Continuation::next_id() {
+  return Atomic::add((jlong)1, &_next_id);
+}
+
+#if INCLUDE_NMT
+// Bytes of the Java heap taken by the arrays of a chunk
+static size_t chunk_heap_size(typeArrayOop stack, objArrayOop refs) {
+  return (size_t)(stack->size() + refs->size()) * HeapWordSize;
+}
+#endif
+
+int Continuation::save_oops(const BitMap& oop_bits, const BitMap& narrow_bits, size_t beg, size_t end,
+                            const intptr_t* top, objArrayOop refs, int ref_index) {
+  for (BitMap::idx_t bit = oop_bits.get_next_one_offset(beg, end); bit < end;
+       bit = oop_bits.get_next_one_offset(bit + 1, end)) {
+    address slot = (address)top + bit * BytesPerInt;
+    oop o = narrow_bits.at(bit) ? CompressedOops::decode(*(narrowOop*)slot) : *(oop*)slot;
+    refs->obj_at_put(ref_index++, o);
+  }
+  return ref_index;
+}
+
+int Continuation::restore_oops(const BitMap& oop_bits, const BitMap& narrow_bits, size_t beg, size_t end,
+                               intptr_t* top, objArrayOop refs, int ref_index) {
+  for (BitMap::idx_t bit = oop_bits.get_next_one_offset(beg, end); bit < end;
+       bit = oop_bits.get_next_one_offset(bit + 1, end)) {
+    address slot = (address)top + bit * BytesPerInt;
+    oop o = refs->obj_at(ref_index++);
+    if (narrow_bits.at(bit)) {
+      *(narrowOop*)slot = CompressedOops::encode(o);
+    } else {
+      *(oop*)slot = o;
+    }
+  }
+  return ref_index;
+}
+
+#ifdef SUPPORT_CONTINUATIONS
+
+// True if the thread's mounted continuation was thawed below sp, the sp
+// its enter() frame returns with. Thaw may have moved the frames down to
+// keep them aligned.
+static bool is_mounted_at(JavaThread* thread, intptr_t* sp) {
+  intptr_t* mount_sp = thread->cont_mount_sp();
+  return thread->cont_mount_id() != 0 && sp <= mount_sp &&
+         (address)mount_sp - (address)sp < StackAlignmentInBytes;
+}
+
+// After a freeze the thread runs the continuation being thawed lazily, if any.
+static void remount_lazy(JavaThread* thread) {
+  oop lazy = thread->cont_lazy();
+  if (lazy != NULL) {
+    thread->set_cont_mount(java_lang_Continuation::stack(lazy)->long_at(Continuation::hdr_id),
+                           thread->cont_entry_sp());
+  } else {
+    thread->set_cont_mount(0, NULL);
+  }
+}
+
+// Collects everything needed to freeze the frames between the last Java
+// frame and the enter() frame, without changing the stack.
+class FreezeContext : public StackObj {
+ private:
+  JavaThread* const _thread;
+  intptr_t* const   _top;
+  intptr_t*         _end;
+  intptr_t*         _limit;       // highest slot address seen so far, for validation
+
+  GrowableArray<int>               _relocs;      // word offsets of stack addresses
+  GrowableArray<jlong>             _oops;        // oop slot descriptors, may repeat
+  GrowableArray<jlong>             _derived;     // (derived, base) byte offset pairs
+  GrowableArray<CompiledMethod*>   _nmethods;
+  GrowableArray<jlong>             _frames;      // FrameRecords, from the top
+  GrowableArray<Handle>            _monitors;    // objects locked by the frames
+  GrowableArray<Handle>            _code_oops;   // oops of the nmethods
+
+  bool              _at_barrier;  // the bottom frame returns to the return barrier
+  ResourceBitMap    _oop_bits;    // slots holding oops
+  ResourceBitMap    _narrow_bits; // slots holding narrow oops
+  int               _oop_count;
+  intptr_t*         _return_sp;
+  intptr_t*         _return_fp;
+  address           _return_pc;
+
+  jlong byte_offset(void* p) const {
+    return (jlong)((address)p - (address)_top);
+  }
+
+  int word_offset(void* p) const {
+    return (int)((intptr_t*)p - _top);
+  }
+
+  bool in_frozen_part(void* p) {
+    if ((intptr_t*)p < _top) {
+      return false;
+    }
+    _limit = MAX2(_limit, (intptr_t*)p + 1);
+    return true;
+  }
+
+  class OopSlotClosure : public OopClosure {
+    FreezeContext* _fc;
+    bool _failed;
+   public:
+    OopSlotClosure(FreezeContext* fc) : _fc(fc), _failed(false) {}
+    bool failed() const { return _failed; }
+    virtual void do_oop(oop* p)       { if (!_fc->add_oop_slot(p, Continuation::slot_oop))        _failed = true; }
+    virtual void do_oop(narrowOop* p) { if (!_fc->add_oop_slot(p, Continuation::slot_narrow_oop)) _failed = true; }
+  };
+
+  bool add_oop_slot(void* p, int kind) {
+    if (!in_frozen_part(p)) {
+      return false;
+    }
+    // NULL and the decoded narrow NULL are left in the frozen words as they are.
+    if (kind == Continuation::slot_oop) {
+      oop o = *(oop*)p;
+      if (o == NULL || CompressedOops::is_base(o)) {
+        return true;
+      }
+    } else if (CompressedOops::is_null(*(narrowOop*)p)) {
+      return true;
+    }
+    _oops.append((byte_offset(p) << Continuation::slot_kind_bits) | kind);
+    return true;
+  }
+
+  bool add_monitor(oop obj);
+
+  bool add_reloc(intptr_t** p) {
+    if (!in_frozen_part(p)) {
+      return false;
+    }
+    _relocs.append(word_offset(p));
+    return true;
+  }
+
+  // Returned by walk_compiled() when the frames need the general walk
+  enum { walk_fallback = -1 };
+
+  int walk_compiled();
+  int walk_frames();
+  void reset();
+
+  int add_interpreted_frame(const frame& f, RegisterMap* map, bool bottom);
+  int add_compiled_frame(const frame& f, RegisterMap* map, bool bottom);
+  int add_compiled_oops(const frame& f, RegisterMap* map, bool bottom);
+  void add_frame_record(const frame& f, int first_reloc, int first_oop, int first_derived);
+  int add_bottom_frame(const frame& f);
+
+ public:
+  FreezeContext(JavaThread* thread, intptr_t* top) :
+    _thread(thread), _top(top), _end(NULL), _limit(top), _at_barrier(false), _oop_count(0),
+    _return_sp(NULL), _return_fp(NULL), _return_pc(NULL) {}
+
+  int walk();
+  void compute_oop_bitmaps();
+  void collect_code_oops();
+
+  int size() const              { return (int)(_end - _top); }
+  int frames() const            { return _frames.length() / Continuation::frame_record_size; }
+  int stack_length() const {
+    return Continuation::header_size + size() + _relocs.length() + 2 * Continuation::oop_bitmap_words(size()) +
+           _derived.length() + _nmethods.length() + _frames.length();
+  }
+  // The oops, locked objects and nmethod oops, followed by the parent chunk
+  int ref_length() const        { return _oop_count + _monitors.length() + _code_oops.length() + 2; }
+  bool at_barrier() const       { return _at_barrier; }
+
+  void fill(typeArrayOop stack, objArrayOop refs, typeArrayOop parent_stack, objArrayOop parent_refs, jlong id);
+
+  intptr_t* return_sp() const   { return _return_sp; }
+  intptr_t* return_fp() const   { return _return_fp; }
+  address   return_pc() const   { return _return_pc; }
+};
+
+// True if no method compiled into cm, inlined or not, synchronizes, so that
+// its frames hold no locks. The nmethod's metadata includes every method
+// inlined into it.
+static bool is_lock_free(CompiledMethod* cm) {
+  nmethod* nm = cm->as_nmethod_or_null();
+  if (nm == NULL || nm->method()->has_monitors()) {
+    return false;
+  }
+  for (Metadata** p = nm->metadata_begin(); p < nm->metadata_end(); p++) {
+    Metadata* md = *p;
+    if (md == Universe::non_oop_word() || md == NULL || !md->is_method()) {
+      continue;
+    }
+    if (((Method*)md)->has_monitors()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int FreezeContext::walk() {
+  int result = walk_compiled();
+  if (result != walk_fallback) {
+    return result;
+  }
+  reset();
+  return walk_frames();
+}
+
+void FreezeContext::reset() {
+  _end = NULL;
+  _limit = _top;
+  _relocs.clear();
+  _oops.clear();
+  _derived.clear();
+  _nmethods.clear();
+  _frames.clear();
+  _monitors.clear();
+  _code_oops.clear();
+  _at_barrier = false;
+}
+
+// The fast path for the common case of compiled frames that hold no locks
+// and keep no stack address in the frame pointer. Those frames need no
+// scope decoding and no relocations: they are frozen as they are, only
+// their oops and bottom link taken care of. Returns walk_fallback at the
+// first frame that is not of that kind.
+int FreezeContext::walk_compiled() {
+  RegisterMap map(_thread, true);
+  map.set_include_argument_oops(false);
+  ContinuationHelper::set_saved_fp_location(&map, (intptr_t**)_top);
+
+  for (frame f = _thread->last_frame(); ; f = f.sender(&map)) {
+    if (!f.is_compiled_frame()) {
+      return walk_fallback;
+    }
+    CompiledMethod* cm = f.cb()->as_compiled_method();
+    if (cm->is_native_method() || ContinuationHelper::fp_is_stack_address(f)) {
+      return walk_fallback;
+    }
+    // Recursive frames share their nmethod, checked for the frame above.
+    if ((_nmethods.is_empty() || _nmethods.top() != cm) && !is_lock_free(cm)) {
+      return walk_fallback;
+    }
+
+    int first_derived = _derived.length() / 2;
+    _at_barrier = StubRoutines::is_cont_returnBarrier(*ContinuationHelper::return_pc_address(f));
+    bool bottom = _at_barrier || cm->method()->intrinsic_id() == vmIntrinsics::_Continuation_enter;
+    int result = add_compiled_oops(f, &map, bottom);
+    if (result != Continuation::freeze_ok) {
+      return result;
+    }
+    add_frame_record(f, 0, 0, first_derived);
+    if (bottom) {
+      return add_bottom_frame(f);
+    }
+  }
+}
+
+int FreezeContext::walk_frames() {
+  RegisterMap map(_thread, true);
+  map.set_include_argument_oops(false);
+  ContinuationHelper::set_saved_fp_location(&map, (intptr_t**)_top);
+
+  // The slot holding the frame pointer value of the current frame. For the
+  // top frame that is where the yield stub saved it.
+  intptr_t** fp_slot = (intptr_t**)_top;
+
+  for (frame f = _thread->last_frame(); ; f = f.sender(&map)) {
+    Method* m = NULL;
+    if (f.is_interpreted_frame()) {
+      m = f.interpreter_frame_method();
+    } else if (f.is_compiled_frame() && !f.cb()->as_compiled_method()->is_native_method()) {
+      m = f.cb()->as_compiled_method()->method();
+    }
+    if (m == NULL || m->is_native()) {
+      // Reached a native, VM or entry frame before enter()
+      return Continuation::freeze_pinned_native;
+    }
+
+    int first_reloc = _relocs.length();
+    int first_oop = 0;   // set by compute_oop_bitmaps()
+    int first_derived = _derived.length() / 2;
+    if (ContinuationHelper::fp_is_stack_address(f) && !add_reloc(fp_slot)) {
+      return Continuation::freeze_pinned_native;
+    }
+
+    // Frames below the return barrier are still frozen in the continuation.
+    _at_barrier = StubRoutines::is_cont_returnBarrier(*ContinuationHelper::return_pc_address(f));
+    bool bottom = _at_barrier || m->intrinsic_id() == vmIntrinsics::_Continuation_enter;
+    int result = f.is_interpreted_frame() ? add_interpreted_frame(f, &map, bottom)
+                                          : add_compiled_frame(f, &map, bottom);
+    if (result != Continuation::freeze_ok) {
+      return result;
+    }
+    add_frame_record(f, first_reloc, first_oop, first_derived);
+    if (bottom) {
+      return add_bottom_frame(f);
+    }
+    fp_slot = ContinuationHelper::link_address(f);
+  }
+}
+
+// Locks held by frozen frames must not depend on the thread or on the stack
+// address of the lock record: the bias is revoked and the lock inflated,
+// owned by the thread itself rather than by the lock record. Thaw passes the
+// monitor on to the thread the frames are thawed on.
+bool FreezeContext::add_monitor(oop obj) {
+  Handle h_obj(_thread, obj);
+  if (UseBiasedLocking && h_obj->mark().has_bias_pattern()) {
+    GrowableArray<Handle> objs(1);
+    objs.append(h_obj);
+    BiasedLocking::revoke(&objs, _thread);
+  }
+  ObjectMonitor* m = ObjectSynchronizer::inflate(_thread, h_obj(), ObjectSynchronizer::inflate_cause_vm_internal);
+  if (m->owner() != _thread) {
+    if (!_thread->is_lock_owned((address)m->owner())) {
+      return false;
+    }
+    m->set_owner(_thread);
+  }
+  _monitors.append(h_obj);
+  return true;
+}
+
+int FreezeContext::add_interpreted_frame(const frame& f, RegisterMap* map, bool bottom) {
+  for (BasicObjectLock* mon = f.interpreter_frame_monitor_end();
+       mon < f.interpreter_frame_monitor_begin();
+       mon = f.next_monitor_in_interpreter_frame(mon)) {
+    if (mon->obj() != NULL && !add_monitor(mon->obj())) {
+      return Continuation::freeze_pinned_monitor;
+    }
+  }
+
+  GrowableArray<intptr_t**> slots(4);
+  ContinuationHelper::collect_interpreted_stack_slots(f, &slots);
+  if (!bottom) {
+    // The bottom frame's sender sp is set by thaw instead.
+    slots.append(ContinuationHelper::interpreted_sender_sp_address(f));
+  }
+  for (int i = 0; i < slots.length(); i++) {
+    if (!add_reloc(slots.at(i))) {
+      return Continuation::freeze_pinned_native;
+    }
+  }
+
+  OopSlotClosure cl(this);
+  const_cast<frame&>(f).oops_interpreted_do(&cl, map);
+  return cl.failed() ? Continuation::freeze_pinned_native : Continuation::freeze_ok;
+}
+
+int FreezeContext::add_compiled_frame(const frame& f, RegisterMap* map, bool bottom) {
+  CompiledMethod* cm = f.cb()->as_compiled_method();
+
+  for (ScopeDesc* sd = cm->scope_desc_at(f.pc()); sd != NULL; sd = sd->sender()) {
+    GrowableArray<MonitorValue*>* monitors = sd->monitors();
+    for (int i = 0; monitors != NULL && i < monitors->length(); i++) {
+      MonitorValue* mv = monitors->at(i);
+      // Eliminated locks are only relocked on deoptimization.
+      if (mv->eliminated() || mv->owner()->is_object()) {
+        return Continuation::freeze_pinned_monitor;
+      }
+      StackValue* owner = StackValue::create_stack_value(&f, map, mv->owner());
+      if (!add_monitor(owner->get_obj()())) {
+        return Continuation::freeze_pinned_monitor;
+      }
+    }
+  }
+  return add_compiled_oops(f, map, bottom);
+}
+
+int FreezeContext::add_compiled_oops(const frame& f, RegisterMap* map, bool bottom) {
+  CompiledMethod* cm = f.cb()->as_compiled_method();
+  assert(!bottom || _at_barrier || cm->method()->size_of_parameters() == 1, "enter() takes no arguments");
+
+  const ImmutableOopMap* oop_map = cm->oop_map_for_return_address(f.pc());
+  assert(oop_map != NULL, "no oop map at a call site");
+  int mask = OopMapValue::oop_value | OopMapValue::narrowoop_value | OopMapValue::derived_oop_value;
+  for (OopMapStream oms(oop_map, mask); !oms.is_done(); oms.next()) {
+    OopMapValue omv = oms.current();
+    oop* loc = f.oopmapreg_to_location(omv.reg(), map);
+    if (loc == NULL) {
+      return Continuation::freeze_pinned_native;
+    }
+    if (omv.type() == OopMapValue::derived_oop_value) {
+      oop* base_loc = f.oopmapreg_to_location(omv.content_reg(), map);
+      if (base_loc == NULL || !in_frozen_part(base_loc) || !in_frozen_part(loc)) {
+        return Continuation::freeze_pinned_native;
+      }
+      if (*base_loc != NULL && !CompressedOops::is_base(*base_loc)) {
+        _derived.append(byte_offset(loc));
+        _derived.append(byte_offset(base_loc));
+      }
+    } else if (omv.type() == OopMapValue::narrowoop_value) {
+      narrowOop* nl = (narrowOop*)loc;
+#ifndef VM_LITTLE_ENDIAN
+      if (!omv.reg()->is_stack()) {
+        // A narrow oop in a register is in the low half of the saved word.
+        nl = (narrowOop*)((address)nl + 4);
+      }
+#endif
+      if (!add_oop_slot(nl, Continuation::slot_narrow_oop)) {
+        return Continuation::freeze_pinned_native;
+      }
+    } else if (!add_oop_slot(loc, Continuation::slot_oop)) {
+      return Continuation::freeze_pinned_native;
+    }
+  }
+
+  _nmethods.append(cm);
+  return Continuation::freeze_ok;
+}
+
+void FreezeContext::add_frame_record(const frame& f, int first_reloc, int first_oop, int first_derived) {
+  _frames.append(word_offset(f.unextended_sp()));
+  _frames.append(word_offset(ContinuationHelper::frame_end(f)));
+  _frames.append(word_offset(ContinuationHelper::link_address(f)));
+  _frames.append(word_offset(ContinuationHelper::return_pc_address(f)));
+  if (f.is_interpreted_frame()) {
+    _frames.append(word_offset(ContinuationHelper::interpreted_sender_sp_address(f)));
+    _frames.append((jlong)(intptr_t)f.interpreter_frame_method());
+    _frames.append(f.interpreter_frame_bci());
+  } else {
+    // Stack walks decode the frame's scopes from the nmethod, kept locked.
+    CompiledMethod* cm = f.cb()->as_compiled_method();
+    _frames.append(-1);
+    _frames.append((jlong)(intptr_t)cm);
+    _frames.append(cm->pc_desc_at(f.pc())->scope_decode_offset());
+  }
+  _frames.append(first_reloc);
+  _frames.append(first_oop);
+  _frames.append(first_derived);
+}
+
+// Turns the oop slot descriptors into bitmaps. Thaw finds the oops of the
+// frames it thaws by scanning the bitmaps from the first word of the top
+// frame, and the oops are kept in the refStack in slot order, so each frame
+// record also gets the number of oops above its first word.
+void FreezeContext::compute_oop_bitmaps() {
+  _oop_bits.initialize(Continuation::oop_bitmap_bits(size()));
+  _narrow_bits.initialize(Continuation::oop_bitmap_bits(size()));
+  for (int i = 0; i < _oops.length(); i++) {
+    jlong desc = _oops.at(i);
+    BitMap::idx_t slot = (BitMap::idx_t)((desc >> Continuation::slot_kind_bits) / BytesPerInt);
+    _oop_bits.set_bit(slot);
+    if ((desc & Continuation::slot_kind_mask) == Continuation::slot_narrow_oop) {
+      _narrow_bits.set_bit(slot);
+    }
+  }
+
+  BitMap::idx_t bit = _oop_bits.get_next_one_offset(0);
+  int rank = 0;
+  int frames = _frames.length() / Continuation::frame_record_size;
+  for (int k = 0; k < frames; k++) {
+    int start = (k == 0) ? 0 : (int)_frames.at(k * Continuation::frame_record_size + Continuation::frame_sp);
+    BitMap::idx_t limit = Continuation::oop_bitmap_bits(start);
+    while (bit < limit) {
+      rank++;
+      bit = _oop_bits.get_next_one_offset(bit + 1);
+    }
+    _frames.at_put(k * Continuation::frame_record_size + Continuation::frame_first_oop, rank);
+  }
+  _oop_count = (int)_oop_bits.count_one_bits();
+}
+
+int FreezeContext::add_bottom_frame(const frame& f) {
+  _end = ContinuationHelper::frame_end(f);
+
+  intptr_t** link = ContinuationHelper::link_address(f);
+  address* pc = ContinuationHelper::return_pc_address(f);
+  if ((intptr_t*)link >= _end || (intptr_t*)pc >= _end || _limit > _end) {
+    return Continuation::freeze_pinned_native;
+  }
+
+  if (_at_barrier) {
+    // Return to the caller of doContinue(), as the frames below do.
+    _return_sp = _thread->cont_entry_sp();
+    _return_fp = _thread->cont_entry_fp();
+    _return_pc = _thread->cont_entry_pc();
+  } else {
+    _return_sp = ContinuationHelper::sender_unextended_sp(f);
+    _return_fp = *link;
+    _return_pc = *pc;
+  }
+  return Continuation::freeze_ok;
+}
+
+class CodeOopsClosure : public OopClosure {
+  Thread* _thread;
+  GrowableArray<Handle>* _oops;
+ public:
+  CodeOopsClosure(Thread* thread, GrowableArray<Handle>* oops) : _thread(thread), _oops(oops) {}
+  virtual void do_oop(oop* p) {
+    oop obj = NativeAccess<>::oop_load(p);
+    if (obj != NULL) {
+      _oops->append(Handle(_thread, obj));
+    }
+  }
+  virtual void do_oop(narrowOop* p) { ShouldNotReachHere(); }
+};
+
+// Off the stack, the nmethods of the frozen frames are no roots: GC would
+// find their oops dead and unload them. The refStack keeps the oops alive
+// instead, those of each nmethod once.
+void FreezeContext::collect_code_oops() {
+  CodeOopsClosure cl(_thread, &_code_oops);
+  for (int i = 0; i < _nmethods.length(); i++) {
+    CompiledMethod* cm = _nmethods.at(i);
+    if (cm->is_nmethod() && _nmethods.find(cm) == i) {
+      cm->as_nmethod()->oops_do(&cl);
+    }
+  }
+}
+
+void FreezeContext::fill(typeArrayOop stack, objArrayOop refs, typeArrayOop parent_stack, objArrayOop parent_refs, jlong id) {
+  int n = size();
+  stack->long_at_put(Continuation::hdr_size,     n);
+  stack->long_at_put(Continuation::hdr_old_top,  (jlong)(intptr_t)_top);
+  stack->long_at_put(Continuation::hdr_frames,   frames());
+  stack->long_at_put(Continuation::hdr_thawed,   0);
+  stack->long_at_put(Continuation::hdr_relocs,   _relocs.length());
+  stack->long_at_put(Continuation::hdr_oops,     _oop_count);
+  stack->long_at_put(Continuation::hdr_derived,  _derived.length() / 2);
+  stack->long_at_put(Continuation::hdr_nmethods, _nmethods.length());
+  stack->long_at_put(Continuation::hdr_monitors, _monitors.length());
+  stack->long_at_put(Continuation::hdr_code_oops, _code_oops.length());
+  stack->long_at_put(Continuation::hdr_id,       id);
+  stack->long_at_put(Continuation::hdr_carrier,  _thread->carrier_id());
+
+  int index = Continuation::header_size;
+  Copy::disjoint_words((HeapWord*)_top, (HeapWord*)stack->long_at_addr(index), n);
+  index += n;
+  for (int i = 0; i < _relocs.length(); i++) {
+    stack->long_at_put(index++, _relocs.at(i));
+  }
+  int bitmap_words = Continuation::oop_bitmap_words(n);
+  // A recycled stack holds the bitmaps of an earlier chunk.
+  BitMapView oop_bits((BitMap::bm_word_t*)stack->long_at_addr(index), _oop_bits.size());
+  oop_bits.set_from(_oop_bits);
+  index += bitmap_words;
+  BitMapView narrow_bits((BitMap::bm_word_t*)stack->long_at_addr(index), _narrow_bits.size());
+  narrow_bits.set_from(_narrow_bits);
+  index += bitmap_words;
+  int ref_index = Continuation::save_oops(_oop_bits, _narrow_bits, 0, _oop_bits.size(), _top, refs, 0);
+  assert(ref_index == _oop_count, "must be");
+  for (int i = 0; i < _derived.length(); i += 2) {
+    jlong derived = _derived.at(i);
+    jlong base = _derived.at(i + 1);
+    // Keep the derived pointer as an offset from its base, which may move.
+    intptr_t offset = *(intptr_t*)((address)_top + derived) - *(intptr_t*)((address)_top + base);
+    stack->long_at_put(Continuation::header_size + (int)(derived / wordSize), offset);
+    stack->long_at_put(index++, derived);
+    stack->long_at_put(index++, base);
+  }
+  for (int i = 0; i < _nmethods.length(); i++) {
+    // The frozen frames must not lose their code while they are off the stack.
+    nmethodLocker::lock_nmethod(_nmethods.at(i));
+    stack->long_at_put(index++, (jlong)(intptr_t)_nmethods.at(i));
+  }
+  for (int i = 0; i < _frames.length(); i++) {
+    stack->long_at_put(index++, _frames.at(i));
+  }
+  assert(index <= stack->length(), "must fit the array");
+
+  for (int i = 0; i < _monitors.length(); i++) {
+    refs->obj_at_put(ref_index++, _monitors.at(i)());
+  }
+  for (int i = 0; i < _code_oops.length(); i++) {
+    refs->obj_at_put(ref_index++, _code_oops.at(i)());
+  }
+  refs->obj_at_put(ref_index++, parent_stack);
+  refs->obj_at_put(ref_index++, parent_refs);
+}
+
+#if INCLUDE_JFR
+// Samples where continuations unmount, at most once per method sampling
+// period. The stack trace includes the frames still frozen below the barrier.
+static void post_yield_sample(const FreezeContext& fc, jlong id) {
+  EventContinuationYieldSample event;
+  if (event.should_commit() && JfrThreadSampling::claim_yield_sample()) {
+    event.set_continuation((u8)id);
+    event.set_frames(fc.frames());
+    event.set_size((u8)fc.size() * wordSize);
+    event.commit();
+  }
+}
+
+static const char* pinned_reason(int result) {
+  switch (result) {
+    case Continuation::freeze_pinned_native:  return "Native or VM frame on the stack";
+    case Continuation::freeze_pinned_monitor: return "Monitor held";
+    default:                                  return "Other";
+  }
+}
+
+// The event's duration is that of the failed yield.
+static void post_pinned(EventContinuationPinned& event, JavaThread* thread, int result) {
+  if (event.should_commit()) {
+    event.set_reason(pinned_reason(result));
+    event.set_continuation((u8)thread->cont_mount_id());
+    event.commit();
+  }
+}
+#endif
+
+// Takes the smallest chunk in the thread's free list with room for a chunk
+// of the given lengths. Returns false if there is none.
+static bool reuse_chunk(JavaThread* thread, int stack_length, int ref_length,
+                        typeArrayOop* stack, objArrayOop* refs) {
+  int slot = -1;
+  for (int i = 0; i < JavaThread::cont_free_chunks; i++) {
+    typeArrayOop s = (typeArrayOop)thread->cont_free_stack(i);
+    objArrayOop r = (objArrayOop)thread->cont_free_refs(i);
+    if (s != NULL && s->length() >= stack_length && r->length() >= ref_length &&
+        (slot < 0 || s->length() < ((typeArrayOop)thread->cont_free_stack(slot))->length())) {
+      slot = i;
+    }
+  }
+  if (slot < 0) {
+    return false;
+  }
+  *stack = (typeArrayOop)thread->cont_free_stack(slot);
+  *refs = (objArrayOop)thread->cont_free_refs(slot);
+  thread->set_cont_free_chunk(slot, NULL, NULL);
+  return true;
+}
+
+JRT_ENTRY(int, Continuation::freeze(JavaThread* thread, oopDesc* cont_oop, intptr_t* top))
+  Handle cont(thread, cont_oop);
+  ResourceMark rm(thread);
+  JFR_ONLY(EventContinuationPinned pinned_event;)
+
+  FreezeContext fc(thread, top);
+  int result = fc.walk();
+  if (result == freeze_ok && fc.at_barrier() && !oopDesc::equals(thread->cont_lazy(), cont())) {
+    // Yielding a continuation other than the one being thawed
+    result = freeze_pinned_native;
+  }
+  if (result != freeze_ok) {
+    log_debug(continuations)("freeze pinned (%d)", result);
+    JFR_ONLY(post_pinned(pinned_event, thread, result);)
+    return result;
+  }
+  fc.compute_oop_bitmaps();
+  fc.collect_code_oops();
+
+  // The frames below the barrier stay in the partially thawed chunk.
+  typeArrayHandle parent_stack(thread, fc.at_barrier() ? java_lang_Continuation::stack(cont()) : (typeArrayOop)NULL);
+  objArrayHandle parent_refs(thread, fc.at_barrier() ? java_lang_Continuation::refStack(cont()) : (objArrayOop)NULL);
+
+  jlong id;
+  if (fc.at_barrier()) {
+    id = parent_stack->long_at(hdr_id);
+  } else if (is_mounted_at(thread, fc.return_sp())) {
+    id = thread->cont_mount_id();
+  } else {
+    id = next_id();   // the first yield
+  }
+  JFR_ONLY(post_yield_sample(fc, id);)
+
+  typeArrayOop s;
+  objArrayOop refs;
+  bool reused = reuse_chunk(thread, fc.stack_length(), fc.ref_length(), &s, &refs);
+  if (!reused) {
+    s = oopFactory::new_longArray(fc.stack_length(), CHECK_(freeze_exception));
+    typeArrayHandle new_stack(thread, s);
+    refs = oopFactory::new_objArray(SystemDictionary::Object_klass(), fc.ref_length(),
+                                    CHECK_(freeze_exception));
+    s = new_stack();
+  }
+  typeArrayHandle stack(thread, s);
+
+  {
+    // From here on the frames must stay as walked.
+    NoSafepointVerifier nsv;
+    fc.fill(stack(), refs, parent_stack(), parent_refs(), id);
+    java_lang_Continuation::set_stack(cont(), stack());
+    java_lang_Continuation::set_refStack(cont(), refs);
+    thread->set_cont_frame(fc.return_sp(), fc.return_fp(), fc.return_pc());
+    if (fc.at_barrier()) {
+      thread->clear_cont_lazy();
+    }
+    remount_lazy(thread);
+    NMT_ONLY(if (ContinuationChunkTracker::is_enabled()) {
+      ContinuationChunkTracker::record_freeze(thread, chunk_heap_size(stack(), refs), reused);
+    })
+  }
+
+  log_trace(continuations)("froze %d words, %d refs", fc.size(), fc.ref_length() - 2);
+  if (JvmtiExport::should_notify_continuations()) {
+    JvmtiExport::post_continuation_unmount(thread, cont, id);
+  }
+  return freeze_ok;
+JRT_END
+
+#else // !SUPPORT_CONTINUATIONS
+
+// No doYield stub is generated on this platform, so this is not reached
+// from generated code; the Java body of doYield() runs instead.
+JRT_ENTRY(int, Continuation::freeze(JavaThread* thread, oopDesc* cont_oop, intptr_t* top))
+  return freeze_pinned_native;
+JRT_END
+
+#endif // SUPPORT_CONTINUATIONS
+
+JRT_ENTRY(void, Continuation::notify_mount(JavaThread* thread, oopDesc* cont_oop))
+  Handle cont(thread, cont_oop);
+  jlong id = java_lang_Continuation::stack(cont())->long_at(hdr_id);
+  JvmtiExport::post_continuation_mount(thread, cont, id);
+  thread->set_vm_result(cont());
+JRT_END
+
+// Where a thawed frame returns to, or where to resume a thawed frame
+struct ThawLink {
+  intptr_t* sp;
+  intptr_t* fp;
+  address   pc;
+};
+
+// Accessors for a chunk of frozen frames
+class FrozenChunk : public StackObj {
+ private:
+  typeArrayOop _stack;
+  objArrayOop  _refs;
+
+  int header(int index) const    { return (int)_stack->long_at(index); }
+  int relocs_index() const       { return Continuation::header_size + size(); }
+  int oop_bits_index() const     { return relocs_index() + header(Continuation::hdr_relocs); }
+  int narrow_bits_index() const  { return oop_bits_index() + Continuation::oop_bitmap_words(size()); }
+  int derived_index() const      { return narrow_bits_index() + Continuation::oop_bitmap_words(size()); }
+
+  BitMapView bitmap_at(int index) const {
+    return BitMapView((BitMap::bm_word_t*)_stack->long_at_addr(index), Continuation::oop_bitmap_bits(size()));
+  }
+  int nmethods_index() const     { return derived_index() + 2 * header(Continuation::hdr_derived); }
+  int frames_index() const       { return nmethods_index() + header(Continuation::hdr_nmethods); }
+
+  intptr_t word_at(int offset) const { return (intptr_t)_stack->long_at(Continuation::header_size + offset); }
+  jlong record_at(int k, int field) const {
+    assert(0 <= k && k < frames(), "no such frame");
+    return _stack->long_at(frames_index() + k * Continuation::frame_record_size + field);
+  }
+  int frame_at(int k, int field) const { return (int)record_at(k, field); }
+  int first_of(int k, int field, int total) const {
+    return k == frames() ? total : frame_at(k, field);
+  }
+
+  // The first word of frame k and the frames below it
+  int start(int k) const         { return k == 0 ? 0 : frame_at(k, Continuation::frame_sp); }
+
+ public:
+  FrozenChunk(typeArrayOop stack, objArrayOop refs) : _stack(stack), _refs(refs) {}
+
+  bool is_empty() const          { return _stack == NULL; }
+  jlong id() const               { return _stack->long_at(Continuation::hdr_id); }
+  int carrier() const            { return header(Continuation::hdr_carrier); }
+
+  int size() const               { return header(Continuation::hdr_size); }
+  intptr_t* old_top() const      { return (intptr_t*)(intptr_t)_stack->long_at(Continuation::hdr_old_top); }
+  int frames() const             { return header(Continuation::hdr_frames); }
+  int thawed() const             { return header(Continuation::hdr_thawed); }
+  void set_thawed(int n)         { _stack->long_at_put(Continuation::hdr_thawed, n); }
+
+  int parent_index() const {
+    return header(Continuation::hdr_oops) + header(Continuation::hdr_monitors) + header(Continuation::hdr_code_oops);
+  }
+
+  typeArrayOop parent_stack() const { return (typeArrayOop)_refs->obj_at(parent_index()); }
+  objArrayOop parent_refs() const   { return (objArrayOop)_refs->obj_at(parent_index() + 1); }
+
+  bool is_interpreted(int k) const { return frame_at(k, Continuation::frame_sender_sp) >= 0; }
+  Method* method(int k) const {
+    assert(is_interpreted(k), "must be");
+    return (Method*)(intptr_t)record_at(k, Continuation::frame_method);
+  }
+  int bci(int k) const {
+    assert(is_interpreted(k), "must be");
+    return frame_at(k, Continuation::frame_bci);
+  }
+  CompiledMethod* code(int k) const {
+    assert(!is_interpreted(k), "must be");
+    return (CompiledMethod*)(intptr_t)record_at(k, Continuation::frame_method);
+  }
+  int decode_offset(int k) const {
+    assert(!is_interpreted(k), "must be");
+    return frame_at(k, Continuation::frame_bci);
+  }
+
+  // Stack bytes the frames not yet thawed need, including realignment
+  size_t remaining_size() const  { return (size_t)(size() - start(thawed()) + 1) * wordSize; }
+
+  typeArrayOop stack() const     { return _stack; }
+  objArrayOop refs() const       { return _refs; }
+  void clear_refs();
+
+  intptr_t* thaw(int from, int to, intptr_t* below, const ThawLink& ret, ThawLink* resume);
+  void unlock_nmethods();
+  void transfer_monitors(JavaThread* thread);
+};
+
+// Makes the thawed compiled frame with the given unextended sp return to
+// its deopt handler, as frame::deoptimize() does. pc_addr holds the pc the
+// frame returns to.
+static void deoptimize_thawed(CompiledMethod* cm, intptr_t* sp, address* pc_addr) {
+  address pc = *pc_addr;
+  if (cm->is_deopt_pc(pc)) {
+    return;   // deoptimized before it was frozen
+  }
+  frame f(sp, sp, NULL, pc);
+  cm->set_original_pc(&f, pc);
+  *pc_addr = cm->is_method_handle_return(pc) ? cm->deopt_mh_handler_begin() : cm->deopt_handler_begin();
+  log_debug(continuations)("deoptimized thawed frame of " INTPTR_FORMAT, p2i(cm));
+}
+
+// Copies frames [from, to) right below 'below', linking the lowest of them
+// to return to 'ret', and returns the new address of their first word. The
+// frame 'from' is to be resumed as described by 'resume'.
+intptr_t* FrozenChunk::thaw(int from, int to, intptr_t* below, const ThawLink& ret, ThawLink* resume) {
+  int start = this->start(from);
+  int end = frame_at(to - 1, Continuation::frame_end);
+  intptr_t* old_start = old_top() + start;
+  intptr_t* old_end = old_top() + end;
+
+  // Keep the frames' stack alignment.
+  intptr_t misalignment = ((intptr_t)below - (intptr_t)old_end) & (StackAlignmentInBytes - 1);
+  intptr_t* new_end = (intptr_t*)((address)below - misalignment);
+  intptr_t* new_start = new_end - (end - start);
+  intptr_t delta = (address)new_start - (address)old_start;
+  // Frozen word offsets map to new_top[offset] for offsets in [start, end).
+  intptr_t* new_top = new_start - start;
+
+  Copy::disjoint_words((HeapWord*)_stack->long_at_addr(Continuation::header_size + start),
+                       (HeapWord*)new_start, end - start);
+
+  int relocs = header(Continuation::hdr_relocs);
+  for (int i = first_of(from, Continuation::frame_first_reloc, relocs);
+       i < first_of(to, Continuation::frame_first_reloc, relocs); i++) {
+    int offset = (int)_stack->long_at(relocs_index() + i);
+    if (offset < start || offset >= end) {
+      continue;   // the slot holding the fp of frame 'from'
+    }
+    intptr_t* slot = new_top + offset;
+    if ((intptr_t*)*slot >= old_start && (intptr_t*)*slot < old_end) {
+      *slot += delta;
+    }
+  }
+
+  BitMapView oop_bits = bitmap_at(oop_bits_index());
+  BitMapView narrow_bits = bitmap_at(narrow_bits_index());
+  Continuation::restore_oops(oop_bits, narrow_bits, Continuation::oop_bitmap_bits(start), Continuation::oop_bitmap_bits(end),
+                             new_top, _refs, frame_at(from, Continuation::frame_first_oop));
+
+  int derived = header(Continuation::hdr_derived);
+  for (int i = first_of(from, Continuation::frame_first_derived, derived);
+       i < first_of(to, Continuation::frame_first_derived, derived); i++) {
+    intptr_t* derived_slot = (intptr_t*)((address)new_top + _stack->long_at(derived_index() + 2 * i));
+    intptr_t* base_slot = (intptr_t*)((address)new_top + _stack->long_at(derived_index() + 2 * i + 1));
+    *derived_slot += *base_slot;
+  }
+
+  int bottom = to - 1;
+  new_top[frame_at(bottom, Continuation::frame_link)] = (intptr_t)ret.fp;
+  new_top[frame_at(bottom, Continuation::frame_pc)] = (intptr_t)ret.pc;
+  int sender_sp = frame_at(bottom, Continuation::frame_sender_sp);
+  if (sender_sp >= 0) {
+    new_top[sender_sp] = (intptr_t)ret.sp;
+  }
+
+  if (from == 0) {
+    // The doYield stub saved the fp and return pc of the top frame.
+    resume->fp = (intptr_t*)new_top[0];
+    resume->pc = (address)new_top[1];
+  } else {
+    // They are in the frame above, which was thawed before.
+    intptr_t* fp = (intptr_t*)word_at(frame_at(from - 1, Continuation::frame_link));
+    resume->fp = (fp >= old_start && fp < old_end) ? (intptr_t*)((address)fp + delta) : fp;
+    resume->pc = (address)word_at(frame_at(from - 1, Continuation::frame_pc));
+  }
+  resume->sp = new_top + frame_at(from, Continuation::frame_sp);
+
+  // Deoptimization only patches the frames on thread stacks: those of
+  // nmethods invalidated while they were frozen are deoptimized now.
+  for (int k = from; k < to; k++) {
+    assert(is_interpreted(k) || !code(k)->is_unloading(), "the refStack keeps frozen nmethods alive");
+    if (!is_interpreted(k) && code(k)->is_marked_for_deoptimization()) {
+      address* pc_addr = (k == from) ? &resume->pc : (address*)(new_top + frame_at(k - 1, Continuation::frame_pc));
+      deoptimize_thawed(code(k), new_top + frame_at(k, Continuation::frame_sp), pc_addr);
+    }
+  }
+  return new_start;
+}
+
+void FrozenChunk::unlock_nmethods() {
+  int nmethods = header(Continuation::hdr_nmethods);
+  for (int i = 0; i < nmethods; i++) {
+    nmethodLocker::unlock_nmethod((CompiledMethod*)(intptr_t)_stack->long_at(nmethods_index() + i));
+  }
+}
+
+void FrozenChunk::transfer_monitors(JavaThread* thread) {
+  int index = header(Continuation::hdr_oops);
+  for (int i = 0; i < header(Continuation::hdr_monitors); i++) {
+    markWord mark = _refs->obj_at(index + i)->mark();
+    assert(mark.has_monitor(), "frozen locks are inflated");
+    mark.monitor()->set_owner(thread);
+  }
+}
+
+void FrozenChunk::clear_refs() {
+  int n = parent_index() + 2;
+  for (int i = 0; i < n; i++) {
+    _refs->obj_at_put(i, NULL);
+  }
+}
+
+// Keeps the arrays of a chunk that is fully thawed, and so referenced by
+// nothing but the thread, in the thread's free list, and stops counting
+// them as frozen. A chunk only replaces
+// a smaller one when the list is full, and large chunks are left to the
+// collector.
+static void recycle_chunk(JavaThread* thread, FrozenChunk& chunk) {
+  NMT_ONLY(if (ContinuationChunkTracker::is_enabled()) {
+    ContinuationChunkTracker::record_thaw(chunk_heap_size(chunk.stack(), chunk.refs()), chunk.carrier());
+  })
+  int length = chunk.stack()->length();
+  if (length > Continuation::max_free_chunk_length) {
+    return;
+  }
+  int slot = -1;
+  int slot_length = length;
+  for (int i = 0; i < JavaThread::cont_free_chunks; i++) {
+    oop s = thread->cont_free_stack(i);
+    if (s == NULL) {
+      slot = i;
+      break;
+    }
+    if (typeArrayOop(s)->length() < slot_length) {
+      slot = i;
+      slot_length = typeArrayOop(s)->length();
+    }
+  }
+  if (slot >= 0) {
+    chunk.clear_refs();
+    thread->set_cont_free_chunk(slot, chunk.stack(), chunk.refs());
+  }
+}
+
+static size_t remaining_size(oop cont) {
+  size_t size = 0;
+  typeArrayOop stack = java_lang_Continuation::stack(cont);
+  objArrayOop refs = java_lang_Continuation::refStack(cont);
+  while (stack != NULL) {
+    FrozenChunk chunk(stack, refs);
+    size += chunk.remaining_size();
+    stack = chunk.parent_stack();
+    refs = chunk.parent_refs();
+  }
+  return size;
+}
+
+// Thaws the next frames of the continuation being thawed lazily, below the
+// caller of its doContinue().
+static void thaw_lazily(JavaThread* thread, oop cont) {
+  FrozenChunk chunk(java_lang_Continuation::stack(cont), java_lang_Continuation::refStack(cont));
+  int from = chunk.thawed();
+  int to = MIN2(from + Continuation::lazy_thaw_frames, chunk.frames());
+  bool last = (to == chunk.frames());
+  typeArrayOop parent_stack = chunk.parent_stack();
+
+  ThawLink ret;
+  ret.sp = thread->cont_entry_sp();
+  ret.fp = thread->cont_entry_fp();
+  if (last && parent_stack == NULL) {
+    // This includes the enter() frame.
+    ret.pc = thread->cont_entry_pc();
+  } else {
+    ret.pc = StubRoutines::cont_returnBarrier();
+  }
+
+  ThawLink resume;
+  chunk.thaw(from, to, thread->cont_entry_sp(), ret, &resume);
+  thread->set_cont_mount(chunk.id(), thread->cont_entry_sp());
+  chunk.set_thawed(to);
+  chunk.transfer_monitors(thread);
+  if (last) {
+    chunk.unlock_nmethods();
+    java_lang_Continuation::set_stack(cont, parent_stack);
+    java_lang_Continuation::set_refStack(cont, chunk.parent_refs());
+    if (parent_stack == NULL) {
+      thread->clear_cont_lazy();
+    }
+    recycle_chunk(thread, chunk);
+  }
+  thread->set_cont_frame(resume.sp, resume.fp, resume.pc);
+  log_trace(continuations)("thawed frames %d-%d of %d", from, to, chunk.frames());
+}
+
+// Thaws all frames of the continuation below the caller of its doContinue().
+static void thaw_all(JavaThread* thread, oop cont) {
+  ResourceMark rm(thread);
+  GrowableArray<typeArrayOop> stacks;
+  GrowableArray<objArrayOop> refs;
+  typeArrayOop s = java_lang_Continuation::stack(cont);
+  objArrayOop r = java_lang_Continuation::refStack(cont);
+  while (s != NULL) {
+    stacks.append(s);
+    refs.append(r);
+    FrozenChunk chunk(s, r);
+    s = chunk.parent_stack();
+    r = chunk.parent_refs();
+  }
+
+  ThawLink ret;
+  ret.sp = thread->cont_sp();
+  ret.fp = thread->cont_fp();
+  ret.pc = thread->cont_pc();
+  intptr_t* below = ret.sp;
+  thread->set_cont_mount(FrozenChunk(stacks.at(0), refs.at(0)).id(), below);
+  // The oldest chunk is the lowest on the stack.
+  for (int i = stacks.length() - 1; i >= 0; i--) {
+    FrozenChunk chunk(stacks.at(i), refs.at(i));
+    ThawLink resume;
+    below = chunk.thaw(chunk.thawed(), chunk.frames(), below, ret, &resume);
+    chunk.set_thawed(chunk.frames());
+    chunk.transfer_monitors(thread);
+    chunk.unlock_nmethods();
+    recycle_chunk(thread, chunk);
+    ret = resume;
+  }
+  java_lang_Continuation::set_stack(cont, NULL);
+  java_lang_Continuation::set_refStack(cont, NULL);
+  thread->set_cont_frame(ret.sp, ret.fp, ret.pc);
+}
+
+JRT_LEAF(size_t, Continuation::prepare_thaw(JavaThread* thread, oopDesc* cont))
+  assert(java_lang_Continuation::stack(cont) != NULL, "nothing to thaw");
+  size_t size = remaining_size(cont);
+  address limit = thread->stack_overflow_limit();
+  if ((address)thread->cont_sp() < limit + size) {
+    return 0;
+  }
+  return size;
+JRT_END
+
+JRT_LEAF(void, Continuation::thaw(JavaThread* thread, oopDesc* cont))
+  if (thread->cont_lazy() == NULL) {
+    // The frames below the ones thawed now return to the barrier and are
+    // thawed when it is reached, below the caller of doContinue().
+    thread->set_cont_lazy(cont, thread->cont_sp(), thread->cont_fp(), thread->cont_pc(),
+                          remaining_size(cont));
+    thaw_lazily(thread, cont);
+  } else {
+    thaw_all(thread, cont);
+  }
+JRT_END
+
+JRT_LEAF(void, Continuation::thaw_return_barrier(JavaThread* thread))
+  assert(thread->cont_lazy() != NULL, "no continuation is being thawed");
+  thaw_lazily(thread, thread->cont_lazy());
+JRT_END
+
+FrozenFrameStream::FrozenFrameStream(JavaThread* thread)
+  : _thread(thread), _state(not_started), _chunk(0), _frame(0), _cm(NULL),
+    _sender_decode_offset(DebugInformationRecorder::serialized_null), _method(NULL), _bci(0) {}
+
+// The chunk at the given depth of the chain of the continuation
+static FrozenChunk frozen_chunk_at(JavaThread* thread, int depth) {
+  oop cont = thread->cont_lazy();
+  typeArrayOop stack = java_lang_Continuation::stack(cont);
+  objArrayOop refs = java_lang_Continuation::refStack(cont);
+  for (int i = 0; i < depth && stack != NULL; i++) {
+    FrozenChunk chunk(stack, refs);
+    stack = chunk.parent_stack();
+    refs = chunk.parent_refs();
+  }
+  return FrozenChunk(stack, refs);
+}
+
+bool FrozenFrameStream::enter_at(intptr_t* id) {
+  if (_state != not_started || _thread->cont_lazy() == NULL || id != _thread->cont_entry_sp()) {
+    return false;
+  }
+  _state = walking;
+  _chunk = 0;
+  _frame = -1;
+  return fill_from_frame();
+}
+
+// Fills in the top scope of frame _frame of chunk _chunk, moving on to the
+// next chunk past its last frame. A negative _frame stands for the first
+// frame of the chunk not thawed yet. Returns false at the end.
+bool FrozenFrameStream::fill_from_frame() {
+  while (true) {
+    FrozenChunk chunk = frozen_chunk_at(_thread, _chunk);
+    if (chunk.is_empty()) {
+      _state = done;
+      return false;
+    }
+    if (_frame < 0) {
+      _frame = chunk.thawed();
+    }
+    if (_frame < chunk.frames()) {
+      if (chunk.is_interpreted(_frame)) {
+        _cm = NULL;
+        _sender_decode_offset = DebugInformationRecorder::serialized_null;
+        _method = chunk.method(_frame);
+        _bci = chunk.bci(_frame);
+      } else {
+        _cm = chunk.code(_frame);
+        fill_from_scope(chunk.decode_offset(_frame));
+      }
+      return true;
+    }
+    _chunk++;
+    _frame = -1;
+  }
+}
+
+void FrozenFrameStream::fill_from_scope(int decode_offset) {
+  DebugInfoReadStream buffer(_cm, decode_offset);
+  _sender_decode_offset = buffer.read_int();
+  _method = buffer.read_method();
+  _bci = buffer.read_bci();
+}
+
+void FrozenFrameStream::next() {
+  assert(is_walking(), "must be");
+  if (_sender_decode_offset != DebugInformationRecorder::serialized_null) {
+    fill_from_scope(_sender_decode_offset);
+    return;
+  }
+  _frame++;
+  fill_from_frame();
+}
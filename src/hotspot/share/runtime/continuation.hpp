@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_CONTINUATION_HPP
+#define SHARE_RUNTIME_CONTINUATION_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class BitMap;
+class CompiledMethod;
+class JavaThread;
+class Method;
+
+// One-shot delimited continuations.
+//
+// A java.lang.Continuation delimits a portion of the thread stack with its
+// enter() method. Continuation.doYield(cont) freezes all Java frames between
+// the yield point and the enter() frame into the continuation, and returns
+// to the caller of enter() as if enter() had returned. Continuation.doContinue()
+// later thaws those frames onto the stack of the current thread, returning to
+// the frame that yielded as if doYield() had returned 0. Each freeze is thawed
+// at most once.
+//
+// Frames are walked with frame/RegisterMap and their oops are located with
+// the interpreter and compiled oop maps. The frozen frames are stored as raw
+// stack words in a long[] (the continuation's "stack") and the oops they hold
+// in an Object[] (its "refStack"). Slots that hold pointers into the frozen
+// part of the stack are recorded so that thaw can relocate them, and oop
+// slots are recorded so that thaw can restore them from the refStack. Since
+// both arrays are ordinary Java objects, frozen frames are kept alive and
+// updated by every collector without further support. Stacks of compiled
+// frames that synchronize on nothing take a faster walk, which decodes no
+// scopes and records no relocations.
+//
+// Freezing fails, leaving the stack untouched, if the frames are pinned to
+// the thread: if a native or VM frame is found between doYield() and enter().
+// Monitors held by the frames are inflated when frozen and passed on to the
+// thread the frames are thawed on; only locks that compiled code elided pin.
+// Frozen compiled frames keep their nmethods locked, so that the sweeper does
+// not flush them, and keep the oops of their nmethods, which include the
+// mirrors or loaders of the holders of all methods compiled into them, in
+// the refStack, so that GC does not unload them: off the stack, the nmethods
+// are no roots. Frozen frames are deoptimized when they are thawed if their
+// nmethod was marked for deoptimization meanwhile, so that invalidating code
+// needs no thawing of parked continuations.
+//
+// Thawing is lazy: doContinue() only thaws the top lazy_thaw_frames frames
+// and makes the lowest of them return to the return barrier stub, which
+// thaws the next frames when it is reached. Java frames below the barrier
+// are skipped by stack walks until they are thawed. A continuation yielding
+// again while some of its frames are still frozen freezes only the thawed
+// frames, into a new chunk whose parent is the partially thawed one. Only one
+// continuation per thread is thawed lazily at a time; doContinue() of another
+// continuation while one is thaws all of its frames at once. Stack traces
+// and StackWalker include the frames still frozen through FrozenFrameStream.
+//
+// A chunk is a pair of arrays. The stack long[] starts with a header (see
+// StackHeader) followed by the frozen words, the relocation offsets, a bitmap
+// of the jint sized slots holding oops and one of those holding narrow oops,
+// the derived pointer descriptors, the nmethods the frames execute in and a
+// record (see FrameRecord) per frame, from the top. The refStack Object[]
+// holds the oops in slot order, the objects locked by the frames and the oops
+// of their nmethods, followed by the parent chunk's arrays.
+//
+// The arrays of a fully thawed chunk are kept in a small free list of the
+// thread, their refStack cleared, and reused by the next freeze on the
+// thread that fits in them, most often that of the same continuation. The
+// arrays may then be longer than the chunk needs.
+//
+// Collectors scan chunks without special support: the long[] holds no oops
+// and is never scanned, and the refStack is scanned like any other object
+// array, in parallel by the collectors that split large arrays. They do not
+// know about the frozen frames, though, which is why the refStack keeps the
+// nmethods of the frozen frames from unloading.
+//
+// Each continuation gets an id when it is first frozen, kept in its chunks.
+// The thread remembers the id of the continuation it thawed last (see
+// JavaThread::cont_mount_id()), so that JFR can attribute samples to the
+// mounted continuation; a continuation that has not yielded yet has none.
+// JVMTI is notified with the id after a continuation unmounts and before it
+// mounts again, when JvmtiExport::should_notify_continuations().
+
+class Continuation : AllStatic {
+ public:
+  // Value returned to Java by doYield()
+  enum FreezeResult {
+    freeze_ok             = 0,
+    freeze_pinned_native  = 1,   // a native, VM or otherwise unmovable frame
+    freeze_pinned_monitor = 2,   // a frame holds a lock that cannot be migrated
+    freeze_exception      = 3    // an exception is pending (e.g. OOME)
+  };
+
+  // Layout of the header at the start of the stack long[]
+  enum StackHeader {
+    hdr_size,              // number of frozen stack words
+    hdr_old_top,           // address of the top word when frozen
+    hdr_frames,            // number of frozen frames
+    hdr_thawed,            // number of frames already thawed, from the top
+    hdr_relocs,            // number of relocated slots
+    hdr_oops,              // number of oop slots
+    hdr_derived,           // number of derived pointers
+    hdr_nmethods,          // number of nmethods locked by the frozen frames
+    hdr_monitors,          // number of objects locked by the frozen frames
+    hdr_code_oops,         // number of oops of the nmethods kept alive
+    hdr_id,                // identifies the continuation in JFR events
+    hdr_carrier,           // the carrier pool queue of the freezing thread
+    header_size
+  };
+
+  // Layout of the per frame records at the end of the stack long[]. All
+  // offsets are in words from the top, indices count from the start of the
+  // respective section.
+  enum FrameRecord {
+    frame_sp,              // the sp the frame resumes with
+    frame_end,             // the end of the words owned by the frame
+    frame_link,            // the slot holding the caller's fp
+    frame_pc,              // the slot holding the return pc
+    frame_sender_sp,       // the slot holding the saved sender sp, or -1
+    frame_method,          // the Method* if interpreted, else the CompiledMethod*
+    frame_bci,             // the bci if interpreted, else the scope decode offset
+    frame_first_reloc,     // index of the frame's first relocation
+    frame_first_oop,       // number of oops above the first word of the frame
+    frame_first_derived,   // index of the frame's first derived pointer
+    frame_record_size
+  };
+
+  // Kinds of the oop slot descriptors collected by freeze, kept in the low
+  // bits of the byte offset
+  enum OopSlotKind {
+    slot_oop        = 0,
+    slot_narrow_oop = 1,
+    slot_kind_bits  = 1,
+    slot_kind_mask  = right_n_bits(slot_kind_bits)
+  };
+
+  // Size of the oop bitmaps for size frozen words
+  static int oop_bitmap_bits(int size)  { return size * (wordSize / BytesPerInt); }
+  static int oop_bitmap_words(int size) { return (oop_bitmap_bits(size) + BitsPerLong - 1) / BitsPerLong; }
+
+  // Copy the oops of the slots set in oop_bits in [beg, end), in slot order,
+  // from the frames at top to refs starting at ref_index, or back. The slots
+  // set in narrow_bits hold narrow oops. Return the index after the last oop.
+  static int save_oops(const BitMap& oop_bits, const BitMap& narrow_bits, size_t beg, size_t end,
+                       const intptr_t* top, objArrayOop refs, int ref_index);
+  static int restore_oops(const BitMap& oop_bits, const BitMap& narrow_bits, size_t beg, size_t end,
+                          intptr_t* top, objArrayOop refs, int ref_index);
+
+  // Number of frames thawed by doContinue() and by each return barrier
+  static const int lazy_thaw_frames = 2;
+
+  // Length of the largest stack long[] kept for reuse once thawed
+  static const int max_free_chunk_length = 4 * K;
+
+  // A new continuation id, assigned when a continuation is first frozen
+  static jlong next_id();
+
+  // True if this platform generated the doYield/doContinue stubs.
+  static bool is_supported();
+
+  // Called from the doYield stub with the yielding frame as the last Java
+  // frame. top is the lowest address of the stack portion to freeze, where
+  // the stub saved the frame pointer of the yielding frame. On success the
+  // frame to return to (the caller of enter()) is left in thread->cont_*.
+  static int freeze(JavaThread* thread, oopDesc* cont, intptr_t* top);
+
+  // Called from the doContinue stub, before prepare_thaw(), when JVMTI
+  // asks to be notified of continuations mounting. May safepoint, and
+  // returns cont in thread->vm_result().
+  static void notify_mount(JavaThread* thread, oopDesc* cont);
+
+  // Called from the doContinue stub with thread->cont_* describing the caller
+  // of doContinue(). Returns the number of bytes of stack the frozen frames
+  // need below the caller's sp, or 0 if they do not fit.
+  static size_t prepare_thaw(JavaThread* thread, oopDesc* cont);
+
+  // Copies the top frozen frames back below the caller of doContinue(), and
+  // leaves the frame that yielded, to resume with doYield() returning 0, in
+  // thread->cont_*.
+  static void thaw(JavaThread* thread, oopDesc* cont);
+
+  // Called from the return barrier stub, with the stack below
+  // thread->cont_entry_sp() unused. Thaws the next frames and leaves the one
+  // to return to in thread->cont_*.
+  static void thaw_return_barrier(JavaThread* thread);
+};
+
+// Iterates over the Java methods of the frames of the thread's lazily thawed
+// continuation that are still frozen, from the top, without thawing them.
+// A stack walk calls enter_at() with the id of every physical frame it
+// reaches; when that is the frame the return barrier returns to, the frozen
+// frames are to be walked before it. Nothing but the thread's own oops is
+// kept across next(), so the walk may safepoint between frames.
+class FrozenFrameStream : public StackObj {
+ private:
+  enum State { not_started, walking, done };
+
+  JavaThread*     _thread;
+  State           _state;
+  int             _chunk;                  // depth of the chunk in the chain
+  int             _frame;                  // index of the frame in the chunk
+  CompiledMethod* _cm;
+  int             _sender_decode_offset;   // of the scope inlining the current one
+  Method*         _method;
+  int             _bci;
+
+  bool fill_from_frame();
+  void fill_from_scope(int decode_offset);
+
+ public:
+  FrozenFrameStream(JavaThread* thread);
+
+  // Starts walking the frozen frames if id is the id of the frame the
+  // return barrier returns to and they were not walked yet. Returns true
+  // if it did.
+  bool enter_at(intptr_t* id);
+
+  bool is_walking() const { return _state == walking; }
+  void next();
+
+  Method* method() const  { return _method; }
+  int bci() const         { return _bci; }
+  bool is_interpreted_frame() const { return _cm == NULL; }
+};
+
+#endif // SHARE_RUNTIME_CONTINUATION_HPP
@@ -34,6 +34,8 @@
 #include "interpreter/bytecode.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/oopMapCache.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -53,9 +55,11 @@
 #include "runtime/fieldDescriptor.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/frame.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
@@ -780,9 +784,35 @@ JRT_LEAF(BasicType, Deoptimization::unpack_frames(JavaThread* thread, int exec_m
 JRT_END
 
 
-int Deoptimization::deoptimize_dependents() {
-  Threads::deoptimized_wrt_marked_nmethods();
-  return 0;
+class DeoptimizeMarkedClosure : public ThreadClosure {
+ public:
+  virtual void do_thread(Thread* thread) {
+    JavaThread* jt = (JavaThread*)thread;
+    jt->deoptimized_wrt_marked_nmethods();
+  }
+};
+
+void Deoptimization::deoptimize_all_marked() {
+  ResourceMark rm;
+  DeoptimizationMarker dm;
+
+  // Make the dependent methods not entrant first so that no new
+  // activations can be created while the stacks are being patched.
+  {
+    MutexLocker mu(SafepointSynchronize::is_at_safepoint() ? NULL : CodeCache_lock,
+                   Mutex::_no_safepoint_check_flag);
+    CodeCache::make_marked_nmethods_not_entrant();
+  }
+
+  // Patch the activations of marked nmethods so that they deoptimize
+  // lazily when control returns to them. Outside of a safepoint each
+  // thread is handshaked individually instead of stopping the world.
+  DeoptimizeMarkedClosure deopt;
+  if (SafepointSynchronize::is_at_safepoint()) {
+    Threads::java_threads_do(&deopt);
+  } else {
+    Handshake::execute(&deopt);
+  }
 }
 
 Deoptimization::DeoptAction Deoptimization::_unloaded_action
@@ -1613,6 +1643,27 @@ void Deoptimization::load_class_by_index(const constantPoolHandle& constant_pool
   }
 }
 
+static void post_deoptimization_storm_event(MethodData* trap_mdo,
+                                            Deoptimization::DeoptReason reason,
+                                            Deoptimization::DeoptAction action) {
+  Method* m = trap_mdo->method();
+  uint reason_traps = ((uint)reason < MethodData::trap_reason_limit()) ? trap_mdo->trap_count(reason) : 0;
+  log_info(jit, compilation)("deoptimization storm in %s: reason=%s action=%s traps=%u decompiles=%u",
+                             m->name_and_sig_as_C_string(),
+                             Deoptimization::trap_reason_name(reason),
+                             Deoptimization::trap_action_name(action),
+                             reason_traps, trap_mdo->decompile_count());
+  EventDeoptimizationStorm event;
+  if (event.should_commit()) {
+    event.set_method(m);
+    event.set_reason(Deoptimization::trap_reason_name(reason));
+    event.set_action(Deoptimization::trap_action_name(action));
+    event.set_reasonTrapCount(reason_traps);
+    event.set_decompileCount(trap_mdo->decompile_count());
+    event.commit();
+  }
+}
+
 JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint trap_request)) {
   HandleMark hm;
 
@@ -2026,6 +2077,17 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       if (reason == Reason_tenured && trap_mdo != NULL) {
         trap_mdo->inc_tenure_traps();
       }
+
+      // Back off from a deoptimization storm: instead of recompiling right away
+      // (and eventually hitting PerMethodTrapLimit), run the method in the
+      // interpreter for a while so the profile reflects the new behavior.
+      // Only traps that actually invalidated nm get here, so traps which
+      // merely reinterpret, or lose the make_not_entrant() race, do not count.
+      if (DeoptStormThreshold > 0 && trap_mdo != NULL &&
+          trap_mdo->record_deopt_for_storm(os::javaTimeMillis())) {
+        reprofile = true;
+        post_deoptimization_storm_event(trap_mdo, reason, action);
+      }
     }
 
     if (inc_recompile_count) {
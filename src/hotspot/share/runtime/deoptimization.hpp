@@ -137,9 +137,10 @@ class Deoptimization : AllStatic {
     Unpack_LIMIT                = 4
   };
 
-  // Checks all compiled methods. Invalid methods are deleted and
-  // corresponding activations are deoptimized.
-  static int deoptimize_dependents();
+  // Makes all compiled methods marked for deoptimization not entrant and
+  // lazily deoptimizes their activations. Outside of a safepoint the
+  // activations are patched with a handshake rather than a VM operation.
+  static void deoptimize_all_marked();
 
   // Deoptimizes a frame lazily. nmethod gets patched deopt happens on return to the frame
   static void deoptimize(JavaThread* thread, frame fr, RegisterMap *reg_map);
@@ -314,6 +314,11 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, UseInlineCaches, true,                                      \
           "Use Inline Caches for virtual calls ")                           \
                                                                             \
+  product(bool, UseSecondarySupersCache, true,                              \
+          "Remember the last secondary super found by a subtype check "     \
+          "in the subclass. Turn off if the same classes are checked "      \
+          "against several interfaces from many threads")                   \
+                                                                            \
   diagnostic(bool, InlineArrayCopy, true,                                   \
           "Inline arraycopy native that is known to be part of "            \
           "base library DLL")                                               \
@@ -408,6 +413,11 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, AbortVMOnSafepointTimeout, false,                        \
           "Abort upon failure to reach safepoint (see SafepointTimeout)")   \
                                                                             \
+  diagnostic(intx, SafepointSlowThreadThreshold, 0,                         \
+          "Report where threads were executing if they took longer than "   \
+          "this many milliseconds to reach a safepoint (0 is off)")         \
+          range(0, max_jint)                                                \
+                                                                            \
   diagnostic(bool, AbortVMOnVMOperationTimeout, false,                      \
           "Abort upon failure to complete VM operation promptly")           \
                                                                             \
@@ -551,6 +561,12 @@ const size_t minimumSymbolTableSize = 1024;
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(size_t, NativeMemoryTrackingSampleInterval, 0,                    \
+          "With detail native memory tracking, record the call stack of "   \
+          "about one malloc per this many bytes allocated (0 records "      \
+          "every malloc). Can be changed with jcmd VM.native_memory")       \
+          range(0, max_uintx)                                               \
+                                                                            \
   diagnostic(bool, PrintNMTStatistics, false,                               \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -1010,6 +1026,13 @@ const size_t minimumSymbolTableSize = 1024;
              "Reduce the number of parallel compiler threads when they "    \
              "are not used")                                                \
                                                                             \
+  manageable(uintx, CompilerThreadsCPUPercent, 100,                         \
+          "With UseDynamicNumberOfCompilerThreads, keep the number of "     \
+          "running compiler threads at or below this percentage of the "    \
+          "processors available to the VM (including container CPU "       \
+          "quotas). At least one thread per compiler is always kept")       \
+          range(1, 100)                                                     \
+                                                                            \
   diagnostic(bool, TraceCompilerThreads, false,                             \
              "Trace creation and removal of compiler threads")              \
                                                                             \
@@ -1145,6 +1168,15 @@ const size_t minimumSymbolTableSize = 1024;
           "If LogVMOutput or LogCompilation is on, save VM output to "      \
           "this file [default: ./hotspot_pid%p.log] (%p replaced with pid)")\
                                                                             \
+  product(bool, AsyncLogging, false,                                        \
+          "Write -Xlog file outputs from a dedicated thread instead of "    \
+          "the thread that logs")                                           \
+                                                                            \
+  product(size_t, AsyncLogBufferSize, 2*M,                                  \
+          "Memory (in bytes) for messages pending in asynchronous "         \
+          "logging; messages that do not fit are dropped")                  \
+          range(100*K, 50*M)                                                \
+                                                                            \
   product(ccstr, ErrorFile, NULL,                                           \
           "If an error occurs, save the error data to this file "           \
           "[default: ./hs_err_pid%p.log] (%p replaced with pid)")           \
@@ -1558,6 +1590,18 @@ const size_t minimumSymbolTableSize = 1024;
           "After recompiling N times, stay in the interpreter (-1=>'Inf')") \
           range(-1, max_intx)                                               \
                                                                             \
+  product(intx, DeoptStormThreshold, 0,                                     \
+          "Number of deoptimizations of a method within DeoptStormWindow "  \
+          "that is treated as a deoptimization storm: the method is "       \
+          "reprofiled in the interpreter before it is recompiled "          \
+          "(0, the default, disables storm detection)")                     \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(intx, DeoptStormWindow, 1000,                                     \
+          "Length in milliseconds of the window used to detect "            \
+          "deoptimization storms")                                          \
+          range(1, max_jint)                                                \
+                                                                            \
   product(intx, PerBytecodeRecompilationCutoff, 200,                        \
           "Per-BCI limit on repeated recompilation (-1=>'Inf')")            \
           range(-1, max_intx)                                               \
@@ -1657,6 +1701,10 @@ const size_t minimumSymbolTableSize = 1024;
           range(0, 99)                                                      \
           constraint(MinMetaspaceFreeRatioConstraintFunc,AfterErgo)         \
                                                                             \
+  product(bool, MetaspaceReclaimFreeChunks, false,                          \
+          "Return the memory of free medium and humongous Metaspace "       \
+          "chunks to the operating system while keeping it committed")      \
+                                                                            \
   product(size_t, MaxMetaspaceExpansion, ScaleForWordSize(4*M),             \
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
           range(0, max_uintx)                                               \
@@ -1987,6 +2035,19 @@ const size_t minimumSymbolTableSize = 1024;
           "and the value of the per-method flag.")                          \
           range(0.0, DBL_MAX)                                               \
                                                                             \
+  product(ccstr, DumpCompilationProfile, NULL,                              \
+          "Write the methods in the code cache and their compilation "      \
+          "levels to this file when the VM exits")                          \
+                                                                            \
+  product(ccstr, LoadCompilationProfile, NULL,                              \
+          "Compile the methods listed in this file, written by "            \
+          "DumpCompilationProfile, after fewer invocations")                \
+                                                                            \
+  product(double, CompilationProfileThresholdScaling, 0.05,                 \
+          "Factor applied to the compilation thresholds of methods "        \
+          "listed in the LoadCompilationProfile file")                      \
+          range(0.0, 1.0)                                                   \
+                                                                            \
   product(intx, Tier0InvokeNotifyFreqLog, 7,                                \
           "Interpreter (tier 0) invocation notification frequency")         \
           range(0, 30)                                                      \
@@ -2105,6 +2166,12 @@ const size_t minimumSymbolTableSize = 1024;
           "given timeout in milliseconds")                                  \
           range(0, max_intx)                                                \
                                                                             \
+  product(intx, TieredCompileTaskAgingTime, 1000,                           \
+          "Raise the priority of a queued compile task by its own weight "  \
+          "for every given number of milliseconds it has been waiting "     \
+          "(0 disables aging)")                                             \
+          range(0, max_intx)                                                \
+                                                                            \
   product(intx, TieredStopAtLevel, 4,                                       \
           "Stop at given compilation level")                                \
           range(0, 4)                                                       \
@@ -2452,6 +2519,11 @@ const size_t minimumSymbolTableSize = 1024;
   JFR_ONLY(product(ccstr, StartFlightRecording, NULL,                       \
           "Start flight recording with options"))                           \
                                                                             \
+  JFR_ONLY(product(size_t, FlightRecorderAllocationSampleInterval, 512*K,   \
+          "Minimum number of bytes a thread allocates between two "         \
+          "ObjectAllocationSample events (0 samples every slow-path "       \
+          "allocation)"))                                                   \
+                                                                            \
   experimental(bool, UseFastUnorderedTimeStamps, false,                     \
           "Use platform unstable time where supported for timestamps only")
 
@@ -26,6 +26,7 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/icBuffer.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmci.hpp"
@@ -138,6 +139,7 @@ jint init_globals() {
   vtableStubs_init();
   InlineCacheBuffer_init();
   compilerOracle_init();
+  CompilationProfile::load();
   dependencyContext_init();
 
   if (!compileBroker_init()) {
@@ -31,6 +31,7 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
@@ -40,6 +41,7 @@
 #include "jvmci/jvmci.hpp"
 #endif
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logStream.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -497,9 +499,17 @@ void before_exit(JavaThread* thread) {
   }
 #endif
 
+  if (DumpCompilationProfile != NULL) {
+    CompilationProfile::dump(DumpCompilationProfile, tty);
+  }
+
   print_statistics();
   Universe::heap()->print_tracing_info();
 
+  // Write out messages still pending in asynchronous logging. Messages
+  // logged from here on are written synchronously.
+  AsyncLogWriter::stop();
+
   { MutexLocker ml(BeforeExit_lock);
     _before_exit_status = BEFORE_EXIT_DONE;
     BeforeExit_lock->notify_all();
@@ -88,6 +88,28 @@ jobject JNIHandles::make_local(JNIEnv* env, oop obj) {
 }
 
 
+// The per-thread caches are bypassed when checking JNI calls, so that a
+// deleted handle is not mistaken for a live global one.
+static JavaThread* handle_cache_thread() {
+  Thread* thread = Thread::current();
+  if (CheckJNICalls || !thread->is_Java_thread()) {
+    return NULL;
+  }
+  return (JavaThread*)thread;
+}
+
+static oop* allocate_global_entry(OopStorage* storage, JNIHandleCache* cache) {
+  return (cache != NULL) ? cache->allocate(storage) : storage->allocate();
+}
+
+static void release_global_entry(OopStorage* storage, JNIHandleCache* cache, oop* ptr) {
+  if (cache != NULL) {
+    cache->release(storage, ptr);
+  } else {
+    storage->release(ptr);
+  }
+}
+
 static void report_handle_allocation_failure(AllocFailType alloc_failmode,
                                              const char* handle_kind) {
   if (alloc_failmode == AllocFailStrategy::EXIT_OOM) {
@@ -106,7 +128,9 @@ jobject JNIHandles::make_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = global_handles()->allocate();
+    JavaThread* thread = handle_cache_thread();
+    oop* ptr = allocate_global_entry(global_handles(),
+                                     (thread != NULL) ? thread->jni_global_handle_cache() : NULL);
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -128,7 +152,9 @@ jobject JNIHandles::make_weak_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = weak_global_handles()->allocate();
+    JavaThread* thread = handle_cache_thread();
+    oop* ptr = allocate_global_entry(weak_global_handles(),
+                                     (thread != NULL) ? thread->jni_weak_handle_cache() : NULL);
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -167,7 +193,10 @@ void JNIHandles::destroy_global(jobject handle) {
     assert(!is_jweak(handle), "wrong method for detroying jweak");
     oop* oop_ptr = jobject_ptr(handle);
     NativeAccess<>::oop_store(oop_ptr, (oop)NULL);
-    global_handles()->release(oop_ptr);
+    JavaThread* thread = handle_cache_thread();
+    release_global_entry(global_handles(),
+                         (thread != NULL) ? thread->jni_global_handle_cache() : NULL,
+                         oop_ptr);
   }
 }
 
@@ -177,7 +206,10 @@ void JNIHandles::destroy_weak_global(jobject handle) {
     assert(is_jweak(handle), "JNI handle not jweak");
     oop* oop_ptr = jweak_ptr(handle);
     NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(oop_ptr, (oop)NULL);
-    weak_global_handles()->release(oop_ptr);
+    JavaThread* thread = handle_cache_thread();
+    release_global_entry(weak_global_handles(),
+                         (thread != NULL) ? thread->jni_weak_handle_cache() : NULL,
+                         oop_ptr);
   }
 }
 
@@ -206,6 +238,49 @@ void JNIHandles::initialize() {
                                         JNIWeakActive_lock);
 }
 
+void JNIHandles::flush_handle_caches(JavaThread* thread) {
+  // Threads can exit before the storages exist if VM startup fails.
+  if (_global_handles != NULL) {
+    thread->jni_global_handle_cache()->flush(_global_handles);
+  }
+  if (_weak_global_handles != NULL) {
+    thread->jni_weak_handle_cache()->flush(_weak_global_handles);
+  }
+}
+
+oop* JNIHandleCache::allocate(OopStorage* storage) {
+  if (_count == 0) {
+    // Only fill half the cache, leaving room for entries that are released
+    // before the next refill.
+    _count = (uint)storage->allocate(_entries, capacity / 2);
+    if (_count == 0) {
+      return NULL;
+    }
+  }
+  return _entries[--_count];
+}
+
+void JNIHandleCache::release(OopStorage* storage, oop* ptr) {
+  assert(*ptr == NULL, "precondition");
+  if (_count == capacity) {
+    // Return the oldest half in one batch.
+    const uint surplus = capacity / 2;
+    storage->release(_entries, surplus);
+    for (uint i = surplus; i < capacity; i++) {
+      _entries[i - surplus] = _entries[i];
+    }
+    _count -= surplus;
+  }
+  _entries[_count++] = ptr;
+}
+
+void JNIHandleCache::flush(OopStorage* storage) {
+  if (_count > 0) {
+    storage->release(_entries, _count);
+    _count = 0;
+  }
+}
+
 
 inline bool is_storage_handle(const OopStorage* storage, const oop* ptr) {
   return storage->allocation_status(ptr) == OopStorage::ALLOCATED_ENTRY;
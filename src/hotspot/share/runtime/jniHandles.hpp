@@ -95,6 +95,10 @@ class JNIHandles : AllStatic {
   // Initialization
   static void initialize();
 
+  // Return the free entries cached by thread to the storages, when the
+  // thread exits and during safepoint cleanup
+  static void flush_handle_caches(JavaThread* thread);
+
   // Debugging
   static void print_on(outputStream* st);
   static void print();
@@ -128,6 +132,33 @@ class JNIHandles : AllStatic {
 };
 
 
+// Per-thread cache of free global or weak global handle entries.  The
+// cached entries are allocated in the owning OopStorage but hold NULL, so
+// the GC ignores them.  Refilling takes the storage's allocation mutex
+// once per batch rather than once per handle, and destroying a handle
+// normally returns its entry to the cache without touching the storage.
+
+class JNIHandleCache {
+ public:
+  static const uint capacity = 16;
+
+ private:
+  oop* _entries[capacity];
+  uint _count;
+
+ public:
+  JNIHandleCache() : _count(0) {}
+
+  // Returns a free entry, refilling the cache from storage when empty.
+  // Returns NULL if storage allocation failed.
+  oop* allocate(OopStorage* storage);
+  // Adds a free entry, returning surplus entries to storage when full.
+  // precondition: *ptr == NULL.
+  void release(OopStorage* storage, oop* ptr);
+  // Returns all cached entries to storage.
+  void flush(OopStorage* storage);
+};
+
 
 // JNI handle blocks holding local/global JNI handles
 
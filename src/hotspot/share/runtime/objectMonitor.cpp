@@ -1590,6 +1590,10 @@ int ObjectMonitor::TrySpin(Thread * Self) {
     return 0;
   }
 
+  // Spin attempts, successes and aborts because the owner is not running
+  // are exported so that the profitability of spinning can be observed.
+  OM_PERFDATA_OP(SpinAttempts, inc());
+
   for (ctr = Knob_PreSpin + 1; --ctr >= 0;) {
     if (TryLock(Self) > 0) {
       // Increase _SpinDuration ...
@@ -1600,6 +1604,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
         if (x < Knob_Poverty) x = Knob_Poverty;
         _SpinDuration = x + Knob_BonusB;
       }
+      OM_PERFDATA_OP(SpinSuccesses, inc());
       return 1;
     }
     SpinPause();
@@ -1623,6 +1628,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
   if (ctr <= 0) return 0;
 
   if (NotRunnable(Self, (Thread *) _owner)) {
+    OM_PERFDATA_OP(SpinOwnerNotRunnable, inc());
     return 0;
   }
 
@@ -1690,6 +1696,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
           if (x < Knob_Poverty) x = Knob_Poverty;
           _SpinDuration = x + Knob_Bonus;
         }
+        OM_PERFDATA_OP(SpinSuccesses, inc());
         return 1;
       }
 
@@ -1713,6 +1720,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
     // Spinning while the owner is OFFPROC is idiocy.
     // Consider: ctr -= RunnablePenalty ;
     if (NotRunnable(Self, ox)) {
+      OM_PERFDATA_OP(SpinOwnerNotRunnable, inc());
       goto Abort;
     }
     if (_succ == NULL) {
@@ -1742,7 +1750,10 @@ int ObjectMonitor::TrySpin(Thread * Self) {
     // in the normal usage of TrySpin(), but it's safest
     // to make TrySpin() as foolproof as possible.
     OrderAccess::fence();
-    if (TryLock(Self) > 0) return 1;
+    if (TryLock(Self) > 0) {
+      OM_PERFDATA_OP(SpinSuccesses, inc());
+      return 1;
+    }
   }
   return 0;
 }
@@ -1891,6 +1902,9 @@ PerfCounter * ObjectMonitor::_sync_Parks                       = NULL;
 PerfCounter * ObjectMonitor::_sync_Notifications               = NULL;
 PerfCounter * ObjectMonitor::_sync_Inflations                  = NULL;
 PerfCounter * ObjectMonitor::_sync_Deflations                  = NULL;
+PerfCounter * ObjectMonitor::_sync_SpinAttempts                = NULL;
+PerfCounter * ObjectMonitor::_sync_SpinSuccesses               = NULL;
+PerfCounter * ObjectMonitor::_sync_SpinOwnerNotRunnable        = NULL;
 PerfLongVariable * ObjectMonitor::_sync_MonExtant              = NULL;
 
 // One-shot global initialization for the sync subsystem.
@@ -1926,6 +1940,9 @@ void ObjectMonitor::Initialize() {
     NEWPERFCOUNTER(_sync_FutileWakeups);
     NEWPERFCOUNTER(_sync_Parks);
     NEWPERFCOUNTER(_sync_Notifications);
+    NEWPERFCOUNTER(_sync_SpinAttempts);
+    NEWPERFCOUNTER(_sync_SpinSuccesses);
+    NEWPERFCOUNTER(_sync_SpinOwnerNotRunnable);
     NEWPERFVARIABLE(_sync_MonExtant);
 #undef NEWPERFCOUNTER
 #undef NEWPERFVARIABLE
@@ -195,6 +195,9 @@ class ObjectMonitor {
   static PerfCounter * _sync_Notifications;
   static PerfCounter * _sync_Inflations;
   static PerfCounter * _sync_Deflations;
+  static PerfCounter * _sync_SpinAttempts;
+  static PerfCounter * _sync_SpinSuccesses;
+  static PerfCounter * _sync_SpinOwnerNotRunnable;
   static PerfLongVariable * _sync_MonExtant;
 
   static int Knob_SpinLimit;
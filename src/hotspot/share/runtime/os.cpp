@@ -680,7 +680,7 @@ static bool has_reached_max_malloc_test_peak(size_t alloc_size) {
 }
 
 void* os::malloc(size_t size, MEMFLAGS flags) {
-  return os::malloc(size, flags, CALLER_PC);
+  return os::malloc(size, flags, SAMPLED_CALLER_PC(size));
 }
 
 void* os::malloc(size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
@@ -741,7 +741,7 @@ void* os::malloc(size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
 }
 
 void* os::realloc(void *memblock, size_t size, MEMFLAGS flags) {
-  return os::realloc(memblock, size, flags, CALLER_PC);
+  return os::realloc(memblock, size, flags, SAMPLED_CALLER_PC(size));
 }
 
 void* os::realloc(void *memblock, size_t size, MEMFLAGS memflags, const NativeCallStack& stack) {
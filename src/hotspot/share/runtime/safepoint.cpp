@@ -40,6 +40,7 @@
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -52,6 +53,7 @@
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/jniHandles.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/osThread.hpp"
@@ -65,6 +67,7 @@
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/timerTrace.hpp"
+#include "runtime/vframe.inline.hpp"
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
@@ -112,6 +115,26 @@ static void post_safepoint_cleanup_task_event(EventSafepointCleanupTask& event,
   }
 }
 
+static void post_safepoint_slow_thread_event(uint64_t safepoint_id,
+                                             JavaThread* thread,
+                                             jlong ttsp_ns,
+                                             Method* method,
+                                             int bci,
+                                             bool compiled,
+                                             address pc) {
+  EventSafepointSlowThread event(UNTIMED);
+  if (event.should_commit()) {
+    event.set_safepointId(safepoint_id);
+    event.set_slowThread(JFR_THREAD_ID(thread));
+    event.set_timeToSafepoint(ttsp_ns);
+    event.set_method(method);
+    event.set_bci(bci);
+    event.set_compiled(compiled);
+    event.set_pc((u8)pc);
+    event.commit();
+  }
+}
+
 static void post_safepoint_end_event(EventSafepointEnd& event, uint64_t safepoint_id) {
   if (event.should_commit()) {
     event.set_safepointId(safepoint_id);
@@ -147,6 +170,26 @@ static bool timeout_error_printed = false;
 static jlong _safepoint_begin_time = 0;
 static volatile int _nof_threads_hit_polling_page = 0;
 
+// Threads that took longer than SafepointSlowThreadThreshold to reach the
+// current safepoint. Threads are recorded in the order they stop, so when
+// more than SlowThreadsMax are slow the buffer keeps the slowest ones.
+struct SlowSafepointThread {
+  JavaThread* _thread;
+  jlong       _ttsp_ns;
+};
+static const int SlowThreadsMax = 8;
+static SlowSafepointThread _slow_threads[SlowThreadsMax];
+static int _nof_slow_threads = 0;
+
+static void record_slow_thread(JavaThread* thread) {
+  jlong ttsp_ns = os::javaTimeNanos() - SafepointTracing::start_of_safepoint();
+  if (ttsp_ns >= SafepointSlowThreadThreshold * NANOSECS_PER_MILLISEC) {
+    SlowSafepointThread* slow = &_slow_threads[_nof_slow_threads++ % SlowThreadsMax];
+    slow->_thread = thread;
+    slow->_ttsp_ns = ttsp_ns;
+  }
+}
+
 void SafepointSynchronize::init(Thread* vmthread) {
   // WaitBarrier should never be destroyed since we will have
   // threads waiting on it while exiting.
@@ -264,6 +307,9 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
       assert(cur_tss->is_running(), "Illegal initial state");
       if (thread_not_running(cur_tss)) {
         --still_running;
+        if (SafepointSlowThreadThreshold > 0) {
+          record_slow_thread(cur_tss->thread());
+        }
         *p_prev = NULL;
         ThreadSafepointState *tmp = cur_tss;
         cur_tss = cur_tss->get_next();
@@ -374,6 +420,7 @@ void SafepointSynchronize::begin() {
   int nof_threads = Threads::number_of_threads();
 
   _nof_threads_hit_polling_page = 0;
+  _nof_slow_threads = 0;
 
   log_debug(safepoint)("Safepoint synchronization initiated using %s wait barrier. (%d threads)", _wait_barrier->description(), nof_threads);
 
@@ -437,6 +484,10 @@ void SafepointSynchronize::begin() {
                                    initial_running,
                                    _waiting_to_block, iterations);
 
+  if (_nof_slow_threads > 0) {
+    report_slow_threads();
+  }
+
   SafepointTracing::synchronized(nof_threads, initial_running, _nof_threads_hit_polling_page);
 
   // We do the safepoint cleanup first since a GC related safepoint
@@ -544,10 +595,14 @@ public:
 
   void do_thread(Thread* thread) {
     ObjectSynchronizer::deflate_thread_local_monitors(thread, _counters);
-    if (_nmethod_cl != NULL && thread->is_Java_thread() &&
-        ! thread->is_Code_cache_sweeper_thread()) {
+    if (thread->is_Java_thread()) {
       JavaThread* jt = (JavaThread*) thread;
-      jt->nmethods_do(_nmethod_cl);
+      if (_nmethod_cl != NULL && ! thread->is_Code_cache_sweeper_thread()) {
+        jt->nmethods_do(_nmethod_cl);
+      }
+      // Cached free entries keep their blocks allocated, so hand them
+      // back to let OopStorage cleanup delete blocks that became empty.
+      JNIHandles::flush_handle_caches(jt);
     }
   }
 };
@@ -568,8 +623,12 @@ public:
 
   void work(uint worker_id) {
     uint64_t safepoint_id = SafepointSynchronize::safepoint_id();
-    // All threads deflate monitors and mark nmethods (if necessary).
-    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
+
+    // The subtasks below are claimed as a whole by a single worker, so
+    // start them first. The per-thread work is claimed one thread at a
+    // time and is picked up afterwards by all workers, including those
+    // that ran a subtask. This way the longest subtask overlaps with the
+    // per-thread work instead of running after it.
 
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
       const char* name = "deflating global idle monitors";
@@ -650,6 +709,10 @@ public:
       OopStorage::trigger_cleanup_if_needed();
     }
 
+    // All threads deflate monitors, mark nmethods (if necessary) and
+    // flush their JNI handle caches.
+    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
+
     _subtasks.all_tasks_completed(_num_workers);
   }
 };
@@ -904,6 +967,38 @@ void SafepointSynchronize::handle_polling_page_exception(JavaThread *thread) {
 }
 
 
+void SafepointSynchronize::report_slow_threads() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  ResourceMark rm;
+  int first = MAX2(0, _nof_slow_threads - SlowThreadsMax);
+  log_info(safepoint, stats)("%d thread(s) took more than " INTX_FORMAT " ms to reach safepoint " UINT64_FORMAT,
+                             _nof_slow_threads, SafepointSlowThreadThreshold, _safepoint_id);
+  for (int i = first; i < _nof_slow_threads; i++) {
+    const SlowSafepointThread* slow = &_slow_threads[i % SlowThreadsMax];
+    JavaThread* thread = slow->_thread;
+    Method* method = NULL;
+    int bci = 0;
+    bool compiled = false;
+    address pc = NULL;
+    // The thread is stopped, so its last Java frame is the location where
+    // it noticed the safepoint, e.g. the poll at the end of a long loop.
+    if (thread->has_last_Java_frame()) {
+      vframeStream vfst(thread);
+      if (!vfst.at_end()) {
+        method = vfst.method();
+        bci = vfst.bci();
+        compiled = !vfst.is_interpreted_frame();
+        pc = vfst.frame_pc();
+      }
+    }
+    log_info(safepoint, stats)("  %s: time to safepoint " JLONG_FORMAT " ns, at %s%s bci %d pc " PTR_FORMAT,
+                               thread->get_thread_name(), slow->_ttsp_ns,
+                               method != NULL ? method->external_name() : "<no Java frame>",
+                               compiled ? " (compiled)" : "", bci, p2i(pc));
+    post_safepoint_slow_thread_event(_safepoint_id, thread, slow->_ttsp_ns, method, bci, compiled, pc);
+  }
+}
+
 void SafepointSynchronize::print_safepoint_timeout() {
   if (!timeout_error_printed) {
     timeout_error_printed = true;
@@ -114,6 +114,7 @@ class SafepointSynchronize : AllStatic {
 
   // For debug long safepoint
   static void print_safepoint_timeout();
+  static void report_slow_threads();
 
   // Helper methods for safepoint procedure:
   static void arm_safepoint();
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/protectionDomainCache.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
@@ -109,6 +110,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool resolved_method_table_work = false;
     bool protection_domain_table_work = false;
     bool oopstorage_work = false;
+    bool cldg_purge_work = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -134,7 +136,8 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
               (symboltable_work = SymbolTable::has_work()) |
               (resolved_method_table_work = ResolvedMethodTable::has_work()) |
               (protection_domain_table_work = SystemDictionary::pd_cache_table()->has_work()) |
-              (oopstorage_work = OopStorage::has_cleanup_work_and_reset()))
+              (oopstorage_work = OopStorage::has_cleanup_work_and_reset()) |
+              (cldg_purge_work = ClassLoaderDataGraph::has_deferred_purge()))
              == 0) {
         // Wait until notified that there is some work to do.
         ml.wait();
@@ -180,6 +183,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (oopstorage_work) {
       cleanup_oopstorages(oopstorages, oopstorage_count);
     }
+
+    if (cldg_purge_work) {
+      ClassLoaderDataGraph::purge_deferred();
+    }
   }
 }
 
@@ -496,6 +496,10 @@ address SharedRuntime::raw_exception_handler_for_return_address(JavaThread* thre
   if (StubRoutines::returns_to_call_stub(return_address)) {
     return StubRoutines::catch_exception_entry();
   }
+  // Frames still frozen below a lazily thawed continuation
+  if (StubRoutines::is_cont_returnBarrier(return_address)) {
+    return StubRoutines::cont_returnBarrierExc();
+  }
   // Interpreted code
   if (Interpreter::contains(return_address)) {
     return Interpreter::rethrow_exception_entry();
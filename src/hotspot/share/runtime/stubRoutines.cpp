@@ -160,6 +160,11 @@ address StubRoutines::_montgomerySquare = NULL;
 
 address StubRoutines::_vectorizedMismatch = NULL;
 
+address StubRoutines::_cont_doYield    = NULL;
+address StubRoutines::_cont_doContinue = NULL;
+address StubRoutines::_cont_returnBarrier    = NULL;
+address StubRoutines::_cont_returnBarrierExc = NULL;
+
 address StubRoutines::_dexp = NULL;
 address StubRoutines::_dlog = NULL;
 address StubRoutines::_dlog10 = NULL;
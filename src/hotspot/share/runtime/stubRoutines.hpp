@@ -242,6 +242,12 @@ class StubRoutines: AllStatic {
 
   static address _vectorizedMismatch;
 
+  // Continuation freeze and thaw entries
+  static address _cont_doYield;
+  static address _cont_doContinue;
+  static address _cont_returnBarrier;
+  static address _cont_returnBarrierExc;
+
   static address _dexp;
   static address _dlog;
   static address _dlog10;
@@ -417,6 +423,15 @@ class StubRoutines: AllStatic {
 
   static address vectorizedMismatch()  { return _vectorizedMismatch; }
 
+  static address cont_doYield()          { return _cont_doYield; }
+  static address cont_doContinue()       { return _cont_doContinue; }
+  static address cont_returnBarrier()    { return _cont_returnBarrier; }
+  static address cont_returnBarrierExc() { return _cont_returnBarrierExc; }
+
+  static bool is_cont_returnBarrier(address pc) {
+    return pc != NULL && pc == _cont_returnBarrier;
+  }
+
   static address dexp()                { return _dexp; }
   static address dlog()                { return _dlog; }
   static address dlog10()              { return _dlog10; }
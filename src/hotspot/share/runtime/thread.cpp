@@ -44,6 +44,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -64,6 +65,7 @@
 #include "runtime/arguments.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/carrierPool.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/flags/jvmFlagConstraintList.hpp"
 #include "runtime/flags/jvmFlagRangeList.hpp"
@@ -462,6 +464,9 @@ Thread::~Thread() {
   delete handle_area();
   delete metadata_handles();
 
+  // The areas above may have left chunks in the cache.
+  _chunk_cache.flush();
+
   // SR_handler uses this as a termination indicator -
   // needs to happen before os::free_thread()
   delete _SR_lock;
@@ -1662,6 +1667,13 @@ void JavaThread::initialize() {
   set_deopt_mark(NULL);
   set_deopt_compiled_method(NULL);
   set_monitor_chunks(NULL);
+  set_cont_frame(NULL, NULL, NULL);
+  clear_cont_lazy();
+  set_cont_mount(0, NULL);
+  _carrier_id = CarrierPool::no_carrier;
+  for (int i = 0; i < cont_free_chunks; i++) {
+    set_cont_free_chunk(i, NULL, NULL);
+  }
   _on_thread_list = false;
   set_thread_state(_thread_new);
   _terminated = _not_terminated;
@@ -1690,6 +1702,8 @@ void JavaThread::initialize() {
   _is_method_handle_return = 0;
   _jvmti_thread_state= NULL;
   _should_post_on_exceptions_flag = JNI_FALSE;
+  _profile_sample_counter = 0;
+  _profile_sample_seed = os::random() | 1;  // xorshift needs a non-zero seed
   _interp_only_mode    = 0;
   _special_runtime_exit_condition = _no_async_condition;
   _pending_async_exception = NULL;
@@ -1835,6 +1849,9 @@ JavaThread::~JavaThread() {
     delete deferred;
   }
 
+  // Hand back any free JNI global handle entries cached by this thread
+  JNIHandles::flush_handle_caches(this);
+
   // All Java related clean up happens in exit
   ThreadSafepointState::destroy(this);
   if (_thread_stat != NULL) delete _thread_stat;
@@ -2092,6 +2109,9 @@ void JavaThread::exit(bool destroy_vm, ExitType exit_type) {
     assert(!this->has_pending_exception(), "release_monitors should have cleared");
   }
 
+  // The tasks left in the thread's run queue are stolen by other carriers.
+  CarrierPool::unregister_carrier(this);
+
   // These things needs to be done while we are still a Java Thread. Make sure that thread
   // is in a consistent state, in case GC happens
   JFR_ONLY(Jfr::on_thread_exit(this);)
@@ -2941,6 +2961,11 @@ void JavaThread::oops_do(OopClosure* f, CodeBlobClosure* cf) {
   f->do_oop((oop*) &_vm_result);
   f->do_oop((oop*) &_exception_oop);
   f->do_oop((oop*) &_pending_async_exception);
+  f->do_oop((oop*) &_cont_lazy);
+  for (int i = 0; i < cont_free_chunks; i++) {
+    f->do_oop((oop*) &_cont_free_stacks[i]);
+    f->do_oop((oop*) &_cont_free_refs[i]);
+  }
 
   if (jvmti_thread_state() != NULL) {
     jvmti_thread_state()->oops_do(f);
@@ -3850,6 +3875,7 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   set_init_completed();
 
   LogConfiguration::post_initialize();
+  AsyncLogWriter::initialize();
   Metaspace::post_initialize();
 
   HOTSPOT_VM_INIT_END();
@@ -30,6 +30,7 @@
 #include "gc/shared/gcThreadLocalData.hpp"
 #include "gc/shared/threadLocalAllocBuffer.hpp"
 #include "memory/allocation.hpp"
+#include "memory/arena.hpp"
 #include "oops/oop.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/frame.hpp"
@@ -576,6 +577,7 @@ class Thread: public ThreadShadow {
 
   // Resource area
   ResourceArea* resource_area() const            { return _resource_area; }
+  ChunkCache* chunk_cache()                      { return &_chunk_cache; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
   OSThread* osthread() const                     { return _osthread;   }
@@ -694,6 +696,9 @@ protected:
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
 
+  // Free arena chunks kept for reuse by this thread
+  ChunkCache _chunk_cache;
+
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
   // Thread local handle area for allocation of handles within the VM
@@ -1011,6 +1016,10 @@ class JavaThread: public Thread {
 
   JNIEnv        _jni_environment;
 
+  // Free entries for JNI global and weak global handles
+  JNIHandleCache _jni_global_handle_cache;
+  JNIHandleCache _jni_weak_handle_cache;
+
   // Deopt support
   DeoptResourceMark*  _deopt_mark;               // Holds special ResourceMark for deoptimization
 
@@ -1046,6 +1055,38 @@ class JavaThread: public Thread {
                                                  // allocated during deoptimization
                                                  // and by JNI_MonitorEnter/Exit
 
+  // Continuation support. Where to resume after a continuation has been
+  // frozen or thawed; written by Continuation::freeze/thaw and consumed by
+  // the doYield/doContinue stubs. Never live across a safepoint.
+  intptr_t*     _cont_sp;
+  intptr_t*     _cont_fp;
+  address       _cont_pc;
+
+  // The continuation whose frames are being thawed lazily, returning
+  // through the return barrier, and the caller of its doContinue().
+  oop           _cont_lazy;
+  intptr_t*     _cont_entry_sp;
+  intptr_t*     _cont_entry_fp;
+  address       _cont_entry_pc;
+  size_t        _cont_entry_size;    // stack bytes the remaining frames need
+
+  // The id of the continuation thawed last, 0 if none, and the sp of the
+  // caller of its doContinue(). Read asynchronously by the JFR sampler.
+  jlong         _cont_mount_id;
+  intptr_t*     _cont_mount_sp;
+
+  // The index of the carrier pool queue owned by the thread, or -1
+  int           _carrier_id;
+
+  // Chunks of continuations fully thawed on the thread, with their refStacks
+  // cleared, for the next freezes on the thread to reuse (see
+  // Continuation::freeze()). Empty slots are NULL.
+ public:
+  static const int cont_free_chunks = 4;
+ private:
+  oop           _cont_free_stacks[cont_free_chunks];
+  oop           _cont_free_refs[cont_free_chunks];
+
   // Async. requests support
   enum AsyncRequests {
     _no_async_condition = 0,
@@ -1744,6 +1785,11 @@ class JavaThread: public Thread {
   static ByteSize callee_target_offset()         { return byte_offset_of(JavaThread, _callee_target); }
   static ByteSize vm_result_offset()             { return byte_offset_of(JavaThread, _vm_result); }
   static ByteSize vm_result_2_offset()           { return byte_offset_of(JavaThread, _vm_result_2); }
+  static ByteSize cont_sp_offset()               { return byte_offset_of(JavaThread, _cont_sp); }
+  static ByteSize cont_fp_offset()               { return byte_offset_of(JavaThread, _cont_fp); }
+  static ByteSize cont_pc_offset()               { return byte_offset_of(JavaThread, _cont_pc); }
+  static ByteSize cont_entry_sp_offset()         { return byte_offset_of(JavaThread, _cont_entry_sp); }
+  static ByteSize cont_entry_size_offset()       { return byte_offset_of(JavaThread, _cont_entry_size); }
   static ByteSize thread_state_offset()          { return byte_offset_of(JavaThread, _thread_state); }
   static ByteSize saved_exception_pc_offset()    { return byte_offset_of(JavaThread, _saved_exception_pc); }
   static ByteSize osthread_offset()              { return byte_offset_of(JavaThread, _osthread); }
@@ -1768,11 +1814,16 @@ class JavaThread: public Thread {
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
+  static ByteSize profile_sample_counter_offset() { return byte_offset_of(JavaThread, _profile_sample_counter); }
+  static ByteSize profile_sample_seed_offset()    { return byte_offset_of(JavaThread, _profile_sample_seed); }
   static ByteSize doing_unsafe_access_offset() { return byte_offset_of(JavaThread, _doing_unsafe_access); }
 
   // Returns the jni environment for this thread
   JNIEnv* jni_environment()                      { return &_jni_environment; }
 
+  JNIHandleCache* jni_global_handle_cache()      { return &_jni_global_handle_cache; }
+  JNIHandleCache* jni_weak_handle_cache()        { return &_jni_weak_handle_cache; }
+
   static JavaThread* thread_from_jni_environment(JNIEnv* env) {
     JavaThread *thread_from_jni_env = (JavaThread*)((intptr_t)env - in_bytes(jni_environment_offset()));
     // Only return NULL if thread is off the thread list; starting to
@@ -1814,6 +1865,33 @@ class JavaThread: public Thread {
 
  public:
   MonitorChunk* monitor_chunks() const           { return _monitor_chunks; }
+
+  // Continuation support
+  intptr_t* cont_sp() const                      { return _cont_sp; }
+  intptr_t* cont_fp() const                      { return _cont_fp; }
+  address   cont_pc() const                      { return _cont_pc; }
+  void set_cont_frame(intptr_t* sp, intptr_t* fp, address pc) {
+    _cont_sp = sp; _cont_fp = fp; _cont_pc = pc;
+  }
+  oop       cont_lazy() const                    { return _cont_lazy; }
+  intptr_t* cont_entry_sp() const                { return _cont_entry_sp; }
+  intptr_t* cont_entry_fp() const                { return _cont_entry_fp; }
+  intptr_t** cont_entry_fp_addr()                { return &_cont_entry_fp; }
+  address   cont_entry_pc() const                { return _cont_entry_pc; }
+  void set_cont_lazy(oop cont, intptr_t* sp, intptr_t* fp, address pc, size_t size) {
+    _cont_lazy = cont; _cont_entry_sp = sp; _cont_entry_fp = fp; _cont_entry_pc = pc; _cont_entry_size = size;
+  }
+  void clear_cont_lazy()                         { set_cont_lazy(NULL, NULL, NULL, NULL, 0); }
+  jlong     cont_mount_id() const                { return _cont_mount_id; }
+  intptr_t* cont_mount_sp() const                { return _cont_mount_sp; }
+  void set_cont_mount(jlong id, intptr_t* sp)    { _cont_mount_id = id; _cont_mount_sp = sp; }
+  int       carrier_id() const                   { return _carrier_id; }
+  void set_carrier_id(int id)                    { _carrier_id = id; }
+  oop       cont_free_stack(int i) const         { return _cont_free_stacks[i]; }
+  oop       cont_free_refs(int i) const          { return _cont_free_refs[i]; }
+  void set_cont_free_chunk(int i, oop stack, oop refs) {
+    _cont_free_stacks[i] = stack; _cont_free_refs[i] = refs;
+  }
   void add_monitor_chunk(MonitorChunk* chunk);
   void remove_monitor_chunk(MonitorChunk* chunk);
   bool in_deopt_handler() const                  { return _in_deopt_handler > 0; }
@@ -2005,6 +2083,13 @@ class JavaThread: public Thread {
   int   should_post_on_exceptions_flag()  { return _should_post_on_exceptions_flag; }
   void  set_should_post_on_exceptions_flag(int val)  { _should_post_on_exceptions_flag = val; }
 
+  // countdown used by tier 3 code to update branch profiles only on
+  // about every C1ProfileSampleRate-th execution, and the xorshift state
+  // the countdown is jittered with
+ private:
+  int    _profile_sample_counter;
+  int    _profile_sample_seed;
+
  private:
   ThreadStatistics *_thread_stat;
 
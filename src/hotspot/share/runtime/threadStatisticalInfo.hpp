@@ -35,14 +35,24 @@ class ThreadStatisticalInfo {
   // The time stamp the thread was started.
   const uint64_t _start_time_stamp;
   uint64_t _define_class_count;
+  // String interns not yet added to the StringTable statistics.
+  uint _pending_interns;
+  uint _pending_intern_misses;
+  // Bytes this thread may still malloc before NMT records a malloc site.
+  size_t _malloc_bytes_until_sample;
 
 public:
-  ThreadStatisticalInfo() : _start_time_stamp(os::javaTimeMillis()), _define_class_count(0) {}
+  ThreadStatisticalInfo() : _start_time_stamp(os::javaTimeMillis()), _define_class_count(0),
+                            _pending_interns(0), _pending_intern_misses(0),
+                            _malloc_bytes_until_sample(0) {}
   uint64_t getStartTime() const             { return _start_time_stamp; }
   uint64_t getDefineClassCount() const                    { return  _define_class_count; }
   void     setDefineClassCount(uint64_t defineClassCount) { _define_class_count = defineClassCount; }
   void     incr_define_class_count()                      { _define_class_count += 1; }
   uint64_t getElapsedTime() const           { return os::javaTimeMillis() - getStartTime(); }
+  uint&    pending_interns()                { return _pending_interns; }
+  uint&    pending_intern_misses()          { return _pending_intern_misses; }
+  size_t&  malloc_bytes_until_sample()      { return _malloc_bytes_until_sample; }
 };
 
 #endif // SHARE_RUNTIME_THREADSTATISTICALINFO_HPP
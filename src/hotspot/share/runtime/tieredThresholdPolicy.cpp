@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "memory/resourceArea.hpp"
@@ -31,6 +32,7 @@
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/tieredThresholdPolicy.hpp"
+#include "runtime/timer.hpp"
 #include "code/scopeDesc.hpp"
 #include "oops/method.inline.hpp"
 #if INCLUDE_JVMCI
@@ -48,6 +50,7 @@ bool TieredThresholdPolicy::call_predicate_helper(int i, int b, double scale, Me
   if (CompilerOracle::has_option_value(method, "CompileThresholdScaling", threshold_scaling)) {
     scale *= threshold_scaling;
   }
+  scale *= CompilationProfile::threshold_scale(method, level);
   switch(level) {
   case CompLevel_aot:
     return (i >= Tier3AOTInvocationThreshold * scale) ||
@@ -69,6 +72,7 @@ bool TieredThresholdPolicy::loop_predicate_helper(int i, int b, double scale, Me
   if (CompilerOracle::has_option_value(method, "CompileThresholdScaling", threshold_scaling)) {
     scale *= threshold_scaling;
   }
+  scale *= CompilationProfile::threshold_scale(method, level);
   switch(level) {
   case CompLevel_aot:
     return b >= Tier3AOTBackEdgeThreshold * scale;
@@ -305,7 +309,10 @@ CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
   CompileTask *max_blocking_task = NULL;
   CompileTask *max_task = NULL;
   Method* max_method = NULL;
+  double max_weight = 0.0;
+  double max_blocking_weight = 0.0;
   jlong t = os::javaTimeMillis();
+  jlong now = os::elapsed_counter();
   // Iterate through the queue and find a method with a maximum rate.
   for (CompileTask* task = compile_queue->first(); task != NULL;) {
     CompileTask* next_task = task->next();
@@ -324,15 +331,18 @@ CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
       continue;
     }
     update_rate(t, method);
-    if (max_task == NULL || compare_methods(method, max_method)) {
+    double w = task_weight(task, now);
+    if (max_task == NULL || compare_methods(method, w, max_method, max_weight)) {
       // Select a method with the highest rate
       max_task = task;
       max_method = method;
+      max_weight = w;
     }
 
     if (task->is_blocking()) {
-      if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
+      if (max_blocking_task == NULL || compare_methods(method, w, max_blocking_task->method(), max_blocking_weight)) {
         max_blocking_task = task;
+        max_blocking_weight = w;
       }
     }
 
@@ -564,14 +574,25 @@ double TieredThresholdPolicy::weight(Method* method) {
     (method->invocation_count() + 1) * (method->backedge_count() + 1);
 }
 
+// A task that keeps losing to methods with higher rates still gets
+// compiled eventually: its weight grows linearly with its time in the queue.
+double TieredThresholdPolicy::task_weight(CompileTask* task, jlong now) {
+  double w = weight(task->method());
+  if (TieredCompileTaskAgingTime > 0) {
+    jlong waited = (jlong)TimeHelper::counter_to_millis(now - task->time_queued());
+    w *= 1.0 + (double)waited / TieredCompileTaskAgingTime;
+  }
+  return w;
+}
+
 // Apply heuristics and return true if x should be compiled before y
-bool TieredThresholdPolicy::compare_methods(Method* x, Method* y) {
+bool TieredThresholdPolicy::compare_methods(Method* x, double x_weight, Method* y, double y_weight) {
   if (x->highest_comp_level() > y->highest_comp_level()) {
     // recompilation after deopt
     return true;
   } else
     if (x->highest_comp_level() == y->highest_comp_level()) {
-      if (weight(x) > weight(y)) {
+      if (x_weight > y_weight) {
         return true;
       }
     }
@@ -195,8 +195,11 @@ class TieredThresholdPolicy : public CompilationPolicy {
   inline bool is_stale(jlong t, jlong timeout, Method* m);
   // Compute the weight of the method for the compilation scheduling
   inline double weight(Method* method);
+  // The weight of a queued task's method, raised by the time the task
+  // has been waiting (see TieredCompileTaskAgingTime).
+  inline double task_weight(CompileTask* task, jlong now);
   // Apply heuristics and return true if x should be compiled before y
-  inline bool compare_methods(Method* x, Method* y);
+  inline bool compare_methods(Method* x, double x_weight, Method* y, double y_weight);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline void update_rate(jlong t, Method* m);
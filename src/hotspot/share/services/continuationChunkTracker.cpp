@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/carrierPool.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+#include "services/continuationChunkTracker.hpp"
+#include "services/memTracker.hpp"
+#include "utilities/macros.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/vmError.hpp"
+
+#if INCLUDE_NMT
+
+volatile size_t ContinuationChunkTracker::_chunk_count      = 0;
+volatile size_t ContinuationChunkTracker::_reused_count     = 0;
+volatile size_t ContinuationChunkTracker::_frozen_size      = 0;
+volatile size_t ContinuationChunkTracker::_peak_frozen_size = 0;
+volatile size_t* ContinuationChunkTracker::_carrier_frozen_size = NULL;
+
+bool ContinuationChunkTracker::is_enabled() {
+  return MemTracker::tracking_level() >= NMT_summary;
+}
+
+void ContinuationChunkTracker::initialize_carriers(uint n) {
+  if (!is_enabled()) {
+    return;
+  }
+  volatile size_t* sizes = NEW_C_HEAP_ARRAY(volatile size_t, n, mtContinuation);
+  for (uint i = 0; i < n; i++) {
+    sizes[i] = 0;
+  }
+  // Published before any thread can register as a carrier.
+  OrderAccess::release_store(&_carrier_frozen_size, sizes);
+}
+
+void ContinuationChunkTracker::record_freeze(JavaThread* thread, size_t size, bool reused) {
+  Atomic::inc(reused ? &_reused_count : &_chunk_count);
+  size_t frozen = Atomic::add(size, &_frozen_size);
+  size_t peak = _peak_frozen_size;
+  while (frozen > peak) {
+    size_t old = Atomic::cmpxchg(frozen, &_peak_frozen_size, peak);
+    if (old == peak) {
+      break;
+    }
+    peak = old;
+  }
+  int carrier = thread->carrier_id();
+  if (carrier != CarrierPool::no_carrier && _carrier_frozen_size != NULL) {
+    Atomic::add(size, &_carrier_frozen_size[carrier]);
+  }
+}
+
+void ContinuationChunkTracker::record_thaw(size_t size, int carrier) {
+  Atomic::sub(size, &_frozen_size);
+  if (carrier != CarrierPool::no_carrier && _carrier_frozen_size != NULL) {
+    Atomic::sub(size, &_carrier_frozen_size[carrier]);
+  }
+}
+
+size_t ContinuationChunkTracker::cached_size(JavaThread* thread) {
+  // Handshake operations run in the VM thread or in the thread itself.
+  assert(thread == Thread::current() || SafepointSynchronize::is_at_safepoint() ||
+         Thread::current()->is_VM_thread(), "the free list may change");
+  size_t size = 0;
+  for (int i = 0; i < JavaThread::cont_free_chunks; i++) {
+    oop stack = thread->cont_free_stack(i);
+    if (stack != NULL) {
+      size += (stack->size() + thread->cont_free_refs(i)->size()) * HeapWordSize;
+    }
+  }
+  return size;
+}
+
+class ContinuationCachedSizeClosure : public ThreadClosure {
+ private:
+  size_t _size;
+ public:
+  ContinuationCachedSizeClosure() : _size(0) {}
+  size_t size() const { return _size; }
+  void do_thread(Thread* thread) {
+    _size = ContinuationChunkTracker::cached_size((JavaThread*)thread);
+  }
+};
+
+void ContinuationChunkTracker::print_summary(outputStream* out, size_t scale) {
+  const char* unit = NMTUtil::scale_name(scale);
+  out->print_cr("%27s (chunks #" SIZE_FORMAT ", reused #" SIZE_FORMAT ")", " ",
+                chunk_count(), reused_count());
+  out->print_cr("%27s (frozen=" SIZE_FORMAT "%s, peak=" SIZE_FORMAT "%s)", " ",
+                NMTUtil::amount_in_scale(frozen_size(), scale), unit,
+                NMTUtil::amount_in_scale(peak_frozen_size(), scale), unit);
+  if (!CarrierPool::is_initialized() || _carrier_frozen_size == NULL) {
+    return;
+  }
+  // The free lists of the carriers are read in a handshake with each, or
+  // directly at a safepoint. They are left out of error reports.
+  bool at_safepoint = SafepointSynchronize::is_at_safepoint();
+  bool can_handshake = !at_safepoint && Thread::current()->is_Java_thread() && !VMError::is_error_reported();
+  ThreadsListHandle tlh;
+  for (uint i = 0; i < CarrierPool::size(); i++) {
+    size_t frozen = NMTUtil::amount_in_scale(_carrier_frozen_size[i], scale);
+    JavaThread* carrier = CarrierPool::carrier_at(i);
+    ContinuationCachedSizeClosure cl;
+    bool cached = false;
+    if (carrier != NULL && tlh.includes(carrier)) {
+      if (at_safepoint) {
+        cl.do_thread(carrier);
+        cached = true;
+      } else if (can_handshake) {
+        cached = Handshake::execute(&cl, carrier);
+      }
+    }
+    if (cached) {
+      out->print_cr("%27s (carrier %u: frozen=" SIZE_FORMAT "%s, cached=" SIZE_FORMAT "%s)", " ", i,
+                    frozen, unit, NMTUtil::amount_in_scale(cl.size(), scale), unit);
+    } else {
+      out->print_cr("%27s (carrier %u: frozen=" SIZE_FORMAT "%s)", " ", i, frozen, unit);
+    }
+  }
+}
+
+#endif // INCLUDE_NMT
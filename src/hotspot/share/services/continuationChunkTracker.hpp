@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_SERVICES_CONTINUATIONCHUNKTRACKER_HPP
+#define SHARE_SERVICES_CONTINUATIONCHUNKTRACKER_HPP
+
+#if INCLUDE_NMT
+
+#include "memory/allocation.hpp"
+#include "services/nmtCommon.hpp"
+
+class JavaThread;
+class outputStream;
+
+// Counts the Java heap memory held by frozen continuation chunks, reported
+// by NMT with the native memory of the "Continuation" category. A chunk is
+// counted from the freeze that fills it until its last frame is thawed;
+// chunks of continuations that are collected while frozen are not uncounted.
+// The chunks frozen on each carrier of the carrier pool are also counted for
+// that carrier, wherever they are thawed, and the chunks cached in the free
+// list of each carrier thread are summed up when reported. Nothing is
+// counted unless NMT tracks at least a summary.
+class ContinuationChunkTracker : AllStatic {
+ private:
+  static volatile size_t _chunk_count;         // chunks allocated by freezes
+  static volatile size_t _reused_count;        // chunks taken from free lists
+  static volatile size_t _frozen_size;         // bytes of frozen chunks
+  static volatile size_t _peak_frozen_size;
+  static volatile size_t* _carrier_frozen_size; // bytes of frozen chunks by carrier
+
+ public:
+  static bool is_enabled();
+
+  // Called when the carrier pool is created with n carriers.
+  static void initialize_carriers(uint n);
+
+  static void record_freeze(JavaThread* thread, size_t size, bool reused);
+  // carrier is the carrier the chunk was frozen on, or CarrierPool::no_carrier
+  static void record_thaw(size_t size, int carrier);
+
+  static size_t chunk_count()      { return _chunk_count; }
+  static size_t reused_count()     { return _reused_count; }
+  static size_t frozen_size()      { return _frozen_size; }
+  static size_t peak_frozen_size() { return _peak_frozen_size; }
+
+  // Bytes of the chunks in the free list of thread. Called by the thread
+  // itself, in a handshake with it or at a safepoint.
+  static size_t cached_size(JavaThread* thread);
+
+  // Prints the counters, and the chunks frozen on and cached by each thread
+  // of the carrier pool, for the NMT summary.
+  static void print_summary(outputStream* out, size_t scale);
+};
+
+#endif // INCLUDE_NMT
+#endif // SHARE_SERVICES_CONTINUATIONCHUNKTRACKER_HPP
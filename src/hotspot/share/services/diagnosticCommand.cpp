@@ -26,8 +26,10 @@
 #include "jvm.h"
 #include "classfile/classLoaderHierarchyDCmd.hpp"
 #include "classfile/classLoaderStats.hpp"
+#include "compiler/compilationProfile.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
+#include "gc/shared/allocationProfile.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "memory/metaspace/metaspaceDCmd.hpp"
 #include "memory/resourceArea.hpp"
@@ -46,6 +48,7 @@
 #include "services/diagnosticFramework.hpp"
 #include "services/heapDumper.hpp"
 #include "services/management.hpp"
+#include "services/threadService.hpp"
 #include "services/writeableFlags.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/events.hpp"
@@ -86,6 +89,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemGCDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapInfoDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<AllocationProfileDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<FinalizerInfoDCmd>(full_export, true, false));
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
@@ -109,6 +113,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderHierarchyDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilationProfileDumpDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
@@ -454,6 +459,37 @@ void HeapInfoDCmd::execute(DCmdSource source, TRAPS) {
   Universe::heap()->print_on(output());
 }
 
+AllocationProfileDCmd::AllocationProfileDCmd(outputStream* output, bool heap) :
+                                             DCmdWithParser(output, heap),
+  _max_classes("-max", "Maximum number of classes to print", "INT", false, "50") {
+  _dcmdparser.add_dcmd_option(&_max_classes);
+}
+
+void AllocationProfileDCmd::execute(DCmdSource source, TRAPS) {
+  if (!AllocationProfiling) {
+    output()->print_cr("Allocation profiling is disabled (-XX:-AllocationProfiling).");
+    return;
+  }
+  jlong max_classes = _max_classes.value();
+  if (max_classes < 1) {
+    Exceptions::fthrow(THREAD_AND_LOCATION, vmSymbols::java_lang_IllegalArgumentException(),
+                       "Invalid max value " JLONG_FORMAT ". Should be positive.\n", max_classes);
+    return;
+  }
+  AllocationProfile::print_on(output(), (size_t)max_classes);
+}
+
+int AllocationProfileDCmd::num_arguments() {
+  ResourceMark rm;
+  AllocationProfileDCmd* dcmd = new AllocationProfileDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 void FinalizerInfoDCmd::execute(DCmdSource source, TRAPS) {
   ResourceMark rm;
 
@@ -622,12 +658,25 @@ int ClassStatsDCmd::num_arguments() {
 ThreadDumpDCmd::ThreadDumpDCmd(outputStream* output, bool heap) :
                                DCmdWithParser(output, heap),
   _locks("-l", "print java.util.concurrent locks", "BOOLEAN", false, "false"),
-  _extended("-e", "print extended thread information", "BOOLEAN", false, "false") {
+  _extended("-e", "print extended thread information", "BOOLEAN", false, "false"),
+  _format("-format", "output format: text, or json to capture one thread at a time "
+          "without a safepoint and print identical stacks once", "STRING", false, "text") {
   _dcmdparser.add_dcmd_option(&_locks);
   _dcmdparser.add_dcmd_option(&_extended);
+  _dcmdparser.add_dcmd_option(&_format);
 }
 
 void ThreadDumpDCmd::execute(DCmdSource source, TRAPS) {
+  if (strcmp(_format.value(), "json") == 0) {
+    JSONThreadDump dump(output());
+    dump.dump();
+    return;
+  } else if (strcmp(_format.value(), "text") != 0) {
+    Exceptions::fthrow(THREAD_AND_LOCATION, vmSymbols::java_lang_IllegalArgumentException(),
+                       "Invalid format \"%s\". Should be text or json.\n", _format.value());
+    return;
+  }
+
   // thread stacks
   VM_PrintThreads op1(output(), _locks.value(), _extended.value());
   VMThread::execute(&op1);
@@ -938,6 +987,29 @@ void CodeListDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_codelist(output());
 }
 
+CompilationProfileDumpDCmd::CompilationProfileDumpDCmd(outputStream* output, bool heap) :
+                                                       DCmdWithParser(output, heap),
+  _filename("filename", "Name of the profile file", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void CompilationProfileDumpDCmd::execute(DCmdSource source, TRAPS) {
+  if (CompilationProfile::dump(_filename.value(), output())) {
+    output()->print_cr("Compilation profile written to %s", _filename.value());
+  }
+}
+
+int CompilationProfileDumpDCmd::num_arguments() {
+  ResourceMark rm;
+  CompilationProfileDumpDCmd* dcmd = new CompilationProfileDumpDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
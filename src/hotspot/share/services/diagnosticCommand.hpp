@@ -304,6 +304,31 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class AllocationProfileDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _max_classes;
+public:
+  AllocationProfileDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.alloc_profile";
+  }
+  static const char* description() {
+    return "Print sampled allocation bytes per class, collected at TLAB refills "
+           "and allocations outside TLABs.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the number of allocating classes. "
+           "Holds ClassLoaderDataGraph_lock while printing.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class FinalizerInfoDCmd : public DCmd {
 public:
   FinalizerInfoDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -446,6 +471,7 @@ class ThreadDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _locks;
   DCmdArgument<bool> _extended;
+  DCmdArgument<char*> _format;
 public:
   ThreadDumpDCmd(outputStream* output, bool heap);
   static const char* name() { return "Thread.print"; }
@@ -598,6 +624,30 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CompilationProfileDumpDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  CompilationProfileDumpDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.profile_dump";
+  }
+  static const char* description() {
+    return "Write the compiled methods and their levels to a file that "
+           "can be read with -XX:LoadCompilationProfile.";
+  }
+  static const char* impact() {
+    return "Medium";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class CodeListDCmd : public DCmd {
 public:
   CodeListDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
@@ -40,13 +40,7 @@ class VM_DeoptimizeTheWorld : public VM_Operation {
   }
   void doit() {
     CodeCache::mark_all_nmethods_for_deoptimization();
-    ResourceMark rm;
-    DeoptimizationMarker dm;
-    // Deoptimize all activations depending on marked methods
-    Deoptimization::deoptimize_dependents();
-
-    // Mark the dependent methods non entrant
-    CodeCache::make_marked_nmethods_not_entrant();
+    Deoptimization::deoptimize_all_marked();
   }
 };
 
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 
 #include "runtime/atomic.hpp"
+#include "runtime/thread.hpp"
 #include "services/mallocSiteTable.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/mallocTracker.inline.hpp"
@@ -65,19 +66,47 @@ void MallocMemorySummary::initialize() {
   ::new ((void*)_snapshot)MallocMemorySnapshot();
 }
 
+volatile size_t MallocTracker::_sample_interval = 0;
+volatile size_t MallocTracker::_sampled_bytes = 0;
+
+bool MallocTracker::should_sample(size_t size) {
+  const size_t interval = _sample_interval;
+  if (interval == 0) {
+    return true;
+  }
+  Thread* thread = Thread::current_or_null();
+  if (thread == NULL) {
+    const size_t total = Atomic::add(size, &_sampled_bytes);
+    return (total - size) / interval != total / interval;
+  }
+  size_t& remaining = thread->statistical_info().malloc_bytes_until_sample();
+  if (size < remaining) {
+    remaining -= size;
+    return false;
+  }
+  // Carry the overshoot over, so that the next sample comes after
+  // interval bytes on average whatever the allocation sizes are.
+  remaining = interval - (size - remaining) % interval;
+  return true;
+}
+
 void MallocHeader::release() const {
   // Tracking already shutdown, no housekeeping is needed anymore
   if (MemTracker::tracking_level() <= NMT_minimal) return;
 
   MallocMemorySummary::record_free(size(), flags());
   MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
-  if (MemTracker::tracking_level() == NMT_detail) {
+  if (MemTracker::tracking_level() == NMT_detail && _bucket_idx != NO_MALLOCSITE) {
     MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
   }
 }
 
 bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
   size_t* bucket_idx, size_t* pos_idx, MEMFLAGS flags) const {
+  if (stack.is_empty() && MallocTracker::sample_interval() != 0) {
+    // Not sampled, see SAMPLED_CALLER_PC
+    return false;
+  }
   bool ret = MallocSiteTable::allocation_at(stack, size, bucket_idx, pos_idx, flags);
 
   // Something went wrong, could be OOM or overflow malloc site table.
@@ -90,6 +119,9 @@ bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
+  if (_bucket_idx == NO_MALLOCSITE) {
+    return false;
+  }
   return MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
 }
 
@@ -250,6 +250,7 @@ class MallocHeader {
   size_t           _bucket_idx: 40;
 #define MAX_MALLOCSITE_TABLE_SIZE right_n_bits(40)
 #define MAX_BUCKET_LENGTH         right_n_bits(16)
+#define NO_MALLOCSITE             MAX_MALLOCSITE_TABLE_SIZE
 #else
   size_t           _size      : 32;
   size_t           _flags     : 8;
@@ -257,6 +258,7 @@ class MallocHeader {
   size_t           _bucket_idx: 16;
 #define MAX_MALLOCSITE_TABLE_SIZE  right_n_bits(16)
 #define MAX_BUCKET_LENGTH          right_n_bits(8)
+#define NO_MALLOCSITE              MAX_MALLOCSITE_TABLE_SIZE
 #endif  // _LP64
 
  public:
@@ -274,10 +276,14 @@ class MallocHeader {
       size_t bucket_idx;
       size_t pos_idx;
       if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
-        assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
+        assert(bucket_idx < MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
         _pos_idx = pos_idx;
+      } else {
+        // Not sampled, or the site table is gone: nothing to update on release
+        _bucket_idx = NO_MALLOCSITE;
+        _pos_idx = 0;
       }
     }
 
@@ -303,7 +309,20 @@ class MallocHeader {
 
 // Main class called from MemTracker to track malloc activities
 class MallocTracker : AllStatic {
+  static volatile size_t _sample_interval;
+  static volatile size_t _sampled_bytes;
+
  public:
+  // In detail mode, only record the malloc site of about one allocation per
+  // sample interval bytes (0 records all of them). Can change at any time.
+  static size_t sample_interval()                 { return _sample_interval; }
+  static void set_sample_interval(size_t interval) { _sample_interval = interval; }
+
+  // Each thread counts its own malloc bytes down to the next sample, so
+  // there is no shared counter to contend on. Threads that are not attached
+  // yet, or not anymore, fall back to a shared byte counter.
+  static bool should_sample(size_t size);
+
   // Initialize malloc tracker for specific tracking level
   static bool initialize(NMT_TrackingLevel level);
 
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 
 #include "memory/allocation.hpp"
+#include "services/continuationChunkTracker.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/memReporter.hpp"
 #include "services/threadStackTracker.hpp"
@@ -146,7 +147,11 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
     committed_amount += _malloc_snapshot->malloc_overhead()->size();
   }
 
-  if (amount_in_current_scale(reserved_amount) > 0) {
+  // Frozen continuation chunks are in the Java heap, and reported even
+  // when the carrier pool takes no native memory.
+  bool has_chunks = (flag == mtContinuation && ContinuationChunkTracker::chunk_count() > 0);
+
+  if (amount_in_current_scale(reserved_amount) > 0 || has_chunks) {
     outputStream* out   = output();
     const char*   scale = current_scale();
     out->print("-%26s (", NMTUtil::flag_to_name(flag));
@@ -177,6 +182,8 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
           amount_in_current_scale(thread_stack_memory->malloc_size()), scale);
       }
       out->print_cr(")");
+    } else if (flag == mtContinuation) {
+      ContinuationChunkTracker::print_summary(out, _scale);
     }
 
      // report malloc'd memory
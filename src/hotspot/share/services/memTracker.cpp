@@ -99,6 +99,9 @@ void MemTracker::init() {
       return;
     }
   }
+  if (level == NMT_detail) {
+    MallocTracker::set_sample_interval(NativeMemoryTrackingSampleInterval);
+  }
 }
 
 bool MemTracker::check_launcher_nmt_support(const char* value) {
@@ -33,6 +33,7 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define SAMPLED_CALLER_PC(size) NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -91,6 +92,11 @@ extern volatile bool NMT_stack_walkable;
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
 #define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
+// CALLER_PC for a malloc of the given size, honoring the malloc sample
+// interval; unsampled allocations get an empty stack and no malloc site.
+#define SAMPLED_CALLER_PC(size) ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                                  MallocTracker::should_sample(size)) ?                              \
+                                 NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
 class MemBaseline;
 
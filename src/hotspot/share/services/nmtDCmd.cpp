@@ -56,7 +56,11 @@ NMTDCmd::NMTDCmd(outputStream* output,
   _statistics("statistics", "print tracker statistics for tuning purpose.", \
             "BOOLEAN", false, "false"),
   _scale("scale", "Memory usage in which scale, KB, MB or GB",
-       "STRING", false, "KB") {
+       "STRING", false, "KB"),
+  _sample_interval("sample_interval", "with detail tracking, record the call " \
+            "stack of about one malloc per this many bytes allocated " \
+            "(0 records every malloc).",
+            "MEMORY SIZE", false, "0") {
   _dcmdparser.add_dcmd_option(&_summary);
   _dcmdparser.add_dcmd_option(&_detail);
   _dcmdparser.add_dcmd_option(&_baseline);
@@ -65,6 +69,7 @@ NMTDCmd::NMTDCmd(outputStream* output,
   _dcmdparser.add_dcmd_option(&_shutdown);
   _dcmdparser.add_dcmd_option(&_statistics);
   _dcmdparser.add_dcmd_option(&_scale);
+  _dcmdparser.add_dcmd_option(&_sample_interval);
 }
 
 
@@ -91,6 +96,19 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
     return;
   }
 
+  if (_sample_interval.is_set()) {
+    if (!check_detail_tracking_level(output())) {
+      return;
+    }
+    MallocTracker::set_sample_interval((size_t)_sample_interval.value()._size);
+    output()->print_cr("Malloc sample interval set to " SIZE_FORMAT " bytes",
+                       MallocTracker::sample_interval());
+    if (!_summary.is_set() && !_detail.is_set() && !_baseline.is_set() &&
+        !_summary_diff.is_set() && !_detail_diff.is_set() && !_statistics.is_set()) {
+      return;
+    }
+  }
+
   int nopt = 0;
   if (_summary.is_set() && _summary.value()) { ++nopt; }
   if (_detail.is_set() && _detail.value()) { ++nopt; }
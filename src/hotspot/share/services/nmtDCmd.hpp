@@ -45,6 +45,7 @@ class NMTDCmd: public DCmdWithParser {
   DCmdArgument<bool>  _shutdown;
   DCmdArgument<bool>  _statistics;
   DCmdArgument<char*> _scale;
+  DCmdArgument<MemorySizeArgument> _sample_interval;
 
  public:
   NMTDCmd(outputStream* output, bool heap);
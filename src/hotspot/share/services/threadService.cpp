@@ -33,15 +33,20 @@
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/continuation.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
 #include "runtime/objectMonitor.inline.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.inline.hpp"
-#include "runtime/vframe.hpp"
+#include "runtime/vframe.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
+#include "runtime/vm_version.hpp"
 #include "services/threadService.hpp"
+#include "utilities/resourceHash.hpp"
 
 // TODO: we need to define a naming convention for perf counters
 // to distinguish counters for:
@@ -1045,3 +1050,153 @@ ThreadsListEnumerator::ThreadsListEnumerator(Thread* cur_thread,
     _threads_array->append(h);
   }
 }
+
+// Captures the frames of a thread as the elements of a JSON array,
+// including those of a continuation still frozen below the return barrier.
+class JSONStackClosure : public ThreadClosure {
+ private:
+  stringStream* _frames;
+
+  void print_frame(Method* method, int bci);
+ public:
+  JSONStackClosure(stringStream* frames) : _frames(frames) {}
+  void do_thread(Thread* th);
+};
+
+void JSONStackClosure::print_frame(Method* method, int bci) {
+  InstanceKlass* holder = method->method_holder();
+  stringStream element;
+  element.print("%s.%s(", holder->external_name(), method->name()->as_C_string());
+  if (method->is_native()) {
+    element.print("Native Method");
+  } else if (holder->source_file_name() != NULL) {
+    element.print("%s", holder->source_file_name()->as_C_string());
+    int line = method->line_number_from_bci(bci);
+    if (line >= 0) {
+      element.print(":%d", line);
+    }
+  } else {
+    element.print("Unknown Source");
+  }
+  element.print(")");
+  if (_frames->size() > 0) {
+    _frames->print(", ");
+  }
+  JSONThreadDump::print_string(_frames, element.base());
+}
+
+void JSONStackClosure::do_thread(Thread* th) {
+  JavaThread* jt = (JavaThread*)th;
+  ResourceMark rm;
+  vframeStream vfst(jt);
+  FrozenFrameStream frozen(jt);
+  while (!vfst.at_end()) {
+    if (frozen.is_walking()) {
+      print_frame(frozen.method(), frozen.bci());
+      frozen.next();
+      continue;
+    }
+    print_frame(vfst.method(), vfst.bci());
+    vfst.next();
+    if (!vfst.at_end()) {
+      frozen.enter_at(vfst.frame_id());
+    }
+  }
+}
+
+static unsigned json_stack_hash(const char* const& frames) {
+  unsigned hash = 0;
+  for (const char* p = frames; *p != '\0'; p++) {
+    hash = 31 * hash + (unsigned char)*p;
+  }
+  return hash;
+}
+
+static bool json_stack_equals(const char* const& a, const char* const& b) {
+  return strcmp(a, b) == 0;
+}
+
+typedef ResourceHashtable<const char*, int, &json_stack_hash, &json_stack_equals, 1024> JSONStackTable;
+
+void JSONThreadDump::print_string(outputStream* out, const char* s) {
+  out->put('"');
+  for (const char* p = s; *p != '\0'; p++) {
+    char c = *p;
+    if (c == '"' || c == '\\') {
+      out->put('\\');
+      out->put(c);
+    } else if ((unsigned char)c < 0x20) {
+      out->print("\\u%04x", (unsigned char)c);
+    } else {
+      out->put(c);
+    }
+  }
+  out->put('"');
+}
+
+void JSONThreadDump::print_stack_record(int index, const char* frames) {
+  _out->print_cr("%s", (_threads + _stacks) > 0 ? "," : "");
+  _out->print("      { \"stack\": %d, \"frames\": [%s] }", index, frames);
+}
+
+void JSONThreadDump::print_thread_record(JavaThread* thread, int stack) {
+  ResourceMark rm;
+  oop thread_obj = thread->threadObj();
+  _out->print_cr("%s", (_threads + _stacks) > 0 ? "," : "");
+  _out->print("      { \"thread\": { \"tid\": " JLONG_FORMAT ", \"name\": ", java_lang_Thread::thread_id(thread_obj));
+  print_string(_out, thread->get_thread_name());
+  _out->print(", \"state\": \"%s\", \"daemon\": %s",
+              java_lang_Thread::thread_status_name(thread_obj),
+              java_lang_Thread::is_daemon(thread_obj) ? "true" : "false");
+  if (thread->cont_mount_id() != 0) {
+    _out->print(", \"continuation\": " JLONG_FORMAT, thread->cont_mount_id());
+  }
+  _out->print(", \"stack\": %d } }", stack);
+  _threads++;
+}
+
+void JSONThreadDump::dump() {
+  ResourceMark rm;
+  JSONStackTable stacks;
+
+  _out->print_cr("{");
+  _out->print_cr("  \"threadDump\": {");
+  _out->print_cr("    \"processId\": %d,", os::current_process_id());
+  _out->print("    \"runtimeVersion\": ");
+  print_string(_out, VM_Version::vm_release());
+  _out->print_cr(",");
+  _out->print("    \"records\": [");
+
+  ThreadsListHandle tlh;
+  for (uint i = 0; i < tlh.length(); i++) {
+    JavaThread* jt = tlh.thread_at(i);
+    if (jt->threadObj() == NULL || jt->is_exiting() || jt->is_hidden_from_external_view()) {
+      continue;
+    }
+    stringStream frames;
+    JSONStackClosure cl(&frames);
+    if (!Handshake::execute(&cl, jt)) {
+      continue;   // the thread has exited
+    }
+    int* found = stacks.get(frames.base());
+    int stack;
+    if (found != NULL) {
+      stack = *found;
+    } else {
+      char* key = NEW_RESOURCE_ARRAY(char, frames.size() + 1);
+      strcpy(key, frames.base());
+      stack = _stacks;
+      stacks.put(key, stack);
+      print_stack_record(stack, key);
+      _stacks++;
+    }
+    print_thread_record(jt, stack);
+  }
+
+  _out->cr();
+  _out->print_cr("    ],");
+  _out->print_cr("    \"threadCount\": %d,", _threads);
+  _out->print_cr("    \"stackCount\": %d", _stacks);
+  _out->print_cr("  }");
+  _out->print_cr("}");
+}
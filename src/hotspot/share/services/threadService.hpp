@@ -424,6 +424,28 @@ public:
   instanceHandle get_threadObj(int index) { return _threads_array->at(index); }
 };
 
+// Writes a thread dump as JSON without stopping all threads at once. The
+// stack of each thread is captured in a handshake with that thread alone
+// and its record is written before the next thread is visited. Identical
+// stacks are written once, as a "stack" record that the "thread" records
+// of all threads sharing it refer to by index.
+class JSONThreadDump : public StackObj {
+private:
+  outputStream* _out;
+  int           _threads;
+  int           _stacks;
+
+  void print_stack_record(int index, const char* frames);
+  void print_thread_record(JavaThread* thread, int stack);
+public:
+  JSONThreadDump(outputStream* out) : _out(out), _threads(0), _stacks(0) {}
+
+  void dump();
+
+  // Prints s as a JSON string literal, with quotes
+  static void print_string(outputStream* out, const char* s);
+};
+
 
 // abstract utility class to set new thread states, and restore previous after the block exits
 class JavaThreadStatusChanger : public StackObj {
@@ -131,10 +131,7 @@ class BitMap {
   void verify_range(idx_t beg_index, idx_t end_index) const NOT_DEBUG_RETURN;
 
   // Statistics.
-  static const idx_t* _pop_count_table;
-  static void init_pop_count_table();
   static idx_t num_set_bits(bm_word_t w);
-  static idx_t num_set_bits_from_table(unsigned char c);
 
   // Allocation Helpers.
 
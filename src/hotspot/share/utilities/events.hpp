@@ -26,7 +26,9 @@
 #define SHARE_UTILITIES_EVENTS_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -78,15 +80,28 @@ class EventLog : public CHeapObj<mtInternal> {
 // providing a more featureful log function if the existing copy
 // semantics aren't appropriate.  The name is used as the label of the
 // log when it is dumped during a crash.
+//
+// Logging takes no lock: writers get a sequence number by atomically
+// incrementing a counter, and the slot it maps to.  A slot is written or
+// printed only by the thread that marked it busy with a CAS.  A writer
+// waits while another thread holds its slot, and gives up if a newer
+// record already took it; it publishes its record by storing the sequence
+// number in the slot.  Printers skip slots that are busy or hold a record
+// other than the one expected.
 template <class T> class EventLogBase : public EventLog {
   template <class X> class EventRecord : public CHeapObj<mtInternal> {
    public:
+    volatile size_t seq;  // Sequence number + 1, or EmptyRecord or BusyRecord
     double  timestamp;
     Thread* thread;
     X       data;
   };
 
  protected:
+  static const size_t EmptyRecord = 0;
+  static const size_t BusyRecord = SIZE_MAX;
+
+  // Serializes printing of the log.
   Mutex           _mutex;
   // Name is printed out as a header.
   const char*     _name;
@@ -94,8 +109,8 @@ template <class T> class EventLogBase : public EventLog {
   // for printing (see VM.events command).
   const char*     _handle;
   int             _length;
-  int             _index;
-  int             _count;
+  // Sequence number of the next record to be claimed.
+  volatile size_t _next;
   EventRecord<T>* _records;
 
  public:
@@ -104,24 +119,47 @@ template <class T> class EventLogBase : public EventLog {
     _name(name),
     _handle(handle),
     _length(length),
-    _index(0),
-    _count(0) {
+    _next(0) {
     _records = new EventRecord<T>[length];
+    for (int i = 0; i < length; i++) {
+      _records[i].seq = EmptyRecord;
+    }
   }
 
   double fetch_timestamp() {
     return os::elapsedTime();
   }
 
-  // move the ring buffer to next open slot and return the index of
-  // the slot to use for the current message.  Should only be called
-  // while mutex is held.
-  int compute_log_index() {
-    int index = _index;
-    if (_count < _length) _count++;
-    _index++;
-    if (_index >= _length) _index = 0;
-    return index;
+  // Claim the next slot in the ring buffer for the record with the
+  // sequence number returned in seq.  The slot stays busy until
+  // commit_record().  Returns false, and nothing is to be logged, if a newer
+  // record took the slot first, which can only happen once the ring wrapped.
+  bool claim_record(size_t* seq) {
+    *seq = Atomic::add((size_t)1, &_next) - 1;
+    volatile size_t* slot = &record_at(*seq).seq;
+    for (;;) {
+      size_t cur = OrderAccess::load_acquire(slot);
+      if (cur == BusyRecord) {
+        // Another writer or a printer, neither of which takes long.
+        SpinPause();
+        continue;
+      }
+      if (cur != EmptyRecord && cur > *seq + 1) {
+        return false;
+      }
+      if (Atomic::cmpxchg(BusyRecord, slot, cur) == cur) {
+        return true;
+      }
+    }
+  }
+
+  EventRecord<T>& record_at(size_t seq) {
+    return _records[seq % _length];
+  }
+
+  // Publish a record filled in after claim_record().
+  void commit_record(size_t seq) {
+    OrderAccess::release_store(&record_at(seq).seq, seq + 1);
   }
 
   bool should_log() {
@@ -173,11 +211,12 @@ class FormatStringEventLog : public EventLogBase< FormatStringLogMessage<bufsz>
     if (!this->should_log()) return;
 
     double timestamp = this->fetch_timestamp();
-    MutexLocker ml(&this->_mutex, Mutex::_no_safepoint_check_flag);
-    int index = this->compute_log_index();
-    this->_records[index].thread = thread;
-    this->_records[index].timestamp = timestamp;
-    this->_records[index].data.printv(format, ap);
+    size_t seq;
+    if (!this->claim_record(&seq)) return;
+    this->record_at(seq).thread = thread;
+    this->record_at(seq).timestamp = timestamp;
+    this->record_at(seq).data.printv(format, ap);
+    this->commit_record(seq);
   }
 
   void log(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(3, 4) {
@@ -334,37 +373,34 @@ inline void EventLogBase<T>::print_names(outputStream* out) const {
 // Dump the ring buffer entries that current have entries.
 template <class T>
 inline void EventLogBase<T>::print_log_impl(outputStream* out, int max) {
-  out->print_cr("%s (%d events):", _name, _count);
-  if (_count == 0) {
+  size_t next = OrderAccess::load_acquire(&_next);
+  size_t count = MIN2(next, (size_t)_length);
+  out->print_cr("%s (%d events):", _name, (int)count);
+  if (count == 0) {
     out->print_cr("No events");
     out->cr();
     return;
   }
 
   int printed = 0;
-  if (_count < _length) {
-    for (int i = 0; i < _count; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+  for (size_t seq = next - count; seq < next; seq++) {
+    if (max > 0 && printed == max) {
+      break;
     }
-  } else {
-    for (int i = _index; i < _length; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
-    }
-    for (int i = 0; i < _index; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+    EventRecord<T>& record = record_at(seq);
+    // Hold the slot while formatting it, so that no writer rewrites it
+    // meanwhile.  Skip it if it is still being written, or was already
+    // overwritten by a newer event.
+    if (Atomic::cmpxchg(BusyRecord, &record.seq, seq + 1) != seq + 1) {
+      continue;
     }
+    char buf[1024];
+    stringStream st(buf, sizeof(buf));
+    print(&st, record);
+    OrderAccess::release_store(&record.seq, seq + 1);
+    // Writers waiting for the slot need not wait for the output.
+    out->print_raw(st.base(), st.size());
+    printed ++;
   }
 
   if (printed == max) {
@@ -31,16 +31,38 @@
 #include "utilities/spinYield.hpp"
 
 GlobalCounter::PaddedCounter GlobalCounter::_global_counter;
+GlobalCounter::PaddedCounter GlobalCounter::_completed_counter;
+
+bool GlobalCounter::is_completed(uintx gbl_cnt) {
+  uintx completed = OrderAccess::load_acquire(&_completed_counter._counter);
+  // Wrap-around safe completed >= gbl_cnt.
+  return (completed - gbl_cnt) <= (max_uintx / 2);
+}
+
+void GlobalCounter::set_completed(uintx gbl_cnt) {
+  uintx completed = OrderAccess::load_acquire(&_completed_counter._counter);
+  // Only move forward; a slower writer may finish after a newer one.
+  while ((gbl_cnt - completed) - 1 < (max_uintx / 2)) {
+    uintx prev = Atomic::cmpxchg(gbl_cnt, &_completed_counter._counter, completed);
+    if (prev == completed) {
+      break;
+    }
+    completed = prev;
+  }
+}
 
 class GlobalCounter::CounterThreadCheck : public ThreadClosure {
  private:
   uintx _gbl_cnt;
+  bool _done;
  public:
-  CounterThreadCheck(uintx gbl_cnt) : _gbl_cnt(gbl_cnt) {}
+  CounterThreadCheck(uintx gbl_cnt) : _gbl_cnt(gbl_cnt), _done(false) {}
+  // True if another writer completed a grace period covering ours.
+  bool done() const { return _done; }
   void do_thread(Thread* thread) {
     SpinYield yield;
     // Loops on this thread until it has exited the critical read section.
-    while(true) {
+    while(!_done) {
       uintx cnt = OrderAccess::load_acquire(thread->get_rcu_counter());
       // This checks if the thread's counter is active. And if so is the counter
       // for a pre-existing reader (belongs to this grace period). A pre-existing
@@ -49,6 +71,7 @@ class GlobalCounter::CounterThreadCheck : public ThreadClosure {
       //  is a new reader and we can continue.
       if (((cnt & COUNTER_ACTIVE) != 0) && (cnt - _gbl_cnt) > (max_uintx / 2)) {
         yield.wait();
+        _done = is_completed(_gbl_cnt);
       } else {
         break;
       }
@@ -61,12 +84,24 @@ void GlobalCounter::write_synchronize() {
   // Atomic::add must provide fence since we have storeload dependency.
   uintx gbl_cnt = Atomic::add(COUNTER_INCREMENT, &_global_counter._counter);
 
+  // A concurrent writer that incremented after us may already be done.
+  if (is_completed(gbl_cnt)) {
+    return;
+  }
+
   // Do all RCU threads.
   CounterThreadCheck ctc(gbl_cnt);
   for (JavaThreadIteratorWithHandle jtiwh; JavaThread *thread = jtiwh.next(); ) {
     ctc.do_thread(thread);
+    if (ctc.done()) {
+      return;
+    }
   }
   for (NonJavaThread::Iterator njti; !njti.end(); njti.step()) {
     ctc.do_thread(njti.current());
+    if (ctc.done()) {
+      return;
+    }
   }
+  set_completed(gbl_cnt);
 }
@@ -54,6 +54,15 @@ class GlobalCounter : public AllStatic {
   // The global counter
   static PaddedCounter _global_counter;
 
+  // The highest global counter value whose grace period has completed.
+  // Concurrent writers share grace periods: a writer is done as soon as
+  // a scan that started at or after its own increment has finished.
+  static PaddedCounter _completed_counter;
+
+  // True if the grace period for the given global counter value is over.
+  static bool is_completed(uintx gbl_cnt);
+  static void set_completed(uintx gbl_cnt);
+
   // Bit 0 is active bit.
   static const uintx COUNTER_ACTIVE = 1;
   // Thus we increase counter by 2.
@@ -44,4 +44,11 @@ static uint32_t population_count(uint32_t x) {
   return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
 }
 
+// 64-bit variant of the above.
+static uint32_t population_count(uint64_t x) {
+  x -= ((x >> 1) & CONST64(0x5555555555555555));
+  x = (x & CONST64(0x3333333333333333)) + ((x >> 2) & CONST64(0x3333333333333333));
+  return (uint32_t)((((x + (x >> 4)) & CONST64(0x0F0F0F0F0F0F0F0F)) * CONST64(0x0101010101010101)) >> 56);
+}
+
 #endif // SHARE_UTILITIES_POPULATION_COUNT_HPP
@@ -65,17 +65,61 @@ Java_sun_nio_ch_EPoll_create(JNIEnv *env, jclass clazz) {
     return epfd;
 }
 
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE (1u << 28)
+#endif
+
+/*
+ * Applies a single interest change. EPOLLEXCLUSIVE may only be given
+ * when an fd is added, so a modification that uses it re-adds the fd.
+ * Returns 0 or the errno of the failed call.
+ */
+static int
+epollCtl(int epfd, int opcode, int fd, int events)
+{
+    struct epoll_event event;
+    int res;
+
+    event.events = events;
+    event.data.fd = fd;
+
+    if (opcode == EPOLL_CTL_MOD && (events & EPOLLEXCLUSIVE) != 0) {
+        res = epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+        if (res == 0 || errno == ENOENT) {
+            res = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event);
+        }
+    } else {
+        res = epoll_ctl(epfd, opcode, fd, &event);
+    }
+    return (res == 0) ? 0 : errno;
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_EPoll_ctl(JNIEnv *env, jclass clazz, jint epfd,
                           jint opcode, jint fd, jint events)
+{
+    return epollCtl(epfd, (int)opcode, (int)fd, (int)events);
+}
+
+/*
+ * Arms fd for a single event: the fd is disabled once the event is
+ * reported, until it is registered again. An fd registered before is
+ * re-armed, others are added.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_registerOneShot(JNIEnv *env, jclass clazz, jint epfd,
+                                      jint fd, jint events)
 {
     struct epoll_event event;
     int res;
 
-    event.events = events;
+    event.events = events | EPOLLONESHOT;
     event.data.fd = fd;
 
-    res = epoll_ctl(epfd, (int)opcode, (int)fd, &event);
+    res = epoll_ctl(epfd, EPOLL_CTL_MOD, (int)fd, &event);
+    if (res != 0 && errno == ENOENT) {
+        res = epoll_ctl(epfd, EPOLL_CTL_ADD, (int)fd, &event);
+    }
     return (res == 0) ? 0 : errno;
 }
 
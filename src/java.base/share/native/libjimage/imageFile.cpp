@@ -257,6 +257,88 @@ bool ImageFileReaderTable::contains(ImageFileReader* image) {
     return false;
 }
 
+// Keep a bounded number of recently decompressed resources so that
+// resources read repeatedly, such as the /packages/ entries consulted by
+// package_to_module, are only decompressed twice.  Most resources are read
+// once, so a resource is only cached when it is decompressed the second
+// time.  The cache is direct mapped on the resource offset; a new resource
+// simply replaces the previous occupant of its slot.  Large resources are
+// not cached.
+class ImageDecompressedCache {
+private:
+    enum {
+        SLOTS = 256,               // Number of cached resources
+        MAX_SIZE = 16 * 1024       // Largest resource that is cached
+    };
+
+    struct Slot {
+        u8 _offset;                // Resource offset in the image
+        u8 _size;                  // Uncompressed size of the resource
+        u1* _data;                 // Uncompressed bytes, or NULL if unused
+    };
+
+    Slot _slots[SLOTS];
+    u8 _missed[SLOTS];             // Offset + 1 of the last uncached resource, or 0
+    SimpleCriticalSection _lock;
+
+    static inline u4 index_for(u8 offset) {
+        return (u4)(offset ^ (offset >> 16)) % SLOTS;
+    }
+
+public:
+    ImageDecompressedCache() {
+        memset(_slots, 0, sizeof(_slots));
+        memset(_missed, 0, sizeof(_missed));
+    }
+
+    ~ImageDecompressedCache() {
+        for (u4 i = 0; i < SLOTS; i++) {
+            delete[] _slots[i]._data;
+        }
+    }
+
+    // Return true if the resource size is small enough to be cached.
+    static inline bool is_cacheable(u8 size) {
+        return size <= MAX_SIZE;
+    }
+
+    // Copy the resource at offset into uncompressed_data if present.
+    bool get(u8 offset, u1* uncompressed_data, u8 size) {
+        SimpleCriticalSectionLock cs(&_lock);
+        Slot* slot = &_slots[index_for(offset)];
+        if (slot->_data == NULL || slot->_offset != offset || slot->_size != size) {
+            return false;
+        }
+        memcpy(uncompressed_data, slot->_data, (size_t)size);
+        return true;
+    }
+
+    // Remember a copy of the decompressed resource at offset if it was
+    // decompressed before.
+    void put(u8 offset, const u1* uncompressed_data, u8 size) {
+        u4 index = index_for(offset);
+        {
+            SimpleCriticalSectionLock cs(&_lock);
+            if (_missed[index] != offset + 1) {
+                _missed[index] = offset + 1;
+                return;
+            }
+        }
+        u1* data = new u1[(size_t)size];
+        memcpy(data, uncompressed_data, (size_t)size);
+        u1* old_data;
+        {
+            SimpleCriticalSectionLock cs(&_lock);
+            Slot* slot = &_slots[index];
+            old_data = slot->_data;
+            slot->_offset = offset;
+            slot->_size = size;
+            slot->_data = data;
+        }
+        delete[] old_data;
+    }
+};
+
 // Table to manage multiple opens of an image file.
 ImageFileReaderTable ImageFileReader::_reader_table;
 
@@ -358,6 +440,7 @@ ImageFileReader::ImageFileReader(const char* name, bool big_endian) {
     _fd = -1;
     _endian = Endian::get_handler(big_endian);
     _index_data = NULL;
+    _decompressed_cache = new ImageDecompressedCache();
 }
 
 // Close image and free up data structures.
@@ -369,6 +452,9 @@ ImageFileReader::~ImageFileReader() {
         delete[] _name;
         _name = NULL;
     }
+    // Free up cached resources.
+    delete _decompressed_cache;
+    _decompressed_cache = NULL;
 }
 
 // Open image file for read access.
@@ -538,6 +624,11 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
     u8 compressed_size = location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED);
     // If the resource is compressed.
     if (compressed_size != 0) {
+        bool cacheable = ImageDecompressedCache::is_cacheable(uncompressed_size);
+        // Reuse an earlier decompression of the same resource.
+        if (cacheable && _decompressed_cache->get(offset, uncompressed_data, uncompressed_size)) {
+            return;
+        }
         u1* compressed_data;
         // If not memory mapped read in bytes.
         if (!memory_map_image) {
@@ -559,6 +650,9 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
         if (!memory_map_image) {
                 delete[] compressed_data;
         }
+        if (cacheable) {
+            _decompressed_cache->put(offset, uncompressed_data, uncompressed_size);
+        }
     } else {
         // Read bytes from offset beyond the image index.
         bool is_read = read_at(uncompressed_data, uncompressed_size, _index_size + offset);
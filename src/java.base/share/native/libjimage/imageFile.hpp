@@ -359,6 +359,7 @@ public:
 #define IMAGE_MAX_PATH 4096
 
 class ImageFileReader;
+class ImageDecompressedCache; // forward declaration
 
 // Manage a table of open image files.  This table allows multiple access points
 // to share an open image.
@@ -424,6 +425,7 @@ private:
     u1* _location_bytes; // Location attributes
     u1* _string_bytes;   // String table
     ImageModuleData *module_data;       // The ImageModuleData for this image
+    ImageDecompressedCache* _decompressed_cache; // Recently decompressed resources
 
     ImageFileReader(const char* name, bool big_endian);
     ~ImageFileReader();
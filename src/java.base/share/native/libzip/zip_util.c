@@ -1162,6 +1162,24 @@ jboolean equals(char* name1, int len1, char* name2, int len2) {
     return JNI_TRUE;
 }
 
+/*
+ * Returns false if the CEN name of the given hash cell is known not to
+ * match "name". With the CEN mapped the name is compared in place, so
+ * a hash collision costs no entry allocation; otherwise the caller has
+ * to read the entry to find out.
+ */
+static jboolean
+cellNameMayEqual(jzfile *zip, jzcell *zc, char *name, jint ulen)
+{
+#ifdef USE_MMAP
+    if (zip->usemmap) {
+        char *cen = (char*) zip->maddr + zc->cenpos - zip->offset;
+        return equals(cen + CENHDR, CENNAM(cen), name, ulen);
+    }
+#endif
+    return JNI_TRUE;
+}
+
 /*
  * Returns the zip entry corresponding to the specified name, or
  * NULL if not found.
@@ -1207,7 +1225,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         while (idx != ZIP_ENDCHAIN) {
             jzcell *zc = &zip->entries[idx];
 
-            if (zc->hash == hsh) {
+            if (zc->hash == hsh && cellNameMayEqual(zip, zc, name, ulen)) {
                 /*
                  * OK, we've found a ZIP entry whose 32 bit hashcode
                  * matches the name we're looking for.  Try to read
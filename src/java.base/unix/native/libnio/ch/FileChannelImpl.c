@@ -29,7 +29,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#if defined(__linux__) || defined(__solaris__)
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(__solaris__)
 #include <sys/sendfile.h>
 #elif defined(_AIX)
 #include <string.h>
@@ -60,6 +63,48 @@ Java_sun_nio_ch_FileChannelImpl_initIDs(JNIEnv *env, jclass clazz)
     return pageSize;
 }
 
+#if defined(__linux__)
+/* Cleared once copy_file_range is found to be missing from the kernel */
+static int copy_file_range_supported = 1;
+
+/*
+ * Copies between two regular files with copy_file_range, which lets the
+ * kernel share extents or copy without a round trip through user space.
+ * dstMode is the st_mode of dstFD. Returns -1 with errno set to ENOSYS if
+ * the path is unusable for this pair of descriptors, so that the caller
+ * can fall back to sendfile.
+ */
+static jlong
+copyFileRange(jint srcFD, jint dstFD, mode_t dstMode, off64_t *offset, size_t count)
+{
+#ifdef __NR_copy_file_range
+    jlong n;
+
+    if (!copy_file_range_supported || !S_ISREG(dstMode)) {
+        errno = ENOSYS;
+        return -1;
+    }
+    n = syscall(__NR_copy_file_range, srcFD, offset, dstFD, NULL, count, 0);
+    if (n < 0) {
+        if (errno == ENOSYS) {
+            copy_file_range_supported = 0;
+        } else if (errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP ||
+                   errno == EBADF || errno == EPERM || errno == ETXTBSY) {
+            /* Cross-device copy on older kernels, unsupported file system,
+             * or a descriptor copy_file_range rejects but sendfile may
+             * accept, such as one opened for append, an immutable file or
+             * a swap file */
+            errno = ENOSYS;
+        }
+    }
+    return n;
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+#endif
+
 static jlong
 handle(JNIEnv *env, jlong rv, char *msg)
 {
@@ -169,7 +214,23 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 
 #if defined(__linux__)
     off64_t offset = (off64_t)position;
-    jlong n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
+    struct stat64 st;
+    mode_t dstMode = (fstat64(dstFD, &st) == 0) ? st.st_mode : 0;
+    jlong n = copyFileRange(srcFD, dstFD, dstMode, &offset, (size_t)count);
+    if (n < 0 && errno == ENOSYS) {
+        n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
+    }
+    if (n < 0 && errno == EINVAL && (ssize_t)count >= 0) {
+        /* Older kernels only support sendfile to a socket; a pipe can
+         * still be fed directly from the page cache with splice */
+        if (S_ISFIFO(dstMode)) {
+            n = splice(srcFD, &offset, dstFD, NULL, (size_t)count, SPLICE_F_MOVE);
+            if (n < 0 && errno != EAGAIN && errno != EINTR)
+                errno = EINVAL;
+        } else {
+            errno = EINVAL;
+        }
+    }
     if (n < 0) {
         if (errno == EAGAIN)
             return IOS_UNAVAILABLE;
@@ -24,6 +24,7 @@
  */
 
  #include <sys/types.h>
+ #include <sys/socket.h>
  #include <sys/uio.h>
  #include <unistd.h>
 
@@ -49,6 +50,30 @@
      }
  }
 
+ /*
+  * Reads without blocking even if the socket is in blocking mode, returning
+  * IOS_UNAVAILABLE if no data is available, so that a continuation can wait
+  * for the socket to be readable on a poller instead of pinning its carrier.
+  */
+ JNIEXPORT jint JNICALL
+ Java_sun_nio_ch_SocketDispatcher_readNonBlocking0(JNIEnv *env, jclass clazz,
+                                                   jobject fdo, jlong address, jint len)
+ {
+     jint fd = fdval(env, fdo);
+     void *buf = (void *)jlong_to_ptr(address);
+ #ifdef MSG_DONTWAIT
+     jint n = recv(fd, buf, len, MSG_DONTWAIT);
+ #else
+     jint n = recv(fd, buf, len, MSG_NONBLOCK);
+ #endif
+     if ((n == -1) && (errno == ECONNRESET || errno == EPIPE)) {
+         JNU_ThrowByName(env, "sun/net/ConnectionResetException", "Connection reset");
+         return IOS_THROWN;
+     } else {
+         return convertReturnVal(env, n, JNI_TRUE);
+     }
+ }
+
  JNIEXPORT jlong JNICALL
  Java_sun_nio_ch_SocketDispatcher_readv0(JNIEnv *env, jclass clazz,
                                          jobject fdo, jlong address, jint len)
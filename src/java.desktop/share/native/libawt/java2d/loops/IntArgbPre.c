@@ -33,6 +33,14 @@
 #include "ByteGray.h"
 #include "ByteIndexed.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INTARGBPRE_SIMD_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INTARGBPRE_SIMD_NEON
+#endif
+
 /*
  * This file declares, registers, and defines the various graphics
  * primitive loops to manipulate surfaces of type "IntArgbPre".
@@ -178,3 +186,100 @@ DEFINE_SOLID_DRAWGLYPHLISTAA(IntArgbPre, 4ByteArgb)
 DEFINE_SOLID_DRAWGLYPHLISTLCD(IntArgbPre, 4ByteArgb)
 
 DEFINE_TRANSFORMHELPERS(IntArgbPre)
+
+#if defined(INTARGBPRE_SIMD_SSE2) || defined(INTARGBPRE_SIMD_NEON)
+/*
+ * SrcOver MaskFill for IntArgbPre using SSE2 or NEON, substituted for
+ * IntArgbPreSrcOverMaskFill by MapAccelFunction.
+ *
+ * Without a coverage mask every pixel is blended with the same
+ * premultiplied color, so each of the four components is computed as
+ * MUL8(dstF, dst) + src.  Four pixels are processed at a time, with
+ * MUL8(a, b) evaluated as (x + (x >> 8)) >> 8 for x = a * b + 128,
+ * which gives exactly the values in mul8table for all 8-bit a and b.
+ * Fills with a coverage mask use the generic loop.
+ */
+void IntArgbPreSrcOverMaskFillSimd(void *rasBase,
+                                   jubyte *pMask, jint maskOff, jint maskScan,
+                                   jint width, jint height,
+                                   jint fgColor,
+                                   SurfaceDataRasInfo *pRasInfo,
+                                   NativePrimitive *pPrim,
+                                   CompositeInfo *pCompInfo)
+{
+    juint *pRas = (juint *) rasBase;
+    jint rasScan = pRasInfo->scanStride;
+    jint srcA, srcR, srcG, srcB, dstF;
+    juint srcPixel;
+
+    if (pMask != NULL) {
+        IntArgbPreSrcOverMaskFill(rasBase, pMask, maskOff, maskScan,
+                                  width, height, fgColor,
+                                  pRasInfo, pPrim, pCompInfo);
+        return;
+    }
+
+    ExtractIntDcmComponents1234(fgColor, srcA, srcR, srcG, srcB);
+    if (srcA != 0xff) {
+        if (srcA == 0) {
+            return;
+        }
+        srcR = MUL8(srcA, srcR);
+        srcG = MUL8(srcA, srcG);
+        srcB = MUL8(srcA, srcB);
+    }
+    srcPixel = ComposeIntDcmComponents1234(srcA, srcR, srcG, srcB);
+    dstF = 0xff - srcA;
+
+    {
+#ifdef INTARGBPRE_SIMD_SSE2
+        __m128i vSrc = _mm_set1_epi32((jint) srcPixel);
+        __m128i vDstF = _mm_set1_epi16((short) dstF);
+        __m128i vRound = _mm_set1_epi16(128);
+        __m128i vZero = _mm_setzero_si128();
+#else
+        uint8x16_t vSrc = vreinterpretq_u8_u32(vdupq_n_u32(srcPixel));
+        uint8x8_t vDstF = vdup_n_u8((uint8_t) dstF);
+        uint16x8_t vRound = vdupq_n_u16(128);
+#endif
+
+        do {
+            juint *pPix = pRas;
+            jint w = width;
+
+            for (; w >= 4; w -= 4, pPix += 4) {
+#ifdef INTARGBPRE_SIMD_SSE2
+                __m128i d = _mm_loadu_si128((__m128i *) pPix);
+                __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, vZero), vDstF);
+                __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, vZero), vDstF);
+                lo = _mm_add_epi16(lo, vRound);
+                hi = _mm_add_epi16(hi, vRound);
+                lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+                d = _mm_add_epi8(_mm_packus_epi16(lo, hi), vSrc);
+                _mm_storeu_si128((__m128i *) pPix, d);
+#else
+                uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(pPix));
+                uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(d), vDstF), vRound);
+                uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(d), vDstF), vRound);
+                lo = vsraq_n_u16(lo, lo, 8);
+                hi = vsraq_n_u16(hi, hi, 8);
+                d = vaddq_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)), vSrc);
+                vst1q_u32(pPix, vreinterpretq_u32_u8(d));
+#endif
+            }
+            for (; w > 0; w--, pPix++) {
+                jint dstA, dstR, dstG, dstB;
+                juint pixel = *pPix;
+                ExtractIntDcmComponents1234(pixel, dstA, dstR, dstG, dstB);
+                dstA = MUL8(dstF, dstA) + srcA;
+                dstR = MUL8(dstF, dstR) + srcR;
+                dstG = MUL8(dstF, dstG) + srcG;
+                dstB = MUL8(dstF, dstB) + srcB;
+                *pPix = ComposeIntDcmComponents1234(dstA, dstR, dstG, dstB);
+            }
+            pRas = PtrAddBytes(pRas, rasScan);
+        } while (--height > 0);
+    }
+}
+#endif
@@ -23,15 +23,43 @@
  * questions.
  */
 
+#include <stdlib.h>
+
 #include "GraphicsPrimitiveMgr.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(__ARM_NEON)
+#define SIMD_LOOPS
+
+extern MaskFillFunc IntArgbPreSrcOverMaskFill;
+extern MaskFillFunc IntArgbPreSrcOverMaskFillSimd;
+
+static int initialized;
+static int usesimd = JNI_TRUE;
+#endif
+
 /*
- * This is a dummy function that satisfies the MapAccelFunction
- * contract by simply returning a pointer to the indicated
- * C function.  This function is only executed in the absence
- * of an implementation specific function that maps the C
- * functions to accelerated versions of the same operation.
+ * This is the default MapAccelFunction, used in the absence of an
+ * implementation specific function that maps the C functions to
+ * accelerated versions of the same operation.  It returns the SSE2
+ * or NEON version of the few loops that have one, which those
+ * instruction sets being baseline on x86_64 and aarch64, unless the
+ * J2D_USE_SIMD_LOOPS environment variable is set to false, and
+ * otherwise the indicated C function.
  */
 AnyFunc *MapAccelFunction(AnyFunc *c_func) {
+#ifdef SIMD_LOOPS
+    if (!initialized) {
+        char *simd_env = getenv("J2D_USE_SIMD_LOOPS");
+        if (simd_env != NULL && (*simd_env == 'f' || *simd_env == 'F')) {
+            usesimd = JNI_FALSE;
+        }
+        initialized = 1;
+    }
+    if (usesimd) {
+        if (c_func == (AnyFunc *) IntArgbPreSrcOverMaskFill) {
+            return (AnyFunc *) IntArgbPreSrcOverMaskFillSimd;
+        }
+    }
+#endif
     return c_func;
 }
@@ -192,9 +192,16 @@ lib_info* add_lib_info_fd(struct ps_prochandle* ph, const char* libname, int fd,
       return NULL;
    }
 
-   newlib->symtab = build_symtab(newlib->fd, libname);
-   if (newlib->symtab == NULL) {
-      print_debug("symbol table build failed for %s\n", newlib->name);
+   // For a core dump the fd stays open, so the symbol table is built
+   // on first use; most libraries of a large core are never searched.
+   // A live process closes the fd right away, so build it now.
+   if (ph->core != NULL) {
+      newlib->symtab_pending = true;
+   } else {
+      newlib->symtab = build_symtab(newlib->fd, libname);
+      if (newlib->symtab == NULL) {
+         print_debug("symbol table build failed for %s\n", newlib->name);
+      }
    }
 
    // even if symbol table building fails, we add the lib_info.
@@ -211,6 +218,20 @@ lib_info* add_lib_info_fd(struct ps_prochandle* ph, const char* libname, int fd,
    return newlib;
 }
 
+// symbol table of a library, building it first if that was deferred
+static struct symtab* lib_symtab(lib_info* lib) {
+   if (lib->symtab_pending) {
+      lib->symtab_pending = false;
+      if (lib->fd >= 0) {
+         lib->symtab = build_symtab(lib->fd, lib->name);
+      }
+      if (lib->symtab == NULL) {
+         print_debug("symbol table build failed for %s\n", lib->name);
+      }
+   }
+   return lib->symtab;
+}
+
 // lookup for a specific symbol
 uintptr_t lookup_symbol(struct ps_prochandle* ph,  const char* object_name,
                        const char* sym_name) {
@@ -223,7 +244,7 @@ uintptr_t lookup_symbol(struct ps_prochandle* ph,  const char* object_name,
 
    lib_info* lib = ph->libs;
    while (lib) {
-      if (lib->symtab) {
+      if (lib_symtab(lib)) {
          uintptr_t res = search_symbol(lib->symtab, lib->base, sym_name, NULL);
          if (res) return res;
       }
@@ -240,7 +261,7 @@ const char* symbol_for_pc(struct ps_prochandle* ph, uintptr_t addr, uintptr_t* p
    const char* res = NULL;
    lib_info* lib = ph->libs;
    while (lib) {
-      if (lib->symtab && addr >= lib->base) {
+      if (addr >= lib->base && lib_symtab(lib)) {
          res = nearest_symbol(lib->symtab, addr - lib->base, poffset);
          if (res) return res;
       }
@@ -39,6 +39,7 @@ typedef struct lib_info {
   char             name[BUF_SIZE];
   uintptr_t        base;
   struct symtab*   symtab;
+  bool             symtab_pending; // symtab not built yet, see lib_symtab
   int              fd;        // file descriptor for lib
   struct lib_info* next;
 } lib_info;
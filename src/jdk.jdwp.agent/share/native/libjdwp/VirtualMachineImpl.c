@@ -539,7 +539,12 @@ getAllThreads(PacketInputStream *in, PacketOutputStream *out)
         jint threadCount;
         jthread *theThreads;
 
-        theThreads = allThreads(&threadCount);
+        if (gdata->lazyThreads) {
+            /* Only the suspended threads and those at an event */
+            theThreads = threadControl_reportedThreads(&threadCount);
+        } else {
+            theThreads = allThreads(&threadCount);
+        }
         if (theThreads == NULL) {
             outStream_setError(out, JDWP_ERROR(OUT_OF_MEMORY));
         } else {
@@ -874,6 +874,7 @@ printUsage(void)
  "onthrow=<exception name>         debug on throw                    none\n"
  "onuncaught=y|n                   debug on any uncaught?            n\n"
  "timeout=<timeout value>          for listen/attach in milliseconds n\n"
+ "lazythreads=y|n                  list only suspended threads       n\n"
  "mutf8=y|n                        output modified utf-8             n\n"
  "quiet=y|n                        control over terminal messages    n\n"));
 
@@ -1225,6 +1226,10 @@ parseOptions(char *options)
             if ( !get_boolean(&str, &initOnUncaught) ) {
                 goto syntax_error;
             }
+        } else if ( strcmp(buf, "lazythreads")==0 ) {
+            if ( !get_boolean(&str, &(gdata->lazyThreads)) ) {
+                goto syntax_error;
+            }
         } else if ( strcmp(buf, "mutf8")==0 ) {
             if ( !get_boolean(&str, &(gdata->modifiedUtf8)) ) {
                 goto syntax_error;
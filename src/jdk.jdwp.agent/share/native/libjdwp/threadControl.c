@@ -84,6 +84,8 @@ typedef struct ThreadNode {
     struct ThreadNode *prev;
     jlong frameGeneration;
     struct ThreadList *list;  /* Tells us what list this thread is in */
+    jint hashCode;            /* identity hash code of the thread */
+    struct ThreadNode *hashNext; /* next node in this hash slot */
 } ThreadNode;
 
 static jint suspendAllCount;
@@ -119,6 +121,18 @@ static jvmtiError threadControl_removeDebugThread(jthread thread);
 static ThreadList runningThreads;
 static ThreadList otherThreads;
 
+/*
+ * Hash table of the nodes in both lists, by the identity hash code of
+ * their thread. It finds the nodes of threads without TLS set without
+ * scanning the lists. The slot count is a power of two, doubled when
+ * there are more nodes than slots.
+ */
+#define THREAD_HASH_INIT_SLOT_COUNT 256
+
+static ThreadNode **threadHash;
+static jint threadHashSlotCount;
+static jint threadHashNodeCount;
+
 #define MAX_DEBUG_THREADS 10
 static int debugThreadCount;
 static jthread debugThreads[MAX_DEBUG_THREADS];
@@ -197,20 +211,97 @@ getThreadLocalStorage(jthread thread)
     return node;
 }
 
-/* Search list for nodes that don't have TLS set and match this thread.
- *   It assumed that this logic is never dealing with terminated threads,
- *   since the ThreadEnd events always delete the ThreadNode while the
- *   jthread is still alive.  So we can only look at the ThreadNode's that
- *   have never had their TLS set, making the search much faster.
- *   But keep in mind, this kind of search should rarely be needed.
+static ThreadNode **
+hashSlot(ThreadNode **table, jint slotCount, jint hashCode)
+{
+    return &table[(unsigned int)hashCode & (unsigned int)(slotCount - 1)];
+}
+
+static void
+growThreadHash(void)
+{
+    ThreadNode **newTable;
+    jint newSlotCount;
+    jint i;
+
+    newSlotCount = threadHashSlotCount == 0 ? THREAD_HASH_INIT_SLOT_COUNT
+                                            : threadHashSlotCount * 2;
+    newTable = jvmtiAllocate(newSlotCount * (int)sizeof(ThreadNode *));
+    if (newTable == NULL) {
+        EXIT_ERROR(AGENT_ERROR_OUT_OF_MEMORY, "thread hash table");
+        return;
+    }
+    (void)memset(newTable, 0, newSlotCount * sizeof(ThreadNode *));
+    for (i = 0; i < threadHashSlotCount; i++) {
+        ThreadNode *node = threadHash[i];
+        while (node != NULL) {
+            ThreadNode *next = node->hashNext;
+            ThreadNode **slot = hashSlot(newTable, newSlotCount, node->hashCode);
+            node->hashNext = *slot;
+            *slot = node;
+            node = next;
+        }
+    }
+    if (threadHash != NULL) {
+        jvmtiDeallocate(threadHash);
+    }
+    threadHash = newTable;
+    threadHashSlotCount = newSlotCount;
+}
+
+static void
+hashNode(ThreadNode *node)
+{
+    ThreadNode **slot;
+
+    if (threadHashNodeCount >= threadHashSlotCount) {
+        growThreadHash();
+    }
+    node->hashCode = objectHashCode(node->thread);
+    slot = hashSlot(threadHash, threadHashSlotCount, node->hashCode);
+    node->hashNext = *slot;
+    *slot = node;
+    threadHashNodeCount++;
+}
+
+static void
+unhashNode(ThreadNode *node)
+{
+    ThreadNode **nodePtr;
+
+    nodePtr = hashSlot(threadHash, threadHashSlotCount, node->hashCode);
+    for (; *nodePtr != NULL; nodePtr = &((*nodePtr)->hashNext)) {
+        if (*nodePtr == node) {
+            *nodePtr = node->hashNext;
+            node->hashNext = NULL;
+            threadHashNodeCount--;
+            return;
+        }
+    }
+    JDI_ASSERT(JNI_FALSE);
+}
+
+/* Search the hash table for the node of a thread that doesn't have TLS
+ *   set. It assumed that this logic is never dealing with terminated
+ *   threads, since the ThreadEnd events always delete the ThreadNode
+ *   while the jthread is still alive. Only nodes with the same hash code
+ *   are compared, and only those in list if it isn't NULL.
  */
 static ThreadNode *
 nonTlsSearch(JNIEnv *env, ThreadList *list, jthread thread)
 {
     ThreadNode *node;
+    jint hashCode;
 
-    for (node = list->first; node != NULL; node = node->next) {
-        if (isSameObject(env, node->thread, thread)) {
+    if (threadHashNodeCount == 0) {
+        return NULL;
+    }
+    hashCode = objectHashCode(thread);
+    node = *hashSlot(threadHash, threadHashSlotCount, hashCode);
+    for (; node != NULL; node = node->hashNext) {
+        if (node->hashCode == hashCode &&
+            (list == NULL || node->list == list) &&
+            isSameObject(env, node->thread, thread)) {
             break;
         }
     }
@@ -237,14 +328,7 @@ findThread(ThreadList *list, jthread thread)
         JNIEnv *env;
 
         env = getEnv();
-        if ( list != NULL ) {
-            node = nonTlsSearch(env, list, thread);
-        } else {
-            node = nonTlsSearch(env, &runningThreads, thread);
-            if ( node == NULL ) {
-                node = nonTlsSearch(env, &otherThreads, thread);
-            }
-        }
+        node = nonTlsSearch(env, list, thread);
         if ( node != NULL ) {
             /* Here we make another attempt to set TLS, it's ok if this fails */
             setThreadLocalStorage(thread, (void*)node);
@@ -348,6 +432,7 @@ insertThread(JNIEnv *env, ThreadList *list, jthread thread)
         node->instructionStepMode = JVMTI_DISABLE;
         node->eventBag = eventBag;
         addNode(list, node);
+        hashNode(node);
 
         /* Set thread local storage for quick thread -> node access.
          *   Some threads may not be in a state that allows setting of TLS,
@@ -362,6 +447,7 @@ insertThread(JNIEnv *env, ThreadList *list, jthread thread)
 static void
 clearThread(JNIEnv *env, ThreadNode *node)
 {
+    unhashNode(node);
     if (node->pendingStop != NULL) {
         tossGlobalRef(env, &(node->pendingStop));
     }
@@ -570,6 +656,9 @@ threadControl_initialize(void)
     suspendAllCount = 0;
     runningThreads.first = NULL;
     otherThreads.first = NULL;
+    threadHash = NULL;
+    threadHashSlotCount = 0;
+    threadHashNodeCount = 0;
     debugThreadCount = 0;
     threadLock = debugMonitorCreate("JDWP Thread Lock");
     if (gdata->threadClass==NULL) {
@@ -1429,6 +1518,50 @@ threadControl_resumeThread(jthread thread, jboolean do_unblock)
     return error;
 }
 
+/*
+ * With lazythreads=y, VirtualMachine.AllThreads only reports the threads
+ * the debugger suspended and those stopped at an event. Others become
+ * known to the debugger the first time they are reported by an event.
+ */
+static jboolean
+isReportedThread(ThreadNode *node)
+{
+    return !node->isDebugThread && (node->suspendCount > 0 || node->current_ei != 0);
+}
+
+/* Returns the reported threads as local refs, in a jvmtiAllocate'd array. */
+jthread *
+threadControl_reportedThreads(jint *count)
+{
+    JNIEnv *env;
+    ThreadNode *node;
+    jthread *threads;
+    jint n;
+
+    env = getEnv();
+    *count = 0;
+
+    debugMonitorEnter(threadLock);
+    n = 0;
+    for (node = runningThreads.first; node != NULL; node = node->next) {
+        if (isReportedThread(node)) {
+            n++;
+        }
+    }
+    /* Never allocate 0 bytes, NULL means out of memory to the caller. */
+    threads = jvmtiAllocate((n == 0 ? 1 : n) * (int)sizeof(jthread));
+    if (threads != NULL) {
+        for (node = runningThreads.first; node != NULL; node = node->next) {
+            if (isReportedThread(node)) {
+                threads[(*count)++] = JNI_FUNC_PTR(env,NewLocalRef)(env, node->thread);
+            }
+        }
+    }
+    debugMonitorExit(threadLock);
+
+    return threads;
+}
+
 jvmtiError
 threadControl_suspendCount(jthread thread, jint *count)
 {
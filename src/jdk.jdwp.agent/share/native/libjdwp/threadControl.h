@@ -48,6 +48,7 @@ void threadControl_onEventHandlerExit(EventIndex ei, jthread thread, struct bag
 jvmtiError threadControl_suspendThread(jthread thread, jboolean deferred);
 jvmtiError threadControl_resumeThread(jthread thread, jboolean do_unblock);
 jvmtiError threadControl_suspendCount(jthread thread, jint *count);
+jthread *threadControl_reportedThreads(jint *count);
 
 jvmtiError threadControl_suspendAll(void);
 jvmtiError threadControl_resumeAll(void);
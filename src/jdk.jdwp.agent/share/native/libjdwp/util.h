@@ -80,6 +80,7 @@ typedef struct {
     jboolean doerrorexit;
     jboolean modifiedUtf8;
     jboolean quiet;
+    jboolean lazyThreads;
 
     /* Debug flags (bit mask) */
     int      debugflags;
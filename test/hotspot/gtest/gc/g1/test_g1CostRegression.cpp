@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CostRegression.hpp"
+#include "unittest.hpp"
+
+static const double epsilon = 1e-6;
+
+TEST_VM(G1CostRegression, not_valid_initially) {
+  G1CostRegression r;
+  ASSERT_FALSE(r.is_valid());
+  for (int i = 0; i < 4; i++) {
+    r.add(i, 1.0);
+  }
+  ASSERT_FALSE(r.is_valid());
+  r.add(5.0, 1.0);
+  ASSERT_TRUE(r.is_valid());
+}
+
+TEST_VM(G1CostRegression, fits_line) {
+  G1CostRegression r;
+  for (int i = 0; i < 20; i++) {
+    double x = 100.0 * (i % 7);
+    r.add(x, 2.0 + 0.01 * x);
+  }
+  ASSERT_NEAR(r.intercept(), 2.0, epsilon);
+  ASSERT_NEAR(r.slope(), 0.01, epsilon);
+  ASSERT_NEAR(r.stddev(), 0.0, epsilon);
+  ASSERT_NEAR(r.predict(1000.0), 12.0, epsilon);
+}
+
+TEST_VM(G1CostRegression, constant_work_uses_average_cost) {
+  G1CostRegression r;
+  for (int i = 0; i < 10; i++) {
+    r.add(50.0, 5.0);
+  }
+  ASSERT_NEAR(r.intercept(), 0.0, epsilon);
+  ASSERT_NEAR(r.unit_cost(), 0.1, epsilon);
+}
+
+TEST_VM(G1CostRegression, follows_changes) {
+  G1CostRegression r;
+  for (int i = 0; i < 20; i++) {
+    double x = 10.0 * (i % 5);
+    r.add(x, 1.0 + x);
+  }
+  for (int i = 0; i < 100; i++) {
+    double x = 10.0 * (i % 5);
+    r.add(x, 1.0 + 2.0 * x);
+  }
+  ASSERT_NEAR(r.slope(), 2.0, 1e-3);
+  ASSERT_GT(r.fixed_cost(1.0), r.intercept());
+}
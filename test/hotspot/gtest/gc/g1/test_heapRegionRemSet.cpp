@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CardTable.hpp"
+#include "gc/g1/g1CollectedHeap.hpp"
+#include "gc/g1/heapRegion.inline.hpp"
+#include "gc/g1/heapRegionRemSet.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/vmOperations.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "unittest.hpp"
+
+class CollectCardsClosure : public StackObj {
+  CHeapBitMap* _bm;
+  size_t _count;
+
+public:
+  CollectCardsClosure(CHeapBitMap* bm) : _bm(bm), _count(0) { }
+
+  void do_card(uint card_index) {
+    _bm->set_bit(card_index);
+    _count++;
+  }
+
+  size_t count() const { return _count; }
+};
+
+class VM_PerRegionTableCardContainersTest : public VM_GTestExecuteAtSafepoint {
+  // Spreads the cards over the whole region.
+  static CardIdx_t card_for(uint i) {
+    return (CardIdx_t)((i * 7) % HeapRegion::CardsPerRegion);
+  }
+
+  static OopOrNarrowOopStar address_of(HeapRegion* hr, CardIdx_t card) {
+    return (OopOrNarrowOopStar)((char*)hr->bottom() + (size_t)card * G1CardTable::card_size);
+  }
+
+public:
+  void doit();
+};
+
+void VM_PerRegionTableCardContainersTest::doit() {
+  G1CollectedHeap* heap = G1CollectedHeap::heap();
+  HeapRegion* hr = heap->heap_region_containing(heap->bottom_addr_for_region(0));
+
+  // Start from a PRT without a bitmap, also if the free list has one.
+  PerRegionTable::release_free_bitmaps();
+  PerRegionTable* prt = PerRegionTable::alloc(hr);
+
+  // Without a bitmap, the PRT is its fields and the array.
+  size_t array_mem_size = prt->mem_size();
+  size_t capacity = (array_mem_size - sizeof(PerRegionTable)) / sizeof(CardIdx_t);
+  EXPECT_LE(capacity, (size_t)G1RSetFineArrayEntriesMax);
+  EXPECT_LE(capacity, BitMap::calc_size_in_bytes(HeapRegion::CardsPerRegion) / 4 / sizeof(CardIdx_t));
+
+  // Up to the capacity, cards go to the array.
+  for (uint i = 0; i < capacity; i++) {
+    prt->add_card(card_for(i));
+    EXPECT_TRUE(prt->contains_reference(address_of(hr, card_for(i))));
+  }
+  EXPECT_EQ((jint)capacity, prt->occupied());
+  EXPECT_EQ(array_mem_size, prt->mem_size());
+
+  // Adding a card again does not take a slot.
+  if (capacity > 0) {
+    prt->add_card(card_for(0));
+    EXPECT_EQ((jint)capacity, prt->occupied());
+    EXPECT_EQ(array_mem_size, prt->mem_size());
+  }
+
+  // The next card overflows the array into the bitmap.
+  uint num_cards = (uint)capacity + 10;
+  for (uint i = (uint)capacity; i < num_cards; i++) {
+    prt->add_card(card_for(i));
+    EXPECT_TRUE(prt->contains_reference(address_of(hr, card_for(i))));
+  }
+  EXPECT_EQ((jint)num_cards, prt->occupied());
+  EXPECT_EQ(array_mem_size + BitMap::calc_size_in_words(HeapRegion::CardsPerRegion) * HeapWordSize,
+            prt->mem_size());
+
+  // Cards in the array stay there.
+  for (uint i = 0; i < capacity; i++) {
+    EXPECT_TRUE(prt->contains_reference(address_of(hr, card_for(i))));
+  }
+  EXPECT_FALSE(prt->contains_reference(address_of(hr, card_for(num_cards))));
+
+  // Iteration visits the union of both containers.
+  CHeapBitMap expected(HeapRegion::CardsPerRegion, mtGC);
+  for (uint i = 0; i < num_cards; i++) {
+    expected.set_bit(card_for(i));
+  }
+  CHeapBitMap visited(HeapRegion::CardsPerRegion, mtGC);
+  CollectCardsClosure cl(&visited);
+  prt->iterate_cards(cl);
+  EXPECT_EQ((size_t)num_cards, cl.count());
+  EXPECT_TRUE(visited.is_same(expected));
+
+  // Freed PRTs give their bitmaps back.
+  PerRegionTable::free(prt);
+  PerRegionTable::release_free_bitmaps();
+  EXPECT_EQ(array_mem_size, prt->mem_size());
+}
+
+TEST_VM(PerRegionTable, card_containers) {
+  if (!UseG1GC) {
+    return;
+  }
+
+  // Run the test in our very own safepoint, where cards are iterated
+  // and free bitmaps released.
+  VM_PerRegionTableCardContainersTest op;
+  ThreadInVMfromNative invm(JavaThread::current());
+  VMThread::execute(&op);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/mutex.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "microbench.hpp"
+#include "unittest.hpp"
+
+const size_t bench_storage_entries = 4096;
+
+class OopStorageBench : public CHeapObj<mtTest> {
+  static const int _active_rank = Mutex::leaf - 1;
+  static const int _allocate_rank = Mutex::leaf;
+
+  Mutex _allocation_mutex;
+  Mutex _active_mutex;
+
+ public:
+  OopStorage _storage;
+  oop* _entries[bench_storage_entries];
+
+  OopStorageBench() :
+    _allocation_mutex(_allocate_rank,
+                      "bench_OopStorage_allocation",
+                      false,
+                      Mutex::_safepoint_check_never),
+    _active_mutex(_active_rank,
+                  "bench_OopStorage_active",
+                  false,
+                  Mutex::_safepoint_check_never),
+    _storage("Bench Storage", &_allocation_mutex, &_active_mutex)
+  { }
+};
+
+// Allocates and then releases bench_storage_entries entries one at a time.
+class OopStorageAllocateReleaseOp : public MicroBenchOp {
+  OopStorageBench* _bench;
+ public:
+  OopStorageAllocateReleaseOp(OopStorageBench* bench) : _bench(bench) {}
+  virtual void run() {
+    for (size_t i = 0; i < bench_storage_entries; ++i) {
+      _bench->_entries[i] = _bench->_storage.allocate();
+    }
+    for (size_t i = 0; i < bench_storage_entries; ++i) {
+      _bench->_storage.release(_bench->_entries[i]);
+    }
+  }
+};
+
+// Allocates bench_storage_entries entries in batches and releases them
+// in a single bulk release.
+class OopStorageBulkAllocateReleaseOp : public MicroBenchOp {
+  OopStorageBench* _bench;
+ public:
+  OopStorageBulkAllocateReleaseOp(OopStorageBench* bench) : _bench(bench) {}
+  virtual void run() {
+    size_t allocated = 0;
+    while (allocated < bench_storage_entries) {
+      size_t count = _bench->_storage.allocate(_bench->_entries + allocated,
+                                               bench_storage_entries - allocated);
+      if (count == 0) break;  // Out of memory.
+      allocated += count;
+    }
+    _bench->_storage.release(_bench->_entries, allocated);
+  }
+};
+
+BENCH_VM(OopStorage, allocate_release) {
+  OopStorageBench* bench = new OopStorageBench();
+  OopStorageAllocateReleaseOp op(bench);
+  MicroBench::run("OopStorage.allocate_release", bench_storage_entries, &op);
+  delete bench;
+}
+
+BENCH_VM(OopStorage, bulk_allocate_release) {
+  OopStorageBench* bench = new OopStorageBench();
+  OopStorageBulkAllocateReleaseOp op(bench);
+  MicroBench::run("OopStorage.bulk_allocate_release", bench_storage_entries, &op);
+  delete bench;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/threadLocalAllocBuffer.inline.hpp"
+#include "memory/oopFactory.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "microbench.hpp"
+#include "unittest.hpp"
+
+const size_t bench_tlab_refills = 64;
+
+// Retires the thread's TLAB before each allocation, so that every
+// allocation takes the slow path and refills the TLAB. The sampled
+// times include the collections that the refills trigger.
+class TLABRefillOp : public MicroBenchOp {
+  JavaThread* _thread;
+ public:
+  TLABRefillOp(JavaThread* thread) : _thread(thread) {}
+  virtual void run() {
+    JavaThread* THREAD = _thread;
+    for (size_t i = 0; i < bench_tlab_refills; i++) {
+      _thread->tlab().retire();
+      oopFactory::new_intArray(1, THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        CLEAR_PENDING_EXCEPTION;
+        return;
+      }
+    }
+  }
+};
+
+BENCH_VM(ThreadLocalAllocBuffer, refill) {
+  if (!UseTLAB) {
+    return;
+  }
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  TLABRefillOp op(THREAD);
+  MicroBench::run("ThreadLocalAllocBuffer.refill", bench_tlab_refills, &op);
+}
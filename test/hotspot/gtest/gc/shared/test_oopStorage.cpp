@@ -399,6 +399,53 @@ TEST_VM_F(OopStorageTest, allocate_many) {
   }
 }
 
+TEST_VM_F(OopStorageTest, bulk_allocation) {
+  static const size_t max_entries = 1000;
+  static const size_t zero = 0;
+  oop* entries[max_entries] = {};
+
+  AllocationList& allocation_list = TestAccess::allocation_list(_storage);
+
+  EXPECT_EQ(0u, empty_block_count(_storage));
+  size_t allocated = _storage.allocate(entries, max_entries);
+  ASSERT_NE(allocated, zero);
+  // All entries come from a single block, which is now full.
+  EXPECT_EQ(allocated, _storage.allocation_count());
+  EXPECT_EQ(1u, active_count(_storage));
+  EXPECT_EQ(1u, _storage.block_count());
+  EXPECT_TRUE(is_list_empty(allocation_list));
+  const OopBlock* block = TestAccess::active_array(_storage).at(0);
+  EXPECT_TRUE(TestAccess::block_is_full(*block));
+  EXPECT_EQ(allocated, TestAccess::block_allocation_count(*block));
+  for (size_t i = 0; i < max_entries; ++i) {
+    if (i < allocated) {
+      ASSERT_TRUE(entries[i] != NULL);
+      EXPECT_TRUE(*entries[i] == NULL);
+    } else {
+      EXPECT_TRUE(entries[i] == NULL);
+    }
+  }
+
+  // A request smaller than a block is satisfied in full from a new block.
+  static const size_t small = 3;
+  oop* more[small] = {};
+  EXPECT_EQ(small, _storage.allocate(more, small));
+  EXPECT_EQ(allocated + small, _storage.allocation_count());
+  EXPECT_EQ(2u, _storage.block_count());
+  EXPECT_EQ(1u, list_length(allocation_list));
+  const OopBlock* second = allocation_list.chead();
+  EXPECT_NE(block, second);
+  EXPECT_FALSE(TestAccess::block_is_full(*second));
+  EXPECT_EQ(small, TestAccess::block_allocation_count(*second));
+
+  _storage.release(entries, allocated);
+  _storage.release(more, small);
+  process_deferred_updates(_storage);
+  EXPECT_EQ(0u, _storage.allocation_count());
+  EXPECT_EQ(2u, list_length(allocation_list));
+  EXPECT_EQ(2u, empty_block_count(_storage));
+}
+
 TEST_VM_F(OopStorageTestWithAllocation, random_release) {
   static const size_t step = 11;
   ASSERT_NE(0u, _max_entries % step); // max_entries and step are mutually prime
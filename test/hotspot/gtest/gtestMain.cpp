@@ -36,6 +36,7 @@
 #endif
 
 #include "jni.h"
+#include "microbench.hpp"
 #include "unittest.hpp"
 
 // Default value for -new-thread option: true on AIX because we run into
@@ -157,6 +158,23 @@ static bool get_spawn_new_main_thread_arg(int argc, char** argv) {
   return DEFAULT_SPAWN_IN_NEW_THREAD;
 }
 
+static void get_bench_args(int argc, char** argv) {
+  // -bench, -bench-warmup=<n>, -bench-samples=<n>, -bench-json=<file>
+  for (int i = 0; i < argc; i++) {
+    if (strcmp(argv[i], "-bench") == 0) {
+      MicroBench::enabled = true;
+    } else if (is_prefix("-bench-warmup=", argv[i])) {
+      MicroBench::warmup = atoi(argv[i] + strlen("-bench-warmup="));
+    } else if (is_prefix("-bench-samples=", argv[i])) {
+      MicroBench::samples = atoi(argv[i] + strlen("-bench-samples="));
+    } else if (is_prefix("-bench-json=", argv[i])) {
+      MicroBench::json_file = argv[i] + strlen("-bench-json=");
+    } else if (is_prefix("-bench", argv[i])) {
+      fprintf(stderr, "Invalid benchmark option (%s)\n", argv[i]);
+    }
+  }
+}
+
 static int num_args_to_skip(char* arg) {
   if (strcmp(arg, "-jdk") == 0) {
     return 2; // skip the argument after -jdk as well
@@ -170,6 +188,9 @@ static int num_args_to_skip(char* arg) {
   if (is_prefix("-new-thread", arg)) {
     return 1;
   }
+  if (is_prefix("-bench", arg)) {
+    return 1;
+  }
   return 0;
 }
 
@@ -237,6 +258,7 @@ static void runUnitTestsInner(int argc, char** argv) {
   sprintf_s(envString, len, "%s=%s", java_home_var, java_home);
   _putenv(envString);
 #endif // _WIN32
+  get_bench_args(argc, argv);
   argv = remove_test_runner_arguments(&argc, argv);
 
   if (is_vmassert_test || is_othervm_test) {
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "logTestFixture.hpp"
+#include "logTestUtils.inline.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logDecorations.hpp"
+#include "logging/logFileOutput.hpp"
+#include "logging/logTagSet.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/globals.hpp"
+#include "unittest.hpp"
+#include "utilities/ostream.hpp"
+
+static const LogTagSet& tagset = LogTagSetMapping<LOG_TAGS(logging)>::tagset();
+
+// The writer threads of these tests are never started; the tests write
+// the pending messages out themselves.
+class AsyncLogWriterTest : public LogTestFixture {
+ protected:
+  AsyncLogWriter* _writer;
+  LogFileOutput*  _output;
+
+  AsyncLogWriterTest() : _writer(new AsyncLogWriter()), _output(NULL) {
+    ResourceMark rm;
+    char* name = prepend_prefix_temp_dir("file=", "async_log_writer_test.log");
+    _output = new LogFileOutput(name);
+    os::free(name);
+    stringStream ss;
+    EXPECT_TRUE(_output->initialize("", &ss)) << ss.as_string();
+  }
+
+  ~AsyncLogWriterTest() {
+    _writer->write_pending(false);
+    delete _writer;
+    const char* file_name = os::strdup(_output->cur_log_file_name());
+    delete _output;
+    delete_file(file_name);
+    os::free((void*)file_name);
+  }
+
+  bool enqueue(const char* msg) {
+    LogDecorations decorations(LogLevel::Info, tagset, LogDecorators());
+    return _writer->enqueue(_output, decorations, msg);
+  }
+
+  void write_pending() { _writer->write_pending(false); }
+  void stop()          { _writer->write_pending(true); }
+
+  bool output_contains(const char* substr) {
+    return file_contains_substring(_output->cur_log_file_name(), substr);
+  }
+};
+
+TEST_VM_F(AsyncLogWriterTest, write_pending) {
+  EXPECT_TRUE(enqueue("first async message"));
+  EXPECT_TRUE(enqueue("second async message"));
+  EXPECT_FALSE(output_contains("first async message"));
+
+  write_pending();
+  EXPECT_TRUE(output_contains("first async message"));
+  EXPECT_TRUE(output_contains("second async message"));
+}
+
+TEST_VM_F(AsyncLogWriterTest, drop_when_full) {
+  size_t saved = AsyncLogBufferSize;
+  AsyncLogBufferSize = 1;
+  EXPECT_TRUE(enqueue("dropped async message"));
+  EXPECT_TRUE(enqueue("dropped async message"));
+  AsyncLogBufferSize = saved;
+
+  EXPECT_TRUE(enqueue("async message after the gap"));
+  write_pending();
+  const char* expected[] = { "[2 messages dropped due to async logging]",
+                             "async message after the gap", NULL };
+  EXPECT_TRUE(file_contains_substrings_in_order(_output->cur_log_file_name(), expected));
+  EXPECT_FALSE(output_contains("dropped async message"));
+}
+
+TEST_VM_F(AsyncLogWriterTest, stop) {
+  EXPECT_TRUE(enqueue("async message before stop"));
+  stop();
+  EXPECT_TRUE(output_contains("async message before stop"));
+  // The caller writes the message itself from now on.
+  EXPECT_FALSE(enqueue("async message after stop"));
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.hpp"
+#include "memory/arena.hpp"
+#include "runtime/thread.hpp"
+#include "unittest.hpp"
+
+static Chunk* new_chunk(size_t length) {
+  return new (AllocFailStrategy::EXIT_OOM, length) Chunk(length);
+}
+
+static void test_cached(size_t length) {
+  ChunkCache* cache = Thread::current()->chunk_cache();
+
+  // Taking a chunk empties the cache slot for its size.
+  Chunk* c1 = new_chunk(length);
+  EXPECT_FALSE(cache->contains(c1));
+  delete c1;
+  EXPECT_TRUE(cache->contains(c1));
+
+  Chunk* c2 = new_chunk(length);
+  EXPECT_EQ(c1, c2);
+  EXPECT_FALSE(cache->contains(c2));
+  delete c2;
+}
+
+static void test_not_cached(size_t length) {
+  ChunkCache* cache = Thread::current()->chunk_cache();
+  Chunk* c = new_chunk(length);
+  delete c;
+  EXPECT_FALSE(cache->contains(c));
+}
+
+TEST_VM(ChunkCache, small_chunks_are_cached) {
+  test_cached(Chunk::init_size);
+  test_cached(Chunk::tiny_size);
+}
+
+TEST_VM(ChunkCache, large_chunks_are_not_cached) {
+  test_not_cached(Chunk::size);
+  test_not_cached(Chunk::medium_size);
+  test_not_cached(Chunk::non_pool_size);
+}
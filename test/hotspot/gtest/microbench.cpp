@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "microbench.hpp"
+
+bool MicroBench::enabled = false;
+int MicroBench::warmup = 5;
+int MicroBench::samples = 50;
+const char* MicroBench::json_file = NULL;
+
+static int compare_sample(jlong a, jlong b) {
+  return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+static double sample_ns_per_op(const jlong* sorted, int count, int percent, size_t ops) {
+  return (double)sorted[((count - 1) * percent) / 100] / (double)ops;
+}
+
+void MicroBench::run(const char* name, size_t ops_per_sample, MicroBenchOp* op) {
+  assert(ops_per_sample > 0, "must measure something");
+  const int count = MAX2(samples, 1);
+
+  for (int i = 0; i < warmup; i++) {
+    op->run();
+  }
+
+  jlong* times = NEW_C_HEAP_ARRAY(jlong, count, mtTest);
+  jlong total = 0;
+  for (int i = 0; i < count; i++) {
+    jlong start = os::javaTimeNanos();
+    op->run();
+    times[i] = os::javaTimeNanos() - start;
+    total += times[i];
+  }
+  QuickSort::sort(times, count, compare_sample, false);
+
+  stringStream result;
+  result.print("{\"benchmark\":\"%s\",\"ops_per_sample\":" SIZE_FORMAT ",\"samples\":%d,"
+               "\"ns_per_op\":{\"min\":%.3f,\"mean\":%.3f,\"p50\":%.3f,"
+               "\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f}}",
+               name, ops_per_sample, count,
+               sample_ns_per_op(times, count, 0, ops_per_sample),
+               (double)total / ((double)count * (double)ops_per_sample),
+               sample_ns_per_op(times, count, 50, ops_per_sample),
+               sample_ns_per_op(times, count, 90, ops_per_sample),
+               sample_ns_per_op(times, count, 99, ops_per_sample),
+               sample_ns_per_op(times, count, 100, ops_per_sample));
+  FREE_C_HEAP_ARRAY(jlong, times);
+
+  tty->print_cr("%s", result.base());
+  if (json_file != NULL) {
+    fileStream out(json_file, "a");
+    if (out.is_open()) {
+      out.print_cr("%s", result.base());
+    } else {
+      tty->print_cr("Could not open %s for benchmark results", json_file);
+    }
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef MICROBENCH_HPP
+#define MICROBENCH_HPP
+
+#include "jni.h"
+
+// Support for microbenchmarks of VM internals.
+//
+// A benchmark is an ordinary TEST_VM declared with BENCH_VM.  It returns
+// immediately unless the launcher was started with -bench, so benchmarks
+// cost nothing in regular test runs.  Launcher options:
+//
+//   -bench                  run benchmark bodies (select them with
+//                           --gtest_filter=*_bench_test_vm)
+//   -bench-warmup=<n>       untimed samples before measuring (default 5)
+//   -bench-samples=<n>      timed samples (default 50)
+//   -bench-json=<file>      append one JSON object per benchmark to file
+//
+// Each sample runs MicroBenchOp::run once, which should perform the
+// operation being measured ops_per_sample times.  Results are reported in
+// nanoseconds per operation as min, mean, p50, p90, p99 and max over the
+// timed samples.
+
+class MicroBenchOp {
+ public:
+  virtual void run() = 0;
+};
+
+class MicroBench {
+ public:
+  // Launcher options, set before any test runs.
+  static bool enabled;
+  static int warmup;
+  static int samples;
+  static const char* json_file;
+
+  static void run(const char* name, size_t ops_per_sample, MicroBenchOp* op);
+};
+
+#define BENCH_VM(category, name)                                    \
+  static void bench_ ## category ## _ ## name ## _();               \
+                                                                    \
+  TEST_VM(category, CONCAT(name, _bench)) {                         \
+    if (MicroBench::enabled) {                                      \
+      bench_ ## category ## _ ## name ## _();                       \
+    }                                                               \
+  }                                                                 \
+                                                                    \
+  static void bench_ ## category ## _ ## name ## _()
+
+#endif // MICROBENCH_HPP
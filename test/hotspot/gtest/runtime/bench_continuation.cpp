@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/oopFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/oop.inline.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "oops/typeArrayOop.inline.hpp"
+#include "runtime/continuation.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/copy.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "microbench.hpp"
+#include "unittest.hpp"
+
+const int bench_continuation_round_trips = 16;
+
+// Copies words of stack into a long[] and its oops into an Object[], as
+// freeze does, and back, as thaw does. Every stride-th word holds an oop;
+// a stride of 0 means none do. The Java frames a continuation freezes need
+// the doYield/doContinue stubs and a java.lang.Continuation, which the
+// runtime/Continuation jtreg tests provide; this measures the part of the
+// cost that depends only on the stack size and oop density.
+class FreezeThawCopyOp : public MicroBenchOp {
+  int _words;
+  intptr_t* _frames;
+  ResourceBitMap _oop_bits;
+  ResourceBitMap _narrow_bits;
+  typeArrayHandle _stack;
+  objArrayHandle _refs;
+ public:
+  FreezeThawCopyOp(JavaThread* thread, int words, int stride, oop obj) :
+    _words(words),
+    _frames(NEW_C_HEAP_ARRAY(intptr_t, words, mtTest)),
+    _oop_bits(Continuation::oop_bitmap_bits(words)),
+    _narrow_bits(Continuation::oop_bitmap_bits(words)) {
+    int oops = 0;
+    for (int i = 0; i < words; i++) {
+      if (stride != 0 && i % stride == 0) {
+        _frames[i] = cast_from_oop<intptr_t>(obj);
+        _oop_bits.set_bit(Continuation::oop_bitmap_bits(i));
+        oops++;
+      } else {
+        _frames[i] = i;
+      }
+    }
+    _stack = typeArrayHandle(thread, oopFactory::new_longArray(words, thread));
+    _refs = objArrayHandle(thread, oopFactory::new_objArray(SystemDictionary::Object_klass(), oops, thread));
+  }
+
+  ~FreezeThawCopyOp() {
+    FREE_C_HEAP_ARRAY(intptr_t, _frames);
+  }
+
+  virtual void run() {
+    for (int i = 0; i < bench_continuation_round_trips; i++) {
+      Copy::disjoint_words((HeapWord*)_frames, (HeapWord*)_stack->long_at_addr(0), _words);
+      Continuation::save_oops(_oop_bits, _narrow_bits, 0, _oop_bits.size(), _frames, _refs(), 0);
+      Copy::disjoint_words((HeapWord*)_stack->long_at_addr(0), (HeapWord*)_frames, _words);
+      Continuation::restore_oops(_oop_bits, _narrow_bits, 0, _oop_bits.size(), _frames, _refs(), 0);
+    }
+  }
+};
+
+static void bench_freeze_thaw_copy(const char* name, int words, int stride) {
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  ResourceMark rm(THREAD);
+  HandleMark hm(THREAD);
+  // No safepoint can move the object while the op holds it in _frames.
+  FreezeThawCopyOp op(THREAD, words, stride, SystemDictionary::Object_klass()->java_mirror());
+  MicroBench::run(name, bench_continuation_round_trips, &op);
+}
+
+BENCH_VM(Continuation, freeze_thaw_copy_small) {
+  bench_freeze_thaw_copy("Continuation.freeze_thaw_copy_small", 64, 0);
+}
+
+BENCH_VM(Continuation, freeze_thaw_copy_small_oops) {
+  bench_freeze_thaw_copy("Continuation.freeze_thaw_copy_small_oops", 64, 4);
+}
+
+BENCH_VM(Continuation, freeze_thaw_copy_large) {
+  bench_freeze_thaw_copy("Continuation.freeze_thaw_copy_large", 4096, 0);
+}
+
+BENCH_VM(Continuation, freeze_thaw_copy_large_oops) {
+  bench_freeze_thaw_copy("Continuation.freeze_thaw_copy_large_oops", 4096, 4);
+}
+
+BENCH_VM(Continuation, freeze_thaw_copy_large_dense_oops) {
+  bench_freeze_thaw_copy("Continuation.freeze_thaw_copy_large_dense_oops", 4096, 1);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/jniHandles.inline.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "microbench.hpp"
+#include "unittest.hpp"
+
+const size_t bench_jni_handles = 1024;
+
+// Creates bench_jni_handles global (or weak global) handles to the same
+// object and then destroys them, the pattern of native code that caches
+// references only briefly.
+class JNIGlobalHandleOp : public MicroBenchOp {
+  Handle _obj;
+  bool _weak;
+  jobject _handles[bench_jni_handles];
+ public:
+  JNIGlobalHandleOp(Handle obj, bool weak) : _obj(obj), _weak(weak) {}
+  virtual void run() {
+    if (_weak) {
+      for (size_t i = 0; i < bench_jni_handles; i++) {
+        _handles[i] = JNIHandles::make_weak_global(_obj);
+      }
+      for (size_t i = 0; i < bench_jni_handles; i++) {
+        JNIHandles::destroy_weak_global(_handles[i]);
+      }
+    } else {
+      for (size_t i = 0; i < bench_jni_handles; i++) {
+        _handles[i] = JNIHandles::make_global(_obj);
+      }
+      for (size_t i = 0; i < bench_jni_handles; i++) {
+        JNIHandles::destroy_global(_handles[i]);
+      }
+    }
+  }
+};
+
+BENCH_VM(JNIHandles, global_create_destroy) {
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  HandleMark hm(THREAD);
+  Handle obj(THREAD, SystemDictionary::Object_klass()->java_mirror());
+  JNIGlobalHandleOp op(obj, false);
+  MicroBench::run("JNIHandles.global_create_destroy", bench_jni_handles, &op);
+}
+
+BENCH_VM(JNIHandles, weak_global_create_destroy) {
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  HandleMark hm(THREAD);
+  Handle obj(THREAD, SystemDictionary::Object_klass()->java_mirror());
+  JNIGlobalHandleOp op(obj, true);
+  MicroBench::run("JNIHandles.weak_global_create_destroy", bench_jni_handles, &op);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "microbench.hpp"
+#include "unittest.hpp"
+
+typedef BitMap::idx_t idx_t;
+
+static const idx_t bench_bitmap_size = 1024 * 1024;
+
+// Results are stored here so the measured work cannot be optimized away.
+static volatile idx_t bench_bitmap_sink = 0;
+
+class BitMapSearchOp : public MicroBenchOp {
+  const CHeapBitMap& _map;
+ public:
+  BitMapSearchOp(const CHeapBitMap& map) : _map(map) {}
+  virtual void run() {
+    idx_t found = 0;
+    for (idx_t i = _map.get_next_one_offset(0);
+         i < _map.size();
+         i = _map.get_next_one_offset(i + 1)) {
+      found++;
+    }
+    bench_bitmap_sink = found;
+  }
+};
+
+class BitMapCountOp : public MicroBenchOp {
+  const CHeapBitMap& _map;
+ public:
+  BitMapCountOp(const CHeapBitMap& map) : _map(map) {}
+  virtual void run() {
+    bench_bitmap_sink = _map.count_one_bits();
+  }
+};
+
+BENCH_VM(BitMap, search_sparse) {
+  const idx_t stride = 4096;
+  CHeapBitMap map(bench_bitmap_size, mtTest);
+  for (idx_t i = 0; i < bench_bitmap_size; i += stride) {
+    map.set_bit(i);
+  }
+  BitMapSearchOp op(map);
+  MicroBench::run("BitMap.get_next_one_offset.sparse", bench_bitmap_size / stride, &op);
+}
+
+BENCH_VM(BitMap, search_dense) {
+  const idx_t stride = 3;
+  CHeapBitMap map(bench_bitmap_size, mtTest);
+  for (idx_t i = 0; i < bench_bitmap_size; i += stride) {
+    map.set_bit(i);
+  }
+  BitMapSearchOp op(map);
+  MicroBench::run("BitMap.get_next_one_offset.dense", bench_bitmap_size / stride + 1, &op);
+}
+
+BENCH_VM(BitMap, count_one_bits) {
+  CHeapBitMap map(bench_bitmap_size, mtTest);
+  for (idx_t i = 0; i < bench_bitmap_size; i += 7) {
+    map.set_bit(i);
+  }
+  BitMapCountOp op(map);
+  MicroBench::run("BitMap.count_one_bits.word", BitMap::calc_size_in_words(map.size()), &op);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "microbench.hpp"
+#include "unittest.hpp"
+
+struct BenchCHTConfig : public AllStatic {
+  typedef uintptr_t Value;
+  static uintx get_hash(const Value& value, bool* dead_hash) {
+    return (uintx)value;
+  }
+  static void* allocate_node(size_t size, const Value& value) {
+    return AllocateHeap(size, mtTest);
+  }
+  static void free_node(void* memory, const Value& value) {
+    FreeHeap(memory);
+  }
+};
+
+typedef ConcurrentHashTable<BenchCHTConfig, mtTest> BenchCHTTable;
+
+struct BenchCHTLookup {
+  uintptr_t _val;
+  BenchCHTLookup(uintptr_t val) : _val(val) {}
+  uintx get_hash() {
+    return BenchCHTConfig::get_hash(_val, NULL);
+  }
+  bool equals(const uintptr_t* value, bool* is_dead) {
+    return _val == *value;
+  }
+};
+
+struct BenchCHTFound {
+  uintptr_t _value;
+  BenchCHTFound() : _value(0) {}
+  void operator()(uintptr_t* value) {
+    _value = *value;
+  }
+};
+
+static const size_t bench_cht_log2_size = 14;
+static const uintptr_t bench_cht_entries = (uintptr_t)1 << bench_cht_log2_size;
+
+// Results are stored here so the measured work cannot be optimized away.
+static volatile uintptr_t bench_cht_sink = 0;
+
+// Looks up every key in the table, all of which are present.
+class CHTGetOp : public MicroBenchOp {
+  BenchCHTTable* _table;
+  Thread* _thread;
+ public:
+  CHTGetOp(BenchCHTTable* table, Thread* thread) : _table(table), _thread(thread) {}
+  virtual void run() {
+    uintptr_t sum = 0;
+    for (uintptr_t v = 1; v <= bench_cht_entries; v++) {
+      BenchCHTLookup lookup(v);
+      BenchCHTFound found;
+      _table->get(_thread, lookup, found);
+      sum += found._value;
+    }
+    bench_cht_sink = sum;
+  }
+};
+
+BENCH_VM(ConcurrentHashTable, get) {
+  Thread* thread = Thread::current();
+  BenchCHTTable* table = new BenchCHTTable(bench_cht_log2_size);
+  for (uintptr_t v = 1; v <= bench_cht_entries; v++) {
+    BenchCHTLookup lookup(v);
+    table->insert(thread, lookup, v);
+  }
+  CHTGetOp op(table, thread);
+  MicroBench::run("ConcurrentHashTable.get", bench_cht_entries, &op);
+  delete table;
+}
@@ -75,3 +75,29 @@ TEST(population_count, sparse) {
   EXPECT_EQ(31u, population_count(UINT_MAX - 1))
       << "value = " << (UINT_MAX - 1);
 }
+
+TEST(population_count, sparse64) {
+  // Combine two sparse 32-bit values into each 64-bit value, and check
+  // against the sum of the 32-bit population counts
+  uint32_t step = 4711;
+  for (uint32_t value = os::random() % step; value < UINT_MAX - step; value += step) {
+    uint32_t high = value * 2654435761u;
+    uint64_t value64 = ((uint64_t)high << 32) | value;
+    EXPECT_EQ(population_count(high) + population_count(value), population_count(value64))
+        << "value = " << value64;
+  }
+
+  // Test a few edge cases
+  EXPECT_EQ(0u, population_count((uint64_t)0))
+      << "value = " << 0;
+  EXPECT_EQ(1u, population_count((uint64_t)1))
+      << "value = " << 1;
+  EXPECT_EQ(1u, population_count((uint64_t)UCONST64(0x8000000000000000)))
+      << "value = " << UCONST64(0x8000000000000000);
+  EXPECT_EQ(32u, population_count((uint64_t)UINT_MAX << 32))
+      << "value = " << ((uint64_t)UINT_MAX << 32);
+  EXPECT_EQ(64u, population_count((uint64_t)max_julong))
+      << "value = " << max_julong;
+  EXPECT_EQ(63u, population_count((uint64_t)(max_julong - 1)))
+      << "value = " << (max_julong - 1);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Sampled branch profiling in tier 3 code must not change the
+ *          outcome of the profiled branches.
+ * @requires vm.compiler1.enabled
+ *
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3
+ *      -XX:C1ProfileSampleRate=1
+ *      compiler.c1.TestProfileSampleRate
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3
+ *      -XX:C1ProfileSampleRate=16
+ *      compiler.c1.TestProfileSampleRate
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3
+ *      -XX:C1ProfileSampleRate=1000
+ *      compiler.c1.TestProfileSampleRate
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3
+ *      -XX:CompileCommand=option,compiler.c1.TestProfileSampleRate::*,intx,C1ProfileSampleRate,8
+ *      compiler.c1.TestProfileSampleRate
+ */
+
+package compiler.c1;
+
+public class TestProfileSampleRate {
+    static final int ITERATIONS = 20_000;
+
+    static int countInts(int[] a, int pivot) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] < pivot) {
+                n += 1;
+            } else if (a[i] == pivot) {
+                n += 100;
+            }
+        }
+        return n;
+    }
+
+    static int countLongs(long[] a, long pivot) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] <= pivot) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    static int countFloats(float[] a, float pivot) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] > pivot) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    static int countDoubles(double[] a, double pivot) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] >= pivot) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    static int countRefs(Object[] a, Object o) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] == null) {
+                n += 1;
+            } else if (a[i] != o) {
+                n += 100;
+            }
+        }
+        return n;
+    }
+
+    static int run(int[] ints, long[] longs, float[] floats, double[] doubles, Object[] refs) {
+        return countInts(ints, 50)
+               + 3 * countLongs(longs, 1L << 40)
+               + 5 * countFloats(floats, 0.5f)
+               + 7 * countDoubles(doubles, 0.25)
+               + 11 * countRefs(refs, refs[0]);
+    }
+
+    public static void main(String[] args) {
+        int[] ints = new int[100];
+        long[] longs = new long[100];
+        float[] floats = new float[100];
+        double[] doubles = new double[100];
+        Object[] refs = new Object[100];
+        Object shared = new Object();
+        for (int i = 0; i < 100; i++) {
+            ints[i] = (i * 37) % 101;
+            longs[i] = (long)i << (i % 48);
+            floats[i] = (i % 7) / 7.0f;
+            doubles[i] = (i % 5) / 5.0;
+            refs[i] = (i % 3 == 0) ? null : (i % 3 == 1 ? shared : new Object());
+        }
+        refs[0] = shared;
+
+        // The first run is interpreted.
+        int expected = run(ints, longs, floats, doubles, refs);
+        for (int i = 0; i < ITERATIONS; i++) {
+            int result = run(ints, longs, floats, doubles, refs);
+            if (result != expected) {
+                throw new RuntimeException("iteration " + i + ": expected " + expected + " but got " + result);
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Write a compilation profile at exit and with Compiler.profile_dump,
+ *          and read it back with LoadCompilationProfile.
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ *
+ * @run driver compiler.profile.TestCompilationProfile
+ */
+
+package compiler.profile;
+
+import java.io.File;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.util.List;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCompilationProfile {
+    static final String HOT_METHOD = "compiler/profile/TestCompilationProfile$Workload hot (I)I";
+
+    public static class Workload {
+        static int hot(int x) {
+            return x * 31 + (x >>> 3);
+        }
+
+        public static void main(String[] args) {
+            int sum = 0;
+            for (int i = 0; i < 100_000; i++) {
+                sum += hot(i);
+            }
+            System.out.println("sum " + sum);
+        }
+    }
+
+    static OutputAnalyzer runWorkload(String... flags) throws Exception {
+        String[] args = new String[flags.length + 2];
+        args[0] = "-Xbatch";
+        System.arraycopy(flags, 0, args, 1, flags.length);
+        args[args.length - 1] = Workload.class.getName();
+        OutputAnalyzer output = ProcessTools.executeTestJvm(args);
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    static void testDumpAtExitAndLoad() throws Exception {
+        String profile = new File("exit.profile").getAbsolutePath();
+        runWorkload("-XX:DumpCompilationProfile=" + profile);
+
+        List<String> lines = Files.readAllLines(Paths.get(profile));
+        Asserts.assertTrue(lines.get(0).startsWith("#"), "missing header: " + lines.get(0));
+        Asserts.assertTrue(lines.stream().anyMatch(l -> l.matches("\\d " + Pattern.quote(HOT_METHOD))),
+                           HOT_METHOD + " not in " + profile);
+
+        OutputAnalyzer output = runWorkload("-XX:LoadCompilationProfile=" + profile,
+                                            "-Xlog:jit+compilation=info");
+        output.shouldMatch("Loaded [1-9]\\d* methods from compilation profile");
+
+        // A missing profile is reported, not fatal.
+        output = runWorkload("-XX:LoadCompilationProfile=" + profile + ".missing");
+        output.shouldContain("Could not open compilation profile");
+    }
+
+    static void testDumpCommand() throws Exception {
+        String profile = new File("dcmd.profile").getAbsolutePath();
+        OutputAnalyzer output = new JMXExecutor().execute("Compiler.profile_dump " + profile);
+        output.shouldContain("Compilation profile written to " + profile);
+
+        List<String> lines = Files.readAllLines(Paths.get(profile));
+        Asserts.assertTrue(lines.get(0).startsWith("#"), "missing header: " + lines.get(0));
+        for (String line : lines.subList(1, lines.size())) {
+            Asserts.assertTrue(line.matches("\\d \\S+ \\S+ \\S+"), "malformed line: " + line);
+        }
+
+        output = new JMXExecutor().execute("Compiler.profile_dump " + profile + File.separator + "x");
+        output.shouldContain("Could not open");
+    }
+
+    public static void main(String[] args) throws Exception {
+        testDumpAtExitAndLoad();
+        testDumpCommand();
+    }
+}
@@ -24,7 +24,7 @@
 
 /* @test
  * @bug 8167409
- * @requires (os.arch != "aarch64") & (os.arch != "arm")
+ * @requires os.arch != "arm"
  * @run main/othervm/native -Xcomp -XX:+CriticalJNINatives compiler.runtime.criticalnatives.argumentcorruption.CheckLongArgs
  */
 package compiler.runtime.criticalnatives.argumentcorruption;
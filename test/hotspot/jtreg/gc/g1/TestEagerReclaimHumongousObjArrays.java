@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestEagerReclaimHumongousObjArrays
+ * @summary Check that with G1EagerReclaimHumongousObjArrays dead humongous
+ * object arrays are reclaimed at young GC, and that the live ones and the
+ * objects they reference survive intact.
+ * @key gc
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run main gc.g1.TestEagerReclaimHumongousObjArrays
+ */
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+import static jdk.test.lib.Asserts.*;
+
+class TestEagerReclaimHumongousObjArraysApp {
+    static class Holder {
+        Object[] ref;
+    }
+
+    // Old gen object referencing a humongous array, generating
+    // remembered set entries for it.
+    static Holder fromOld = new Holder();
+
+    static Object[] newArray(int seed) {
+        // 4M elements are humongous with any region size.
+        Object[] a = new Object[4 * 1024 * 1024];
+        for (int i = 0; i < a.length; i += 1024) {
+            a[i] = Integer.valueOf(seed + i);
+        }
+        return a;
+    }
+
+    static void check(Object[] a, int seed) {
+        for (int i = 0; i < a.length; i += 1024) {
+            if (!Integer.valueOf(seed + i).equals(a[i])) {
+                throw new RuntimeException("Element " + i + " of array " + seed + " is " + a[i]);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        Object[] live = newArray(-1);
+        for (int i = 0; i < 40; i++) {
+            // Only the most recent array stays reachable, through an
+            // old gen object; the others die right away.
+            fromOld.ref = newArray(i);
+            for (int j = 0; j < 16 * 1024; j++) {
+                Object garbage = new int[100];
+            }
+            check(fromOld.ref, i);
+        }
+        check(live, -1);
+        System.out.println("Done");
+    }
+}
+
+public class TestEagerReclaimHumongousObjArrays {
+    static final Pattern DEAD_OBJ_ARRAY =
+        Pattern.compile("Dead humongous region \\d+ .* type array 0");
+
+    static OutputAnalyzer run(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xms256M",
+            "-Xmx256M",
+            "-Xmn16M",
+            "-XX:+UnlockExperimentalVMOptions",
+            flag,
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            "-Xlog:gc,gc+humongous=debug",
+            TestEagerReclaimHumongousObjArraysApp.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Done");
+        return output;
+    }
+
+    static int count(Pattern p, String s) {
+        int found = 0;
+        Matcher m = p.matcher(s);
+        while (m.find()) {
+            found++;
+        }
+        return found;
+    }
+
+    public static void main(String[] args) throws Exception {
+        OutputAnalyzer output = run("-XX:+G1EagerReclaimHumongousObjArrays");
+        assertGreaterThan(count(DEAD_OBJ_ARRAY, output.getStdout()), 0,
+                          "No humongous object array was eagerly reclaimed");
+        int fullGCs = count(Pattern.compile("Pause Full"), output.getStdout());
+        assertLessThan(fullGCs, 10, "Found " + fullGCs + " Full GCs, eager reclaim of object arrays does not seem to work");
+
+        output = run("-XX:-G1EagerReclaimHumongousObjArrays");
+        assertEquals(count(DEAD_OBJ_ARRAY, output.getStdout()), 0,
+                     "Humongous object arrays reclaimed although disabled");
+    }
+}
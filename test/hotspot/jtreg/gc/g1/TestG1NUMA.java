@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/**
+ * @test TestG1NUMA
+ * @requires vm.gc.G1
+ * @summary Verify that G1 with UseNUMA binds committed regions to nodes and
+ *          survives young and full collections.
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ * @modules java.management/sun.management
+ * @run main gc.g1.TestG1NUMA
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestG1NUMA {
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                                                                  "-XX:+UseNUMA",
+                                                                  "-Xlog:gc+heap=info,gc+heap+numa=trace",
+                                                                  "-Xmx128M",
+                                                                  GCTest.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Done");
+        // NUMA is only enabled on machines with more than one node.
+        if (output.getStdout().contains("NUMA enabled with")) {
+            output.shouldMatch("Request memory \\[0x\\p{XDigit}+, 0x\\p{XDigit}+\\) to be NUMA id \\(\\d+\\)");
+        }
+
+        pb = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                                                   "-XX:-UseNUMA",
+                                                   "-Xlog:gc+heap=info,gc+heap+numa=trace",
+                                                   "-Xmx128M",
+                                                   GCTest.class.getName());
+
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Done");
+        output.shouldNotContain("NUMA enabled with");
+        output.shouldNotContain("Request memory");
+    }
+
+    static class GCTest {
+        public static Object sink;
+
+        public static void main(String [] args) throws Exception {
+            // Fill eden several times over from a few threads, so that
+            // mutator and survivor alloc regions on every node get used.
+            Thread[] threads = new Thread[4];
+            for (int t = 0; t < threads.length; t++) {
+                threads[t] = new Thread(() -> {
+                    Object[] keep = new Object[64];
+                    for (int i = 0; i < 200_000; i++) {
+                        Object o = new byte[1024];
+                        keep[i % keep.length] = o;
+                        sink = o;
+                    }
+                });
+                threads[t].start();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+            System.gc();
+            System.out.println("Done");
+        }
+    }
+}
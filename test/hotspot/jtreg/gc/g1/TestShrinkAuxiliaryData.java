@@ -243,7 +243,7 @@ public class TestShrinkAuxiliaryData {
             System.gc();
 
             muFree = ManagementFactory.getMemoryMXBean().getHeapMemoryUsage();
-            muAuxDataFree = WhiteBox.getWhiteBox().g1AuxiliaryMemoryUsage();
+            muAuxDataFree = waitForAuxiliaryDataUncommit();
 
             numUsedRegions = WhiteBox.getWhiteBox().g1NumMaxRegions()
                     - WhiteBox.getWhiteBox().g1NumFreeRegions();
@@ -273,6 +273,28 @@ public class TestShrinkAuxiliaryData {
             }
         }
 
+        /**
+         * With -XX:+G1ConcurrentUncommit the auxiliary data of the regions the
+         * heap shrank by is uncommitted after the pause, so wait until its
+         * usage stops changing before measuring it.
+         */
+        private MemoryUsage waitForAuxiliaryDataUncommit() {
+            MemoryUsage prev = WhiteBox.getWhiteBox().g1AuxiliaryMemoryUsage();
+            for (int i = 0; i < 100; i++) {
+                try {
+                    Thread.sleep(100);
+                } catch (InterruptedException e) {
+                    throw new RuntimeException(e);
+                }
+                MemoryUsage cur = WhiteBox.getWhiteBox().g1AuxiliaryMemoryUsage();
+                if (cur.getCommitted() == prev.getCommitted()) {
+                    return cur;
+                }
+                prev = cur;
+            }
+            throw new RuntimeException("auxiliary data uncommit did not finish");
+        }
+
         private void allocate() {
             for (int r = 0; r < REGIONS_TO_ALLOCATE; r++) {
                 for (int i = 0; i < NUM_OBJECTS_PER_REGION; i++) {
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1.pinnedregions;
+
+/*
+ * @test TestPinnedRegions
+ * @summary Check that with G1UseRegionPinning objects pinned by JNI critical
+ * sections, and the other objects in their regions, survive young and full
+ * collections in place and intact.
+ * @key gc
+ * @requires vm.gc.G1
+ * @run main/othervm/native -XX:+UseG1GC -Xmx128m -Xmn8m
+ *      -XX:+UnlockExperimentalVMOptions -XX:+G1UseRegionPinning
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *      -Xlog:gc,gc+cset=debug
+ *      gc.g1.pinnedregions.TestPinnedRegions
+ * @run main/othervm/native -XX:+UseG1GC -Xmx128m -Xmn8m
+ *      -XX:+UnlockExperimentalVMOptions -XX:+G1UseRegionPinning
+ *      -XX:+G1FullGCCompactHumongousObjects
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      gc.g1.pinnedregions.TestPinnedRegions
+ */
+
+public class TestPinnedRegions {
+    static {
+        System.loadLibrary("TestPinnedRegions");
+    }
+
+    private static final int NUM_RUNS = 20;
+    private static final int NEIGHBORS = 1_000;
+
+    // Returns the address of the elements of a, which stays pinned until unpin.
+    private static native long pin(int[] a);
+    private static native void unpin(int[] a, long addr);
+    // Stores value at index of the pinned elements at addr.
+    private static native void store(long addr, int index, int value);
+
+    public static Object sink;
+
+    static void allocateGarbage(int count) {
+        for (int i = 0; i < count; i++) {
+            sink = new int[64];
+        }
+    }
+
+    static void check(boolean condition, String message) {
+        if (!condition) {
+            throw new RuntimeException(message);
+        }
+    }
+
+    static void test(int run, boolean humongous, boolean fullGC) {
+        // Objects allocated right before and after the pinned array end up
+        // in the same region and must survive with it.
+        Integer[] before = new Integer[NEIGHBORS];
+        for (int i = 0; i < NEIGHBORS; i++) {
+            before[i] = Integer.valueOf(run * NEIGHBORS + i);
+        }
+        int[] pinned = new int[humongous ? 2 * 1024 * 1024 : 128];
+        for (int i = 0; i < pinned.length; i += 16) {
+            pinned[i] = i;
+        }
+        Integer[] after = new Integer[NEIGHBORS];
+        for (int i = 0; i < NEIGHBORS; i++) {
+            after[i] = Integer.valueOf(-(run * NEIGHBORS + i));
+        }
+
+        long addr = pin(pinned);
+        try {
+            // Several young collections, with the pinned array young at first.
+            allocateGarbage(500_000);
+            if (fullGC) {
+                System.gc();
+            }
+            allocateGarbage(200_000);
+
+            // Had the array been moved, the store would not be visible.
+            store(addr, 1, 4711 + run);
+            check(pinned[1] == 4711 + run, "pinned array moved in run " + run);
+        } finally {
+            unpin(pinned, addr);
+        }
+
+        for (int i = 0; i < pinned.length; i += 16) {
+            check(pinned[i] == i, "pinned array element " + i + " is " + pinned[i]);
+        }
+        for (int i = 0; i < NEIGHBORS; i++) {
+            check(before[i].intValue() == run * NEIGHBORS + i, "neighbor before lost in run " + run);
+            check(after[i].intValue() == -(run * NEIGHBORS + i), "neighbor after lost in run " + run);
+        }
+
+        // Unpinned, the region can be evacuated again.
+        allocateGarbage(200_000);
+        System.gc();
+        check(pinned[1] == 4711 + run, "pinned array corrupted after unpin in run " + run);
+    }
+
+    public static void main(String[] args) {
+        for (int run = 0; run < NUM_RUNS; run++) {
+            test(run, false, false);
+            test(run, false, true);
+            test(run, true, true);
+        }
+    }
+}
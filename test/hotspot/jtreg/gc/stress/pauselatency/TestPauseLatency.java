@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.stress.pauselatency;
+
+/*
+ * @test TestPauseLatencySerial
+ * @summary Report GC pause and safepoint latency distributions for a controlled workload
+ * @key gc stress
+ * @requires vm.gc.Serial
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver/timeout=600 gc.stress.pauselatency.TestPauseLatency -XX:+UseSerialGC
+ */
+
+/*
+ * @test TestPauseLatencyParallel
+ * @key gc stress
+ * @requires vm.gc.Parallel
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver/timeout=600 gc.stress.pauselatency.TestPauseLatency -XX:+UseParallelGC
+ */
+
+/*
+ * @test TestPauseLatencyG1
+ * @key gc stress
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver/timeout=600 gc.stress.pauselatency.TestPauseLatency -XX:+UseG1GC
+ */
+
+/*
+ * @test TestPauseLatencyShenandoah
+ * @key gc stress
+ * @requires vm.gc.Shenandoah & !vm.graal.enabled
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver/timeout=600 gc.stress.pauselatency.TestPauseLatency -XX:+UnlockExperimentalVMOptions -XX:+UseShenandoahGC
+ */
+
+/*
+ * @test TestPauseLatencyZ
+ * @key gc stress
+ * @requires vm.gc.Z & !vm.graal.enabled
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver/timeout=600 gc.stress.pauselatency.TestPauseLatency -XX:+UnlockExperimentalVMOptions -XX:+UseZGC
+ */
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+/**
+ * Runs an allocation workload with the given collector options and
+ * summarizes the pause times found in its unified logging output.
+ *
+ * The workload shape is controlled with system properties passed to the
+ * driver (for example with jtreg -vmoption:-Dpauselatency.threads=16):
+ *
+ *   pauselatency.threads       allocating threads (default 4)
+ *   pauselatency.allocRateMB   total allocation rate in MB/s, 0 for
+ *                              unthrottled (default 200)
+ *   pauselatency.liveSetMB     retained live set in MB (default 64)
+ *   pauselatency.objectSize    size of each allocated byte[] (default 64)
+ *   pauselatency.durationSec   run time of the workload (default 20)
+ *   pauselatency.heapMB        -Xms and -Xmx of the workload (default 512)
+ *   pauselatency.maxP99Ms      if set, fail when the p99 GC pause or
+ *                              safepoint time exceeds this many ms
+ *
+ * The report lists count, p50, p90, p99 and max in milliseconds for GC
+ * pauses (gc and gc+phases "Pause" lines), total safepoint time and
+ * time to reach the safepoint, plus total safepoint time per VM operation.
+ */
+public class TestPauseLatency {
+
+    private static final Pattern GC_PAUSE =
+        Pattern.compile("\\[gc(?:,phases)?\\s*\\].* (Pause [^(\\d]*[^(\\d\\s]).* (\\d+\\.\\d+)ms$");
+    private static final Pattern SAFEPOINT =
+        Pattern.compile("Safepoint \"([^\"]+)\", Time since last: \\d+ ns, " +
+                        "Reaching safepoint: (\\d+) ns, At safepoint: \\d+ ns, Total: (\\d+) ns");
+
+    private static int intProperty(String name, int defaultValue) {
+        return Integer.getInteger("pauselatency." + name, defaultValue);
+    }
+
+    public static void main(String[] args) throws Exception {
+        List<String> vmOpts = new ArrayList<>();
+        for (String arg : args) {
+            vmOpts.add(arg);
+        }
+        int heapMB = intProperty("heapMB", 512);
+        vmOpts.add("-Xms" + heapMB + "m");
+        vmOpts.add("-Xmx" + heapMB + "m");
+        vmOpts.add("-Xlog:gc,gc+phases=info,safepoint=info:stdout:uptime,tags");
+        vmOpts.add(Workload.class.getName());
+        vmOpts.add(Integer.toString(intProperty("threads", 4)));
+        vmOpts.add(Integer.toString(intProperty("allocRateMB", 200)));
+        vmOpts.add(Integer.toString(intProperty("liveSetMB", 64)));
+        vmOpts.add(Integer.toString(intProperty("objectSize", 64)));
+        vmOpts.add(Integer.toString(intProperty("durationSec", 20)));
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(vmOpts.toArray(new String[vmOpts.size()]));
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        Map<String, List<Double>> gcPauses = new LinkedHashMap<>();
+        Map<String, List<Double>> vmOps = new LinkedHashMap<>();
+        List<Double> allGCPauses = new ArrayList<>();
+        List<Double> safepointTotal = new ArrayList<>();
+        List<Double> timeToSafepoint = new ArrayList<>();
+
+        for (String line : output.asLines()) {
+            Matcher m = GC_PAUSE.matcher(line);
+            if (m.find()) {
+                double ms = Double.parseDouble(m.group(2));
+                gcPauses.computeIfAbsent(m.group(1), k -> new ArrayList<>()).add(ms);
+                allGCPauses.add(ms);
+                continue;
+            }
+            m = SAFEPOINT.matcher(line);
+            if (m.find()) {
+                double total = Long.parseLong(m.group(3)) / 1_000_000.0;
+                vmOps.computeIfAbsent(m.group(1), k -> new ArrayList<>()).add(total);
+                safepointTotal.add(total);
+                timeToSafepoint.add(Long.parseLong(m.group(2)) / 1_000_000.0);
+            }
+        }
+
+        System.out.println("Pause latency summary for " + String.join(" ", args) + " (ms)");
+        report("GC pause (all)", allGCPauses);
+        for (Map.Entry<String, List<Double>> e : gcPauses.entrySet()) {
+            report("  " + e.getKey(), e.getValue());
+        }
+        report("Safepoint total", safepointTotal);
+        report("Time to safepoint", timeToSafepoint);
+        for (Map.Entry<String, List<Double>> e : vmOps.entrySet()) {
+            report("  " + e.getKey(), e.getValue());
+        }
+
+        if (safepointTotal.isEmpty()) {
+            throw new RuntimeException("No safepoints found in the workload log");
+        }
+        String maxP99 = System.getProperty("pauselatency.maxP99Ms");
+        if (maxP99 != null) {
+            double limit = Double.parseDouble(maxP99);
+            checkP99("GC pause", allGCPauses, limit);
+            checkP99("Safepoint total", safepointTotal, limit);
+        }
+    }
+
+    private static double percentile(List<Double> sorted, int percent) {
+        return sorted.get(((sorted.size() - 1) * percent) / 100);
+    }
+
+    private static void report(String what, List<Double> samples) {
+        if (samples.isEmpty()) {
+            System.out.printf("%-40s count=0%n", what);
+            return;
+        }
+        List<Double> sorted = new ArrayList<>(samples);
+        Collections.sort(sorted);
+        System.out.printf("%-40s count=%d p50=%.3f p90=%.3f p99=%.3f max=%.3f%n",
+                          what, sorted.size(),
+                          percentile(sorted, 50), percentile(sorted, 90),
+                          percentile(sorted, 99), percentile(sorted, 100));
+    }
+
+    private static void checkP99(String what, List<Double> samples, double limit) {
+        if (samples.isEmpty()) {
+            return;
+        }
+        List<Double> sorted = new ArrayList<>(samples);
+        Collections.sort(sorted);
+        double p99 = percentile(sorted, 99);
+        if (p99 > limit) {
+            throw new RuntimeException(what + " p99 " + p99 + "ms exceeds " + limit + "ms");
+        }
+    }
+
+    /**
+     * Keeps a fixed live set of byte arrays and replaces random entries at
+     * a throttled rate, so that every allocation beyond the live set
+     * becomes garbage.
+     */
+    static class Workload {
+        public static void main(String[] args) throws Exception {
+            int threads = Integer.parseInt(args[0]);
+            long allocRate = Long.parseLong(args[1]) * 1024 * 1024;
+            long liveSet = Long.parseLong(args[2]) * 1024 * 1024;
+            int objectSize = Integer.parseInt(args[3]);
+            long durationMs = Long.parseLong(args[4]) * 1000;
+
+            // Roughly account for the array header when sizing the live set.
+            int slotsPerThread = (int) Math.max(1, liveSet / (objectSize + 16) / threads);
+            long bytesPerMsPerThread = allocRate / 1000 / threads;
+            long end = System.currentTimeMillis() + durationMs;
+
+            Thread[] workers = new Thread[threads];
+            for (int t = 0; t < threads; t++) {
+                workers[t] = new Thread(() -> {
+                    Object[] live = new Object[slotsPerThread];
+                    for (int i = 0; i < live.length; i++) {
+                        live[i] = new byte[objectSize];
+                    }
+                    ThreadLocalRandom random = ThreadLocalRandom.current();
+                    long start = System.currentTimeMillis();
+                    long allocated = 0;
+                    while (true) {
+                        for (int i = 0; i < 1024; i++) {
+                            live[random.nextInt(live.length)] = new byte[objectSize];
+                        }
+                        allocated += 1024L * objectSize;
+                        long now = System.currentTimeMillis();
+                        if (now >= end) {
+                            break;
+                        }
+                        if (bytesPerMsPerThread > 0) {
+                            long ahead = allocated / bytesPerMsPerThread - (now - start);
+                            if (ahead > 0) {
+                                try {
+                                    Thread.sleep(ahead);
+                                } catch (InterruptedException e) {
+                                    throw new RuntimeException(e);
+                                }
+                            }
+                        }
+                    }
+                });
+                workers[t].start();
+            }
+            for (Thread worker : workers) {
+                worker.join();
+            }
+        }
+    }
+}
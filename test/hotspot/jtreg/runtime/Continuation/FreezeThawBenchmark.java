@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test FreezeThawBenchmark
+ * @summary Measures the latency of freezing and thawing continuations by
+ *          stack depth, frame kind and oop density, and checks that the
+ *          frames resume intact.
+ * @library /test/lib
+ * @build jdk.test.lib.process.ProcessTools
+ * @build java.base/java.lang.Continuation FreezeThawBenchmark
+ * @run driver FreezeThawBenchmark interpreted -Xint
+ * @run driver FreezeThawBenchmark c1 -XX:TieredStopAtLevel=1
+ * @run driver FreezeThawBenchmark c2 -XX:-TieredCompilation
+ */
+
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import jdk.test.lib.process.ProcessTools;
+
+// java.lang.Continuation is not part of the JDK, so the benchmark runs in a
+// VM with the one in java.base/java/lang patched in.
+public class FreezeThawBenchmark {
+    static final int[] DEPTHS = { 1, 10, 100 };
+    static final int WARMUP = 20_000;
+    static final int ITERATIONS = 100_000;
+
+    public static void main(String... args) throws Exception {
+        Path patches = Paths.get(System.getProperty("test.classes"), "patches", "java.base");
+        ProcessTools.executeTestJvm("--patch-module", "java.base=" + patches.toString(),
+                                    args[1], Bench.class.getName(), args[0])
+                    .shouldHaveExitValue(0);
+    }
+
+    public static class Bench {
+        public static void main(String... args) {
+            Task probe = new Task(1, false);
+            probe.cont.run();
+            if (probe.yielded != 0) {
+                System.out.println("Skipped: continuations are not supported on this platform");
+                return;
+            }
+            String kind = args[0];
+            for (int depth : DEPTHS) {
+                for (boolean oops : new boolean[] { false, true }) {
+                    Task task = new Task(depth, oops);
+                    task.measure(WARMUP);
+                    long ns = task.measure(ITERATIONS);
+                    System.out.println(String.format("%-12s depth %4d %-8s %8d ns/op",
+                                                     kind, depth, oops ? "oops" : "no-oops",
+                                                     ns / ITERATIONS));
+                }
+            }
+        }
+    }
+
+    // A continuation that yields at the bottom of depth frames, each with
+    // four primitive or reference locals that must survive the yield.
+    static class Task implements Runnable {
+        final int depth;
+        final boolean oops;
+        final Continuation cont;
+        int yielded;
+
+        Task(int depth, boolean oops) {
+            this.depth = depth;
+            this.oops = oops;
+            this.cont = new Continuation(this);
+        }
+
+        // Returns the time taken by n yield/resume round trips.
+        long measure(int n) {
+            long start = System.nanoTime();
+            for (int i = 0; i < n; i++) {
+                cont.run();
+                if (yielded != 0) {
+                    throw new RuntimeException("could not freeze: " + yielded);
+                }
+            }
+            return System.nanoTime() - start;
+        }
+
+        public void run() {
+            while (yielded == 0) {
+                if (oops) {
+                    withOops(depth);
+                } else {
+                    withPrimitives(depth);
+                }
+            }
+        }
+
+        int withPrimitives(int n) {
+            int a = n, b = n + 1, c = n + 2, d = n + 3;
+            int r = n > 1 ? withPrimitives(n - 1) : yieldOnce();
+            check(a == n && b == n + 1 && c == n + 2 && d == n + 3);
+            return r + a;
+        }
+
+        int withOops(int n) {
+            Integer a = n, b = n + 1, c = n + 2, d = n + 3;
+            int r = n > 1 ? withOops(n - 1) : yieldOnce();
+            check(a.intValue() == n && b.intValue() == n + 1 && c.intValue() == n + 2 && d.intValue() == n + 3);
+            return r + a;
+        }
+
+        // Records a failure to freeze, which ends the task.
+        int yieldOnce() {
+            yielded = Continuation.doYield(cont);
+            return 0;
+        }
+
+        static void check(boolean ok) {
+            if (!ok) {
+                throw new RuntimeException("frame changed across freeze/thaw");
+            }
+        }
+    }
+}
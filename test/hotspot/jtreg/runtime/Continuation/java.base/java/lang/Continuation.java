@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+package java.lang;
+
+import jdk.internal.HotSpotIntrinsicCandidate;
+
+/**
+ * A minimal java.lang.Continuation for patching into java.base, with the
+ * fields and methods the VM expects (see runtime/continuation.hpp). The
+ * JDK does not ship the class, so the VM only supports continuations when
+ * it is patched in.
+ */
+public class Continuation {
+    // The frozen frames, written by the VM
+    private long[] stack;
+    private Object[] refStack;
+
+    private final Runnable target;
+    private boolean done;
+
+    public Continuation(Runnable target) {
+        this.target = target;
+    }
+
+    /**
+     * Runs the target until it yields or returns, resuming it where it last
+     * yielded if it did.
+     */
+    public final void run() {
+        if (done) {
+            throw new IllegalStateException("Continuation terminated");
+        }
+        if (stack == null) {
+            enter();
+        } else {
+            doContinue();
+        }
+    }
+
+    public final boolean isDone() {
+        return done;
+    }
+
+    // The frames above this one are frozen by doYield().
+    @HotSpotIntrinsicCandidate
+    private void enter() {
+        target.run();
+        done = true;
+    }
+
+    // Thaws the frozen frames; only reached without the doContinue stub,
+    // in which case nothing is ever frozen.
+    @HotSpotIntrinsicCandidate
+    private void doContinue() {
+        throw new InternalError("no frozen frames");
+    }
+
+    /**
+     * Freezes the frames of the current thread up to the enter() frame of
+     * cont and returns to the caller of run(). Returns 0 once resumed, or
+     * the reason the frames could not be frozen.
+     */
+    @HotSpotIntrinsicCandidate
+    public static int doYield(Continuation cont) {
+        return 1;   // pinned, without the doYield stub
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import org.testng.annotations.Test;
+
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+/*
+ * @test
+ * @summary Test of diagnostic command GC.alloc_profile
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.compiler
+ *          java.management
+ *          jdk.internal.jvmstat/sun.jvmstat.monitor
+ * @run testng/othervm -XX:+AllocationProfiling AllocationProfileTest
+ */
+public class AllocationProfileTest {
+    public static class Payload {
+        long a, b, c, d;
+    }
+
+    public static Object sink;
+
+    public void run(CommandExecutor executor) {
+        // Enough allocations of a single class to refill the TLAB many times.
+        for (int i = 0; i < 10_000_000; i++) {
+            sink = new Payload();
+        }
+
+        OutputAnalyzer output = executor.execute("GC.alloc_profile");
+        output.shouldContain("#sampled bytes");
+        output.shouldContain("AllocationProfileTest$Payload");
+        output.shouldMatch("Total\\s+\\d+\\s+\\d+");
+
+        output = executor.execute("GC.alloc_profile -max 1");
+        output.shouldMatch("(?m)^\\s+1: ");
+        output.shouldNotMatch("(?m)^\\s+2: ");
+    }
+
+    @Test
+    public void jmx() {
+        run(new JMXExecutor());
+    }
+}